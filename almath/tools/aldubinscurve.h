@@ -10,6 +10,7 @@
 #define _LIBALMATH_ALMATH_TOOLS_ALDUBINSCURVE_H_
 
 #include <almath/types/alpose2d.h>
+#include <almath/tools/alrealtime.h>
 #include <vector>
 
 namespace AL {
@@ -24,6 +25,25 @@ namespace AL {
       const Pose2D& pTargetPose,
       const float   pCircleRadius);
 
+    /// <summary>
+    /// Get the dubins solutions, without allocation nor exception.
+    /// </summary>
+    /// <param name="pTargetPose">   the target pose </param>
+    /// <param name="pCircleRadius"> the circle radius </param>
+    /// <param name="pSolutions">    the output buffer, the three poses of the
+    ///                              solution are written in it </param>
+    /// <param name="pSize">         the number of poses of pSolutions </param>
+    /// <returns>
+    /// MATH_OK, MATH_BUFFER_TOO_SMALL if pSize is less than 3, or
+    /// MATH_INVALID_ARGUMENT if the target pose is nearer than 4 circle radius.
+    /// </returns>
+    /// \ingroup Tools
+    const MATH_STATUS tryGetDubinsSolutions(
+      const Pose2D&       pTargetPose,
+      const float         pCircleRadius,
+      Pose2D*             pSolutions,
+      const unsigned int& pSize) ALMATH_NOEXCEPT;
+
   }
 }
 #endif  // _LIBALMATH_ALMATH_TOOLS_ALDUBINSCURVE_H_
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALEXPRESSION_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALEXPRESSION_H_
+
+#include <stdexcept>
+
+#include <almath/types/alpose2d.h>
+#include <almath/types/alposition2d.h>
+#include <almath/types/alposition3d.h>
+#include <almath/types/alposition6d.h>
+#include <almath/types/alvelocity3d.h>
+#include <almath/types/alvelocity6d.h>
+
+/// Expression templates for the element-wise arithmetic of ALMath.
+///
+/// The usual operators of Position3D and the other vector-like types
+/// return a new value for each operator. An expression started with
+/// lazy() instead builds a tree of inline nodes, and computes all the
+/// members in one pass when it is converted to the result type:
+///
+///   Position3D r = lazy(a) + lazy(b)*0.5f - c;
+///
+/// An expression mixes lazy() values, plain values of the same type and
+/// floats, with +, -, unary -, * by a float and / by a float. The result
+/// is the same as with the usual operators, which are not changed.
+///
+/// The nodes keep references to their operands: convert the expression
+/// to a value in the statement which builds it, do not store it with
+/// auto.
+namespace AL {
+  namespace Math {
+
+    /// <summary>
+    /// Number of floats of the types which accept expressions: Pose2D,
+    /// Position2D, Position3D, Position6D, Velocity3D and Velocity6D.
+    /// </summary>
+    /// \ingroup Tools
+    template <class T>
+    struct ExpressionTraits;
+
+    template <> struct ExpressionTraits<Pose2D>     { enum { size = 3 }; };
+    template <> struct ExpressionTraits<Position2D> { enum { size = 2 }; };
+    template <> struct ExpressionTraits<Position3D> { enum { size = 3 }; };
+    template <> struct ExpressionTraits<Position6D> { enum { size = 6 }; };
+    template <> struct ExpressionTraits<Velocity3D> { enum { size = 3 }; };
+    template <> struct ExpressionTraits<Velocity6D> { enum { size = 6 }; };
+
+    /// <summary>
+    /// Copy the members [0, N) of an expression, unrolled at compile time
+    /// so that the nodes are inlined with a constant index.
+    /// </summary>
+    /// \ingroup Tools
+    template <class E, unsigned int N>
+    struct ExpressionLoop
+    {
+      static void evaluate(const E& pExpression, float* pData)
+      {
+        ExpressionLoop<E, N-1>::evaluate(pExpression, pData);
+        pData[N-1] = pExpression.at(N-1);
+      }
+    };
+
+    template <class E>
+    struct ExpressionLoop<E, 0>
+    {
+      static void evaluate(const E&, float*) {}
+    };
+
+    /// <summary>
+    /// Base of an expression E whose result is a T.
+    /// </summary>
+    /// \ingroup Tools
+    template <class T, class E>
+    struct Expression
+    {
+      /// <summary> Return the expression as its node type. </summary>
+      const E& node() const
+      {
+        return static_cast<const E&>(*this);
+      }
+
+      /// <summary>
+      /// Compute all the members of the result in one pass. The result
+      /// may be one of the operands.
+      /// </summary>
+      /// <param name="pResult"> the result </param>
+      void evaluate(T& pResult) const
+      {
+        ExpressionLoop<E, ExpressionTraits<T>::size>::evaluate(
+              node(), reinterpret_cast<float*>(&pResult));
+      }
+
+      /// <summary> Return the result of the expression. </summary>
+      operator T() const
+      {
+        // a copy of a constant is inlined, unlike the default
+        // constructor, so the result may stay in registers
+        static const T zero;
+        T result(zero);
+        evaluate(result);
+        return result;
+      }
+    };
+
+    /// <summary> A value in an expression. </summary>
+    /// \ingroup Tools
+    template <class T>
+    struct ExpressionValue: public Expression<T, ExpressionValue<T> >
+    {
+      explicit ExpressionValue(const T& pValue):
+        fData(reinterpret_cast<const float*>(&pValue)) {}
+
+      float at(const unsigned int& pIndex) const
+      {
+        return fData[pIndex];
+      }
+
+      const float* fData;
+    };
+
+    /// <summary> The sum of two expressions. </summary>
+    /// \ingroup Tools
+    template <class T, class L, class R>
+    struct ExpressionSum: public Expression<T, ExpressionSum<T, L, R> >
+    {
+      ExpressionSum(const L& pLeft, const R& pRight):
+        fLeft(pLeft), fRight(pRight) {}
+
+      float at(const unsigned int& pIndex) const
+      {
+        return fLeft.at(pIndex) + fRight.at(pIndex);
+      }
+
+      const L fLeft;
+      const R fRight;
+    };
+
+    /// <summary> The difference of two expressions. </summary>
+    /// \ingroup Tools
+    template <class T, class L, class R>
+    struct ExpressionDifference: public Expression<T, ExpressionDifference<T, L, R> >
+    {
+      ExpressionDifference(const L& pLeft, const R& pRight):
+        fLeft(pLeft), fRight(pRight) {}
+
+      float at(const unsigned int& pIndex) const
+      {
+        return fLeft.at(pIndex) - fRight.at(pIndex);
+      }
+
+      const L fLeft;
+      const R fRight;
+    };
+
+    /// <summary> An expression multiplied by a float. </summary>
+    /// \ingroup Tools
+    template <class T, class E>
+    struct ExpressionScale: public Expression<T, ExpressionScale<T, E> >
+    {
+      ExpressionScale(const E& pExpression, const float& pFactor):
+        fExpression(pExpression), fFactor(pFactor) {}
+
+      float at(const unsigned int& pIndex) const
+      {
+        return fExpression.at(pIndex)*fFactor;
+      }
+
+      const E fExpression;
+      const float fFactor;
+    };
+
+    /// <summary>
+    /// Start an expression with a value.
+    /// </summary>
+    /// <param name="pValue"> the value, which must outlive the expression </param>
+    /// \ingroup Tools
+    template <class T>
+    inline ExpressionValue<T> lazy(const T& pValue)
+    {
+      return ExpressionValue<T>(pValue);
+    }
+
+    template <class T, class L, class R>
+    inline ExpressionSum<T, L, R> operator+(
+      const Expression<T, L>& pLeft,
+      const Expression<T, R>& pRight)
+    {
+      return ExpressionSum<T, L, R>(pLeft.node(), pRight.node());
+    }
+
+    template <class T, class L>
+    inline ExpressionSum<T, L, ExpressionValue<T> > operator+(
+      const Expression<T, L>& pLeft,
+      const T&                pRight)
+    {
+      return ExpressionSum<T, L, ExpressionValue<T> >(
+            pLeft.node(), ExpressionValue<T>(pRight));
+    }
+
+    template <class T, class R>
+    inline ExpressionSum<T, ExpressionValue<T>, R> operator+(
+      const T&                pLeft,
+      const Expression<T, R>& pRight)
+    {
+      return ExpressionSum<T, ExpressionValue<T>, R>(
+            ExpressionValue<T>(pLeft), pRight.node());
+    }
+
+    template <class T, class L, class R>
+    inline ExpressionDifference<T, L, R> operator-(
+      const Expression<T, L>& pLeft,
+      const Expression<T, R>& pRight)
+    {
+      return ExpressionDifference<T, L, R>(pLeft.node(), pRight.node());
+    }
+
+    template <class T, class L>
+    inline ExpressionDifference<T, L, ExpressionValue<T> > operator-(
+      const Expression<T, L>& pLeft,
+      const T&                pRight)
+    {
+      return ExpressionDifference<T, L, ExpressionValue<T> >(
+            pLeft.node(), ExpressionValue<T>(pRight));
+    }
+
+    template <class T, class R>
+    inline ExpressionDifference<T, ExpressionValue<T>, R> operator-(
+      const T&                pLeft,
+      const Expression<T, R>& pRight)
+    {
+      return ExpressionDifference<T, ExpressionValue<T>, R>(
+            ExpressionValue<T>(pLeft), pRight.node());
+    }
+
+    template <class T, class E>
+    inline ExpressionScale<T, E> operator-(
+      const Expression<T, E>& pExpression)
+    {
+      return ExpressionScale<T, E>(pExpression.node(), -1.0f);
+    }
+
+    template <class T, class E>
+    inline ExpressionScale<T, E> operator*(
+      const Expression<T, E>& pExpression,
+      const float&            pFactor)
+    {
+      return ExpressionScale<T, E>(pExpression.node(), pFactor);
+    }
+
+    template <class T, class E>
+    inline ExpressionScale<T, E> operator*(
+      const float&            pFactor,
+      const Expression<T, E>& pExpression)
+    {
+      return ExpressionScale<T, E>(pExpression.node(), pFactor);
+    }
+
+    template <class T, class E>
+    inline ExpressionScale<T, E> operator/(
+      const Expression<T, E>& pExpression,
+      const float&            pDivisor)
+    {
+      if (pDivisor == 0.0f)
+      {
+        throw std::runtime_error(
+          "ALExpression: operator/ Division by zeros.");
+      }
+      return ExpressionScale<T, E>(pExpression.node(), 1.0f/pDivisor);
+    }
+
+  } // namespace Math
+} // namespace AL
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALEXPRESSION_H_
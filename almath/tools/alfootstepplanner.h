@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALFOOTSTEPPLANNER_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALFOOTSTEPPLANNER_H_
+
+#include <almath/tools/alpolygonbroadphase.h>
+#include <almath/types/alpose2d.h>
+#include <almath/types/alposition2d.h>
+#include <chrono>
+#include <map>
+#include <vector>
+
+namespace AL
+{
+  namespace Math
+  {
+    /// <summary>
+    /// A footstep planned by FootstepPlanner.
+    /// </summary>
+    /// \ingroup Tools
+    struct Footstep
+    {
+      /// <summary> the pose of the foot in the world frame </summary>
+      Pose2D pose;
+      /// <summary>
+      /// the move of the foot expressed in the frame of the support foot,
+      /// as given to avoidFootCollision
+      /// </summary>
+      Pose2D move;
+      /// <summary> true if the moving foot is the left foot </summary>
+      bool isLeft;
+
+      /// <summary>
+      /// Create a Footstep of the right foot at the origin.
+      /// </summary>
+      Footstep();
+    };
+
+    /// <summary>
+    /// Plan a sequence of footsteps toward a goal pose.
+    ///
+    /// The search is an A* over a discretized set of actions. An action is
+    /// the displacement of the swing foot from its nominal position, at
+    /// pFootSeparation on the side of the support foot, given for the left
+    /// foot; it is mirrored for the right foot. Each action is clipped with
+    /// clipFootWithEllipse and its orientation is limited by
+    /// avoidFootCollision. The footsteps in collision with an obstacle are
+    /// rejected.
+    ///
+    /// The states are the poses of the last placed foot, rounded to the
+    /// resolution of the planner. The successors of a state are computed
+    /// once per planning, so that the anytime mode (ARA*) reuses them and
+    /// the cost of the states already expanded at each weight decrease.
+    /// </summary>
+    /// \ingroup Tools
+    class FootstepPlanner
+    {
+    public:
+      /// <summary>
+      /// Create a FootstepPlanner.
+      /// </summary>
+      /// <param name="pLFootBoundingBox"> vector<Pose2D> of the left footBoundingBox. </param>
+      /// <param name="pRFootBoundingBox"> vector<Pose2D> of the right footBoundingBox. </param>
+      /// <param name="pMaxFootX">         float of the max step along x axis. </param>
+      /// <param name="pMaxFootY">         float of the max step along y axis. </param>
+      /// <param name="pFootSeparation">   float of the nominal distance between the feet. </param>
+      /// <param name="pActions">          vector<Pose2D> of the displacements of the left
+      ///                                  foot from its nominal position. </param>
+      FootstepPlanner(
+        const std::vector<Pose2D>& pLFootBoundingBox,
+        const std::vector<Pose2D>& pRFootBoundingBox,
+        const float&               pMaxFootX,
+        const float&               pMaxFootY,
+        const float&               pFootSeparation,
+        const std::vector<Pose2D>& pActions);
+
+      /// <summary>
+      /// Set the obstacles, as convex polygons in the world frame.
+      /// A footstep is rejected if the foot polygon overlaps one of them.
+      /// </summary>
+      /// <param name="pObstacles"> vector of convex polygons. </param>
+      void setObstacles(const std::vector<std::vector<Pose2D> >& pObstacles);
+
+      /// <summary>
+      /// Set the resolution used to identify two states.
+      /// default: 0.01 meter and 0.1 radian.
+      /// </summary>
+      /// <param name="pPositionResolution"> float of the position resolution. </param>
+      /// <param name="pAngleResolution">    float of the angle resolution. </param>
+      void setResolution(
+        const float& pPositionResolution,
+        const float& pAngleResolution);
+
+      /// <summary>
+      /// Set the tolerance on the final pose of each foot.
+      /// default: 0.04 meter and 0.15 radian.
+      /// </summary>
+      /// <param name="pPositionTolerance"> float of the position tolerance. </param>
+      /// <param name="pAngleTolerance">    float of the angle tolerance. </param>
+      void setGoalTolerance(
+        const float& pPositionTolerance,
+        const float& pAngleTolerance);
+
+      /// <summary>
+      /// Set the maximal number of expanded states of a planning.
+      /// default: 20000.
+      /// </summary>
+      /// <param name="pMaxExpansions"> the maximal number of expansions. </param>
+      void setMaxExpansions(const unsigned int& pMaxExpansions);
+
+      /// <summary>
+      /// Plan the optimal sequence of footsteps (with the set of actions)
+      /// from the actual feet poses to the goal pose. The goal pose is the
+      /// pose of the middle of the feet.
+      /// </summary>
+      /// <param name="pLFoot">         Pose2D of the left foot in the world frame. </param>
+      /// <param name="pRFoot">         Pose2D of the right foot in the world frame. </param>
+      /// <param name="pIsLeftSupport"> bool true if the first step is done by the right foot. </param>
+      /// <param name="pGoal">          Pose2D of the goal in the world frame. </param>
+      /// <param name="pFootsteps">     vector<Footstep> of the planned footsteps. </param>
+      /// <returns>
+      /// true if a sequence was found
+      /// </returns>
+      const bool plan(
+        const Pose2D&          pLFoot,
+        const Pose2D&          pRFoot,
+        const bool&            pIsLeftSupport,
+        const Pose2D&          pGoal,
+        std::vector<Footstep>& pFootsteps);
+
+      /// <summary>
+      /// Plan a sequence of footsteps with ARA*: a first solution is found
+      /// with an inflated heuristic, then improved while the weight is
+      /// decreased to 1, until the time budget is spent.
+      /// The number of steps of the returned sequence is at most
+      /// getWeight() times the optimal one.
+      /// </summary>
+      /// <param name="pLFoot">         Pose2D of the left foot in the world frame. </param>
+      /// <param name="pRFoot">         Pose2D of the right foot in the world frame. </param>
+      /// <param name="pIsLeftSupport"> bool true if the first step is done by the right foot. </param>
+      /// <param name="pGoal">          Pose2D of the goal in the world frame. </param>
+      /// <param name="pTimeBudget">    float of the time budget in seconds of wall clock (<= 0: no budget). </param>
+      /// <param name="pInitialWeight"> float of the first weight of the heuristic (>= 1). </param>
+      /// <param name="pFootsteps">     vector<Footstep> of the planned footsteps. </param>
+      /// <returns>
+      /// true if a sequence was found
+      /// </returns>
+      const bool planAnytime(
+        const Pose2D&          pLFoot,
+        const Pose2D&          pRFoot,
+        const bool&            pIsLeftSupport,
+        const Pose2D&          pGoal,
+        const float&           pTimeBudget,
+        const float&           pInitialWeight,
+        std::vector<Footstep>& pFootsteps);
+
+      /// <summary>
+      /// Return the weight of the heuristic of the last returned sequence.
+      /// </summary>
+      float getWeight() const;
+
+      /// <summary>
+      /// Return the number of states expanded by the last planning.
+      /// </summary>
+      unsigned int getNbExpansions() const;
+
+    private:
+      struct StateKey
+      {
+        int x;
+        int y;
+        int theta;
+        bool isLeft;
+
+        bool operator< (const StateKey& pKey) const;
+      };
+
+      struct Successor
+      {
+        unsigned int state;
+        Pose2D move;
+      };
+
+      struct State
+      {
+        // pose of the last placed foot
+        Pose2D pose;
+        bool isLeft;
+        float g;
+        float h;
+        int parent;
+        Pose2D move;
+        bool isExpanded;
+        bool isClosed;
+        bool isInconsistent;
+        std::vector<Successor> successors;
+      };
+
+      const bool xPlan(
+        const Pose2D&          pLFoot,
+        const Pose2D&          pRFoot,
+        const bool&            pIsLeftSupport,
+        const Pose2D&          pGoal,
+        const float&           pTimeBudget,
+        const float&           pInitialWeight,
+        std::vector<Footstep>& pFootsteps);
+
+      const bool xImprovePath(
+        const float&                                 pWeight,
+        const std::chrono::steady_clock::time_point& pDeadline,
+        const bool&                                  pHasDeadline);
+
+      void xExpand(const unsigned int& pState);
+
+      unsigned int xGetState(
+        const Pose2D& pPose,
+        const bool&   pIsLeft);
+
+      const bool xIsGoal(const unsigned int& pState) const;
+
+      float xHeuristic(
+        const Pose2D& pPose,
+        const bool&   pIsLeft) const;
+
+      const bool xIsInCollisionWithObstacles(
+        const Pose2D& pPose,
+        const bool&   pIsLeft) const;
+
+      std::vector<Pose2D> fLFootBoundingBox;
+      std::vector<Pose2D> fRFootBoundingBox;
+      float fMaxFootX;
+      float fMaxFootY;
+      float fFootSeparation;
+      std::vector<Pose2D> fActions;
+      float fMaxStepTheta;
+      PolygonBroadPhase fObstacles;
+
+      float fPositionResolution;
+      float fAngleResolution;
+      float fPositionTolerance;
+      float fAngleTolerance;
+      unsigned int fMaxExpansions;
+
+      // search data, reset by each planning
+      std::vector<State> fStates;
+      std::map<StateKey, unsigned int> fStateIndex;
+      std::vector<std::pair<float, unsigned int> > fOpen;
+      Pose2D fLFootGoal;
+      Pose2D fRFootGoal;
+      Pose2D fStartSwingFoot;
+      int fGoalState;
+      float fWeight;
+      unsigned int fNbExpansions;
+    };
+
+  } // namespace Math
+} // namespace AL
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALFOOTSTEPPLANNER_H_
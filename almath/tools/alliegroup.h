@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALLIEGROUP_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALLIEGROUP_H_
+
+#include <array>
+#include <stdexcept>
+
+#include <almath/types/alpose2d.h>
+#include <almath/types/alposition3d.h>
+#include <almath/types/alquaternion.h>
+#include <almath/types/alrotation.h>
+#include <almath/types/altransform.h>
+#include <almath/types/altransform2d.h>
+#include <almath/types/alvelocity6d.h>
+
+/// Lie groups of ALMath: the same operations on the poses of each space,
+/// resolved at compile time.
+///
+/// LieGroup<G> gives, for a group G:
+///   - dof: the number of degrees of freedom;
+///   - Tangent: the type of the tangent space, the velocities;
+///   - Matrix: a dof*dof matrix, row major;
+///   - identity, compose, inverse;
+///   - exp, from the tangent space to the group, and log, its inverse;
+///   - adjoint: exp(adjoint(g)*v) = g*exp(v)*inverse(g);
+///   - leftJacobian and rightJacobian, the differentials of exp:
+///     exp(v + dv) = exp(leftJacobian(v)*dv)*exp(v) = exp(v)*exp(rightJacobian(v)*dv)
+///     at the first order.
+///
+/// The groups are:
+///   - SE(2): Pose2D and Transform2D, Tangent Pose2D (vx, vy, vtheta);
+///   - SO(3): Rotation and Quaternion, Tangent Position3D, the rotation vector;
+///   - SE(3): Transform, Tangent Velocity6D, as velocityExponential.
+///
+/// The generic functions liePlus, lieMinus, lieInterpolate and lieMean
+/// work on any G with a LieGroup<G>.
+namespace AL {
+  namespace Math {
+
+    /// <summary>
+    /// Operations of the Lie group of the type G; see alliegroup.h.
+    /// </summary>
+    /// \ingroup Tools
+    template <class G>
+    struct LieGroup;
+
+    /// <summary> SE(2) on Pose2D. </summary>
+    /// \ingroup Tools
+    template <>
+    struct LieGroup<Pose2D>
+    {
+      enum { dof = 3 };
+      typedef Pose2D Tangent;
+      typedef std::array<float, 9> Matrix;
+
+      static Pose2D identity();
+      static Pose2D compose(const Pose2D& pA, const Pose2D& pB);
+      static Pose2D inverse(const Pose2D& pA);
+      static Pose2D exp(const Tangent& pV);
+      static Tangent log(const Pose2D& pA);
+      static Matrix adjoint(const Pose2D& pA);
+      static Matrix leftJacobian(const Tangent& pV);
+      static Matrix rightJacobian(const Tangent& pV);
+    };
+
+    /// <summary> SE(2) on Transform2D. </summary>
+    /// \ingroup Tools
+    template <>
+    struct LieGroup<Transform2D>
+    {
+      enum { dof = 3 };
+      typedef Pose2D Tangent;
+      typedef std::array<float, 9> Matrix;
+
+      static Transform2D identity();
+      static Transform2D compose(const Transform2D& pA, const Transform2D& pB);
+      static Transform2D inverse(const Transform2D& pA);
+      static Transform2D exp(const Tangent& pV);
+      static Tangent log(const Transform2D& pA);
+      static Matrix adjoint(const Transform2D& pA);
+      static Matrix leftJacobian(const Tangent& pV);
+      static Matrix rightJacobian(const Tangent& pV);
+    };
+
+    /// <summary> SO(3) on Rotation. </summary>
+    /// \ingroup Tools
+    template <>
+    struct LieGroup<Rotation>
+    {
+      enum { dof = 3 };
+      typedef Position3D Tangent;
+      typedef std::array<float, 9> Matrix;
+
+      static Rotation identity();
+      static Rotation compose(const Rotation& pA, const Rotation& pB);
+      static Rotation inverse(const Rotation& pA);
+      static Rotation exp(const Tangent& pV);
+      static Tangent log(const Rotation& pA);
+      static Matrix adjoint(const Rotation& pA);
+      static Matrix leftJacobian(const Tangent& pV);
+      static Matrix rightJacobian(const Tangent& pV);
+    };
+
+    /// <summary> SO(3) on Quaternion, of norm 1. </summary>
+    /// \ingroup Tools
+    template <>
+    struct LieGroup<Quaternion>
+    {
+      enum { dof = 3 };
+      typedef Position3D Tangent;
+      typedef std::array<float, 9> Matrix;
+
+      static Quaternion identity();
+      static Quaternion compose(const Quaternion& pA, const Quaternion& pB);
+      static Quaternion inverse(const Quaternion& pA);
+      static Quaternion exp(const Tangent& pV);
+      static Tangent log(const Quaternion& pA);
+      static Matrix adjoint(const Quaternion& pA);
+      static Matrix leftJacobian(const Tangent& pV);
+      static Matrix rightJacobian(const Tangent& pV);
+    };
+
+    /// <summary>
+    /// SE(3) on Transform. exp is velocityExponential; log is its inverse,
+    /// as transformLogarithm, but computed in double, so it stays accurate
+    /// for the small rotations.
+    /// </summary>
+    /// \ingroup Tools
+    template <>
+    struct LieGroup<Transform>
+    {
+      enum { dof = 6 };
+      typedef Velocity6D Tangent;
+      typedef std::array<float, 36> Matrix;
+
+      static Transform identity();
+      static Transform compose(const Transform& pA, const Transform& pB);
+      static Transform inverse(const Transform& pA);
+      static Transform exp(const Tangent& pV);
+      static Tangent log(const Transform& pA);
+      static Matrix adjoint(const Transform& pA);
+      static Matrix leftJacobian(const Tangent& pV);
+      static Matrix rightJacobian(const Tangent& pV);
+    };
+
+    /// <summary>
+    /// Move a pose along a velocity in its own frame: pA*exp(pV).
+    /// </summary>
+    /// <param name="pA"> the pose </param>
+    /// <param name="pV"> the velocity </param>
+    /// \ingroup Tools
+    template <class G>
+    inline G liePlus(
+      const G&                              pA,
+      const typename LieGroup<G>::Tangent& pV)
+    {
+      return LieGroup<G>::compose(pA, LieGroup<G>::exp(pV));
+    }
+
+    /// <summary>
+    /// Velocity from a pose to another one, in the frame of the first one:
+    /// log(inverse(pB)*pA), so that liePlus(pB, lieMinus(pA, pB)) = pA.
+    /// </summary>
+    /// <param name="pA"> the pose to reach </param>
+    /// <param name="pB"> the pose to start from </param>
+    /// \ingroup Tools
+    template <class G>
+    inline typename LieGroup<G>::Tangent lieMinus(
+      const G& pA,
+      const G& pB)
+    {
+      return LieGroup<G>::log(LieGroup<G>::compose(LieGroup<G>::inverse(pB), pA));
+    }
+
+    /// <summary>
+    /// Interpolate between two poses along the geodesic, as transformMean:
+    /// pA*exp(pRatio*log(inverse(pA)*pB)).
+    /// </summary>
+    /// <param name="pA"> the pose at pRatio 0 </param>
+    /// <param name="pB"> the pose at pRatio 1 </param>
+    /// <param name="pRatio"> the ratio, usually in [0, 1] </param>
+    /// \ingroup Tools
+    template <class G>
+    inline G lieInterpolate(
+      const G&     pA,
+      const G&     pB,
+      const float& pRatio)
+    {
+      return liePlus(pA, lieMinus(pB, pA)*pRatio);
+    }
+
+    /// <summary>
+    /// Compute the mean of poses: the pose m such that the mean of the
+    /// lieMinus(pValues[i], m) is zero, by Gauss-Newton iterations from
+    /// the first pose. The poses must be closer than pi to each other in
+    /// rotation.
+    /// </summary>
+    /// <param name="pValues"> the poses </param>
+    /// <param name="pSize"> the number of poses, at least one </param>
+    /// <param name="pNbIterations"> the number of iterations - default: 10 </param>
+    /// \ingroup Tools
+    template <class G>
+    inline G lieMean(
+      const G*            pValues,
+      const unsigned int& pSize,
+      const unsigned int& pNbIterations = 10)
+    {
+      if (pSize == 0)
+      {
+        throw std::invalid_argument(
+          "ALLieGroup: lieMean needs at least one value.");
+      }
+      G mean = pValues[0];
+      for (unsigned int k=0; k<pNbIterations; k++)
+      {
+        typename LieGroup<G>::Tangent step = typename LieGroup<G>::Tangent();
+        for (unsigned int i=0; i<pSize; i++)
+        {
+          step = step + lieMinus(pValues[i], mean);
+        }
+        mean = liePlus(mean, step*(1.0f/static_cast<float>(pSize)));
+      }
+      return mean;
+    }
+
+  } // namespace Math
+} // namespace AL
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALLIEGROUP_H_
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALMATHARRAY_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALMATHARRAY_H_
+
+#include <array>
+
+#include <almath/tools/almathbinary.h>
+
+/// Conversions between the ALMath types and contiguous float buffers,
+/// without allocation.
+///
+/// A value is stored as its float members, in the order of their
+/// declaration, as in almathbinary.h: BinaryTraits<T>::nbFloats floats.
+/// A Transform is the 12 floats of its 3x4 matrix, row by row, as
+/// transformToFloatVector. A Quaternion is [w, x, y, z], as toVector.
+///
+/// These functions are the allocation free replacements of toVector and
+/// of the std::vector<float> constructors. They require C++11.
+namespace AL {
+namespace Math {
+
+// defined in almath/tools/althreadpool.h
+struct ExecutionPolicy;
+
+/// <summary>
+/// Fixed size array of the floats of a type.
+/// </summary>
+/// \ingroup Tools
+template <class T>
+struct FloatArray
+{
+  typedef std::array<float, BinaryTraits<T>::nbFloats> type;
+};
+
+/// <summary>
+/// Return the floats of a value in a fixed size array.
+/// </summary>
+/// <param name="pValue"> the value </param>
+/// <returns>
+/// the floats of pValue
+/// </returns>
+/// \ingroup Tools
+template <class T>
+typename FloatArray<T>::type toArray(const T& pValue);
+
+/// <summary>
+/// Return the value stored in a fixed size array, as in
+/// fromArray<Transform>(floats).
+/// </summary>
+/// <param name="pArray"> the floats of the value </param>
+/// <returns>
+/// the value
+/// </returns>
+/// \ingroup Tools
+template <class T>
+T fromArray(const typename FloatArray<T>::type& pArray);
+
+/// <summary>
+/// Write the floats of a value in a buffer.
+/// </summary>
+/// <param name="pValue"> the value </param>
+/// <param name="pData">  the buffer, of at least BinaryTraits<T>::nbFloats floats </param>
+/// \ingroup Tools
+template <class T>
+void toFloats(
+  const T& pValue,
+  float*   pData);
+
+/// <summary>
+/// Read a value from a buffer.
+/// </summary>
+/// <param name="pData">  the buffer, of at least BinaryTraits<T>::nbFloats floats </param>
+/// <param name="pValue"> the value read </param>
+/// \ingroup Tools
+template <class T>
+void fromFloats(
+  const float* pData,
+  T&           pValue);
+
+/// <summary>
+/// Write an array of values in a flat buffer, with a single copy.
+/// The values which do not fit in the buffer are not written.
+/// </summary>
+/// <param name="pValues">   the values </param>
+/// <param name="pSize">     the number of values </param>
+/// <param name="pData">     the buffer </param>
+/// <param name="pNbFloats"> the number of floats of the buffer </param>
+/// <returns>
+/// the number of values written
+/// </returns>
+/// \ingroup Tools
+template <class T>
+unsigned int toFloats(
+  const T*            pValues,
+  const unsigned int& pSize,
+  float*              pData,
+  const unsigned int& pNbFloats);
+
+/// <summary>
+/// Read an array of values from a flat buffer, with a single copy.
+/// A partial value at the end of the buffer is not read.
+/// </summary>
+/// <param name="pData">     the buffer </param>
+/// <param name="pNbFloats"> the number of floats of the buffer </param>
+/// <param name="pValues">   the values read </param>
+/// <param name="pSize">     the number of values of pValues </param>
+/// <returns>
+/// the number of values read
+/// </returns>
+/// \ingroup Tools
+template <class T>
+unsigned int fromFloats(
+  const float*        pData,
+  const unsigned int& pNbFloats,
+  T*                  pValues,
+  const unsigned int& pSize);
+
+/// <summary>
+/// Write an array of values in a flat buffer, on the threads of an
+/// execution policy. The result is the same as the one of the sequential
+/// version.
+/// </summary>
+/// <param name="pValues">   the values </param>
+/// <param name="pSize">     the number of values </param>
+/// <param name="pData">     the buffer </param>
+/// <param name="pNbFloats"> the number of floats of the buffer </param>
+/// <param name="pPolicy">   the execution policy </param>
+/// <returns>
+/// the number of values written
+/// </returns>
+/// \ingroup Tools
+template <class T>
+unsigned int toFloats(
+  const T*               pValues,
+  const unsigned int&    pSize,
+  float*                 pData,
+  const unsigned int&    pNbFloats,
+  const ExecutionPolicy& pPolicy);
+
+/// <summary>
+/// Read an array of values from a flat buffer, on the threads of an
+/// execution policy. The result is the same as the one of the sequential
+/// version.
+/// </summary>
+/// <param name="pData">     the buffer </param>
+/// <param name="pNbFloats"> the number of floats of the buffer </param>
+/// <param name="pValues">   the values read </param>
+/// <param name="pSize">     the number of values of pValues </param>
+/// <param name="pPolicy">   the execution policy </param>
+/// <returns>
+/// the number of values read
+/// </returns>
+/// \ingroup Tools
+template <class T>
+unsigned int fromFloats(
+  const float*           pData,
+  const unsigned int&    pNbFloats,
+  T*                     pValues,
+  const unsigned int&    pSize,
+  const ExecutionPolicy& pPolicy);
+
+} // namespace Math
+} // namespace AL
+
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALMATHARRAY_H_
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALMATHBINARY_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALMATHBINARY_H_
+
+#include <iostream>
+#include <vector>
+
+#include <almath/types/alpose2d.h>
+#include <almath/types/alposition2d.h>
+#include <almath/types/alposition3d.h>
+#include <almath/types/alposition6d.h>
+#include <almath/types/alpositionandvelocity.h>
+#include <almath/types/alrotation.h>
+#include <almath/types/alrotation3d.h>
+#include <almath/types/altransform.h>
+#include <almath/types/altransformandvelocity6d.h>
+#include <almath/types/alvelocity3d.h>
+#include <almath/types/alvelocity6d.h>
+#include <almath/types/alquaternion.h>
+
+/// Binary serialization of the ALMath types.
+///
+/// A value is stored as its float members, in the order of their
+/// declaration, each one as an IEEE 754 single precision float in little
+/// endian. A Pose2D takes 12 bytes, a Transform 48 bytes.
+///
+/// A stream written by writeBinary starts with a header of 12 bytes:
+/// the magic "ALMB", the format version (1 byte), the type id (1 byte),
+/// 2 reserved bytes and the number of values (4 bytes, little endian).
+namespace AL {
+namespace Math {
+
+/// <summary>
+/// Version of the binary format.
+/// </summary>
+/// \ingroup Tools
+static const unsigned char BINARY_FORMAT_VERSION = 1;
+
+/// <summary>
+/// Size in bytes of the header written by writeBinary.
+/// </summary>
+/// \ingroup Tools
+static const unsigned int BINARY_HEADER_SIZE = 12;
+
+/// <summary>
+/// Id of each type in the binary format.
+/// </summary>
+/// \ingroup Tools
+enum BINARY_TYPE
+{
+  BINARY_TYPE_POSE2D                 = 1,
+  BINARY_TYPE_POSITION2D             = 2,
+  BINARY_TYPE_POSITION3D             = 3,
+  BINARY_TYPE_POSITION6D             = 4,
+  BINARY_TYPE_POSITIONANDVELOCITY    = 5,
+  BINARY_TYPE_QUATERNION             = 6,
+  BINARY_TYPE_ROTATION               = 7,
+  BINARY_TYPE_ROTATION3D             = 8,
+  BINARY_TYPE_TRANSFORM              = 9,
+  BINARY_TYPE_TRANSFORMANDVELOCITY6D = 10,
+  BINARY_TYPE_VELOCITY3D             = 11,
+  BINARY_TYPE_VELOCITY6D             = 12
+};
+
+/// <summary>
+/// Number of floats and type id of each ALMath type in the binary format.
+/// </summary>
+/// \ingroup Tools
+template <class T>
+struct BinaryTraits;
+
+template <> struct BinaryTraits<Pose2D>
+{ enum { nbFloats = 3,  type = BINARY_TYPE_POSE2D }; };
+template <> struct BinaryTraits<Position2D>
+{ enum { nbFloats = 2,  type = BINARY_TYPE_POSITION2D }; };
+template <> struct BinaryTraits<Position3D>
+{ enum { nbFloats = 3,  type = BINARY_TYPE_POSITION3D }; };
+template <> struct BinaryTraits<Position6D>
+{ enum { nbFloats = 6,  type = BINARY_TYPE_POSITION6D }; };
+template <> struct BinaryTraits<PositionAndVelocity>
+{ enum { nbFloats = 2,  type = BINARY_TYPE_POSITIONANDVELOCITY }; };
+template <> struct BinaryTraits<Quaternion>
+{ enum { nbFloats = 4,  type = BINARY_TYPE_QUATERNION }; };
+template <> struct BinaryTraits<Rotation>
+{ enum { nbFloats = 9,  type = BINARY_TYPE_ROTATION }; };
+template <> struct BinaryTraits<Rotation3D>
+{ enum { nbFloats = 3,  type = BINARY_TYPE_ROTATION3D }; };
+template <> struct BinaryTraits<Transform>
+{ enum { nbFloats = 12, type = BINARY_TYPE_TRANSFORM }; };
+template <> struct BinaryTraits<TransformAndVelocity6D>
+{ enum { nbFloats = 18, type = BINARY_TYPE_TRANSFORMANDVELOCITY6D }; };
+template <> struct BinaryTraits<Velocity3D>
+{ enum { nbFloats = 3,  type = BINARY_TYPE_VELOCITY3D }; };
+template <> struct BinaryTraits<Velocity6D>
+{ enum { nbFloats = 6,  type = BINARY_TYPE_VELOCITY6D }; };
+
+/// <summary>
+/// Write a value in a buffer.
+/// </summary>
+/// <param name="pValue">  the value to write </param>
+/// <param name="pBuffer"> the buffer, of at least BinaryTraits<T>::nbFloats*4 bytes </param>
+/// <returns>
+/// the number of bytes written
+/// </returns>
+/// \ingroup Tools
+template <class T>
+unsigned int toBinary(
+  const T&       pValue,
+  unsigned char* pBuffer);
+
+/// <summary>
+/// Read a value from a buffer.
+/// </summary>
+/// <param name="pBuffer"> the buffer </param>
+/// <param name="pValue">  the value read </param>
+/// <returns>
+/// the number of bytes read
+/// </returns>
+/// \ingroup Tools
+template <class T>
+unsigned int fromBinary(
+  const unsigned char* pBuffer,
+  T&                   pValue);
+
+/// <summary>
+/// Write an array of values in a buffer. On a little endian host, the
+/// values are copied with a single memcpy.
+/// Throw a std::invalid_argument if the number of bytes does not fit in
+/// an unsigned int.
+/// </summary>
+/// <param name="pValues"> the values to write </param>
+/// <param name="pSize">   the number of values </param>
+/// <param name="pBuffer"> the buffer, of at least pSize*BinaryTraits<T>::nbFloats*4 bytes </param>
+/// <returns>
+/// the number of bytes written
+/// </returns>
+/// \ingroup Tools
+template <class T>
+unsigned int toBinary(
+  const T*            pValues,
+  const unsigned int& pSize,
+  unsigned char*      pBuffer);
+
+/// <summary>
+/// Read an array of values from a buffer. On a little endian host, the
+/// values are copied with a single memcpy.
+/// Throw a std::invalid_argument if the number of bytes does not fit in
+/// an unsigned int.
+/// </summary>
+/// <param name="pBuffer"> the buffer </param>
+/// <param name="pSize">   the number of values </param>
+/// <param name="pValues"> the values read </param>
+/// <returns>
+/// the number of bytes read
+/// </returns>
+/// \ingroup Tools
+template <class T>
+unsigned int fromBinary(
+  const unsigned char* pBuffer,
+  const unsigned int&  pSize,
+  T*                   pValues);
+
+/// <summary>
+/// Write a header and an array of values in a binary stream.
+/// Throw a std::invalid_argument if there are more values than the 4 bytes
+/// of the header can count.
+/// </summary>
+/// <param name="pStream"> the stream, opened in binary mode </param>
+/// <param name="pValues"> the values to write </param>
+/// \ingroup Tools
+template <class T>
+void writeBinary(
+  std::ostream&         pStream,
+  const std::vector<T>& pValues);
+
+/// <summary>
+/// Read a header and an array of values from a binary stream.
+/// Throw a std::runtime_error if the header does not match the type or
+/// the stream is too short. The count of the header is checked against
+/// the length of the stream before any allocation; a stream which cannot
+/// be measured is read by blocks.
+/// </summary>
+/// <param name="pStream"> the stream, opened in binary mode </param>
+/// <param name="pValues"> the values read </param>
+/// \ingroup Tools
+template <class T>
+void readBinary(
+  std::istream&   pStream,
+  std::vector<T>& pValues);
+
+} // namespace Math
+} // namespace AL
+
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALMATHBINARY_H_
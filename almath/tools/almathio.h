@@ -11,6 +11,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include <almath/types/alpose2d.h>
 #include <almath/types/alposition2d.h>
@@ -27,6 +28,11 @@
 
 /// The purpose of grouping ostream operations in one place, is to speed
 /// compilation times when not requiring output.
+///
+/// The operators << write the floats with a sign and a point, with the
+/// precision and the fixed, scientific or default notation of the stream;
+/// the width of the stream pads the whole value, then is reset. They do
+/// not change the flags of the stream.
 namespace AL {
 namespace Math {
 
@@ -218,6 +224,226 @@ std::string toSpaceSeparated(const Position6D& pPos);
 /// \ingroup Types
 std::ostream& operator<< (std::ostream& pStream, const Quaternion& pQua);
 
+/// <summary>
+/// Text formats of the format functions.
+/// </summary>
+/// \ingroup Types
+enum TEXT_FORMAT
+{
+  /// as operator <<, for example {x: +0.100000, y:-0.200000, theta:+0.00000}
+  TEXT_FORMAT_STREAM,
+  /// as toSpaceSeparated, for example +0.100000 -0.200000 +0.00000
+  TEXT_FORMAT_SPACE_SEPARATED,
+  /// a JSON object, for example {"x":0.1,"y":-0.2,"theta":0}
+  TEXT_FORMAT_JSON,
+  /// a line of comma separated values, for example 0.1,-0.2,0
+  TEXT_FORMAT_CSV
+};
+
+/// <summary>
+/// Precision of the format functions which writes the shortest number
+/// which is read back as the same float.
+/// </summary>
+/// \ingroup Types
+static const int TEXT_PRECISION_SHORTEST = 0;
+
+/// <summary>
+/// Write a float in a buffer, without allocation and independently of
+/// the locale. Like snprintf, at most pSize-1 characters are written,
+/// followed by a null character, and the length of the whole text is
+/// returned: the text is truncated if the result is not less than pSize.
+///
+/// The number is written as with %g, without trailing zeros. NaN and
+/// infinity are written nan, inf and -inf.
+/// </summary>
+/// <param name="pValue">     the float </param>
+/// <param name="pBuffer">    the buffer, can be null if pSize is 0 </param>
+/// <param name="pSize">      the size of the buffer </param>
+/// <param name="pPrecision"> the number of significant digits, at most 9, or TEXT_PRECISION_SHORTEST - default: TEXT_PRECISION_SHORTEST </param>
+/// <returns>
+/// the length of the text
+/// </returns>
+/// \ingroup Types
+unsigned int formatFloat(
+  const float&        pValue,
+  char*               pBuffer,
+  const unsigned int& pSize,
+  const int&          pPrecision = TEXT_PRECISION_SHORTEST);
+
+/// <summary>
+/// Write a value in a buffer, without allocation and independently of
+/// the locale. See formatFloat for the use of the buffer.
+///
+/// In TEXT_FORMAT_STREAM and TEXT_FORMAT_SPACE_SEPARATED, the numbers
+/// are written as with std::showpos and std::showpoint: with a sign and
+/// with the trailing zeros. In TEXT_FORMAT_JSON, NaN and infinity are
+/// written null.
+/// </summary>
+/// <param name="pValue">     the value </param>
+/// <param name="pBuffer">    the buffer, can be null if pSize is 0 </param>
+/// <param name="pSize">      the size of the buffer </param>
+/// <param name="pFormat">    the format - default: TEXT_FORMAT_JSON </param>
+/// <param name="pPrecision"> the number of significant digits, at most 9, or TEXT_PRECISION_SHORTEST - default: TEXT_PRECISION_SHORTEST </param>
+/// <returns>
+/// the length of the text
+/// </returns>
+/// \ingroup Types
+template <class T>
+unsigned int format(
+  const T&            pValue,
+  char*               pBuffer,
+  const unsigned int& pSize,
+  const TEXT_FORMAT&  pFormat = TEXT_FORMAT_JSON,
+  const int&          pPrecision = TEXT_PRECISION_SHORTEST);
+
+/// <summary>
+/// Write an array of values in a buffer. In TEXT_FORMAT_JSON, the values
+/// are written in a JSON array, otherwise each value is written on its
+/// own line. See formatFloat for the use of the buffer.
+/// </summary>
+/// <param name="pValues">    the values </param>
+/// <param name="pNbValues">  the number of values </param>
+/// <param name="pBuffer">    the buffer, can be null if pSize is 0 </param>
+/// <param name="pSize">      the size of the buffer </param>
+/// <param name="pFormat">    the format - default: TEXT_FORMAT_JSON </param>
+/// <param name="pPrecision"> the number of significant digits, at most 9, or TEXT_PRECISION_SHORTEST - default: TEXT_PRECISION_SHORTEST </param>
+/// <returns>
+/// the length of the text
+/// </returns>
+/// \ingroup Types
+template <class T>
+unsigned int formatArray(
+  const T*            pValues,
+  const unsigned int& pNbValues,
+  char*               pBuffer,
+  const unsigned int& pSize,
+  const TEXT_FORMAT&  pFormat = TEXT_FORMAT_JSON,
+  const int&          pPrecision = TEXT_PRECISION_SHORTEST);
+
+/// <summary>
+/// Write the header line of the TEXT_FORMAT_CSV format, for example
+/// x,y,theta followed by a new line. See formatFloat for the use of
+/// the buffer.
+/// </summary>
+/// <param name="pBuffer"> the buffer, can be null if pSize is 0 </param>
+/// <param name="pSize">   the size of the buffer </param>
+/// <returns>
+/// the length of the text
+/// </returns>
+/// \ingroup Types
+template <class T>
+unsigned int formatCsvHeader(
+  char*               pBuffer,
+  const unsigned int& pSize);
+
+/// <summary>
+/// Errors of the parse functions.
+/// </summary>
+/// \ingroup Types
+enum PARSE_ERROR
+{
+  PARSE_OK = 0,
+  /// the text is not a number
+  PARSE_INVALID_NUMBER,
+  /// the number is too large or too small for a float
+  PARSE_OUT_OF_RANGE,
+  /// the text does not match the format
+  PARSE_UNEXPECTED_TEXT
+};
+
+/// <summary>
+/// Result of the parse functions: the first character which is not
+/// parsed, where the error is if any, and the error.
+/// </summary>
+/// \ingroup Types
+struct ParseResult
+{
+  const char* ptr;
+  PARSE_ERROR error;
+};
+
+/// <summary>
+/// Parse a float, as std::from_chars does: without allocation,
+/// independently of the locale and without skipping whitespace.
+/// A leading + is accepted, as well as nan, inf and infinity.
+///
+/// On error the value is not modified. If the text is not a number,
+/// ptr is pBegin. If the number is out of range, ptr is after it.
+/// The numbers written by formatFloat are read back exactly.
+/// </summary>
+/// <param name="pBegin"> the beginning of the text </param>
+/// <param name="pEnd">   the end of the text </param>
+/// <param name="pValue"> the float </param>
+/// <returns>
+/// the result
+/// </returns>
+/// \ingroup Types
+ParseResult parseFloat(
+  const char* pBegin,
+  const char* pEnd,
+  float&      pValue);
+
+/// <summary>
+/// Parse a value written by format, without allocation. The leading
+/// whitespace is skipped, the whitespace between the fields is free,
+/// but the fields must be in the order written by format. In
+/// TEXT_FORMAT_JSON, null is read as NaN.
+///
+/// On error the value is not modified and ptr is where the error is.
+/// </summary>
+/// <param name="pBegin">  the beginning of the text </param>
+/// <param name="pEnd">    the end of the text </param>
+/// <param name="pValue">  the value </param>
+/// <param name="pFormat"> the format - default: TEXT_FORMAT_JSON </param>
+/// <returns>
+/// the result
+/// </returns>
+/// \ingroup Types
+template <class T>
+ParseResult parse(
+  const char*        pBegin,
+  const char*        pEnd,
+  T&                 pValue,
+  const TEXT_FORMAT& pFormat = TEXT_FORMAT_JSON);
+
+/// <summary>
+/// Parse an array of values written by formatArray, for example a whole
+/// file of lines. In TEXT_FORMAT_CSV, a header line written by
+/// formatCsvHeader is skipped.
+///
+/// The values are appended to pValues: reserve it, or reuse it after
+/// clear, to parse without allocation. On error, the values before
+/// the error are kept and ptr is where the error is; getLineNumber
+/// gives its line.
+/// </summary>
+/// <param name="pBegin">  the beginning of the text </param>
+/// <param name="pEnd">    the end of the text </param>
+/// <param name="pValues"> the values </param>
+/// <param name="pFormat"> the format - default: TEXT_FORMAT_JSON </param>
+/// <returns>
+/// the result
+/// </returns>
+/// \ingroup Types
+template <class T>
+ParseResult parseArray(
+  const char*        pBegin,
+  const char*        pEnd,
+  std::vector<T>&    pValues,
+  const TEXT_FORMAT& pFormat = TEXT_FORMAT_JSON);
+
+/// <summary>
+/// Return the line of a position in a text, counted from 1.
+/// </summary>
+/// <param name="pBegin">    the beginning of the text </param>
+/// <param name="pPosition"> the position </param>
+/// <returns>
+/// the line
+/// </returns>
+/// \ingroup Types
+unsigned int getLineNumber(
+  const char* pBegin,
+  const char* pPosition);
+
 }
 }
 #endif  // _LIBALMATH_ALMATH_TOOLS_ALMATHIO_H_
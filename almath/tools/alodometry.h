@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALODOMETRY_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALODOMETRY_H_
+
+#include <almath/types/alpose2d.h>
+#include <almath/types/altransform.h>
+#include <almath/types/alvelocity6d.h>
+
+/// Integration of odometry: the pose of a robot from its velocities.
+///
+/// Composing millions of small float increments drifts. The integrators
+/// keep their state in double: the velocities and the poses are floats,
+/// but the increments are computed and accumulated in double. The
+/// rotations of the velocities are exponentiated in double, and the float
+/// rotations of the increments are made orthonormal in double before they
+/// are composed, so the rotation of the pose stays orthonormal.
+///
+/// The velocities are expressed in the frame of the robot: a Pose2D
+/// velocity is (vx, vy, vtheta), per second.
+namespace AL {
+  namespace Math {
+
+    /// <summary>
+    /// How the pose moves with a constant velocity during a time step.
+    ///
+    /// ODOMETRY_INTEGRATION_EULER: the translation is done with the
+    /// orientation at the start of the step. \n
+    /// ODOMETRY_INTEGRATION_MIDPOINT: the translation is done with the
+    /// orientation at the middle of the step. \n
+    /// ODOMETRY_INTEGRATION_EXPONENTIAL: exact motion on SE(2) or SE(3),
+    /// as velocityExponential. \n
+    /// </summary>
+    /// \ingroup Tools
+    enum ODOMETRY_INTEGRATION_MODE
+    {
+      ODOMETRY_INTEGRATION_EULER = 0,
+      ODOMETRY_INTEGRATION_MIDPOINT = 1,
+      ODOMETRY_INTEGRATION_EXPONENTIAL = 2
+    };
+
+    /// <summary>
+    /// Integrate the planar odometry of a robot.
+    ///
+    /// With timestamped velocities, the velocity of a sample is held until
+    /// the next one; with ODOMETRY_INTEGRATION_MIDPOINT, the mean of the two
+    /// samples of a step is used.
+    /// </summary>
+    /// \ingroup Tools
+    class Pose2DIntegrator
+    {
+    public:
+      /// <summary>
+      /// Create an integrator at the origin.
+      /// </summary>
+      /// <param name="pMode"> the integration mode - default: exponential </param>
+      explicit Pose2DIntegrator(
+        const ODOMETRY_INTEGRATION_MODE& pMode = ODOMETRY_INTEGRATION_EXPONENTIAL);
+
+      /// <summary>
+      /// Set the pose, and forget the last timestamped velocity.
+      /// </summary>
+      /// <param name="pPose"> the new pose - default: the origin </param>
+      void reset(const Pose2D& pPose = Pose2D());
+
+      /// <summary>
+      /// Compose the pose with an increment: pose = pose*pIncrement.
+      /// </summary>
+      /// <param name="pIncrement"> the increment, in the robot frame </param>
+      void addIncrement(const Pose2D& pIncrement);
+
+      /// <summary>
+      /// Move the pose with a constant velocity during a time step.
+      /// </summary>
+      /// <param name="pVelocity"> the velocity, in the robot frame </param>
+      /// <param name="pDuration"> the duration of the step in second </param>
+      void addVelocity(
+        const Pose2D& pVelocity,
+        const float&  pDuration);
+
+      /// <summary>
+      /// Move the pose with timestamped velocities. The first sample given
+      /// after the creation or a reset only starts the integration.
+      /// Throws std::invalid_argument if the timestamps decrease; the pose
+      /// is then unchanged.
+      /// </summary>
+      /// <param name="pVelocities"> the velocities, in the robot frame </param>
+      /// <param name="pTimes">      the timestamps in second </param>
+      /// <param name="pSize">       the number of samples </param>
+      void addVelocities(
+        const Pose2D*       pVelocities,
+        const double*       pTimes,
+        const unsigned int& pSize);
+
+      /// <summary>
+      /// Return the pose, with theta in [-pi, pi].
+      /// </summary>
+      Pose2D getPose() const;
+
+    private:
+      void xMove(
+        const double& pVx,
+        const double& pVy,
+        const double& pVtheta,
+        const double& pDuration);
+
+      ODOMETRY_INTEGRATION_MODE fMode;
+      double fX;
+      double fY;
+      double fTheta;
+      bool fHasSample;
+      Pose2D fLastVelocity;
+      double fLastTime;
+    };
+
+    /// <summary>
+    /// Integrate the 3D odometry of a robot.
+    ///
+    /// With timestamped velocities, the velocity of a sample is held until
+    /// the next one; with ODOMETRY_INTEGRATION_MIDPOINT, the mean of the two
+    /// samples of a step is used.
+    /// </summary>
+    /// \ingroup Tools
+    class TransformIntegrator
+    {
+    public:
+      /// <summary>
+      /// Create an integrator at the origin.
+      /// </summary>
+      /// <param name="pMode"> the integration mode - default: exponential </param>
+      explicit TransformIntegrator(
+        const ODOMETRY_INTEGRATION_MODE& pMode = ODOMETRY_INTEGRATION_EXPONENTIAL);
+
+      /// <summary>
+      /// Set the pose, and forget the last timestamped velocity. The
+      /// rotation of the pose is made orthonormal.
+      /// </summary>
+      /// <param name="pTransform"> the new pose - default: the origin </param>
+      void reset(const Transform& pTransform = Transform());
+
+      /// <summary>
+      /// Compose the pose with an increment: pose = pose*pIncrement.
+      /// The rotation of the increment is made orthonormal first.
+      /// </summary>
+      /// <param name="pIncrement"> the increment, in the robot frame </param>
+      void addIncrement(const Transform& pIncrement);
+
+      /// <summary>
+      /// Move the pose with a constant velocity during a time step.
+      /// </summary>
+      /// <param name="pVelocity"> the velocity, in the robot frame </param>
+      /// <param name="pDuration"> the duration of the step in second </param>
+      void addVelocity(
+        const Velocity6D& pVelocity,
+        const float&      pDuration);
+
+      /// <summary>
+      /// Move the pose with timestamped velocities. The first sample given
+      /// after the creation or a reset only starts the integration.
+      /// Throws std::invalid_argument if the timestamps decrease; the pose
+      /// is then unchanged.
+      /// </summary>
+      /// <param name="pVelocities"> the velocities, in the robot frame </param>
+      /// <param name="pTimes">      the timestamps in second </param>
+      /// <param name="pSize">       the number of samples </param>
+      void addVelocities(
+        const Velocity6D*   pVelocities,
+        const double*       pTimes,
+        const unsigned int& pSize);
+
+      /// <summary>
+      /// Return the pose.
+      /// </summary>
+      Transform getTransform() const;
+
+    private:
+      // pVelocity: xd, yd, zd, wxd, wyd, wzd
+      void xMove(
+        const double* pVelocity,
+        const double& pDuration);
+
+      void xCompose(
+        const double* pRotation,
+        const double* pTranslation);
+
+      ODOMETRY_INTEGRATION_MODE fMode;
+      // rotation, row major, and translation
+      double fRotation[9];
+      double fTranslation[3];
+      bool fHasSample;
+      Velocity6D fLastVelocity;
+      double fLastTime;
+    };
+
+  } // namespace Math
+} // namespace AL
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALODOMETRY_H_
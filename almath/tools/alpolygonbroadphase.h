@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALPOLYGONBROADPHASE_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALPOLYGONBROADPHASE_H_
+
+#include <almath/types/alposition2d.h>
+#include <utility>
+#include <vector>
+
+namespace AL
+{
+  namespace Math
+  {
+    /// <summary>
+    /// Broad phase of the collision tests between many convex polygons.
+    ///
+    /// The polygons are stored in a dynamic tree of axis-aligned bounding
+    /// boxes, balanced as an AVL tree. The box of each polygon is enlarged
+    /// by a margin, so that a polygon which moves a little does not need
+    /// to be moved in the tree. The queries first find the polygons whose
+    /// boxes overlap, then the narrow phase uses
+    /// areConvexPolygonsInCollision.
+    /// </summary>
+    /// \ingroup Tools
+    class PolygonBroadPhase
+    {
+    public:
+      /// <summary>
+      /// Create an empty PolygonBroadPhase.
+      /// </summary>
+      /// <param name="pMargin"> the margin of the bounding boxes - default: 0.01 </param>
+      explicit PolygonBroadPhase(const float& pMargin = 0.01f);
+
+      /// <summary>
+      /// Insert a convex polygon.
+      /// </summary>
+      /// <param name="pPolygon"> vector<Position2D> of the vertices of the polygon. </param>
+      /// <returns>
+      /// the id of the polygon
+      /// </returns>
+      int insert(const std::vector<Position2D>& pPolygon);
+
+      /// <summary>
+      /// Update a polygon. It is moved in the tree only if it leaves its
+      /// enlarged bounding box.
+      /// </summary>
+      /// <param name="pId">      the id of the polygon. </param>
+      /// <param name="pPolygon"> vector<Position2D> of the new vertices of the polygon. </param>
+      /// <returns>
+      /// true if the polygon was moved in the tree
+      /// </returns>
+      const bool update(
+        const int&                     pId,
+        const std::vector<Position2D>& pPolygon);
+
+      /// <summary>
+      /// Remove a polygon. Its id can be given again to a new polygon.
+      /// </summary>
+      /// <param name="pId"> the id of the polygon. </param>
+      void remove(const int& pId);
+
+      /// <summary>
+      /// Return the vertices of a polygon.
+      /// </summary>
+      /// <param name="pId"> the id of the polygon. </param>
+      const std::vector<Position2D>& getPolygon(const int& pId) const;
+
+      /// <summary>
+      /// Return the number of polygons.
+      /// </summary>
+      unsigned int size() const;
+
+      /// <summary>
+      /// Return the height of the tree, 0 if it is empty.
+      /// </summary>
+      int getHeight() const;
+
+      /// <summary>
+      /// Find the polygons whose enlarged bounding boxes overlap a box.
+      /// </summary>
+      /// <param name="pMin"> the lower corner of the box. </param>
+      /// <param name="pMax"> the upper corner of the box. </param>
+      /// <param name="pIds"> the ids of the polygons. </param>
+      void queryBox(
+        const Position2D& pMin,
+        const Position2D& pMax,
+        std::vector<int>& pIds) const;
+
+      /// <summary>
+      /// Find the polygons in collision with a convex polygon.
+      /// </summary>
+      /// <param name="pPolygon"> vector<Position2D> of the vertices of the polygon. </param>
+      /// <param name="pIds">     the ids of the polygons in collision. </param>
+      void queryCollisions(
+        const std::vector<Position2D>& pPolygon,
+        std::vector<int>&              pIds) const;
+
+      /// <summary>
+      /// Find the pairs of polygons whose enlarged bounding boxes overlap:
+      /// the candidates for the narrow phase. The first id of a pair is
+      /// the smallest one.
+      /// </summary>
+      /// <param name="pPairs"> the pairs of ids. </param>
+      void queryPairs(std::vector<std::pair<int, int> >& pPairs) const;
+
+      /// <summary>
+      /// Find the pairs of polygons in collision.
+      /// The first id of a pair is the smallest one.
+      /// </summary>
+      /// <param name="pPairs"> the pairs of ids. </param>
+      void queryCollidingPairs(std::vector<std::pair<int, int> >& pPairs) const;
+
+      /// <summary>
+      /// Find the polygons whose enlarged bounding boxes are crossed by a
+      /// segment.
+      /// </summary>
+      /// <param name="pStart"> the start of the segment. </param>
+      /// <param name="pEnd">   the end of the segment. </param>
+      /// <param name="pIds">   the ids of the polygons. </param>
+      void queryRay(
+        const Position2D& pStart,
+        const Position2D& pEnd,
+        std::vector<int>& pIds) const;
+
+      /// <summary>
+      /// Find the first polygon hit by a segment.
+      /// </summary>
+      /// <param name="pStart">    the start of the segment. </param>
+      /// <param name="pEnd">      the end of the segment. </param>
+      /// <param name="pId">       the id of the polygon hit. </param>
+      /// <param name="pFraction"> the fraction of the segment before the hit, in [0, 1]. </param>
+      /// <returns>
+      /// true if a polygon is hit
+      /// </returns>
+      const bool raycast(
+        const Position2D& pStart,
+        const Position2D& pEnd,
+        int&              pId,
+        float&            pFraction) const;
+
+    private:
+      struct Node
+      {
+        Position2D boxMin;
+        Position2D boxMax;
+        // parent, or next free node
+        int parent;
+        int child1;
+        int child2;
+        // 0 for a leaf, -1 for a free node
+        int height;
+        std::vector<Position2D> polygon;
+
+        bool isLeaf() const;
+      };
+
+      int xAllocateNode();
+      void xFreeNode(const int& pNode);
+      void xInsertLeaf(const int& pLeaf);
+      void xRemoveLeaf(const int& pLeaf);
+      int xBalance(const int& pNode);
+      void xSetFatBox(
+        const int&                     pNode,
+        const std::vector<Position2D>& pPolygon);
+      void xCheckId(const int& pId) const;
+
+      float fMargin;
+      int fRoot;
+      int fFreeList;
+      unsigned int fNbPolygons;
+      std::vector<Node> fNodes;
+    };
+
+  } // namespace Math
+} // namespace AL
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALPOLYGONBROADPHASE_H_
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALPOSESCAN_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALPOSESCAN_H_
+
+#include <almath/types/alpose2d.h>
+#include <almath/types/alquaternion.h>
+#include <almath/types/altransform.h>
+
+/// Cumulative composition of chains of poses.
+///
+/// From the relative increments v[0], v[1], ... of a trajectory, the
+/// inclusive scan computes the cumulative poses v[0]*...*v[i], and the
+/// exclusive scan the poses before each increment, from the identity to
+/// v[0]*...*v[i-1].
+///
+/// On a thread pool the array is split in blocks: the product of each
+/// block is computed in parallel, the products are chained, then each
+/// block is scanned in parallel from the pose before it. The blocks do not
+/// depend on the number of threads, so neither do the results; they
+/// differ from the sequential scan by the rounding of the products only.
+///
+/// The renormalization period bounds the drift of long chains: every
+/// pNormalizationPeriod increments, the running pose is normalized.
+/// On a thread pool, the blocks are then rounded up to a multiple of the
+/// period, so that the normalizations are at the same indices as in the
+/// sequential scan.
+/// For a Pose2D, theta is wrapped to [-pi, pi]; for a Quaternion, the norm
+/// is set to 1; for a Transform, the rotation is made orthonormal.
+///
+/// Implemented for Pose2D, Quaternion and Transform.
+namespace AL {
+  namespace Math {
+
+    // defined in almath/tools/althreadpool.h
+    struct ExecutionPolicy;
+
+    /// <summary>
+    /// Compute the cumulative compositions of an array of poses:
+    /// pResults[i] = pValues[0]*...*pValues[i].
+    /// The results may be the values.
+    /// </summary>
+    /// <param name="pValues">              the increments </param>
+    /// <param name="pSize">                the number of increments </param>
+    /// <param name="pResults">             the cumulative poses </param>
+    /// <param name="pNormalizationPeriod"> the number of increments between two
+    ///                                     normalizations, 0 for none - default: 0 </param>
+    /// \ingroup Tools
+    template <class T>
+    void composeInclusiveScan(
+      const T*            pValues,
+      const unsigned int& pSize,
+      T*                  pResults,
+      const unsigned int& pNormalizationPeriod = 0);
+
+    /// <summary>
+    /// composeInclusiveScan with an execution policy. On a thread pool, the
+    /// grain size of the policy is the number of poses of a block, 0 for
+    /// 4096.
+    /// </summary>
+    /// <param name="pValues">              the increments </param>
+    /// <param name="pSize">                the number of increments </param>
+    /// <param name="pResults">             the cumulative poses </param>
+    /// <param name="pPolicy">              the execution policy </param>
+    /// <param name="pNormalizationPeriod"> the number of increments between two
+    ///                                     normalizations, 0 for none - default: 0 </param>
+    /// \ingroup Tools
+    template <class T>
+    void composeInclusiveScan(
+      const T*               pValues,
+      const unsigned int&    pSize,
+      T*                     pResults,
+      const ExecutionPolicy& pPolicy,
+      const unsigned int&    pNormalizationPeriod = 0);
+
+    /// <summary>
+    /// Compute the compositions before each pose of an array:
+    /// pResults[0] is the identity, and
+    /// pResults[i] = pValues[0]*...*pValues[i-1].
+    /// The results may be the values.
+    /// </summary>
+    /// <param name="pValues">              the increments </param>
+    /// <param name="pSize">                the number of increments </param>
+    /// <param name="pResults">             the cumulative poses </param>
+    /// <param name="pNormalizationPeriod"> the number of increments between two
+    ///                                     normalizations, 0 for none - default: 0 </param>
+    /// \ingroup Tools
+    template <class T>
+    void composeExclusiveScan(
+      const T*            pValues,
+      const unsigned int& pSize,
+      T*                  pResults,
+      const unsigned int& pNormalizationPeriod = 0);
+
+    /// <summary>
+    /// composeExclusiveScan with an execution policy. On a thread pool, the
+    /// grain size of the policy is the number of poses of a block, 0 for
+    /// 4096.
+    /// </summary>
+    /// <param name="pValues">              the increments </param>
+    /// <param name="pSize">                the number of increments </param>
+    /// <param name="pResults">             the cumulative poses </param>
+    /// <param name="pPolicy">              the execution policy </param>
+    /// <param name="pNormalizationPeriod"> the number of increments between two
+    ///                                     normalizations, 0 for none - default: 0 </param>
+    /// \ingroup Tools
+    template <class T>
+    void composeExclusiveScan(
+      const T*               pValues,
+      const unsigned int&    pSize,
+      T*                     pResults,
+      const ExecutionPolicy& pPolicy,
+      const unsigned int&    pNormalizationPeriod = 0);
+
+  } // namespace Math
+} // namespace AL
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALPOSESCAN_H_
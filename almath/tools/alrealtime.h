@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALREALTIME_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALREALTIME_H_
+
+#include <almath/types/alpose2d.h>
+#include <almath/types/alposition2d.h>
+#include <almath/types/alposition3d.h>
+#include <almath/types/alposition6d.h>
+#include <almath/types/alquaternion.h>
+#include <almath/types/alrotation.h>
+#include <almath/types/alrotation3d.h>
+#include <almath/types/altransform.h>
+#include <almath/types/alvelocity3d.h>
+#include <almath/types/alvelocity6d.h>
+
+/// Real-time safe functions of ALMath.
+///
+/// The functions of the real-time API set neither allocate nor throw, so
+/// they can be called from a hard real-time loop. They report their
+/// errors with a MATH_STATUS, and leave their outputs unchanged on error.
+///
+/// The real-time API set:
+///   - toVectorInPlace (this file),
+///   - toArray, fromArray, toFloats, fromFloats (almatharray.h), without
+///     an ExecutionPolicy: a thread pool wakes its workers up,
+///   - tryGetDubinsSolutions (aldubinscurve.h),
+///   - tryTransformMeanInPlace, tryAxisRotationProjectionInPlace
+///     (altransformhelpers.h),
+///   - avoidFootCollision in AVOID_FOOT_COLLISION_EXACT mode, and the
+///     functions on FootPolygon (avoidfootcollision.h).
+///
+/// test/tools/alrealtime_test.cpp checks that these functions do not
+/// allocate.
+#if __cplusplus >= 201103L
+# define ALMATH_NOEXCEPT noexcept
+#else
+# define ALMATH_NOEXCEPT throw()
+#endif
+
+namespace AL
+{
+  namespace Math
+  {
+    /// <summary>
+    /// Result of a function of the real-time API set.
+    ///
+    /// MATH_OK: success. \n
+    /// MATH_INVALID_ARGUMENT: an argument is out of its domain. \n
+    /// MATH_DIVISION_BY_ZERO: a null vector can not be normalized. \n
+    /// MATH_BUFFER_TOO_SMALL: the output buffer is too small. \n
+    /// </summary>
+    /// \ingroup Tools
+    enum MATH_STATUS
+    {
+      MATH_OK               = 0,
+      MATH_INVALID_ARGUMENT = 1,
+      MATH_DIVISION_BY_ZERO = 2,
+      MATH_BUFFER_TOO_SMALL = 3
+    };
+
+    /// <summary>
+    /// Write the floats of toVector() in a buffer, without allocation.
+    /// </summary>
+    /// <param name="pValue"> the value to write </param>
+    /// <param name="pData">  the output buffer </param>
+    /// <param name="pSize">  the number of floats of the buffer </param>
+    /// <returns>
+    /// MATH_OK, or MATH_BUFFER_TOO_SMALL if pSize is less than the size of
+    /// toVector().
+    /// </returns>
+    /// \ingroup Tools
+    const MATH_STATUS toVectorInPlace(
+      const Pose2D&       pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT;
+
+    const MATH_STATUS toVectorInPlace(
+      const Position2D&   pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT;
+
+    const MATH_STATUS toVectorInPlace(
+      const Position3D&   pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT;
+
+    const MATH_STATUS toVectorInPlace(
+      const Position6D&   pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT;
+
+    const MATH_STATUS toVectorInPlace(
+      const Quaternion&   pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT;
+
+    const MATH_STATUS toVectorInPlace(
+      const Rotation&     pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT;
+
+    const MATH_STATUS toVectorInPlace(
+      const Rotation3D&   pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT;
+
+    const MATH_STATUS toVectorInPlace(
+      const Transform&    pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT;
+
+    const MATH_STATUS toVectorInPlace(
+      const Velocity3D&   pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT;
+
+    const MATH_STATUS toVectorInPlace(
+      const Velocity6D&   pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT;
+
+  } // namespace Math
+} // namespace AL
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALREALTIME_H_
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALSNAPSHOT_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALSNAPSHOT_H_
+
+#include <almath/tools/almathbinary.h>
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+
+/// Values published by one thread and read by many threads, without lock.
+///
+/// The writer never waits: it marks the value as being written, writes it,
+/// and marks it as written (a sequence lock). A reader copies the value and
+/// starts again if it was written meanwhile. The value is stored in relaxed
+/// atomic words, so a reader never reads a half written float.
+///
+/// These classes require C++11.
+namespace AL
+{
+  namespace Math
+  {
+    /// <summary>
+    /// The last value published by a single writer thread, for any number
+    /// of reader threads.
+    /// </summary>
+    /// \ingroup Tools
+    template <class T>
+    class Snapshot
+    {
+    public:
+      /// <summary>
+      /// Create a snapshot of the default value, at version 0.
+      /// </summary>
+      Snapshot();
+
+      /// <summary>
+      /// Create a snapshot of a value, at version 0.
+      /// </summary>
+      /// <param name="pValue"> the initial value </param>
+      explicit Snapshot(const T& pValue);
+
+      /// <summary>
+      /// Publish a value. To be called by a single thread. It does not
+      /// wait, allocate nor throw.
+      /// </summary>
+      /// <param name="pValue"> the value </param>
+      void publish(const T& pValue);
+
+      /// <summary>
+      /// Read the last value, trying again until it is not written
+      /// during the read.
+      /// </summary>
+      /// <param name="pValue"> the value </param>
+      /// <returns>
+      /// the version of the value
+      /// </returns>
+      uint64_t read(T& pValue) const;
+
+      /// <summary>
+      /// Try once to read the last value.
+      /// </summary>
+      /// <param name="pValue"> the value, unchanged on failure </param>
+      /// <returns>
+      /// false if the value was written during the read
+      /// </returns>
+      const bool tryRead(T& pValue) const;
+
+      /// <summary>
+      /// Return the number of values published.
+      /// </summary>
+      uint64_t getVersion() const;
+
+    private:
+      Snapshot(const Snapshot&);
+      Snapshot& operator=(const Snapshot&);
+
+      const bool xTryRead(
+        T&        pValue,
+        uint64_t& pVersion) const;
+
+      enum { NB_WORDS = BinaryTraits<T>::nbFloats };
+
+      // twice the version, plus 1 while the value is written
+      std::atomic<uint64_t> fSequence;
+      std::atomic<uint32_t> fWords[NB_WORDS];
+    };
+
+    /// <summary>
+    /// A fixed number of values published together by a single writer
+    /// thread, for example all the frames of a tree: a reader always
+    /// reads values of the same publication.
+    ///
+    /// The values are stored twice: the writer writes the copy which was
+    /// not published last, so a reader only starts again when two
+    /// publications happen during its read.
+    /// </summary>
+    /// \ingroup Tools
+    template <class T>
+    class SnapshotArray
+    {
+    public:
+      /// <summary>
+      /// Create an array of default values, at version 0.
+      /// </summary>
+      /// <param name="pSize"> the number of values </param>
+      explicit SnapshotArray(const unsigned int& pSize);
+
+      /// <summary>
+      /// Publish all the values. To be called by a single thread. It does
+      /// not wait, allocate nor throw.
+      /// </summary>
+      /// <param name="pValues"> size() values </param>
+      void publish(const T* pValues);
+
+      /// <summary>
+      /// Publish all the values. Throw a std::invalid_argument if the
+      /// number of values is not size().
+      /// </summary>
+      /// <param name="pValues"> the values </param>
+      void publish(const std::vector<T>& pValues);
+
+      /// <summary>
+      /// Read all the values of the last publication.
+      /// </summary>
+      /// <param name="pValues"> size() values </param>
+      /// <returns>
+      /// the version of the values
+      /// </returns>
+      uint64_t read(T* pValues) const;
+
+      /// <summary>
+      /// Read all the values of the last publication. The vector is
+      /// resized to size().
+      /// </summary>
+      /// <param name="pValues"> the values </param>
+      /// <returns>
+      /// the version of the values
+      /// </returns>
+      uint64_t read(std::vector<T>& pValues) const;
+
+      /// <summary>
+      /// Read one value of the last publication. Throw a
+      /// std::out_of_range if the index is not less than size().
+      /// </summary>
+      /// <param name="pIndex"> the index of the value </param>
+      /// <param name="pValue"> the value </param>
+      /// <returns>
+      /// the version of the value
+      /// </returns>
+      uint64_t read(
+        const unsigned int& pIndex,
+        T&                  pValue) const;
+
+      /// <summary>
+      /// Return the number of publications.
+      /// </summary>
+      uint64_t getVersion() const;
+
+      /// <summary>
+      /// Return the number of values.
+      /// </summary>
+      unsigned int size() const;
+
+    private:
+      SnapshotArray(const SnapshotArray&);
+      SnapshotArray& operator=(const SnapshotArray&);
+
+      uint64_t xRead(
+        const unsigned int& pBegin,
+        const unsigned int& pEnd,
+        T*                  pValues) const;
+
+      enum { NB_WORDS = BinaryTraits<T>::nbFloats };
+
+      unsigned int fSize;
+      std::atomic<uint64_t> fVersion;
+      // per copy: twice the version written in it, plus 1 while written
+      std::atomic<uint64_t> fSequences[2];
+      // the two copies, one after the other
+      std::vector<std::atomic<uint32_t> > fWords;
+    };
+
+  } // namespace Math
+} // namespace AL
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALSNAPSHOT_H_
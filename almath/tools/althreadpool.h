@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALTHREADPOOL_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALTHREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+/// Parallel execution of the batch functions of ALMath.
+///
+/// A batch function which accepts an ExecutionPolicy splits its index
+/// range in chunks, and runs them on the threads of a ThreadPool. Each
+/// index writes its own outputs, so the result does not depend on the
+/// number of threads nor on the order the chunks are run in.
+///
+/// These classes require C++11.
+namespace AL
+{
+  namespace Math
+  {
+    /// <summary>
+    /// Body of a parallel loop: process the indices from pBegin to pEnd,
+    /// pEnd excluded.
+    /// </summary>
+    /// \ingroup Tools
+    typedef std::function<void(const unsigned int& pBegin,
+                               const unsigned int& pEnd)> RangeFunction;
+
+    /// <summary>
+    /// A fixed set of worker threads running parallel loops.
+    ///
+    /// The range of a loop is split in chunks, which are shared between
+    /// the workers and the calling thread. A thread which has finished its
+    /// chunks steals half of the chunks left to another one.
+    /// The workers sleep between the loops.
+    /// </summary>
+    /// \ingroup Tools
+    class ThreadPool
+    {
+    public:
+      /// <summary>
+      /// Start the worker threads.
+      /// </summary>
+      /// <param name="pNbWorkers">  the number of worker threads, 0 to run the
+      ///                            loops on the calling thread only </param>
+      /// <param name="pPinThreads"> pin the worker i to the core i+1, leaving the core 0
+      ///                            to the calling thread - default: false. Only on Linux. </param>
+      explicit ThreadPool(
+        const unsigned int& pNbWorkers,
+        const bool&         pPinThreads = false);
+
+      /// <summary>
+      /// Stop the worker threads.
+      /// </summary>
+      ~ThreadPool();
+
+      /// <summary>
+      /// Run a loop over a range of indices, and return when it is done.
+      /// If the body throws, the remaining chunks are skipped and the
+      /// first exception is thrown again by parallelFor.
+      /// A loop started from the body of another loop of the same pool runs
+      /// on the calling thread.
+      /// </summary>
+      /// <param name="pBegin">     the first index </param>
+      /// <param name="pEnd">       the end of the range, excluded </param>
+      /// <param name="pGrainSize"> the number of indices of a chunk, 0 to split the
+      ///                           range in 4 chunks per thread </param>
+      /// <param name="pBody">      the body of the loop </param>
+      void parallelFor(
+        const unsigned int&  pBegin,
+        const unsigned int&  pEnd,
+        const unsigned int&  pGrainSize,
+        const RangeFunction& pBody);
+
+      /// <summary>
+      /// Return the number of threads running the loops, the calling
+      /// thread included.
+      /// </summary>
+      unsigned int getNbThreads() const;
+
+      /// <summary>
+      /// Return the number of workers using all the cores, the calling
+      /// thread excepted.
+      /// </summary>
+      static unsigned int getDefaultNbWorkers();
+
+    private:
+      ThreadPool(const ThreadPool&);
+      ThreadPool& operator=(const ThreadPool&);
+
+      struct Job;
+
+      // chunks of a thread, from front to back, packed in a word
+      struct Chunks
+      {
+        std::atomic<uint64_t> range;
+        // one cache line per thread
+        char padding[64 - sizeof(std::atomic<uint64_t>)];
+      };
+
+      void xWorkerLoop(const unsigned int& pIndex);
+
+      void xRun(
+        Job&                pJob,
+        const unsigned int& pIndex);
+
+      std::vector<std::thread> fWorkers;
+      std::vector<Chunks> fChunks;
+      bool fPinThreads;
+
+      std::mutex fCallMutex;
+      std::mutex fMutex;
+      std::condition_variable fWakeUp;
+      std::condition_variable fDone;
+      Job* fJob;
+      uint64_t fGeneration;
+      unsigned int fNbActive;
+      bool fStop;
+    };
+
+    /// <summary>
+    /// How a batch function runs: on the calling thread only (the
+    /// default), or on a thread pool.
+    /// </summary>
+    /// \ingroup Tools
+    struct ExecutionPolicy
+    {
+      /// <summary>
+      /// Run on the calling thread only.
+      /// </summary>
+      ExecutionPolicy();
+
+      /// <summary>
+      /// Run on a thread pool.
+      /// </summary>
+      /// <param name="pPool">      the thread pool, which must outlive the policy </param>
+      /// <param name="pGrainSize"> the number of indices of a chunk, 0 for automatic - default: 0 </param>
+      explicit ExecutionPolicy(
+        ThreadPool&         pPool,
+        const unsigned int& pGrainSize = 0);
+
+      /// the thread pool, null to run on the calling thread
+      ThreadPool* pool;
+      /// the number of indices of a chunk, 0 for automatic
+      unsigned int grainSize;
+    };
+
+    /// <summary>
+    /// Run a loop over a range of indices with an execution policy.
+    /// On the calling thread only, the body is called once for the whole
+    /// range.
+    /// </summary>
+    /// <param name="pPolicy"> the execution policy </param>
+    /// <param name="pBegin">  the first index </param>
+    /// <param name="pEnd">    the end of the range, excluded </param>
+    /// <param name="pBody">   the body of the loop </param>
+    /// \ingroup Tools
+    void parallelFor(
+      const ExecutionPolicy& pPolicy,
+      const unsigned int&    pBegin,
+      const unsigned int&    pEnd,
+      const RangeFunction&   pBody);
+
+  } // namespace Math
+} // namespace AL
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALTHREADPOOL_H_
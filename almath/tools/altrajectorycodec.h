@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALTRAJECTORYCODEC_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALTRAJECTORYCODEC_H_
+
+#include <almath/tools/almathbinary.h>
+#include <iostream>
+#include <stdint.h>
+
+/// Lossy compression of a sequence of poses with a bounded error.
+///
+/// Each value is split in channels: the coordinates of a position, an
+/// angle, or the components of a quaternion. Each channel is quantized
+/// on a grid whose step is twice the error bound, so the error of a
+/// decoded channel is at most the bound (plus the float rounding).
+/// The quantized channels are predicted from the previous values, the
+/// last one or a linear extrapolation of the last two, and the residuals
+/// are written with an adaptive Rice code. A sample whose residuals are
+/// all zero takes 2 bits.
+///
+/// The prediction works on the quantized integers, so the encoder and the
+/// decoder stay exactly in sync and the error does not drift along the
+/// sequence. Both keep only the last two values: the memory does not
+/// depend on the length of the sequence.
+///
+/// The stream starts with a header of TRAJECTORY_CODEC_HEADER_SIZE bytes:
+/// the magic "ALMC", the format version (1 byte), the type id of
+/// almathbinary.h (1 byte), the prediction (1 byte), 1 reserved byte, then
+/// the position and the angle bounds (floats, little endian).
+///
+/// Channels and bounds of each type:
+/// - Pose2D: x and y (position bound), theta (angle bound).
+/// - Position3D: x, y and z (position bound).
+/// - Quaternion: w, x, y and z, each one with a quarter of the angle bound,
+///   which bounds the rotation error of a unit quaternion by the angle bound.
+/// - Transform: the translation (position bound) and the quaternion of the
+///   rotation, as above. The decoded rotation is orthonormal.
+namespace AL
+{
+  namespace Math
+  {
+    /// <summary>
+    /// Version of the trajectory codec format.
+    /// </summary>
+    /// \ingroup Tools
+    static const unsigned char TRAJECTORY_CODEC_VERSION = 1;
+
+    /// <summary>
+    /// Size in bytes of the header of a compressed trajectory.
+    /// </summary>
+    /// \ingroup Tools
+    static const unsigned int TRAJECTORY_CODEC_HEADER_SIZE = 16;
+
+    /// <summary>
+    /// Prediction of a value from the previous values.
+    /// </summary>
+    /// \ingroup Tools
+    enum TRAJECTORY_PREDICTION
+    {
+      /// the last value: best for noisy or mostly still trajectories
+      TRAJECTORY_PREDICTION_DELTA  = 0,
+      /// the linear extrapolation of the last two values: best for smooth motions
+      TRAJECTORY_PREDICTION_LINEAR = 1
+    };
+
+    /// <summary>
+    /// Number of channels of each type supported by the codec.
+    /// </summary>
+    /// \ingroup Tools
+    template <class T>
+    struct TrajectoryCodecTraits;
+
+    template <> struct TrajectoryCodecTraits<Pose2D>
+    { enum { nbChannels = 3 }; };
+    template <> struct TrajectoryCodecTraits<Position3D>
+    { enum { nbChannels = 3 }; };
+    template <> struct TrajectoryCodecTraits<Quaternion>
+    { enum { nbChannels = 4 }; };
+    template <> struct TrajectoryCodecTraits<Transform>
+    { enum { nbChannels = 7 }; };
+
+    /// <summary>
+    /// Compress a sequence of values to a stream, one value at a time.
+    /// </summary>
+    /// \ingroup Tools
+    template <class T>
+    class TrajectoryEncoder
+    {
+    public:
+      /// <summary>
+      /// Write the header. Throw a std::invalid_argument if a bound is not
+      /// positive, a std::runtime_error if the stream fails.
+      /// </summary>
+      /// <param name="pStream">        the stream, which must outlive the encoder </param>
+      /// <param name="pPositionBound"> the maximum error of a coordinate, in meters </param>
+      /// <param name="pAngleBound">    the maximum error of an angle, in radians </param>
+      /// <param name="pPrediction">    the prediction - default: TRAJECTORY_PREDICTION_LINEAR </param>
+      TrajectoryEncoder(
+        std::ostream&                pStream,
+        const float&                 pPositionBound,
+        const float&                 pAngleBound,
+        const TRAJECTORY_PREDICTION& pPrediction = TRAJECTORY_PREDICTION_LINEAR);
+
+      /// <summary>
+      /// Finish the stream if it is not finished.
+      /// </summary>
+      ~TrajectoryEncoder();
+
+      /// <summary>
+      /// Compress a value. Throw a std::invalid_argument if the value is
+      /// not finite or too large for the bounds, a std::runtime_error if
+      /// the stream is finished.
+      /// </summary>
+      /// <param name="pValue"> the value </param>
+      void encode(const T& pValue);
+
+      /// <summary>
+      /// Compress a value and return the value the decoder will read.
+      /// </summary>
+      /// <param name="pValue">   the value </param>
+      /// <param name="pDecoded"> the decoded value </param>
+      void encode(
+        const T& pValue,
+        T&       pDecoded);
+
+      /// <summary>
+      /// Write the end of the stream. Throw a std::runtime_error if the
+      /// stream fails.
+      /// </summary>
+      void finish();
+
+      /// <summary>
+      /// Return the number of values compressed.
+      /// </summary>
+      unsigned int size() const;
+
+      /// <summary>
+      /// Return the number of bytes written, header included.
+      /// </summary>
+      unsigned long getNbBytes() const;
+
+    private:
+      TrajectoryEncoder(const TrajectoryEncoder&);
+      TrajectoryEncoder& operator=(const TrajectoryEncoder&);
+
+      void xPutBits(
+        const uint32_t&     pBits,
+        const unsigned int& pNbBits);
+
+      enum { N = TrajectoryCodecTraits<T>::nbChannels };
+
+      std::ostream& fStream;
+      TRAJECTORY_PREDICTION fPrediction;
+      double fSteps[N];
+      int64_t fLast[N];
+      int64_t fBeforeLast[N];
+      uint64_t fRiceSum[N];
+      uint32_t fRiceCount[N];
+      uint64_t fBits;
+      unsigned int fNbBits;
+      unsigned int fNbValues;
+      unsigned long fNbBytes;
+      bool fFinished;
+    };
+
+    /// <summary>
+    /// Decompress a stream written by a TrajectoryEncoder, one value at a
+    /// time. The stream is read byte by byte, it is not read past the end
+    /// of the compressed trajectory.
+    /// </summary>
+    /// \ingroup Tools
+    template <class T>
+    class TrajectoryDecoder
+    {
+    public:
+      /// <summary>
+      /// Read the header. Throw a std::runtime_error if the stream is not
+      /// a compressed trajectory of this type.
+      /// </summary>
+      /// <param name="pStream"> the stream, which must outlive the decoder </param>
+      explicit TrajectoryDecoder(std::istream& pStream);
+
+      /// <summary>
+      /// Decompress the next value. Throw a std::runtime_error if the
+      /// stream is truncated or corrupted.
+      /// </summary>
+      /// <param name="pValue"> the value </param>
+      /// <returns>
+      /// false at the end of the stream
+      /// </returns>
+      const bool decode(T& pValue);
+
+      /// <summary>
+      /// Return the number of values decompressed.
+      /// </summary>
+      unsigned int size() const;
+
+      /// <summary>
+      /// Return the position bound of the stream.
+      /// </summary>
+      float getPositionBound() const;
+
+      /// <summary>
+      /// Return the angle bound of the stream.
+      /// </summary>
+      float getAngleBound() const;
+
+      /// <summary>
+      /// Return the prediction of the stream.
+      /// </summary>
+      TRAJECTORY_PREDICTION getPrediction() const;
+
+    private:
+      TrajectoryDecoder(const TrajectoryDecoder&);
+      TrajectoryDecoder& operator=(const TrajectoryDecoder&);
+
+      uint32_t xGetBits(const unsigned int& pNbBits);
+
+      enum { N = TrajectoryCodecTraits<T>::nbChannels };
+
+      std::istream& fStream;
+      TRAJECTORY_PREDICTION fPrediction;
+      float fPositionBound;
+      float fAngleBound;
+      double fSteps[N];
+      int64_t fLast[N];
+      int64_t fBeforeLast[N];
+      uint64_t fRiceSum[N];
+      uint32_t fRiceCount[N];
+      uint64_t fBits;
+      unsigned int fNbBits;
+      unsigned int fNbValues;
+      bool fFinished;
+    };
+
+  } // namespace Math
+} // namespace AL
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALTRAJECTORYCODEC_H_
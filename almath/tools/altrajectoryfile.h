@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALTRAJECTORYFILE_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALTRAJECTORYFILE_H_
+
+#include <almath/tools/almathbinary.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/// Trajectory file: a stream of timestamped values of one ALMath type.
+///
+/// The file starts with a header of TRAJECTORY_HEADER_SIZE bytes, followed
+/// by a table of records of fixed size. A record is the timestamp in
+/// seconds (a double, little endian) followed by the value in the binary
+/// format of almathbinary.h, padded to a multiple of 8 bytes. The records
+/// are sorted by time.
+///
+/// When the file is closed, a sparse time index is written after the
+/// records: the timestamp of one record every "index stride" records.
+/// A file which was not closed (still recording, or after a crash) has no
+/// index; the reader then builds it from the records counted by the
+/// header, which is updated by each flush.
+namespace AL
+{
+  namespace Math
+  {
+    /// <summary>
+    /// Version of the trajectory file format.
+    /// </summary>
+    /// \ingroup Tools
+    static const unsigned char TRAJECTORY_FORMAT_VERSION = 1;
+
+    /// <summary>
+    /// Size in bytes of the header of a trajectory file.
+    /// </summary>
+    /// \ingroup Tools
+    static const unsigned int TRAJECTORY_HEADER_SIZE = 64;
+
+    /// <summary>
+    /// Size in bytes of a record of a trajectory file.
+    /// </summary>
+    /// \ingroup Tools
+    template <class T>
+    struct TrajectoryRecordSize
+    {
+      enum { value = ((8 + 4*BinaryTraits<T>::nbFloats + 7)/8)*8 };
+    };
+
+    /// <summary>
+    /// Write a trajectory file while recording.
+    ///
+    /// The values are buffered by the C library; flush makes the records
+    /// written so far visible to a reader. The file is valid even if it is
+    /// never closed, only its index is missing, and the records appended
+    /// after the last flush are lost. Appending to a file removes its
+    /// index until it is closed again.
+    /// </summary>
+    /// \ingroup Tools
+    template <class T>
+    class TrajectoryWriter
+    {
+    public:
+      /// <summary>
+      /// Open a trajectory file. Throw a std::runtime_error if the file
+      /// cannot be opened, or if it is appended and is not a trajectory
+      /// of the same type.
+      /// </summary>
+      /// <param name="pFileName">    the name of the file </param>
+      /// <param name="pAppend">      append to an existing file instead of replacing it - default: false </param>
+      /// <param name="pIndexStride"> the number of records between two entries of the index - default: 64 </param>
+      explicit TrajectoryWriter(
+        const std::string&  pFileName,
+        const bool&         pAppend = false,
+        const unsigned int& pIndexStride = 64);
+
+      /// <summary>
+      /// Close the file if it is still open.
+      /// </summary>
+      ~TrajectoryWriter();
+
+      /// <summary>
+      /// Append a record. Throw a std::invalid_argument if the time is
+      /// before the time of the last record.
+      /// </summary>
+      /// <param name="pTime">  the timestamp in seconds </param>
+      /// <param name="pValue"> the value </param>
+      void append(
+        const double& pTime,
+        const T&      pValue);
+
+      /// <summary>
+      /// Write the buffered records to the file.
+      /// </summary>
+      void flush();
+
+      /// <summary>
+      /// Write the index and close the file.
+      /// </summary>
+      void close();
+
+      /// <summary>
+      /// Return the number of records of the file.
+      /// </summary>
+      unsigned int size() const;
+
+    private:
+      TrajectoryWriter(const TrajectoryWriter&);
+      TrajectoryWriter& operator=(const TrajectoryWriter&);
+
+      void xWriteHeader(const bool& pWithIndex);
+      void xCheckOpen() const;
+
+      std::FILE* fFile;
+      unsigned int fIndexStride;
+      unsigned int fNbRecords;
+      double fLastTime;
+      std::vector<double> fIndex;
+    };
+
+    /// <summary>
+    /// Read a trajectory file through a memory mapping.
+    ///
+    /// The records are not copied: a value is decoded from the mapping
+    /// when it is accessed. The file must not be modified while it is read,
+    /// except by appending records, which are not seen by the reader.
+    /// </summary>
+    /// \ingroup Tools
+    template <class T>
+    class TrajectoryReader
+    {
+    public:
+      /// <summary>
+      /// Map a trajectory file. Throw a std::runtime_error if the file
+      /// cannot be mapped or is not a trajectory of this type.
+      /// </summary>
+      /// <param name="pFileName"> the name of the file </param>
+      explicit TrajectoryReader(const std::string& pFileName);
+
+      /// <summary>
+      /// Unmap the file.
+      /// </summary>
+      ~TrajectoryReader();
+
+      /// <summary>
+      /// Return the number of records.
+      /// </summary>
+      unsigned int size() const;
+
+      /// <summary>
+      /// Return the timestamp of a record.
+      /// </summary>
+      /// <param name="pIndex"> the index of the record, less than size() </param>
+      double getTime(const unsigned int& pIndex) const;
+
+      /// <summary>
+      /// Return the value of a record.
+      /// </summary>
+      /// <param name="pIndex"> the index of the record, less than size() </param>
+      /// <param name="pValue"> the value </param>
+      void get(
+        const unsigned int& pIndex,
+        T&                  pValue) const;
+
+      /// <summary>
+      /// Return the binary payload of a record, in the mapping.
+      /// It can be decoded with fromBinary.
+      /// </summary>
+      /// <param name="pIndex"> the index of the record, less than size() </param>
+      const unsigned char* getPayload(const unsigned int& pIndex) const;
+
+      /// <summary>
+      /// Find the last record at or before a time. Throw a
+      /// std::runtime_error if the trajectory is empty.
+      /// </summary>
+      /// <param name="pTime"> the time in seconds </param>
+      /// <returns>
+      /// the index of the record, 0 if the time is before the first record
+      /// </returns>
+      unsigned int findRecord(const double& pTime) const;
+
+      /// <summary>
+      /// Return the value of the last record at or before a time.
+      /// Throw a std::runtime_error if the trajectory is empty.
+      /// </summary>
+      /// <param name="pTime">  the time in seconds </param>
+      /// <param name="pValue"> the value </param>
+      /// <returns>
+      /// the timestamp of the record
+      /// </returns>
+      double getAtTime(
+        const double& pTime,
+        T&            pValue) const;
+
+      /// <summary>
+      /// Return true if the file has the index written by
+      /// TrajectoryWriter::close, false if it was built when mapping.
+      /// </summary>
+      const bool hasIndex() const;
+
+    private:
+      TrajectoryReader(const TrajectoryReader&);
+      TrajectoryReader& operator=(const TrajectoryReader&);
+
+      const unsigned char* xRecord(const unsigned int& pIndex) const;
+      void xUnmap();
+
+      const unsigned char* fData;
+      uint64_t fDataSize;
+      void* fMapping;
+      unsigned int fNbRecords;
+      unsigned int fIndexStride;
+      bool fHasIndex;
+      std::vector<double> fIndex;
+    };
+
+  } // namespace Math
+} // namespace AL
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALTRAJECTORYFILE_H_
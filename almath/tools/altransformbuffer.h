@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALTRANSFORMBUFFER_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALTRANSFORMBUFFER_H_
+
+#include <almath/types/altransform.h>
+#include <almath/types/alvelocity6d.h>
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+
+namespace AL
+{
+  namespace Math
+  {
+    /// <summary>
+    /// History of timestamped Transforms, written by one thread and read
+    /// by any number of threads without lock.
+    ///
+    /// The samples are stored in a ring buffer of fixed capacity: when it
+    /// is full, a new sample replaces the oldest one. push does not
+    /// allocate, lock nor throw, it can be called from a real-time thread.
+    ///
+    /// Each sample also stores the logarithm of the motion from the
+    /// previous sample, computed once by push. A lookup between two samples
+    /// is the SE(3) interpolation of this motion, as transformMean, but
+    /// costs a single exponential.
+    ///
+    /// Each slot is protected by a sequence number: a reader which reads a
+    /// slot while the writer replaces it sees it and reads again.
+    /// This class requires C++11.
+    /// </summary>
+    /// \ingroup Tools
+    class TransformBuffer
+    {
+    public:
+      /// <summary>
+      /// Create an empty buffer. Throw a std::invalid_argument if the
+      /// capacity is less than 2.
+      /// </summary>
+      /// <param name="pCapacity"> the maximum number of samples </param>
+      explicit TransformBuffer(const unsigned int& pCapacity);
+
+      /// <summary>
+      /// Add a sample. To be called by a single thread.
+      /// </summary>
+      /// <param name="pTime">      the timestamp in seconds </param>
+      /// <param name="pTransform"> the transform </param>
+      /// <returns>
+      /// false if the time is not after the time of the last sample, the
+      /// sample is then ignored
+      /// </returns>
+      const bool push(
+        const double&    pTime,
+        const Transform& pTransform);
+
+      /// <summary>
+      /// Interpolate the transform at a time, between the two samples
+      /// around it.
+      /// </summary>
+      /// <param name="pTime">      the time in seconds </param>
+      /// <param name="pTransform"> the interpolated transform </param>
+      /// <returns>
+      /// false if the time is not between the oldest and the last samples
+      /// </returns>
+      const bool getAtTime(
+        const double& pTime,
+        Transform&    pTransform) const;
+
+      /// <summary>
+      /// Return the last sample.
+      /// </summary>
+      /// <param name="pTime">      the timestamp of the sample </param>
+      /// <param name="pTransform"> the transform of the sample </param>
+      /// <returns>
+      /// false if the buffer is empty
+      /// </returns>
+      const bool getLatest(
+        double&    pTime,
+        Transform& pTransform) const;
+
+      /// <summary>
+      /// Return the number of samples in the buffer.
+      /// </summary>
+      unsigned int size() const;
+
+      /// <summary>
+      /// Return the maximum number of samples.
+      /// </summary>
+      unsigned int capacity() const;
+
+    private:
+      TransformBuffer(const TransformBuffer&);
+      TransformBuffer& operator=(const TransformBuffer&);
+
+      // the content of a slot
+      struct Sample
+      {
+        double time;
+        Transform transform;
+        // logarithm of the motion from the previous sample
+        Velocity6D motion;
+      };
+
+      enum { NB_WORDS = (sizeof(Sample) + 7)/8 };
+
+      // A slot holding the sample n has the sequence 2n+2, 2n+1 while it
+      // is written. The sample is copied in relaxed atomic words, so a
+      // reader never reads a half written float.
+      struct Slot
+      {
+        std::atomic<uint64_t> sequence;
+        std::atomic<uint64_t> words[NB_WORDS];
+      };
+
+      const bool xRead(
+        const uint64_t& pIndex,
+        Sample&         pSample) const;
+
+      const bool xReadTime(
+        const uint64_t& pIndex,
+        double&         pTime) const;
+
+      std::vector<Slot> fSlots;
+      std::atomic<uint64_t> fNbSamples;
+
+      // written and read by the writer only
+      double fLastTime;
+      Transform fLastTransform;
+    };
+
+  } // namespace Math
+} // namespace AL
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALTRANSFORMBUFFER_H_
@@ -18,6 +18,7 @@
 #include <almath/types/alaxismask.h>
 #include <almath/types/alpose2d.h>
 #include <almath/types/alquaternion.h>
+#include <almath/tools/alrealtime.h>
 
 namespace AL {
   namespace Math {
@@ -67,6 +68,32 @@ namespace AL {
     /// \ingroup Tools
     Velocity6D transformLogarithm(const Transform& pT);
 
+    /// <summary>
+    /// transformLogarithmInPlace restricted to the axes of a mask, known at
+    /// compile time: the masked-out axes are set to zero and never
+    /// computed. With AXIS_MASK_ROT, the translation part is skipped.
+    /// Instantiated for the 64 masks.
+    /// </summary>
+    /// <param name="pT"> the given Transform </param>
+    /// <param name="pVel"> the Velocity6D logarithme, on the axes of Mask </param>
+    /// \ingroup Tools
+    template <int Mask>
+    void maskedTransformLogarithmInPlace(
+      const Transform& pT,
+      Velocity6D&      pVel);
+
+    /// <summary>
+    /// transformLogarithm restricted to the axes of a mask, known at
+    /// compile time: the masked-out axes are zero.
+    /// </summary>
+    /// <param name="pT"> the given Transform </param>
+    /// <returns>
+    /// the Velocity6D logarithme, on the axes of Mask
+    /// </returns>
+    /// \ingroup Tools
+    template <int Mask>
+    Velocity6D maskedTransformLogarithm(const Transform& pT);
+
 
     /// <summary>
     /// Compute the logarithme of a transform.
@@ -391,6 +418,26 @@ namespace AL {
       const float&     pVal,
       Transform&       pTOut);
 
+    /// <summary>
+    /// Preform a logarithmic mean of pTIn1 and pTIn2 and put it in pTout,
+    /// without exception.
+    /// </summary>
+    /// <param name = "pTIn1"> the first given Transform </param>
+    /// <param name = "pTIn2"> the second given Transform </param>
+    /// <param name = "pVal"> the value between 0 and 1 used in the logarithmic
+    /// mean </param>
+    /// <param name = "pTOut">  the output Transform, unchanged on error.
+    /// </param>
+    /// <returns>
+    /// MATH_OK, or MATH_INVALID_ARGUMENT if pVal is not between 0 and 1.
+    /// </returns>
+    /// \ingroup Tools
+    const MATH_STATUS tryTransformMeanInPlace(
+      const Transform& pTIn1,
+      const Transform& pTIn2,
+      const float&     pVal,
+      Transform&       pTOut) ALMATH_NOEXCEPT;
+
     /// <summary>
     /// Preform a logarithmic mean of pTIn1 and pTIn2.
     /// </summary>
@@ -663,6 +710,80 @@ namespace AL {
       const Transform& pCurrent,
       const Transform& pTarget);
 
+    /// <summary>
+    /// position6DFromTransformDiffInPlace restricted to the axes of a mask,
+    /// known at compile time: the masked-out axes are set to zero and
+    /// never computed. Instantiated for the 64 masks.
+    /// </summary>
+    /// <param name = "pCurrent"> the current Transform </param>
+    /// <param name = "pTarget"> the target Transform </param>
+    /// <param name = "result"> the result Position6D </param>
+    /// \ingroup Tools
+    template <int Mask>
+    void maskedPosition6DFromTransformDiffInPlace(
+      const Transform& pCurrent,
+      const Transform& pTarget,
+      Position6D&      result);
+
+    /// <summary>
+    /// position6DFromTransformDiff restricted to the axes of a mask, known
+    /// at compile time: the masked-out axes are zero.
+    /// </summary>
+    /// <param name = "pCurrent"> the current Transform </param>
+    /// <param name = "pTarget"> the target Transform </param>
+    /// <returns> the result Position6D </returns>
+    /// \ingroup Tools
+    template <int Mask>
+    Position6D maskedPosition6DFromTransformDiff(
+      const Transform& pCurrent,
+      const Transform& pTarget);
+
+    /// <summary>
+    /// Set to zero the axes of a Velocity6D which are not in a mask, known
+    /// at compile time. Instantiated for the 64 masks.
+    /// </summary>
+    /// <param name = "pVel"> the Velocity6D to project </param>
+    /// \ingroup Tools
+    template <int Mask>
+    void maskedVelocity6DProjectionInPlace(Velocity6D& pVel);
+
+    /// <summary>
+    /// Return a Velocity6D with only the axes of a mask, known at compile
+    /// time.
+    /// </summary>
+    /// <param name = "pVel"> the Velocity6D to project </param>
+    /// <returns> the projected Velocity6D </returns>
+    /// \ingroup Tools
+    template <int Mask>
+    Velocity6D maskedVelocity6DProjection(const Velocity6D& pVel);
+
+    /// <summary>
+    /// Compute the squared distance between two Position6D on the axes of
+    /// a mask, known at compile time. Unlike distanceSquared, the rotation
+    /// axes count when they are in the mask. Instantiated for the 64 masks.
+    /// </summary>
+    /// <param name="pPos1"> the first Position6D </param>
+    /// <param name="pPos2"> the second Position6D </param>
+    /// <returns> the squared distance on the axes of Mask </returns>
+    /// \ingroup Tools
+    template <int Mask>
+    float maskedDistanceSquared(
+      const Position6D& pPos1,
+      const Position6D& pPos2);
+
+    /// <summary>
+    /// Compute the distance between two Position6D on the axes of a mask,
+    /// known at compile time.
+    /// </summary>
+    /// <param name="pPos1"> the first Position6D </param>
+    /// <param name="pPos2"> the second Position6D </param>
+    /// <returns> the distance on the axes of Mask </returns>
+    /// \ingroup Tools
+    template <int Mask>
+    float maskedDistance(
+      const Position6D& pPos1,
+      const Position6D& pPos2);
+
     /// <summary>
     /// Compute a Position3D from a Transform.
     ///
@@ -825,6 +946,30 @@ namespace AL {
       const Position3D& pPos,
       Rotation&         pRot);
 
+    /**
+    * Function tryAxisRotationProjectionInPlace :
+    * axisRotationProjectionInPlace without exception.
+    * @param Position3D : axis of rotation
+    * @param pH: a transform, unchanged on error
+    * @return MATH_OK, MATH_DIVISION_BY_ZERO if the axis is null, or
+    * MATH_INVALID_ARGUMENT if there is no projection
+    **/
+    const MATH_STATUS tryAxisRotationProjectionInPlace(
+      const Position3D& pPos,
+      Transform&        pT) ALMATH_NOEXCEPT;
+
+    /**
+    * Function tryAxisRotationProjectionInPlace :
+    * axisRotationProjectionInPlace without exception.
+    * @param Position3D : axis of rotation
+    * @param pRot : a rotation, unchanged on error
+    * @return MATH_OK, MATH_DIVISION_BY_ZERO if the axis is null, or
+    * MATH_INVALID_ARGUMENT if there is no projection
+    **/
+    const MATH_STATUS tryAxisRotationProjectionInPlace(
+      const Position3D& pPos,
+      Rotation&         pRot) ALMATH_NOEXCEPT;
+
 
     void orthogonalSpace(
       const Position3D& pPos,
@@ -10,12 +10,34 @@
 #define _LIBALMATH_ALMATH_TOOLS_AVOIDFOOTCOLLISION_H_
 
 #include <almath/types/alpose2d.h>
+#include <almath/types/alfootpolygon.h>
+#include <almath/types/alposition2d.h>
 #include <vector>
 
 namespace AL
 {
   namespace Math
   {
+    // defined in almath/tools/althreadpool.h
+    struct ExecutionPolicy;
+
+    /// <summary>
+    /// Method used by avoidFootCollision to compute the orientation of the
+    /// moving foot when the desired move is in collision.
+    ///
+    /// AVOID_FOOT_COLLISION_DICHOTOMY: bisection on the orientation,
+    /// precise to theta/32. \n
+    /// AVOID_FOOT_COLLISION_EXACT: largest collision free orientation,
+    /// computed from the contact angles between the vertices of a foot
+    /// and the edges of the other one, without allocation. \n
+    /// </summary>
+    /// \ingroup Tools
+    enum AVOID_FOOT_COLLISION_MODE
+    {
+      AVOID_FOOT_COLLISION_DICHOTOMY = 0,
+      AVOID_FOOT_COLLISION_EXACT     = 1
+    };
+
     /// <summary>
     /// Compute the best position(orientation) of the foot to avoid collision.
     /// </summary>
@@ -23,15 +45,316 @@ namespace AL
     /// <param name="pRFootBoundingBox">  vector<Pose2D> of the right footBoundingBox.</param>
     /// <param name="pIsLeftSupport">     Bool true if left is the support leg. </param>
     /// <param name="pMove">              the desired and return Pose2D. </param>
+    /// <param name="pMode">              the method used to compute the orientation
+    ///                                   of the moving foot - default: AVOID_FOOT_COLLISION_DICHOTOMY </param>
     /// <returns>
     /// true if pMove is clamped.
     /// </returns>
     /// \ingroup Tools
     const bool avoidFootCollision(
+        const std::vector<Pose2D>&        pLFootBoundingBox,
+        const std::vector<Pose2D>&        pRFootBoundingBox,
+        const bool&                       pIsLeftSupport,
+        Pose2D&                           pMove,
+        const AVOID_FOOT_COLLISION_MODE&  pMode = AVOID_FOOT_COLLISION_DICHOTOMY);
+
+
+    /// <summary>
+    /// Query if two convex polygons are in collision.
+    ///
+    /// Use the separating axis theorem: the polygons are disjoint if
+    /// and only if the projections of the two polygons on one of their
+    /// edge normals do not overlap. The test stops on the first
+    /// separating axis found. Polygons which are only touching are not
+    /// in collision.
+    /// </summary>
+    /// <param name="pPolygonA"> vector<Pose2D> of the vertices of the convex polygon A. </param>
+    /// <param name="pPolygonB"> vector<Pose2D> of the vertices of the convex polygon B. </param>
+    /// <returns>
+    /// true if the two polygons are in collision.
+    /// </returns>
+    /// \ingroup Tools
+    const bool areConvexPolygonsInCollision(
+        const std::vector<Pose2D>&  pPolygonA,
+        const std::vector<Pose2D>&  pPolygonB);
+
+
+    /// <summary>
+    /// Query if two convex polygons are in collision.
+    /// </summary>
+    /// <param name="pPolygonA"> vector<Position2D> of the vertices of the convex polygon A. </param>
+    /// <param name="pPolygonB"> vector<Position2D> of the vertices of the convex polygon B. </param>
+    /// <returns>
+    /// true if the two polygons are in collision.
+    /// </returns>
+    /// \ingroup Tools
+    const bool areConvexPolygonsInCollision(
+        const std::vector<Position2D>&  pPolygonA,
+        const std::vector<Position2D>&  pPolygonB);
+
+
+    /// <summary>
+    /// Query if a convex polygon is in collision with each polygon of a list.
+    /// </summary>
+    /// <param name="pPolygonA">   vector<Pose2D> of the vertices of the convex polygon A. </param>
+    /// <param name="pPolygonsB">  the list of convex polygons to test against A. </param>
+    /// <param name="pCollisions"> for each polygon of pPolygonsB, true if it is in collision with A. </param>
+    /// \ingroup Tools
+    void areConvexPolygonsInCollision(
+        const std::vector<Pose2D>&                pPolygonA,
+        const std::vector<std::vector<Pose2D> >&  pPolygonsB,
+        std::vector<bool>&                        pCollisions);
+
+    /// <summary>
+    /// Query if a convex polygon is in collision with each polygon of a
+    /// list, on the threads of an execution policy. The result is the
+    /// same as the one of the sequential version.
+    /// </summary>
+    /// <param name="pPolygonA">   vector<Pose2D> of the vertices of the convex polygon A. </param>
+    /// <param name="pPolygonsB">  the list of convex polygons to test against A. </param>
+    /// <param name="pCollisions"> for each polygon of pPolygonsB, true if it is in collision with A. </param>
+    /// <param name="pPolicy">     the execution policy. </param>
+    /// \ingroup Tools
+    void areConvexPolygonsInCollision(
+        const std::vector<Pose2D>&                pPolygonA,
+        const std::vector<std::vector<Pose2D> >&  pPolygonsB,
+        std::vector<bool>&                        pCollisions,
+        const ExecutionPolicy&                    pPolicy);
+
+
+    /// <summary>
+    /// Compute the signed distance between two convex polygons.
+    ///
+    /// If the polygons are disjoint, this is the distance between their
+    /// closest points. If they overlap, this is minus the penetration
+    /// depth: the smallest translation along an edge normal which
+    /// separates them. The separating axis test stops on the first
+    /// separating axis found, then only the closest points are computed.
+    /// </summary>
+    /// <param name="pPolygonA"> vector<Pose2D> of the vertices of the convex polygon A. </param>
+    /// <param name="pPolygonB"> vector<Pose2D> of the vertices of the convex polygon B. </param>
+    /// <param name="pWitnessA"> the closest (or deepest) point of A. </param>
+    /// <param name="pWitnessB"> the closest (or deepest) point of B. </param>
+    /// <returns>
+    /// the signed distance, negative when the polygons are in collision.
+    /// </returns>
+    /// \ingroup Tools
+    const float signedDistanceBetweenConvexPolygons(
+        const std::vector<Pose2D>&  pPolygonA,
+        const std::vector<Pose2D>&  pPolygonB,
+        Position2D&                 pWitnessA,
+        Position2D&                 pWitnessB);
+
+    /// <summary>
+    /// Compute the signed distance between two convex polygons.
+    /// </summary>
+    /// <param name="pPolygonA"> vector<Position2D> of the vertices of the convex polygon A. </param>
+    /// <param name="pPolygonB"> vector<Position2D> of the vertices of the convex polygon B. </param>
+    /// <param name="pWitnessA"> the closest (or deepest) point of A. </param>
+    /// <param name="pWitnessB"> the closest (or deepest) point of B. </param>
+    /// <returns>
+    /// the signed distance, negative when the polygons are in collision.
+    /// </returns>
+    /// \ingroup Tools
+    const float signedDistanceBetweenConvexPolygons(
+        const std::vector<Position2D>&  pPolygonA,
+        const std::vector<Position2D>&  pPolygonB,
+        Position2D&                     pWitnessA,
+        Position2D&                     pWitnessB);
+
+    /// <summary>
+    /// Compute the signed distance between a convex polygon and each
+    /// polygon of a list, to rank candidates by their clearance.
+    /// </summary>
+    /// <param name="pPolygonA">  vector<Pose2D> of the vertices of the convex polygon A. </param>
+    /// <param name="pPolygonsB"> the list of convex polygons. </param>
+    /// <param name="pDistances"> for each polygon of pPolygonsB, its signed distance to A. </param>
+    /// \ingroup Tools
+    void signedDistanceBetweenConvexPolygons(
+        const std::vector<Pose2D>&                pPolygonA,
+        const std::vector<std::vector<Pose2D> >&  pPolygonsB,
+        std::vector<float>&                       pDistances);
+
+    /// <summary>
+    /// Compute the signed distance between a convex polygon and each
+    /// polygon of a list, on the threads of an execution policy. The
+    /// result is the same as the one of the sequential version.
+    /// </summary>
+    /// <param name="pPolygonA">  vector<Pose2D> of the vertices of the convex polygon A. </param>
+    /// <param name="pPolygonsB"> the list of convex polygons. </param>
+    /// <param name="pDistances"> for each polygon of pPolygonsB, its signed distance to A. </param>
+    /// <param name="pPolicy">    the execution policy. </param>
+    /// \ingroup Tools
+    void signedDistanceBetweenConvexPolygons(
+        const std::vector<Pose2D>&                pPolygonA,
+        const std::vector<std::vector<Pose2D> >&  pPolygonsB,
+        std::vector<float>&                       pDistances,
+        const ExecutionPolicy&                    pPolicy);
+
+
+    /// <summary>
+    /// Compute the first time of contact between a fixed convex polygon
+    /// and a convex polygon moving from pStartMove to pEndMove, along the
+    /// linear interpolation of the Pose2D.
+    ///
+    /// Use conservative advancement: the motion is advanced by the signed
+    /// distance between the polygons divided by the max speed of the
+    /// vertices of the moving polygon, so that the contact cannot be
+    /// missed, whatever the move.
+    /// </summary>
+    /// <param name="pFixedPolygon">  vector<Pose2D> of the vertices of the fixed convex polygon. </param>
+    /// <param name="pMovingPolygon"> vector<Pose2D> of the vertices of the moving convex polygon,
+    ///                               in its own frame. </param>
+    /// <param name="pStartMove">     Pose2D of the moving polygon at time 0. </param>
+    /// <param name="pEndMove">       Pose2D of the moving polygon at time 1. </param>
+    /// <param name="pTimeOfContact"> the first time of contact, in [0, 1]. </param>
+    /// <param name="pTolerance">     the distance considered as a contact - default: 0.0001 </param>
+    /// <returns>
+    /// true if the polygons are in contact during the move.
+    /// </returns>
+    /// \ingroup Tools
+    const bool computeTimeOfContact(
+        const std::vector<Pose2D>&  pFixedPolygon,
+        const std::vector<Pose2D>&  pMovingPolygon,
+        const Pose2D&               pStartMove,
+        const Pose2D&               pEndMove,
+        float&                      pTimeOfContact,
+        const float&                pTolerance = 0.0001f);
+
+    /// <summary>
+    /// Query if the swing foot hits the support foot during the step, and
+    /// compute the first time of contact.
+    ///
+    /// avoidFootCollision only checks the final position of the foot. The
+    /// swing foot is swept here from its lift off position pStartMove to
+    /// pMove, both expressed as in avoidFootCollision.
+    /// </summary>
+    /// <param name="pLFootBoundingBox"> vector<Pose2D> of the left footBoundingBox. </param>
+    /// <param name="pRFootBoundingBox"> vector<Pose2D> of the right footBoundingBox. </param>
+    /// <param name="pIsLeftSupport">    Bool true if left is the support foot. </param>
+    /// <param name="pStartMove">        Pose2D of the swing foot at the start of the step. </param>
+    /// <param name="pMove">             Pose2D of the swing foot at the end of the step. </param>
+    /// <param name="pTimeOfContact">    the first time of contact, in [0, 1]. </param>
+    /// <returns>
+    /// true if the feet are in contact during the step.
+    /// </returns>
+    /// \ingroup Tools
+    const bool sweptFootCollision(
         const std::vector<Pose2D>&  pLFootBoundingBox,
         const std::vector<Pose2D>&  pRFootBoundingBox,
         const bool&                 pIsLeftSupport,
-        Pose2D&                     pMove);
+        const Pose2D&               pStartMove,
+        const Pose2D&               pMove,
+        float&                      pTimeOfContact);
+
+
+    /// <summary>
+    /// Compute the best position(orientation) of the foot to avoid collision.
+    ///
+    /// Same as the std::vector<Pose2D> version, but without any allocation.
+    /// Available for N from 3 to 8.
+    /// </summary>
+    /// <param name="pLFootBoundingBox">  FootPolygon of the left footBoundingBox.</param>
+    /// <param name="pRFootBoundingBox">  FootPolygon of the right footBoundingBox.</param>
+    /// <param name="pIsLeftSupport">     Bool true if left is the support leg. </param>
+    /// <param name="pMove">              the desired and return Pose2D. </param>
+    /// <param name="pMode">              the method used to compute the orientation
+    ///                                   of the moving foot - default: AVOID_FOOT_COLLISION_DICHOTOMY </param>
+    /// <returns>
+    /// true if pMove is clamped.
+    /// </returns>
+    /// \ingroup Tools
+    template <unsigned int N>
+    const bool avoidFootCollision(
+        const FootPolygon<N>&             pLFootBoundingBox,
+        const FootPolygon<N>&             pRFootBoundingBox,
+        const bool&                       pIsLeftSupport,
+        Pose2D&                           pMove,
+        const AVOID_FOOT_COLLISION_MODE&  pMode = AVOID_FOOT_COLLISION_DICHOTOMY);
+
+
+    /// <summary>
+    /// Query if two convex FootPolygon are in collision.
+    ///
+    /// The bounding boxes are tested first, then the separating axis test
+    /// uses the precomputed edge normals.
+    /// Available for N from 3 to 8.
+    /// </summary>
+    /// <param name="pPolygonA"> the convex polygon A. </param>
+    /// <param name="pPolygonB"> the convex polygon B. </param>
+    /// <returns>
+    /// true if the two polygons are in collision.
+    /// </returns>
+    /// \ingroup Tools
+    template <unsigned int N>
+    const bool areConvexPolygonsInCollision(
+        const FootPolygon<N>&  pPolygonA,
+        const FootPolygon<N>&  pPolygonB);
+
+
+    /// <summary>
+    /// Evaluate many footstep candidates for the same support foot.
+    ///
+    /// Each candidate is first clipped with the ellipse of clipFootWithEllipse,
+    /// then the orientation of the swing foot is limited to avoid the
+    /// collision with the support foot, as in avoidFootCollision.
+    /// The clip of all the candidates is done in one vectorizable pass, and
+    /// a bounding test skips the collision test of the candidates far from
+    /// the support foot.
+    /// The output vectors are resized to the number of candidates, so they
+    /// can be reused between calls without allocation.
+    /// Available for N from 3 to 8.
+    /// </summary>
+    /// <param name="pSupportFoot"> FootPolygon of the support foot. </param>
+    /// <param name="pSwingFoot">   FootPolygon of the swing foot. </param>
+    /// <param name="pMaxFootX">    float of the max step along x axis. </param>
+    /// <param name="pMaxFootY">    float of the max step along y axis. </param>
+    /// <param name="pCandidates">  the desired moves of the swing foot. </param>
+    /// <param name="pMoves">       the clipped moves. </param>
+    /// <param name="pCollisions">  for each candidate, true if the orientation
+    ///                             is clamped to avoid a collision. </param>
+    /// <param name="pMode">        the method used to compute the orientation
+    ///                             of the swing foot - default: AVOID_FOOT_COLLISION_DICHOTOMY </param>
+    /// \ingroup Tools
+    template <unsigned int N>
+    void evaluateFootCandidates(
+        const FootPolygon<N>&             pSupportFoot,
+        const FootPolygon<N>&             pSwingFoot,
+        const float&                      pMaxFootX,
+        const float&                      pMaxFootY,
+        const std::vector<Pose2D>&        pCandidates,
+        std::vector<Pose2D>&              pMoves,
+        std::vector<bool>&                pCollisions,
+        const AVOID_FOOT_COLLISION_MODE&  pMode = AVOID_FOOT_COLLISION_DICHOTOMY);
+
+    /// <summary>
+    /// Evaluate many footstep candidates on the threads of an execution
+    /// policy. The result is the same as the one of the sequential version.
+    /// Available for N from 3 to 8.
+    /// </summary>
+    /// <param name="pSupportFoot"> FootPolygon of the support foot. </param>
+    /// <param name="pSwingFoot">   FootPolygon of the swing foot. </param>
+    /// <param name="pMaxFootX">    float of the max step along x axis. </param>
+    /// <param name="pMaxFootY">    float of the max step along y axis. </param>
+    /// <param name="pCandidates">  the desired moves of the swing foot. </param>
+    /// <param name="pMoves">       the clipped moves. </param>
+    /// <param name="pCollisions">  for each candidate, true if the orientation
+    ///                             is clamped to avoid a collision. </param>
+    /// <param name="pMode">        the method used to compute the orientation
+    ///                             of the swing foot. </param>
+    /// <param name="pPolicy">      the execution policy. </param>
+    /// \ingroup Tools
+    template <unsigned int N>
+    void evaluateFootCandidates(
+        const FootPolygon<N>&             pSupportFoot,
+        const FootPolygon<N>&             pSwingFoot,
+        const float&                      pMaxFootX,
+        const float&                      pMaxFootY,
+        const std::vector<Pose2D>&        pCandidates,
+        std::vector<Pose2D>&              pMoves,
+        std::vector<bool>&                pCollisions,
+        const AVOID_FOOT_COLLISION_MODE&  pMode,
+        const ExecutionPolicy&            pPolicy);
 
 
     /// <summary>
@@ -49,6 +372,98 @@ namespace AL
         const float&    pMaxFootY,
         Pose2D&         pMove);
 
+    /// <summary>
+    /// Clip foot move with a rotated and offset ellipse, and clamp its
+    /// orientation. The position is scaled toward the center of the
+    /// ellipse, without trigonometry on the move.
+    /// </summary>
+    /// <param name="pMaxFootX">     float of the half axis of the ellipse along its x axis. </param>
+    /// <param name="pMaxFootY">     float of the half axis of the ellipse along its y axis. </param>
+    /// <param name="pEllipsePose">  Pose2D of the center and the orientation of the ellipse. </param>
+    /// <param name="pMinFootTheta"> float of the min orientation of the move. </param>
+    /// <param name="pMaxFootTheta"> float of the max orientation of the move. </param>
+    /// <param name="pMove">         the desired and return Pose2D. </param>
+    /// <returns>
+    /// true if pMove is clamped.
+    /// </returns>
+    /// \ingroup Tools
+    const bool clipFootWithEllipse(
+        const float&    pMaxFootX,
+        const float&    pMaxFootY,
+        const Pose2D&   pEllipsePose,
+        const float&    pMinFootTheta,
+        const float&    pMaxFootTheta,
+        Pose2D&         pMove);
+
+    /// <summary>
+    /// Clip an array of foot moves with ellipsoid function, in place.
+    /// </summary>
+    /// <param name="pMaxFootX">  float of the max step along x axis. </param>
+    /// <param name="pMaxFootY">  float of the max step along y axis. </param>
+    /// <param name="pMoves">     the desired and return Pose2D. </param>
+    /// <param name="pSize">      the number of moves. </param>
+    /// <returns>
+    /// the number of clamped moves.
+    /// </returns>
+    /// \ingroup Tools
+    unsigned int clipFootWithEllipse(
+        const float&        pMaxFootX,
+        const float&        pMaxFootY,
+        Pose2D*             pMoves,
+        const unsigned int& pSize);
+
+    /// <summary>
+    /// Clip an array of foot moves with a rotated and offset ellipse and
+    /// clamp their orientation, in place. The trigonometry of the ellipse
+    /// orientation is computed once for all the moves.
+    /// </summary>
+    /// <param name="pMaxFootX">     float of the half axis of the ellipse along its x axis. </param>
+    /// <param name="pMaxFootY">     float of the half axis of the ellipse along its y axis. </param>
+    /// <param name="pEllipsePose">  Pose2D of the center and the orientation of the ellipse. </param>
+    /// <param name="pMinFootTheta"> float of the min orientation of the moves. </param>
+    /// <param name="pMaxFootTheta"> float of the max orientation of the moves. </param>
+    /// <param name="pMoves">        the desired and return Pose2D. </param>
+    /// <param name="pSize">         the number of moves. </param>
+    /// <returns>
+    /// the number of clamped moves.
+    /// </returns>
+    /// \ingroup Tools
+    unsigned int clipFootWithEllipse(
+        const float&        pMaxFootX,
+        const float&        pMaxFootY,
+        const Pose2D&       pEllipsePose,
+        const float&        pMinFootTheta,
+        const float&        pMaxFootTheta,
+        Pose2D*             pMoves,
+        const unsigned int& pSize);
+
+    /// <summary>
+    /// Clip an array of foot moves with a rotated and offset ellipse and
+    /// clamp their orientation, in place, on the threads of an execution
+    /// policy.
+    /// </summary>
+    /// <param name="pMaxFootX">     float of the half axis of the ellipse along its x axis. </param>
+    /// <param name="pMaxFootY">     float of the half axis of the ellipse along its y axis. </param>
+    /// <param name="pEllipsePose">  Pose2D of the center and the orientation of the ellipse. </param>
+    /// <param name="pMinFootTheta"> float of the min orientation of the moves. </param>
+    /// <param name="pMaxFootTheta"> float of the max orientation of the moves. </param>
+    /// <param name="pMoves">        the desired and return Pose2D. </param>
+    /// <param name="pSize">         the number of moves. </param>
+    /// <param name="pPolicy">       the execution policy. </param>
+    /// <returns>
+    /// the number of clamped moves.
+    /// </returns>
+    /// \ingroup Tools
+    unsigned int clipFootWithEllipse(
+        const float&            pMaxFootX,
+        const float&            pMaxFootY,
+        const Pose2D&           pEllipsePose,
+        const float&            pMinFootTheta,
+        const float&            pMaxFootTheta,
+        Pose2D*                 pMoves,
+        const unsigned int&     pSize,
+        const ExecutionPolicy&  pPolicy);
+
   } // namespace Math
 } // namespace AL
 
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TYPES_ALFOOTPOLYGON_H_
+#define _LIBALMATH_ALMATH_TYPES_ALFOOTPOLYGON_H_
+
+#include <almath/types/alpose2d.h>
+#include <almath/types/alposition2d.h>
+#include <cmath>
+#include <vector>
+
+namespace AL {
+  namespace Math {
+
+    /// <summary>
+    /// A convex polygon of N vertices, typically a foot bounding box.
+    ///
+    /// The vertices are stored on the stack with the outward unit normal
+    /// of each edge and the axis-aligned bounding box of the polygon, so
+    /// that collision tests do not need to compute them again.
+    /// The normal i is the normal of the edge from the vertex i to the
+    /// vertex i+1. The vertices can be given clockwise or counterclockwise.
+    ///
+    /// If the vertices are modified directly, update() must be called.
+    /// </summary>
+    /// \ingroup Types
+    template <unsigned int N>
+    struct FootPolygon
+    {
+      /// <summary> the vertices of the polygon </summary>
+      Position2D vertices[N];
+      /// <summary> the outward unit normals of the edges </summary>
+      Position2D normals[N];
+      /// <summary> the lower corner of the axis-aligned bounding box </summary>
+      Position2D boxMin;
+      /// <summary> the upper corner of the axis-aligned bounding box </summary>
+      Position2D boxMax;
+
+      /// <summary>
+      /// Create a FootPolygon with all the vertices at the origin.
+      /// </summary>
+      FootPolygon()
+      {
+        update();
+      }
+
+      /// <summary>
+      /// Create a FootPolygon from an array of N Position2D.
+      /// </summary>
+      /// <param name="pVertices"> the N vertices of the polygon </param>
+      explicit FootPolygon(const Position2D* pVertices)
+      {
+        for (unsigned int i=0; i<N; i++)
+        {
+          vertices[i] = pVertices[i];
+        }
+        update();
+      }
+
+      /// <summary>
+      /// Create a FootPolygon from a std::vector of Pose2D, as used by
+      /// avoidFootCollision. Only x and y are used.
+      /// If the vector is not of size N, the missing vertices are set to
+      /// the origin and the extra ones are ignored.
+      /// </summary>
+      /// <param name="pVertices"> the vertices of the polygon </param>
+      explicit FootPolygon(const std::vector<Pose2D>& pVertices)
+      {
+        for (unsigned int i=0; i<N; i++)
+        {
+          if (i < pVertices.size())
+          {
+            vertices[i] = Position2D(pVertices[i].x, pVertices[i].y);
+          }
+        }
+        update();
+      }
+
+      /// <summary>
+      /// Return the number of vertices of the polygon.
+      /// </summary>
+      unsigned int size() const
+      {
+        return N;
+      }
+
+      /// <summary>
+      /// Compute the edge normals and the bounding box from the vertices.
+      /// </summary>
+      void update()
+      {
+        // the sign of the area gives the orientation of the polygon
+        float area = 0.0f;
+        unsigned int iPlusOne = 0;
+        for (unsigned int i=0; i<N; i++)
+        {
+          iPlusOne = (i+1 == N) ? 0 : i+1;
+          area += vertices[i].x*vertices[iPlusOne].y -
+              vertices[iPlusOne].x*vertices[i].y;
+        }
+        const float sign = (area > 0.0f) ? 1.0f : -1.0f;
+
+        float dx, dy, norm;
+        boxMin = vertices[0];
+        boxMax = vertices[0];
+        for (unsigned int i=0; i<N; i++)
+        {
+          iPlusOne = (i+1 == N) ? 0 : i+1;
+          dx = vertices[iPlusOne].x - vertices[i].x;
+          dy = vertices[iPlusOne].y - vertices[i].y;
+          norm = sqrtf(dx*dx + dy*dy);
+          if (norm > 0.0f)
+          {
+            normals[i].x =  sign*dy/norm;
+            normals[i].y = -sign*dx/norm;
+          }
+          else
+          {
+            // degenerated edge
+            normals[i] = Position2D();
+          }
+
+          if (vertices[i].x < boxMin.x)
+            boxMin.x = vertices[i].x;
+          else if (vertices[i].x > boxMax.x)
+            boxMax.x = vertices[i].x;
+          if (vertices[i].y < boxMin.y)
+            boxMin.y = vertices[i].y;
+          else if (vertices[i].y > boxMax.y)
+            boxMax.y = vertices[i].y;
+        }
+      }
+
+      /// <summary>
+      /// Compute the polygon moved by a Pose2D, without computing the
+      /// normals again.
+      /// </summary>
+      /// <param name="pMove"> the move of the polygon </param>
+      /// <param name="pResult"> the moved polygon </param>
+      void transform(
+        const Pose2D&   pMove,
+        FootPolygon<N>& pResult) const
+      {
+        const float c = cosf(pMove.theta);
+        const float s = sinf(pMove.theta);
+        float x, y;
+        for (unsigned int i=0; i<N; i++)
+        {
+          x = vertices[i].x;
+          y = vertices[i].y;
+          pResult.vertices[i].x = pMove.x + c*x - s*y;
+          pResult.vertices[i].y = pMove.y + s*x + c*y;
+
+          x = normals[i].x;
+          y = normals[i].y;
+          pResult.normals[i].x = c*x - s*y;
+          pResult.normals[i].y = s*x + c*y;
+
+          if (i == 0)
+          {
+            pResult.boxMin = pResult.vertices[0];
+            pResult.boxMax = pResult.vertices[0];
+            continue;
+          }
+          if (pResult.vertices[i].x < pResult.boxMin.x)
+            pResult.boxMin.x = pResult.vertices[i].x;
+          else if (pResult.vertices[i].x > pResult.boxMax.x)
+            pResult.boxMax.x = pResult.vertices[i].x;
+          if (pResult.vertices[i].y < pResult.boxMin.y)
+            pResult.boxMin.y = pResult.vertices[i].y;
+          else if (pResult.vertices[i].y > pResult.boxMax.y)
+            pResult.boxMax.y = pResult.vertices[i].y;
+        }
+      }
+
+      /// <summary>
+      /// Check if the bounding box of the actual polygon overlaps the one
+      /// of the polygon given in argument. Touching boxes do not overlap.
+      /// </summary>
+      /// <param name="pPolygon2"> the second polygon </param>
+      /// <returns>
+      /// true if the two bounding boxes overlap
+      /// </returns>
+      template <unsigned int M>
+      bool isBoundingBoxOverlapping(const FootPolygon<M>& pPolygon2) const
+      {
+        return (boxMin.x < pPolygon2.boxMax.x) &&
+            (pPolygon2.boxMin.x < boxMax.x) &&
+            (boxMin.y < pPolygon2.boxMax.y) &&
+            (pPolygon2.boxMin.y < boxMax.y);
+      }
+    };
+
+    /// <summary>
+    /// A foot bounding box: a FootPolygon with 4 vertices.
+    /// </summary>
+    /// \ingroup Types
+    typedef FootPolygon<4> FootBox;
+
+  } // end namespace math
+} // end namespace AL
+#endif  // _LIBALMATH_ALMATH_TYPES_ALFOOTPOLYGON_H_
@@ -447,6 +447,22 @@ namespace AL {
     /// \ingroup Types
     float determinant(const std::vector<float>& pFloats);
 
+    /// <summary>
+    /// Compute the determinant of rotation part of the given buffer of floats,
+    /// without allocation:
+    ///
+    /** \f$pT[0]*pT[5]*pT[10] + pT[1]*pT[6]*pT[8] +
+      * pT[2]*pT[4]*pT[9] - pT[0]*pT[6]*pT[9] -
+      * pT[1]*pT[4]*pT[10] - pT[2]*pT[5]*pT[8]\f$
+      */
+   /// </summary>
+    /// <param name="pFloats"> the given buffer of at least 12 floats </param>
+    /// <returns>
+    /// the float determinant of rotation Transform part
+    /// </returns>
+    /// \ingroup Types
+    float determinant(const float* pFloats);
+
     /// <summary>
     /// Return the transform inverse of the given Transform:
     ///
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TYPES_ALTRANSFORM2D_H_
+#define _LIBALMATH_ALMATH_TYPES_ALTRANSFORM2D_H_
+
+#include <almath/types/alpose2d.h>
+#include <almath/types/alposition2d.h>
+
+namespace AL {
+  namespace Math {
+
+    /// <summary>
+    /// A pose in a 2-dimentional space, as a homogenous 3*3 matrix of SE(2).
+    ///
+    /// The matrix keeps the cosinus and the sinus of the rotation:
+    /// unlike Pose2D, the composition, the inverse and the product with a
+    /// Position2D need no trigonometry. Convert from and to Pose2D at the
+    /// boundary only.
+    ///
+    /** \f$ \left[\begin{array}{ccc}
+      *   cosTheta & -sinTheta & x \\
+      *   sinTheta &  cosTheta & y \\
+      *   0 & 0 & 1
+      * \end{array}\right] \f$
+      */
+    /// </summary>
+    /// \ingroup Types
+    struct Transform2D {
+      /// <summary> </summary>
+      float x;
+      /// <summary> </summary>
+      float y;
+      /// <summary> </summary>
+      float cosTheta;
+      /// <summary> </summary>
+      float sinTheta;
+
+      /// <summary>
+      /// Create an identity Transform2D.
+      /// </summary>
+      Transform2D();
+
+      /// <summary>
+      /// Create a Transform2D from a Pose2D: one cosinus and one sinus.
+      /// </summary>
+      /// <param name="pPose"> the Pose2D </param>
+      explicit Transform2D(const Pose2D& pPose);
+
+      /// <summary>
+      /// Create a Transform2D from a position and an angle.
+      /// </summary>
+      /// <param name="pX"> the position along x </param>
+      /// <param name="pY"> the position along y </param>
+      /// <param name="pTheta"> the angle in radian </param>
+      explicit Transform2D(
+        const float& pX,
+        const float& pY,
+        const float& pTheta);
+
+      /// <summary>
+      /// Compose two Transform2D, as Pose2D::operator*.
+      /// </summary>
+      /// <param name="pT2"> the second Transform2D </param>
+      Transform2D operator*(const Transform2D& pT2) const;
+
+      /// <summary>
+      /// Compose with a Transform2D, as Pose2D::operator*=.
+      /// </summary>
+      /// <param name="pT2"> the second Transform2D </param>
+      Transform2D& operator*=(const Transform2D& pT2);
+
+      /// <summary>
+      /// Apply the Transform2D to a Position2D.
+      /// </summary>
+      /// <param name="pPos"> the Position2D </param>
+      Position2D operator*(const Position2D& pPos) const;
+
+      bool operator==(const Transform2D& pT2) const;
+
+      bool operator!=(const Transform2D& pT2) const;
+
+      /// <summary>
+      /// Check if the actual Transform2D is near the one given in argument.
+      /// </summary>
+      /// <param name="pT2"> the second Transform2D </param>
+      /// <param name="pEpsilon"> an optionnal epsilon distance - default: 0.0001 </param>
+      /// <returns>
+      /// true if the difference of each float of the two Transform2D is
+      /// less than pEpsilon
+      /// </returns>
+      bool isNear(
+        const Transform2D& pT2,
+        const float&       pEpsilon=0.0001f) const;
+
+      /// <summary>
+      /// Return the inverse of the Transform2D.
+      /// </summary>
+      Transform2D inverse() const;
+
+      /// <summary>
+      /// Return the Transform2D as a Pose2D, with theta in [-pi, pi].
+      /// </summary>
+      Pose2D toPose2D() const;
+
+    }; // end struct
+
+    /// <summary>
+    /// Compute the inverse of a Transform2D.
+    /// </summary>
+    /// <param name="pT"> the given Transform2D </param>
+    /// <param name="pTOut"> the inverse, may be pT </param>
+    /// \ingroup Types
+    void transform2DInverse(
+      const Transform2D& pT,
+      Transform2D&       pTOut);
+
+    /// <summary>
+    /// Compute the inverse of a Transform2D.
+    /// </summary>
+    /// <param name="pT"> the given Transform2D </param>
+    /// <returns> the inverse </returns>
+    /// \ingroup Types
+    Transform2D transform2DInverse(const Transform2D& pT);
+
+    /// <summary>
+    /// Normalize the cosinus and the sinus of a Transform2D, whose norm
+    /// drifts after many compositions.
+    /// </summary>
+    /// <param name="pT"> the Transform2D to normalize </param>
+    /// \ingroup Types
+    void transform2DNormalizeInPlace(Transform2D& pT);
+
+    /// <summary>
+    /// Compute a Transform2D from a Pose2D.
+    /// </summary>
+    /// <param name="pPose"> the given Pose2D </param>
+    /// <returns> the Transform2D </returns>
+    /// \ingroup Types
+    Transform2D transform2DFromPose2D(const Pose2D& pPose);
+
+    /// <summary>
+    /// Compute a Pose2D from a Transform2D, with theta in [-pi, pi].
+    /// </summary>
+    /// <param name="pT"> the given Transform2D </param>
+    /// <returns> the Pose2D </returns>
+    /// \ingroup Types
+    Pose2D pose2DFromTransform2D(const Transform2D& pT);
+
+    /// <summary>
+    /// Compose arrays of Transform2D: pResults[i] = pLeft[i]*pRight[i].
+    /// The results may be one of the operands.
+    /// </summary>
+    /// <param name="pLeft"> the left Transform2D </param>
+    /// <param name="pRight"> the right Transform2D </param>
+    /// <param name="pSize"> the number of Transform2D </param>
+    /// <param name="pResults"> the results </param>
+    /// \ingroup Types
+    void transform2DCompose(
+      const Transform2D*  pLeft,
+      const Transform2D*  pRight,
+      const unsigned int& pSize,
+      Transform2D*        pResults);
+
+    /// <summary>
+    /// Compose one Transform2D with an array: pResults[i] = pT*pRight[i].
+    /// The results may be the operands.
+    /// </summary>
+    /// <param name="pT"> the left Transform2D </param>
+    /// <param name="pRight"> the right Transform2D </param>
+    /// <param name="pSize"> the number of Transform2D </param>
+    /// <param name="pResults"> the results </param>
+    /// \ingroup Types
+    void transform2DCompose(
+      const Transform2D&  pT,
+      const Transform2D*  pRight,
+      const unsigned int& pSize,
+      Transform2D*        pResults);
+
+    /// <summary>
+    /// Apply a Transform2D to an array of Position2D.
+    /// The results may be the positions.
+    /// </summary>
+    /// <param name="pT"> the Transform2D </param>
+    /// <param name="pPositions"> the positions </param>
+    /// <param name="pSize"> the number of positions </param>
+    /// <param name="pResults"> the results </param>
+    /// \ingroup Types
+    void transform2DApply(
+      const Transform2D&  pT,
+      const Position2D*   pPositions,
+      const unsigned int& pSize,
+      Position2D*         pResults);
+
+  } // end namespace Math
+} // end namespace AL
+#endif  // _LIBALMATH_ALMATH_TYPES_ALTRANSFORM2D_H_
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// Benchmark of the expression templates.
+//
+// Evaluate typical control law expressions on arrays of values, with
+// the usual operators and with lazy(), and print the time per
+// expression and the speedup.
+//
+// usage: almath_bench_expression [number of values] [number of runs]
+
+#include <almath/tools/alexpression.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+  typedef std::chrono::steady_clock Clock;
+
+  using AL::Math::lazy;
+
+  // best time of the runs, in nanoseconds per value
+  template <class Function>
+  double measure(
+    const Function&     pFunction,
+    const unsigned int& pNbValues,
+    const unsigned int& pNbRuns)
+  {
+    double best = 0.0;
+    for (unsigned int r=0; r<pNbRuns; r++)
+    {
+      const Clock::time_point start = Clock::now();
+      pFunction();
+      const double time = std::chrono::duration<double, std::nano>(
+            Clock::now() - start).count()/pNbValues;
+      best = ((r == 0) || (time < best)) ? time : best;
+    }
+    return best;
+  }
+
+  void print(
+    const char*   pName,
+    const double& pOperators,
+    const double& pExpression)
+  {
+    std::printf("%-40s %12.2f %12.2f %10.2f\n",
+                pName, pOperators, pExpression, pOperators/pExpression);
+  }
+
+  template <class T>
+  std::vector<T> makeValues(
+    const unsigned int& pNbValues,
+    const float&        pOffset)
+  {
+    std::vector<T> values(pNbValues);
+    for (unsigned int i=0; i<pNbValues; i++)
+    {
+      float* data = reinterpret_cast<float*>(&values[i]);
+      for (unsigned int j=0; j<AL::Math::ExpressionTraits<T>::size; j++)
+      {
+        data[j] = pOffset + 0.001f*((i*7 + j*13) % 1000);
+      }
+    }
+    return values;
+  }
+}
+
+
+int main(int argc, char* argv[])
+{
+  const unsigned int nbValues = (argc > 1) ? std::atoi(argv[1]) : 100000;
+  const unsigned int nbRuns = (argc > 2) ? std::atoi(argv[2]) : 20;
+
+  std::printf("%u values, best of %u runs\n", nbValues, nbRuns);
+  std::printf("%-40s %12s %12s %10s\n", "expression", "operators ns", "lazy ns", "speedup");
+
+  // a + b*0.5 - c
+  {
+    const std::vector<AL::Math::Position3D> a = makeValues<AL::Math::Position3D>(nbValues, 0.0f);
+    const std::vector<AL::Math::Position3D> b = makeValues<AL::Math::Position3D>(nbValues, 1.0f);
+    const std::vector<AL::Math::Position3D> c = makeValues<AL::Math::Position3D>(nbValues, 2.0f);
+    std::vector<AL::Math::Position3D> r(nbValues);
+    const double operators = measure([&]()
+    {
+      for (unsigned int i=0; i<nbValues; i++)
+      {
+        r[i] = a[i] + b[i]*0.5f - c[i];
+      }
+    }, nbValues, nbRuns);
+    const double expression = measure([&]()
+    {
+      for (unsigned int i=0; i<nbValues; i++)
+      {
+        r[i] = lazy(a[i]) + lazy(b[i])*0.5f - c[i];
+      }
+    }, nbValues, nbRuns);
+    print("Position3D a + b*0.5 - c", operators, expression);
+  }
+
+  // PD law with feed forward: ff + (ref - meas)*kp - rate*kd
+  {
+    const std::vector<AL::Math::Velocity6D> ff = makeValues<AL::Math::Velocity6D>(nbValues, 0.0f);
+    const std::vector<AL::Math::Velocity6D> ref = makeValues<AL::Math::Velocity6D>(nbValues, 1.0f);
+    const std::vector<AL::Math::Velocity6D> meas = makeValues<AL::Math::Velocity6D>(nbValues, 2.0f);
+    const std::vector<AL::Math::Velocity6D> rate = makeValues<AL::Math::Velocity6D>(nbValues, 3.0f);
+    std::vector<AL::Math::Velocity6D> r(nbValues);
+    const float kp = 2.5f;
+    const float kd = 0.3f;
+    const double operators = measure([&]()
+    {
+      for (unsigned int i=0; i<nbValues; i++)
+      {
+        r[i] = ff[i] + (ref[i] - meas[i])*kp - rate[i]*kd;
+      }
+    }, nbValues, nbRuns);
+    const double expression = measure([&]()
+    {
+      for (unsigned int i=0; i<nbValues; i++)
+      {
+        r[i] = lazy(ff[i]) + (lazy(ref[i]) - meas[i])*kp - lazy(rate[i])*kd;
+      }
+    }, nbValues, nbRuns);
+    print("Velocity6D ff + (ref - meas)*kp - rate*kd", operators, expression);
+  }
+
+  // error integration: sum + (target - current)*dt
+  {
+    const std::vector<AL::Math::Position6D> target = makeValues<AL::Math::Position6D>(nbValues, 0.0f);
+    const std::vector<AL::Math::Position6D> current = makeValues<AL::Math::Position6D>(nbValues, 1.0f);
+    std::vector<AL::Math::Position6D> sum = makeValues<AL::Math::Position6D>(nbValues, 2.0f);
+    const float dt = 0.01f;
+    const double operators = measure([&]()
+    {
+      for (unsigned int i=0; i<nbValues; i++)
+      {
+        sum[i] = sum[i] + (target[i] - current[i])*dt;
+      }
+    }, nbValues, nbRuns);
+    const double expression = measure([&]()
+    {
+      for (unsigned int i=0; i<nbValues; i++)
+      {
+        (lazy(sum[i]) + (lazy(target[i]) - current[i])*dt).evaluate(sum[i]);
+      }
+    }, nbValues, nbRuns);
+    print("Position6D sum + (target - current)*dt", operators, expression);
+  }
+
+  // linear interpolation: p0 + (p1 - p0)*t
+  {
+    const std::vector<AL::Math::Pose2D> p0 = makeValues<AL::Math::Pose2D>(nbValues, 0.0f);
+    const std::vector<AL::Math::Pose2D> p1 = makeValues<AL::Math::Pose2D>(nbValues, 1.0f);
+    std::vector<AL::Math::Pose2D> r(nbValues);
+    const double operators = measure([&]()
+    {
+      for (unsigned int i=0; i<nbValues; i++)
+      {
+        r[i] = p0[i] + (p1[i] - p0[i])*0.25f;
+      }
+    }, nbValues, nbRuns);
+    const double expression = measure([&]()
+    {
+      for (unsigned int i=0; i<nbValues; i++)
+      {
+        r[i] = lazy(p0[i]) + (lazy(p1[i]) - p0[i])*0.25f;
+      }
+    }, nbValues, nbRuns);
+    print("Pose2D p0 + (p1 - p0)*t", operators, expression);
+  }
+  return 0;
+}
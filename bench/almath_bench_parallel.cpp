@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// Scaling benchmark of the thread pool.
+//
+// Evaluate a grid of footstep candidates with evaluateFootCandidates,
+// with 1 to N threads, and print the time and the speedup against the
+// sequential version.
+//
+// usage: almath_bench_parallel [number of candidates] [number of runs]
+
+#include <almath/tools/althreadpool.h>
+#include <almath/tools/avoidfootcollision.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+  typedef std::chrono::steady_clock Clock;
+
+  AL::Math::FootBox makeFoot(const float& pSide)
+  {
+    AL::Math::FootBox foot;
+    foot.vertices[0] = AL::Math::Position2D( 0.080f,  0.038f + 0.012f*pSide);
+    foot.vertices[1] = AL::Math::Position2D( 0.080f, -0.050f + 0.012f*pSide);
+    foot.vertices[2] = AL::Math::Position2D(-0.047f, -0.050f + 0.012f*pSide);
+    foot.vertices[3] = AL::Math::Position2D(-0.047f,  0.038f + 0.012f*pSide);
+    foot.update();
+    return foot;
+  }
+}
+
+
+int main(int argc, char* argv[])
+{
+  const unsigned int nbCandidates = (argc > 1) ? std::atoi(argv[1]) : 200000;
+  const unsigned int nbRuns = (argc > 2) ? std::atoi(argv[2]) : 5;
+
+  const AL::Math::FootBox support = makeFoot(0.0f);
+  const AL::Math::FootBox swing = makeFoot(1.0f);
+  std::vector<AL::Math::Pose2D> candidates;
+  for (unsigned int i=0; i<nbCandidates; i++)
+  {
+    // many candidates near the support foot, to run the collision tests
+    candidates.push_back(AL::Math::Pose2D(0.00001f*(i % 20000) - 0.1f,
+                                          0.0001f*(i % 1500),
+                                          0.001f*(i % 1000) - 0.5f));
+  }
+  std::vector<AL::Math::Pose2D> moves;
+  std::vector<bool> collisions;
+
+  double sequential = 0.0;
+  std::printf("%u candidates, best of %u runs\n", nbCandidates, nbRuns);
+  std::printf("%8s %12s %10s\n", "threads", "time ms", "speedup");
+  const unsigned int maxThreads = AL::Math::ThreadPool::getDefaultNbWorkers() + 1;
+  for (unsigned int nbThreads=1; nbThreads<=maxThreads; nbThreads++)
+  {
+    AL::Math::ThreadPool pool(nbThreads - 1, true);
+    const AL::Math::ExecutionPolicy policy(pool);
+    double best = 0.0;
+    for (unsigned int r=0; r<nbRuns; r++)
+    {
+      const Clock::time_point start = Clock::now();
+      AL::Math::evaluateFootCandidates(support, swing, 0.08f, 0.16f,
+                                       candidates, moves, collisions,
+                                       AL::Math::AVOID_FOOT_COLLISION_EXACT,
+                                       policy);
+      const double time = std::chrono::duration<double, std::milli>(
+            Clock::now() - start).count();
+      best = ((r == 0) || (time < best)) ? time : best;
+    }
+    if (nbThreads == 1)
+    {
+      sequential = best;
+    }
+    std::printf("%8u %12.2f %10.2f\n", nbThreads, best, sequential/best);
+  }
+  return 0;
+}
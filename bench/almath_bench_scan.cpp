@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// Scaling benchmark of the pose scans.
+//
+// Reconstruct a trajectory from relative Pose2D and Transform increments
+// with composeInclusiveScan, sequentially then with 1 to N threads, and
+// print the time and the speedup against the sequential scan.
+//
+// usage: almath_bench_scan [number of increments] [number of runs]
+
+#include <almath/tools/alposescan.h>
+#include <almath/tools/althreadpool.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+  typedef std::chrono::steady_clock Clock;
+
+  // best time of the runs, in milliseconds
+  template <class Function>
+  double measure(
+    const Function&     pFunction,
+    const unsigned int& pNbRuns)
+  {
+    double best = 0.0;
+    for (unsigned int r=0; r<pNbRuns; r++)
+    {
+      const Clock::time_point start = Clock::now();
+      pFunction();
+      const double time = std::chrono::duration<double, std::milli>(
+            Clock::now() - start).count();
+      best = ((r == 0) || (time < best)) ? time : best;
+    }
+    return best;
+  }
+
+  template <class T>
+  void run(
+    const char*           pName,
+    const std::vector<T>& pSteps,
+    const unsigned int&   pNbRuns)
+  {
+    const unsigned int size = static_cast<unsigned int>(pSteps.size());
+    std::vector<T> results(size);
+    const double sequential = measure([&]()
+    {
+      AL::Math::composeInclusiveScan(&pSteps[0], size, &results[0], 1000);
+    }, pNbRuns);
+    std::printf("%-10s %8s %12.2f %10.2f\n", pName, "seq", sequential, 1.0);
+
+    const unsigned int maxThreads = AL::Math::ThreadPool::getDefaultNbWorkers() + 1;
+    for (unsigned int nbThreads=1; nbThreads<=maxThreads; nbThreads++)
+    {
+      AL::Math::ThreadPool pool(nbThreads - 1, true);
+      const AL::Math::ExecutionPolicy policy(pool);
+      const double time = measure([&]()
+      {
+        AL::Math::composeInclusiveScan(&pSteps[0], size, &results[0], policy, 1000);
+      }, pNbRuns);
+      std::printf("%-10s %8u %12.2f %10.2f\n", pName, nbThreads, time, sequential/time);
+    }
+  }
+}
+
+
+int main(int argc, char* argv[])
+{
+  const unsigned int nbSteps = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+  const unsigned int nbRuns = (argc > 2) ? std::atoi(argv[2]) : 5;
+
+  std::vector<AL::Math::Pose2D> poses;
+  std::vector<AL::Math::Transform> transforms;
+  for (unsigned int i=0; i<nbSteps; i++)
+  {
+    poses.push_back(AL::Math::Pose2D(0.001f, 0.0001f*(i % 7), 0.0003f*(i % 5)));
+    transforms.push_back(AL::Math::Transform::fromPosition(
+                           0.001f, 0.0f, 0.0001f*(i % 7), 0.0f, 0.0001f, 0.0003f*(i % 5)));
+  }
+
+  std::printf("%u increments, best of %u runs\n", nbSteps, nbRuns);
+  std::printf("%-10s %8s %12s %10s\n", "type", "threads", "time ms", "speedup");
+  run("Pose2D", poses, nbRuns);
+  run("Transform", transforms, nbRuns);
+  return 0;
+}
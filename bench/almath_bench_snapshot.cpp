@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// Contention benchmark of Snapshot against a mutex.
+//
+// One writer publishes a Transform every period while N readers read it
+// in a loop. For each number of readers, it prints the reads per second
+// of all the readers and the worst time the writer spent to publish.
+//
+// usage: almath_bench_snapshot [duration per run in s] [writer period in us]
+
+#include <almath/tools/alsnapshot.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  typedef std::chrono::steady_clock Clock;
+
+  struct Result
+  {
+    double readsPerSecond;
+    double maxPublishMicroseconds;
+  };
+
+  // the state shared by the readers and the writer
+  class MutexState
+  {
+  public:
+    void publish(const AL::Math::Transform& pValue)
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fValue = pValue;
+    }
+
+    void read(AL::Math::Transform& pValue)
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      pValue = fValue;
+    }
+
+  private:
+    std::mutex fMutex;
+    AL::Math::Transform fValue;
+  };
+
+  class SnapshotState
+  {
+  public:
+    void publish(const AL::Math::Transform& pValue)
+    {
+      fSnapshot.publish(pValue);
+    }
+
+    void read(AL::Math::Transform& pValue)
+    {
+      fSnapshot.read(pValue);
+    }
+
+  private:
+    AL::Math::Snapshot<AL::Math::Transform> fSnapshot;
+  };
+
+  template <class State>
+  Result run(
+    const unsigned int& pNbReaders,
+    const double&       pDuration,
+    const unsigned int& pPeriod)
+  {
+    State state;
+    std::atomic<bool> done(false);
+    std::vector<unsigned long> nbReads(pNbReaders, 0);
+
+    std::vector<std::thread> readers;
+    for (unsigned int r=0; r<pNbReaders; r++)
+    {
+      readers.push_back(std::thread([&state, &done, &nbReads, r]()
+      {
+        AL::Math::Transform value;
+        unsigned long count = 0;
+        while (!done.load(std::memory_order_relaxed))
+        {
+          state.read(value);
+          ++count;
+        }
+        nbReads[r] = count;
+      }));
+    }
+
+    AL::Math::Transform value;
+    double maxPublish = 0.0;
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point end = start +
+        std::chrono::microseconds(static_cast<long>(pDuration*1e6));
+    Clock::time_point next = start;
+    unsigned int i = 0;
+    while (Clock::now() < end)
+    {
+      value.r1_c4 = static_cast<float>(i++);
+      const Clock::time_point before = Clock::now();
+      state.publish(value);
+      const double publish = std::chrono::duration<double, std::micro>(
+            Clock::now() - before).count();
+      maxPublish = (publish > maxPublish) ? publish : maxPublish;
+
+      next += std::chrono::microseconds(pPeriod);
+      while (Clock::now() < next)
+      {
+      }
+    }
+    done.store(true);
+
+    unsigned long total = 0;
+    for (unsigned int r=0; r<pNbReaders; r++)
+    {
+      readers[r].join();
+      total += nbReads[r];
+    }
+    const double elapsed =
+        std::chrono::duration<double>(Clock::now() - start).count();
+
+    Result result;
+    result.readsPerSecond = total/elapsed;
+    result.maxPublishMicroseconds = maxPublish;
+    return result;
+  }
+}
+
+
+int main(int argc, char* argv[])
+{
+  const double duration = (argc > 1) ? std::atof(argv[1]) : 1.0;
+  const unsigned int period = (argc > 2) ? std::atoi(argv[2]) : 1000;
+
+  std::printf("writer period: %u us, %g s per run\n", period, duration);
+  std::printf("%8s %18s %18s %18s %18s\n", "readers",
+              "mutex reads/s", "snapshot reads/s",
+              "mutex max pub us", "snapshot max pub us");
+  for (unsigned int nbReaders=1; nbReaders<=32; nbReaders*=2)
+  {
+    const Result mutex = run<MutexState>(nbReaders, duration, period);
+    const Result snapshot = run<SnapshotState>(nbReaders, duration, period);
+    std::printf("%8u %18.3g %18.3g %18.2f %18.2f\n", nbReaders,
+                mutex.readsPerSecond, snapshot.readsPerSecond,
+                mutex.maxPublishMicroseconds, snapshot.maxPublishMicroseconds);
+  }
+  return 0;
+}
@@ -33,11 +33,10 @@ namespace AL {
 
 
     /// <summary> Calculates the best tangent. </summary>
-    /// <param name="pTangents">    The tangent. </param>
-    /// <param name="pbestTangent"> The best tangent. </param>
-    void xComputeBestTangent(
-        const std::vector<std::vector<dubinsTangent> >& pTangents,
-        std::vector<dubinsTangent>&                     pBestTangent);
+    /// <param name="pTangents">    The four tangents. </param>
+    /// <returns> The index of the best tangent. </returns>
+    unsigned int xComputeBestTangent(
+        const dubinsTangent pTangents[4][2]);
 
 
     /// <summary> Calculates the tangent. </summary>
@@ -53,7 +52,7 @@ namespace AL {
         const int&                  pSens,
         const float&                pCircleRadius,
         const bool&                 pLLorRR,
-        std::vector<dubinsTangent>& pTangent);
+        dubinsTangent               pTangent[2]);
 
 
     /// <summary> Gets the tangents. </summary>
@@ -61,9 +60,9 @@ namespace AL {
     /// <param name="pCircleRadius">  The circle radius. </param>
     /// <param name="pCircleRadius">  The tangents. </param>
     void xGetTangents(
-        const std::vector<AL::Math::Position2D>&  pCircles,
-        const float&                              pCircleRadius,
-        std::vector<std::vector<dubinsTangent> >& pTangents);
+        const AL::Math::Position2D pCircles[4],
+        const float&               pCircleRadius,
+        dubinsTangent              pTangents[4][2]);
 
 
     /// <summary> Calculates the circles. </summary>
@@ -71,44 +70,32 @@ namespace AL {
     /// <param name="pCircleRadius"> The circle radius. </param>
     /// <param name="pCircles">      The calculated circles. </param>
     void xGetCircles(
-        const AL::Math::Pose2D&            pPose,
-        const float&                       pCircleRadius,
-        std::vector<AL::Math::Position2D>& pCircles);
+        const AL::Math::Pose2D& pPose,
+        const float&            pCircleRadius,
+        AL::Math::Position2D    pCircles[4]);
 
-    void xComputeBestTangent(
-        const std::vector<std::vector<dubinsTangent> >& pTangents,
-        std::vector<dubinsTangent>&                     pBestTangent)
+    unsigned int xComputeBestTangent(
+        const dubinsTangent pTangents[4][2])
     {
-
-      if (pTangents.size() != 4)
-      {
-        throw std::invalid_argument("ALDubinsCurve: computeBestTangent Input Tangent must be size 4.");
-      }
-
-      if (pBestTangent.size() != 2)
-      {
-        throw std::invalid_argument(
-            "ALDubinsCurve: computeBestTangent "
-            "Input Best Tangent must be size 2.");
-      }
-
       float shortestTangent = FLT_MAX;
       float tangentLength;
+      unsigned int bestTangent = 0;
 
       for (unsigned int i=0; i<4; i++)
       {
         tangentLength = (
-            (pTangents.at(i).at(0).x - pTangents.at(i).at(1).x) *
-            (pTangents.at(i).at(0).x - pTangents.at(i).at(1).x) +
-            (pTangents.at(i).at(0).y - pTangents.at(i).at(1).y) *
-            (pTangents.at(i).at(0).y - pTangents.at(i).at(1).y) );
+            (pTangents[i][0].x - pTangents[i][1].x) *
+            (pTangents[i][0].x - pTangents[i][1].x) +
+            (pTangents[i][0].y - pTangents[i][1].y) *
+            (pTangents[i][0].y - pTangents[i][1].y) );
 
         if (tangentLength < shortestTangent)
         {
           shortestTangent = tangentLength;
-          pBestTangent = pTangents.at(i);
+          bestTangent = i;
         }
       }
+      return bestTangent;
     }
 
 
@@ -118,15 +105,8 @@ namespace AL {
         const int&                  pSens,
         const float&                pCircleRadius,
         const bool&                 pLLorRR,
-        std::vector<dubinsTangent>& pTangent)
+        dubinsTangent               pTangent[2])
     {
-
-      if (pTangent.size() != 2)
-      {
-        throw std::invalid_argument(
-            "ALDubinsCurve: computeTangent Input must be size 2.");
-      }
-
       float dist; // distance between two center of circle
       float rd;
       float cos_theta;
@@ -170,197 +150,177 @@ namespace AL {
       }
 
       // tangent
-      pTangent.at(0) = point1;
-      pTangent.at(1) = point2;
+      pTangent[0] = point1;
+      pTangent[1] = point2;
 
     } // end computeTangent
 
 
     void xGetTangents(
-        const std::vector<AL::Math::Position2D>&   pCircles,
-        const float&                               pCircleRadius,
-        std::vector< std::vector<dubinsTangent> >& pTangents)
+        const AL::Math::Position2D pCircles[4],
+        const float&               pCircleRadius,
+        dubinsTangent              pTangents[4][2])
     {
-
-      if (pTangents.size() != 4)
-      {
-        throw std::invalid_argument(
-            "ALDubinsCurve: getTangents Input must be size 4.");
-      }
-
       /**
       * LSL
       */
       xComputeTangent(
-          pCircles.at(0),   // pCircle1
-          pCircles.at(2),   // pCircle2
+          pCircles[0],      // pCircle1
+          pCircles[2],      // pCircle2
           1,                // pSens
           pCircleRadius,    // pCircleRadius
           true,             // pLLorRR
-          pTangents.at(0));
-      pTangents.at(0).at(0).isLeft = true;
-      pTangents.at(0).at(1).isLeft = true;
+          pTangents[0]);
+      pTangents[0][0].isLeft = true;
+      pTangents[0][1].isLeft = true;
 
       /**
       * LSR
       */
       xComputeTangent(
-          pCircles.at(0),  // pCircle1
-          pCircles.at(3),  // pCircle2
+          pCircles[0],     // pCircle1
+          pCircles[3],     // pCircle2
           1,               // pSens
           pCircleRadius,   // pCircleRadius
           false,           // pLLorRR
-          pTangents.at(1));
-      pTangents.at(1).at(0).isLeft = true;
-      pTangents.at(1).at(1).isLeft = false;
+          pTangents[1]);
+      pTangents[1][0].isLeft = true;
+      pTangents[1][1].isLeft = false;
 
       /**
       * RSL
       */
       xComputeTangent(
-          pCircles.at(1),  // pCircle1
-          pCircles.at(2),  // pCircle2
+          pCircles[1],     // pCircle1
+          pCircles[2],     // pCircle2
           -1,              // pSens
           pCircleRadius,   // pCircleRadius
           false,           // pLLorRR
-          pTangents.at(2));
-      pTangents.at(2).at(0).isLeft = false;
-      pTangents.at(2).at(1).isLeft = true;
+          pTangents[2]);
+      pTangents[2][0].isLeft = false;
+      pTangents[2][1].isLeft = true;
 
       /**
       * RSR
       */
       xComputeTangent(
-          pCircles.at(1),  // pCircle1
-          pCircles.at(3),  // pCircle2
+          pCircles[1],     // pCircle1
+          pCircles[3],     // pCircle2
           -1,              // pSens
           pCircleRadius,   // pCircleRadius
           true,            // pLLorRR
-          pTangents.at(3));
-      pTangents.at(3).at(0).isLeft = false;
-      pTangents.at(3).at(1).isLeft = false;
+          pTangents[3]);
+      pTangents[3][0].isLeft = false;
+      pTangents[3][1].isLeft = false;
 
     } // end getTangents
 
 
     void xGetCircles(
-        const AL::Math::Pose2D&            pPose,
-        const float&                       pCircleRadius,
-        std::vector<AL::Math::Position2D>& pCircles)
+        const AL::Math::Pose2D& pPose,
+        const float&            pCircleRadius,
+        AL::Math::Position2D    pCircles[4])
     {
-
-      if (pCircles.size() != 4)
-      {
-        throw std::invalid_argument(
-            "ALDubinsCurve: getCircles Input must be size 4.");
-      }
-
-      AL::Math::Position2D tmpCircle;
-
       // Left Circle - init
-      tmpCircle.x = 0.0f;
-      tmpCircle.y = pCircleRadius;
-      pCircles.at(0) = tmpCircle;
+      pCircles[0].x = 0.0f;
+      pCircles[0].y = pCircleRadius;
 
       // Right Circle - init
-      tmpCircle.x = 0.0f;
-      tmpCircle.y = -pCircleRadius;
-      pCircles.at(1) = tmpCircle;
+      pCircles[1].x = 0.0f;
+      pCircles[1].y = -pCircleRadius;
 
       // Left Circle - Desired
-      tmpCircle.x = pPose.x - ( sin(pPose.theta)*pCircleRadius );
-      tmpCircle.y = pPose.y + ( cos(pPose.theta)*pCircleRadius );
-      pCircles.at(2) = tmpCircle;
+      pCircles[2].x = pPose.x - ( sin(pPose.theta)*pCircleRadius );
+      pCircles[2].y = pPose.y + ( cos(pPose.theta)*pCircleRadius );
 
       // Right Circle - Desired
-      tmpCircle.x = pPose.x + ( sin(pPose.theta)*pCircleRadius );
-      tmpCircle.y = pPose.y - ( cos(pPose.theta)*pCircleRadius );
-      pCircles.at(3) = tmpCircle;
+      pCircles[3].x = pPose.x + ( sin(pPose.theta)*pCircleRadius );
+      pCircles[3].y = pPose.y - ( cos(pPose.theta)*pCircleRadius );
     } // end getCircles
 
 
-    std::vector<AL::Math::Pose2D> getDubinsSolutions(
+    const MATH_STATUS tryGetDubinsSolutions(
         const AL::Math::Pose2D& pTargetPose,
-        const float             pCircleRadius)
+        const float             pCircleRadius,
+        AL::Math::Pose2D*       pSolutions,
+        const unsigned int&     pSize) ALMATH_NOEXCEPT
     {
+      if ((pSolutions == 0) || (pSize < 3))
+      {
+        return MATH_BUFFER_TOO_SMALL;
+      }
+
       // protection around small distance
       // in relation with circleRadius
       float dist = sqrt(pTargetPose.x*pTargetPose.x +
                         pTargetPose.y*pTargetPose.y );
       if(dist < 4.0f*pCircleRadius)
       {
-        throw std::invalid_argument(
-            "ALDubinsCurve: getDubinsSolutions pTargetPose.norm() < 4.0*pCircleRadius.");
+        return MATH_INVALID_ARGUMENT;
       }
 
-      std::vector<AL::Math::Pose2D> solutions;
-      AL::Math::Pose2D tmpSolution;
-
-      std::vector<AL::Math::Position2D> circles;
-      circles.resize(4);
+      AL::Math::Position2D circles[4];
       xGetCircles(pTargetPose, pCircleRadius, circles);
 
-      std::vector<dubinsTangent> tmpDubins;
-      tmpDubins.resize(2);
-      std::vector<std::vector<dubinsTangent> > tangents;
-      tangents.resize(4);
-      for (unsigned int i=0; i<4; i++)
-      {
-        tangents.at(i) = tmpDubins;
-      }
+      dubinsTangent tangents[4][2];
       xGetTangents(circles, pCircleRadius, tangents);
 
-      std::vector<dubinsTangent> bestTangent;
-      bestTangent.resize(2);
-
-      xComputeBestTangent(tangents, bestTangent);
+      const dubinsTangent* bestTangent = tangents[xComputeBestTangent(tangents)];
 
       //// First CheckPoint of this Dubins Curve
-      tmpSolution.x = bestTangent.at(0).x;
-      tmpSolution.y = bestTangent.at(0).y;
-      tmpSolution.theta = atan2(bestTangent.at(1).y - bestTangent.at(0).y,
-                                bestTangent.at(1).x - bestTangent.at(0).x);
-      solutions.push_back(tmpSolution);
+      pSolutions[0].x = bestTangent[0].x;
+      pSolutions[0].y = bestTangent[0].y;
+      pSolutions[0].theta = atan2(bestTangent[1].y - bestTangent[0].y,
+                                  bestTangent[1].x - bestTangent[0].x);
 
       //// Second CheckPoint of this Dubins Curve
-      tmpSolution.x = bestTangent.at(1).x;
-      tmpSolution.y = bestTangent.at(1).y;
+      pSolutions[1].x = bestTangent[1].x;
+      pSolutions[1].y = bestTangent[1].y;
       // theta is equivalent in first and second checkPoint
-      solutions.push_back(tmpSolution);
+      pSolutions[1].theta = pSolutions[0].theta;
 
       /// Last CheckPoint is targetPose
-      solutions.push_back(pTargetPose);
+      pSolutions[2] = pTargetPose;
 
       /**********************************
       Check Solution (angle rotation)
       *********************************/
-      AL::Math::Pose2D newSolutions;
-      AL::Math::Pose2D newSolutionsLast;
-      bool findNewSolutionFirst = false;
-      bool findNewSolutionLast  = false;
-
       // first test is angle of rotation find with atan2 is in the good sens
       // first tangent
-      float angle1 = solutions.at(0).theta;
-      if (bestTangent.at(0).isLeft && angle1 < 0.0f)
+      float angle1 = pSolutions[0].theta;
+      if (bestTangent[0].isLeft && angle1 < 0.0f)
       {
-        solutions.at(0).theta = 2.0f * PI + angle1;
+        pSolutions[0].theta = 2.0f * PI + angle1;
       }
-      if (!bestTangent.at(0).isLeft && angle1 > 0.0f)
+      if (!bestTangent[0].isLeft && angle1 > 0.0f)
       {
-        solutions.at(0).theta = 2.0f * PI + angle1;
+        pSolutions[0].theta = 2.0f * PI + angle1;
       }
       // second tangent
-      float angle2 = solutions.at(2).theta - solutions.at(1).theta;
-      if (bestTangent.at(1).isLeft && angle2 < 0.0f)
+      float angle2 = pSolutions[2].theta - pSolutions[1].theta;
+      if (bestTangent[1].isLeft && angle2 < 0.0f)
       {
-        solutions.at(1).theta = 2.0f * PI - angle2 + solutions.at(2).theta;
+        pSolutions[1].theta = 2.0f * PI - angle2 + pSolutions[2].theta;
       }
-      if (!bestTangent.at(1).isLeft && angle2 > 0.0f)
+      if (!bestTangent[1].isLeft && angle2 > 0.0f)
       {
-        solutions.at(1).theta = 2.0f * PI - angle2 + solutions.at(2).theta;
+        pSolutions[1].theta = 2.0f * PI - angle2 + pSolutions[2].theta;
+      }
+      return MATH_OK;
+    } // end tryGetDubinsSolutions
+
+
+    std::vector<AL::Math::Pose2D> getDubinsSolutions(
+        const AL::Math::Pose2D& pTargetPose,
+        const float             pCircleRadius)
+    {
+      AL::Math::Pose2D solutions[3];
+      if (tryGetDubinsSolutions(pTargetPose, pCircleRadius, solutions, 3) != MATH_OK)
+      {
+        throw std::invalid_argument(
+            "ALDubinsCurve: getDubinsSolutions pTargetPose.norm() < 4.0*pCircleRadius.");
       }
-      return solutions;
+      return std::vector<AL::Math::Pose2D>(solutions, solutions + 3);
     } // end getDubinsSolutions
   }
 }
@@ -0,0 +1,528 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alfootstepplanner.h>
+#include <almath/tools/avoidfootcollision.h>
+#include <almath/tools/altrigonometry.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+
+namespace AL
+{
+  namespace Math
+  {
+    /****************************
+    PRIVATE FUNCTION
+    ****************************/
+    // <summary> Wrap an angle in ]-pi, pi]. </summary>
+    // <param name="pAngle"> the angle in radian. </param>
+    // <returns> the wrapped angle. </returns>
+    float xWrapAngle(const float& pAngle);
+
+    // weight decrease between two searches of the anytime mode
+    static const float FOOTSTEP_PLANNER_WEIGHT_STEP = 0.5f;
+
+    float xWrapAngle(const float& pAngle)
+    {
+      float angle = fmodf(pAngle + PI, 2.0f*PI);
+      if (angle <= 0.0f)
+      {
+        angle += 2.0f*PI;
+      }
+      return angle - PI;
+    }
+
+    /****************************
+    PUBLIC FUNCTION
+    ****************************/
+    Footstep::Footstep() :
+      pose(),
+      move(),
+      isLeft(false) {}
+
+
+    bool FootstepPlanner::StateKey::operator< (const StateKey& pKey) const
+    {
+      if (x != pKey.x)
+      {
+        return x < pKey.x;
+      }
+      if (y != pKey.y)
+      {
+        return y < pKey.y;
+      }
+      if (theta != pKey.theta)
+      {
+        return theta < pKey.theta;
+      }
+      return isLeft < pKey.isLeft;
+    }
+
+
+    FootstepPlanner::FootstepPlanner(
+      const std::vector<Pose2D>& pLFootBoundingBox,
+      const std::vector<Pose2D>& pRFootBoundingBox,
+      const float&               pMaxFootX,
+      const float&               pMaxFootY,
+      const float&               pFootSeparation,
+      const std::vector<Pose2D>& pActions) :
+      fLFootBoundingBox(pLFootBoundingBox),
+      fRFootBoundingBox(pRFootBoundingBox),
+      fMaxFootX(fabsf(pMaxFootX)),
+      fMaxFootY(fabsf(pMaxFootY)),
+      fFootSeparation(pFootSeparation),
+      fActions(pActions),
+      fMaxStepTheta(0.0f),
+      fObstacles(),
+      fPositionResolution(0.01f),
+      fAngleResolution(0.1f),
+      fPositionTolerance(0.04f),
+      fAngleTolerance(0.15f),
+      fMaxExpansions(20000),
+      fStates(),
+      fStateIndex(),
+      fOpen(),
+      fLFootGoal(),
+      fRFootGoal(),
+      fStartSwingFoot(),
+      fGoalState(-1),
+      fWeight(1.0f),
+      fNbExpansions(0)
+    {
+      for (unsigned int i=0; i<fActions.size(); i++)
+      {
+        fMaxStepTheta = std::max(fMaxStepTheta, fabsf(fActions[i].theta));
+      }
+    }
+
+
+    void FootstepPlanner::setObstacles(
+      const std::vector<std::vector<Pose2D> >& pObstacles)
+    {
+      fObstacles = PolygonBroadPhase();
+      std::vector<Position2D> polygon;
+      for (unsigned int i=0; i<pObstacles.size(); i++)
+      {
+        if (pObstacles[i].empty())
+        {
+          continue;
+        }
+        polygon.resize(pObstacles[i].size());
+        for (unsigned int j=0; j<pObstacles[i].size(); j++)
+        {
+          polygon[j] = Position2D(pObstacles[i][j].x, pObstacles[i][j].y);
+        }
+        fObstacles.insert(polygon);
+      }
+    }
+
+
+    void FootstepPlanner::setResolution(
+      const float& pPositionResolution,
+      const float& pAngleResolution)
+    {
+      fPositionResolution = pPositionResolution;
+      fAngleResolution = pAngleResolution;
+    }
+
+
+    void FootstepPlanner::setGoalTolerance(
+      const float& pPositionTolerance,
+      const float& pAngleTolerance)
+    {
+      fPositionTolerance = pPositionTolerance;
+      fAngleTolerance = pAngleTolerance;
+    }
+
+
+    void FootstepPlanner::setMaxExpansions(const unsigned int& pMaxExpansions)
+    {
+      fMaxExpansions = pMaxExpansions;
+    }
+
+
+    const bool FootstepPlanner::plan(
+      const Pose2D&          pLFoot,
+      const Pose2D&          pRFoot,
+      const bool&            pIsLeftSupport,
+      const Pose2D&          pGoal,
+      std::vector<Footstep>& pFootsteps)
+    {
+      return xPlan(pLFoot, pRFoot, pIsLeftSupport, pGoal, 0.0f, 1.0f,
+                   pFootsteps);
+    }
+
+
+    const bool FootstepPlanner::planAnytime(
+      const Pose2D&          pLFoot,
+      const Pose2D&          pRFoot,
+      const bool&            pIsLeftSupport,
+      const Pose2D&          pGoal,
+      const float&           pTimeBudget,
+      const float&           pInitialWeight,
+      std::vector<Footstep>& pFootsteps)
+    {
+      return xPlan(pLFoot, pRFoot, pIsLeftSupport, pGoal, pTimeBudget,
+                   pInitialWeight, pFootsteps);
+    }
+
+
+    float FootstepPlanner::getWeight() const
+    {
+      return fWeight;
+    }
+
+
+    unsigned int FootstepPlanner::getNbExpansions() const
+    {
+      return fNbExpansions;
+    }
+
+
+    const bool FootstepPlanner::xPlan(
+      const Pose2D&          pLFoot,
+      const Pose2D&          pRFoot,
+      const bool&            pIsLeftSupport,
+      const Pose2D&          pGoal,
+      const float&           pTimeBudget,
+      const float&           pInitialWeight,
+      std::vector<Footstep>& pFootsteps)
+    {
+      const bool hasDeadline = (pTimeBudget > 0.0f);
+      // wall clock, not std::clock: the budget of a planner called by a
+      // control loop is a duration, whatever the load of the process
+      const std::chrono::steady_clock::time_point deadline =
+          std::chrono::steady_clock::now() +
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float>(std::max(0.0f, pTimeBudget)));
+
+      fStates.clear();
+      fStateIndex.clear();
+      fOpen.clear();
+      fGoalState = -1;
+      fNbExpansions = 0;
+      fWeight = std::max(1.0f, pInitialWeight);
+
+      fLFootGoal = pGoal*Pose2D(0.0f, 0.5f*fFootSeparation, 0.0f);
+      fRFootGoal = pGoal*Pose2D(0.0f, -0.5f*fFootSeparation, 0.0f);
+      fStartSwingFoot = pIsLeftSupport ? pRFoot : pLFoot;
+
+      const unsigned int start = xGetState(
+        pIsLeftSupport ? pLFoot : pRFoot, pIsLeftSupport);
+      fStates[start].g = 0.0f;
+      if (xIsGoal(start))
+      {
+        fGoalState = static_cast<int>(start);
+      }
+      fOpen.push_back(std::make_pair(fWeight*fStates[start].h, start));
+
+      bool isBoundReached = xImprovePath(fWeight, deadline, hasDeadline);
+      float weight = fWeight;
+      while (isBoundReached &&
+             (fWeight > 1.0f) &&
+             (!hasDeadline || (std::chrono::steady_clock::now() < deadline)))
+      {
+        fWeight = std::max(1.0f, fWeight - FOOTSTEP_PLANNER_WEIGHT_STEP);
+
+        // the open and the inconsistent states are searched again with
+        // the new weight, the successors already computed are kept
+        fOpen.clear();
+        for (unsigned int i=0; i<fStates.size(); i++)
+        {
+          State& state = fStates[i];
+          if ((!state.isClosed && (state.g < FLT_MAX)) || state.isInconsistent)
+          {
+            fOpen.push_back(std::make_pair(state.g + fWeight*state.h, i));
+          }
+          state.isClosed = false;
+          state.isInconsistent = false;
+        }
+        std::make_heap(fOpen.begin(), fOpen.end(),
+                       std::greater<std::pair<float, unsigned int> >());
+
+        isBoundReached = xImprovePath(fWeight, deadline, hasDeadline);
+        if (isBoundReached)
+        {
+          weight = fWeight;
+        }
+      }
+      fWeight = weight;
+
+      pFootsteps.clear();
+      if (fGoalState < 0)
+      {
+        return false;
+      }
+
+      for (int i=fGoalState; fStates[i].parent >= 0; i=fStates[i].parent)
+      {
+        Footstep footstep;
+        footstep.move = fStates[i].move;
+        footstep.isLeft = fStates[i].isLeft;
+        pFootsteps.push_back(footstep);
+      }
+      std::reverse(pFootsteps.begin(), pFootsteps.end());
+
+      // replay the moves from the start
+      Pose2D support = fStates[start].pose;
+      for (unsigned int i=0; i<pFootsteps.size(); i++)
+      {
+        support = support*pFootsteps[i].move;
+        support.theta = xWrapAngle(support.theta);
+        pFootsteps[i].pose = support;
+      }
+      return true;
+    }
+
+
+    const bool FootstepPlanner::xImprovePath(
+      const float&                                 pWeight,
+      const std::chrono::steady_clock::time_point& pDeadline,
+      const bool&                                  pHasDeadline)
+    {
+      const std::greater<std::pair<float, unsigned int> > comp;
+      while (!fOpen.empty())
+      {
+        const float f = fOpen.front().first;
+        const unsigned int current = fOpen.front().second;
+
+        // skip the outdated entries of the heap
+        if (fStates[current].isClosed ||
+            (f != fStates[current].g + pWeight*fStates[current].h))
+        {
+          std::pop_heap(fOpen.begin(), fOpen.end(), comp);
+          fOpen.pop_back();
+          continue;
+        }
+
+        if ((fGoalState >= 0) && (fStates[fGoalState].g <= f))
+        {
+          return true;
+        }
+
+        if ((fNbExpansions >= fMaxExpansions) ||
+            (pHasDeadline && (std::chrono::steady_clock::now() >= pDeadline)))
+        {
+          return false;
+        }
+
+        std::pop_heap(fOpen.begin(), fOpen.end(), comp);
+        fOpen.pop_back();
+        fStates[current].isClosed = true;
+        ++fNbExpansions;
+        xExpand(current);
+
+        const float g = fStates[current].g + 1.0f;
+        for (unsigned int i=0; i<fStates[current].successors.size(); i++)
+        {
+          const Successor& successor = fStates[current].successors[i];
+          State& next = fStates[successor.state];
+          if (g >= next.g)
+          {
+            continue;
+          }
+          // the pose of a state is the one reached from its best parent,
+          // so that the moves of the returned sequence are exact
+          next.g = g;
+          next.parent = static_cast<int>(current);
+          next.move = successor.move;
+          next.pose = fStates[current].pose*successor.move;
+          next.pose.theta = xWrapAngle(next.pose.theta);
+
+          // the parent gives the pose of the other foot
+          if (xIsGoal(successor.state))
+          {
+            if ((fGoalState < 0) || (g < fStates[fGoalState].g))
+            {
+              fGoalState = static_cast<int>(successor.state);
+            }
+          }
+          else if (fGoalState == static_cast<int>(successor.state))
+          {
+            fGoalState = -1;
+          }
+
+          if (!next.isClosed)
+          {
+            fOpen.push_back(std::make_pair(g + pWeight*next.h,
+                                           successor.state));
+            std::push_heap(fOpen.begin(), fOpen.end(), comp);
+          }
+          else
+          {
+            next.isInconsistent = true;
+          }
+        }
+      }
+      return (fGoalState >= 0);
+    }
+
+
+    void FootstepPlanner::xExpand(const unsigned int& pState)
+    {
+      if (fStates[pState].isExpanded)
+      {
+        return;
+      }
+
+      // copies, fStates can be reallocated by xGetState
+      const Pose2D support = fStates[pState].pose;
+      const bool isLeftSupport = fStates[pState].isLeft;
+
+      std::vector<Successor> successors;
+      successors.reserve(fActions.size());
+      for (unsigned int i=0; i<fActions.size(); i++)
+      {
+        Pose2D action = fActions[i];
+        clipFootWithEllipse(fMaxFootX, fMaxFootY, action);
+
+        Successor successor;
+        if (isLeftSupport)
+        {
+          successor.move = Pose2D(action.x,
+                                  -fFootSeparation - action.y,
+                                  -action.theta);
+        }
+        else
+        {
+          successor.move = Pose2D(action.x,
+                                  fFootSeparation + action.y,
+                                  action.theta);
+        }
+        avoidFootCollision(fLFootBoundingBox, fRFootBoundingBox,
+                           isLeftSupport, successor.move,
+                           AVOID_FOOT_COLLISION_EXACT);
+
+        Pose2D pose = support*successor.move;
+        pose.theta = xWrapAngle(pose.theta);
+        if (xIsInCollisionWithObstacles(pose, !isLeftSupport))
+        {
+          continue;
+        }
+
+        successor.state = xGetState(pose, !isLeftSupport);
+        bool isDuplicate = false;
+        for (unsigned int j=0; j<successors.size(); j++)
+        {
+          if (successors[j].state == successor.state)
+          {
+            isDuplicate = true;
+            break;
+          }
+        }
+        if (!isDuplicate && (successor.state != pState))
+        {
+          successors.push_back(successor);
+        }
+      }
+
+      fStates[pState].successors.swap(successors);
+      fStates[pState].isExpanded = true;
+    }
+
+
+    unsigned int FootstepPlanner::xGetState(
+      const Pose2D& pPose,
+      const bool&   pIsLeft)
+    {
+      StateKey key;
+      key.x = static_cast<int>(floorf(pPose.x/fPositionResolution + 0.5f));
+      key.y = static_cast<int>(floorf(pPose.y/fPositionResolution + 0.5f));
+      key.theta = static_cast<int>(floorf(pPose.theta/fAngleResolution + 0.5f));
+      key.isLeft = pIsLeft;
+
+      std::map<StateKey, unsigned int>::const_iterator it =
+          fStateIndex.find(key);
+      if (it != fStateIndex.end())
+      {
+        return it->second;
+      }
+
+      State state;
+      state.pose = pPose;
+      state.isLeft = pIsLeft;
+      state.g = FLT_MAX;
+      state.h = xHeuristic(pPose, pIsLeft);
+      state.parent = -1;
+      state.isExpanded = false;
+      state.isClosed = false;
+      state.isInconsistent = false;
+      fStates.push_back(state);
+
+      const unsigned int index = fStates.size() - 1;
+      fStateIndex[key] = index;
+      return index;
+    }
+
+
+    const bool FootstepPlanner::xIsGoal(const unsigned int& pState) const
+    {
+      const State& state = fStates[pState];
+      const Pose2D& otherFoot = (state.parent >= 0) ?
+            fStates[state.parent].pose : fStartSwingFoot;
+      const Pose2D& goal = state.isLeft ? fLFootGoal : fRFootGoal;
+      const Pose2D& otherGoal = state.isLeft ? fRFootGoal : fLFootGoal;
+
+      const float tolerance2 = fPositionTolerance*fPositionTolerance;
+      return (state.pose.distanceSquared(goal) <= tolerance2) &&
+          (otherFoot.distanceSquared(otherGoal) <= tolerance2) &&
+          (fabsf(xWrapAngle(state.pose.theta - goal.theta)) <= fAngleTolerance) &&
+          (fabsf(xWrapAngle(otherFoot.theta - otherGoal.theta)) <= fAngleTolerance);
+    }
+
+
+    float FootstepPlanner::xHeuristic(
+      const Pose2D& pPose,
+      const bool&   pIsLeft) const
+    {
+      // number of steps needed if each step moves the feet of the
+      // maximal step length or angle
+      const Pose2D& goal = pIsLeft ? fLFootGoal : fRFootGoal;
+      float h = 0.0f;
+      // the actions are clipped to the ellipse of axes fMaxFootX and
+      // fMaxFootY: dividing by fMaxFootX only overestimates the lateral
+      // moves, and plan() would not return the optimal sequence
+      const float maxFootStep = std::max(fMaxFootX, fMaxFootY);
+      if (maxFootStep > 0.0f)
+      {
+        h = pPose.distance(goal)/maxFootStep;
+      }
+      if (fMaxStepTheta > 0.0f)
+      {
+        h = std::max(h,
+                     fabsf(xWrapAngle(pPose.theta - goal.theta))/fMaxStepTheta);
+      }
+      return h;
+    }
+
+
+    const bool FootstepPlanner::xIsInCollisionWithObstacles(
+      const Pose2D& pPose,
+      const bool&   pIsLeft) const
+    {
+      if (fObstacles.size() == 0)
+      {
+        return false;
+      }
+
+      const std::vector<Pose2D>& footBox =
+          pIsLeft ? fLFootBoundingBox : fRFootBoundingBox;
+      std::vector<Position2D> foot(footBox.size());
+      for (unsigned int i=0; i<footBox.size(); i++)
+      {
+        const Pose2D vertex = pPose*footBox[i];
+        foot[i] = Position2D(vertex.x, vertex.y);
+      }
+
+      std::vector<int> collisions;
+      fObstacles.queryCollisions(foot, collisions);
+      return !collisions.empty();
+    }
+
+  } // namespace Math
+} // namespace AL
@@ -0,0 +1,649 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alliegroup.h>
+#include <almath/tools/altransformhelpers.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace AL {
+  namespace Math {
+
+    /****************************
+    PRIVATE FUNCTION
+    ****************************/
+    // <summary> Under this angle, the coefficients of exp and of the
+    //  jacobians are computed by their Taylor series. </summary>
+    static const double xLieSmallAngle = 1.0e-2;
+
+    // <summary> Coefficients of SO(3) and SE(2):
+    //  pA = sin(t)/t, pB = (1 - cos(t))/t^2, pC = (t - sin(t))/t^3. </summary>
+    void xLieCoefficients(
+      const double& pTheta,
+      double&       pA,
+      double&       pB,
+      double&       pC)
+    {
+      const double theta2 = pTheta*pTheta;
+      if (std::fabs(pTheta) < xLieSmallAngle)
+      {
+        pA = 1.0 - theta2/6.0;
+        pB = 0.5 - theta2/24.0;
+        pC = 1.0/6.0 - theta2/120.0;
+        return;
+      }
+      const double s = std::sin(pTheta);
+      const double c = std::cos(pTheta);
+      pA = s/pTheta;
+      pB = (1.0 - c)/theta2;
+      pC = (pTheta - s)/(theta2*pTheta);
+    }
+
+    // <summary> Skew matrix of a vector, row major. </summary>
+    void xLieSkew(
+      const double* pV,
+      double*       pK)
+    {
+      pK[0] = 0.0;    pK[1] = -pV[2]; pK[2] = pV[1];
+      pK[3] = pV[2];  pK[4] = 0.0;    pK[5] = -pV[0];
+      pK[6] = -pV[1]; pK[7] = pV[0];  pK[8] = 0.0;
+    }
+
+    // <summary> Product of 3x3 matrices, row major. </summary>
+    void xLieMultiply3(
+      const double* pA,
+      const double* pB,
+      double*       pC)
+    {
+      for (unsigned int i=0; i<3; i++)
+      {
+        for (unsigned int j=0; j<3; j++)
+        {
+          pC[3*i + j] = pA[3*i]*pB[j] + pA[3*i + 1]*pB[3 + j] + pA[3*i + 2]*pB[6 + j];
+        }
+      }
+    }
+
+    // <summary> I + pAlpha*K + pBeta*K^2, with K the skew matrix of
+    //  pW: the exponential of SO(3), and its jacobians. </summary>
+    void xLieSO3Series(
+      const double* pW,
+      const double& pAlpha,
+      const double& pBeta,
+      double*       pR)
+    {
+      double k[9];
+      double k2[9];
+      xLieSkew(pW, k);
+      xLieMultiply3(k, k, k2);
+      for (unsigned int i=0; i<9; i++)
+      {
+        pR[i] = pAlpha*k[i] + pBeta*k2[i];
+      }
+      pR[0] += 1.0;
+      pR[4] += 1.0;
+      pR[8] += 1.0;
+    }
+
+    // <summary> Left jacobian of SO(3), row major. </summary>
+    void xLieSO3LeftJacobian(
+      const double* pW,
+      double*       pJ)
+    {
+      const double theta = std::sqrt(pW[0]*pW[0] + pW[1]*pW[1] + pW[2]*pW[2]);
+      double a, b, c;
+      xLieCoefficients(theta, a, b, c);
+      xLieSO3Series(pW, b, c, pJ);
+    }
+
+    // <summary> Rotation vector of a rotation matrix, row major. </summary>
+    void xLieSO3Log(
+      const double* pR,
+      double*       pW)
+    {
+      double v[3];
+      v[0] = 0.5*(pR[7] - pR[5]);
+      v[1] = 0.5*(pR[2] - pR[6]);
+      v[2] = 0.5*(pR[3] - pR[1]);
+      const double sinTheta = std::sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+      double cosTheta = 0.5*(pR[0] + pR[4] + pR[8] - 1.0);
+      cosTheta = std::max(-1.0, std::min(1.0, cosTheta));
+      const double theta = std::atan2(sinTheta, cosTheta);
+
+      if (cosTheta >= 0.0)
+      {
+        const double ratio = (theta < xLieSmallAngle) ?
+              1.0 + theta*theta/6.0 : theta/sinTheta;
+        pW[0] = ratio*v[0];
+        pW[1] = ratio*v[1];
+        pW[2] = ratio*v[2];
+        return;
+      }
+
+      // near pi, the axis comes from the symmetric part:
+      // (R + R^T)/2 = cos(t)*I + (1 - cos(t))*a*a^T
+      unsigned int k = 0;
+      if (pR[4] > pR[3*k + k])
+      {
+        k = 1;
+      }
+      if (pR[8] > pR[3*k + k])
+      {
+        k = 2;
+      }
+      double axis[3];
+      for (unsigned int i=0; i<3; i++)
+      {
+        axis[i] = 0.5*(pR[3*i + k] + pR[3*k + i]);
+      }
+      axis[k] -= cosTheta;
+      const double norm = std::sqrt(axis[0]*axis[0] + axis[1]*axis[1] + axis[2]*axis[2]);
+      const double sign = (axis[0]*v[0] + axis[1]*v[1] + axis[2]*v[2] < 0.0) ? -1.0 : 1.0;
+      for (unsigned int i=0; i<3; i++)
+      {
+        pW[i] = sign*theta*axis[i]/norm;
+      }
+    }
+
+    // <summary> Rotation from a matrix in double, row major. </summary>
+    void xLieToRotation(
+      const double* pR,
+      Rotation&     pRot)
+    {
+      pRot.r1_c1 = static_cast<float>(pR[0]);
+      pRot.r1_c2 = static_cast<float>(pR[1]);
+      pRot.r1_c3 = static_cast<float>(pR[2]);
+      pRot.r2_c1 = static_cast<float>(pR[3]);
+      pRot.r2_c2 = static_cast<float>(pR[4]);
+      pRot.r2_c3 = static_cast<float>(pR[5]);
+      pRot.r3_c1 = static_cast<float>(pR[6]);
+      pRot.r3_c2 = static_cast<float>(pR[7]);
+      pRot.r3_c3 = static_cast<float>(pR[8]);
+    }
+
+    // <summary> Rotation part of a Rotation or a Transform, in double,
+    //  row major. </summary>
+    template <class T>
+    void xLieFromRotation(
+      const T& pRot,
+      double*  pR)
+    {
+      pR[0] = pRot.r1_c1;
+      pR[1] = pRot.r1_c2;
+      pR[2] = pRot.r1_c3;
+      pR[3] = pRot.r2_c1;
+      pR[4] = pRot.r2_c2;
+      pR[5] = pRot.r2_c3;
+      pR[6] = pRot.r3_c1;
+      pR[7] = pRot.r3_c2;
+      pR[8] = pRot.r3_c3;
+    }
+
+    // <summary> Copy a 3x3 block in a float matrix of pSize columns. </summary>
+    template <std::size_t N>
+    void xLieSetBlock(
+      const double*          pBlock,
+      const unsigned int&    pSize,
+      const unsigned int&    pRow,
+      const unsigned int&    pCol,
+      std::array<float, N>&  pMatrix)
+    {
+      for (unsigned int i=0; i<3; i++)
+      {
+        for (unsigned int j=0; j<3; j++)
+        {
+          pMatrix[(pRow + i)*pSize + pCol + j] = static_cast<float>(pBlock[3*i + j]);
+        }
+      }
+    }
+
+    // <summary> Exponential of SE(2): position, cosinus and sinus. </summary>
+    void xLieSE2Exp(
+      const Pose2D& pV,
+      float&        pX,
+      float&        pY,
+      float&        pCos,
+      float&        pSin)
+    {
+      const double theta = pV.theta;
+      double a, b, c;
+      xLieCoefficients(theta, a, b, c);
+      // (1 - cos(t))/t
+      b *= theta;
+      pX = static_cast<float>(a*pV.x - b*pV.y);
+      pY = static_cast<float>(b*pV.x + a*pV.y);
+      pCos = static_cast<float>(std::cos(theta));
+      pSin = static_cast<float>(std::sin(theta));
+    }
+
+    // <summary> Logarithm of SE(2), from the angle. </summary>
+    Pose2D xLieSE2Log(
+      const float&  pX,
+      const float&  pY,
+      const double& pTheta)
+    {
+      double a, b, c;
+      xLieCoefficients(pTheta, a, b, c);
+      b *= pTheta;
+      const double det = a*a + b*b;
+      return Pose2D(static_cast<float>((a*pX + b*pY)/det),
+                    static_cast<float>((-b*pX + a*pY)/det),
+                    static_cast<float>(pTheta));
+    }
+
+    // <summary> Adjoint of SE(2). </summary>
+    LieGroup<Pose2D>::Matrix xLieSE2Adjoint(
+      const float& pX,
+      const float& pY,
+      const float& pCos,
+      const float& pSin)
+    {
+      LieGroup<Pose2D>::Matrix m = {{
+          pCos, -pSin, pY,
+          pSin,  pCos, -pX,
+          0.0f,  0.0f, 1.0f}};
+      return m;
+    }
+
+    // <summary> Left jacobian of SE(2). </summary>
+    LieGroup<Pose2D>::Matrix xLieSE2LeftJacobian(const Pose2D& pV)
+    {
+      const double theta = pV.theta;
+      double a, b, c;
+      xLieCoefficients(theta, a, b, c);
+      // d1 = (t - sin(t))/t^2, d2 = (1 - cos(t))/t^2
+      const double d1 = c*theta;
+      const double d2 = b;
+      b *= theta;
+      LieGroup<Pose2D>::Matrix m = {{
+          static_cast<float>(a), static_cast<float>(-b),
+          static_cast<float>(d1*pV.x + d2*pV.y),
+          static_cast<float>(b), static_cast<float>(a),
+          static_cast<float>(-d2*pV.x + d1*pV.y),
+          0.0f, 0.0f, 1.0f}};
+      return m;
+    }
+
+    /****************************
+    SE(2): Pose2D
+    ****************************/
+    Pose2D LieGroup<Pose2D>::identity()
+    {
+      return Pose2D();
+    }
+
+    Pose2D LieGroup<Pose2D>::compose(
+      const Pose2D& pA,
+      const Pose2D& pB)
+    {
+      return pA*pB;
+    }
+
+    Pose2D LieGroup<Pose2D>::inverse(const Pose2D& pA)
+    {
+      return pose2DInverse(pA);
+    }
+
+    Pose2D LieGroup<Pose2D>::exp(const Tangent& pV)
+    {
+      float x, y, c, s;
+      xLieSE2Exp(pV, x, y, c, s);
+      return Pose2D(x, y, pV.theta);
+    }
+
+    LieGroup<Pose2D>::Tangent LieGroup<Pose2D>::log(const Pose2D& pA)
+    {
+      const double theta = std::atan2(std::sin(static_cast<double>(pA.theta)),
+                                      std::cos(static_cast<double>(pA.theta)));
+      return xLieSE2Log(pA.x, pA.y, theta);
+    }
+
+    LieGroup<Pose2D>::Matrix LieGroup<Pose2D>::adjoint(const Pose2D& pA)
+    {
+      return xLieSE2Adjoint(pA.x, pA.y, std::cos(pA.theta), std::sin(pA.theta));
+    }
+
+    LieGroup<Pose2D>::Matrix LieGroup<Pose2D>::leftJacobian(const Tangent& pV)
+    {
+      return xLieSE2LeftJacobian(pV);
+    }
+
+    LieGroup<Pose2D>::Matrix LieGroup<Pose2D>::rightJacobian(const Tangent& pV)
+    {
+      return xLieSE2LeftJacobian(pV*-1.0f);
+    }
+
+    /****************************
+    SE(2): Transform2D
+    ****************************/
+    Transform2D LieGroup<Transform2D>::identity()
+    {
+      return Transform2D();
+    }
+
+    Transform2D LieGroup<Transform2D>::compose(
+      const Transform2D& pA,
+      const Transform2D& pB)
+    {
+      return pA*pB;
+    }
+
+    Transform2D LieGroup<Transform2D>::inverse(const Transform2D& pA)
+    {
+      return transform2DInverse(pA);
+    }
+
+    Transform2D LieGroup<Transform2D>::exp(const Tangent& pV)
+    {
+      Transform2D result;
+      xLieSE2Exp(pV, result.x, result.y, result.cosTheta, result.sinTheta);
+      return result;
+    }
+
+    LieGroup<Transform2D>::Tangent LieGroup<Transform2D>::log(const Transform2D& pA)
+    {
+      return xLieSE2Log(pA.x, pA.y, std::atan2(static_cast<double>(pA.sinTheta),
+                                               static_cast<double>(pA.cosTheta)));
+    }
+
+    LieGroup<Transform2D>::Matrix LieGroup<Transform2D>::adjoint(const Transform2D& pA)
+    {
+      return xLieSE2Adjoint(pA.x, pA.y, pA.cosTheta, pA.sinTheta);
+    }
+
+    LieGroup<Transform2D>::Matrix LieGroup<Transform2D>::leftJacobian(const Tangent& pV)
+    {
+      return xLieSE2LeftJacobian(pV);
+    }
+
+    LieGroup<Transform2D>::Matrix LieGroup<Transform2D>::rightJacobian(const Tangent& pV)
+    {
+      return xLieSE2LeftJacobian(pV*-1.0f);
+    }
+
+    /****************************
+    SO(3): Rotation
+    ****************************/
+    Rotation LieGroup<Rotation>::identity()
+    {
+      return Rotation();
+    }
+
+    Rotation LieGroup<Rotation>::compose(
+      const Rotation& pA,
+      const Rotation& pB)
+    {
+      return pA*pB;
+    }
+
+    Rotation LieGroup<Rotation>::inverse(const Rotation& pA)
+    {
+      return pA.transpose();
+    }
+
+    Rotation LieGroup<Rotation>::exp(const Tangent& pV)
+    {
+      const double w[3] = {pV.x, pV.y, pV.z};
+      const double theta = std::sqrt(w[0]*w[0] + w[1]*w[1] + w[2]*w[2]);
+      double a, b, c;
+      xLieCoefficients(theta, a, b, c);
+      double r[9];
+      xLieSO3Series(w, a, b, r);
+      Rotation result;
+      xLieToRotation(r, result);
+      return result;
+    }
+
+    LieGroup<Rotation>::Tangent LieGroup<Rotation>::log(const Rotation& pA)
+    {
+      double r[9];
+      xLieFromRotation(pA, r);
+      double w[3];
+      xLieSO3Log(r, w);
+      return Position3D(static_cast<float>(w[0]),
+                        static_cast<float>(w[1]),
+                        static_cast<float>(w[2]));
+    }
+
+    LieGroup<Rotation>::Matrix LieGroup<Rotation>::adjoint(const Rotation& pA)
+    {
+      Matrix m = {{
+          pA.r1_c1, pA.r1_c2, pA.r1_c3,
+          pA.r2_c1, pA.r2_c2, pA.r2_c3,
+          pA.r3_c1, pA.r3_c2, pA.r3_c3}};
+      return m;
+    }
+
+    LieGroup<Rotation>::Matrix LieGroup<Rotation>::leftJacobian(const Tangent& pV)
+    {
+      const double w[3] = {pV.x, pV.y, pV.z};
+      double j[9];
+      xLieSO3LeftJacobian(w, j);
+      Matrix m;
+      xLieSetBlock(j, 3, 0, 0, m);
+      return m;
+    }
+
+    LieGroup<Rotation>::Matrix LieGroup<Rotation>::rightJacobian(const Tangent& pV)
+    {
+      return leftJacobian(pV*-1.0f);
+    }
+
+    /****************************
+    SO(3): Quaternion
+    ****************************/
+    Quaternion LieGroup<Quaternion>::identity()
+    {
+      return Quaternion();
+    }
+
+    Quaternion LieGroup<Quaternion>::compose(
+      const Quaternion& pA,
+      const Quaternion& pB)
+    {
+      return pA*pB;
+    }
+
+    Quaternion LieGroup<Quaternion>::inverse(const Quaternion& pA)
+    {
+      // conjugate, of norm 1
+      return Quaternion(pA.w, -pA.x, -pA.y, -pA.z);
+    }
+
+    Quaternion LieGroup<Quaternion>::exp(const Tangent& pV)
+    {
+      const double x = pV.x;
+      const double y = pV.y;
+      const double z = pV.z;
+      const double theta = std::sqrt(x*x + y*y + z*z);
+      // sin(t/2)/t
+      const double ratio = (theta < xLieSmallAngle) ?
+            0.5 - theta*theta/48.0 : std::sin(0.5*theta)/theta;
+      return Quaternion(static_cast<float>(std::cos(0.5*theta)),
+                        static_cast<float>(ratio*x),
+                        static_cast<float>(ratio*y),
+                        static_cast<float>(ratio*z));
+    }
+
+    LieGroup<Quaternion>::Tangent LieGroup<Quaternion>::log(const Quaternion& pA)
+    {
+      // q and -q are the same rotation: take the one of angle in [0, pi]
+      const double sign = (pA.w < 0.0f) ? -1.0 : 1.0;
+      const double w = sign*pA.w;
+      const double x = sign*pA.x;
+      const double y = sign*pA.y;
+      const double z = sign*pA.z;
+      const double norm = std::sqrt(x*x + y*y + z*z);
+      // t/sin(t/2), with t = 2*atan2(sin(t/2), cos(t/2))
+      const double ratio = (norm < 1.0e-8) ?
+            2.0/w : 2.0*std::atan2(norm, w)/norm;
+      return Position3D(static_cast<float>(ratio*x),
+                        static_cast<float>(ratio*y),
+                        static_cast<float>(ratio*z));
+    }
+
+    LieGroup<Quaternion>::Matrix LieGroup<Quaternion>::adjoint(const Quaternion& pA)
+    {
+      return LieGroup<Rotation>::adjoint(rotationFromQuaternion(pA.w, pA.x, pA.y, pA.z));
+    }
+
+    LieGroup<Quaternion>::Matrix LieGroup<Quaternion>::leftJacobian(const Tangent& pV)
+    {
+      return LieGroup<Rotation>::leftJacobian(pV);
+    }
+
+    LieGroup<Quaternion>::Matrix LieGroup<Quaternion>::rightJacobian(const Tangent& pV)
+    {
+      return LieGroup<Rotation>::leftJacobian(pV*-1.0f);
+    }
+
+    /****************************
+    SE(3): Transform
+    ****************************/
+    Transform LieGroup<Transform>::identity()
+    {
+      return Transform();
+    }
+
+    Transform LieGroup<Transform>::compose(
+      const Transform& pA,
+      const Transform& pB)
+    {
+      return pA*pB;
+    }
+
+    Transform LieGroup<Transform>::inverse(const Transform& pA)
+    {
+      return transformInverse(pA);
+    }
+
+    Transform LieGroup<Transform>::exp(const Tangent& pV)
+    {
+      return velocityExponential(pV);
+    }
+
+    LieGroup<Transform>::Tangent LieGroup<Transform>::log(const Transform& pA)
+    {
+      double r[9];
+      xLieFromRotation(pA, r);
+      double w[3];
+      xLieSO3Log(r, w);
+
+      // inverse of I + b*K + c*K^2: I - K/2 + e*K^2,
+      // with e = (1 - a/(2*b))/t^2
+      const double theta2 = w[0]*w[0] + w[1]*w[1] + w[2]*w[2];
+      const double theta = std::sqrt(theta2);
+      double e;
+      if (theta < xLieSmallAngle)
+      {
+        e = 1.0/12.0 + theta2/720.0;
+      }
+      else
+      {
+        double a, b, c;
+        xLieCoefficients(theta, a, b, c);
+        e = (1.0 - 0.5*a/b)/theta2;
+      }
+      double vInverse[9];
+      xLieSO3Series(w, -0.5, e, vInverse);
+
+      const double t[3] = {pA.r1_c4, pA.r2_c4, pA.r3_c4};
+      double rho[3];
+      for (unsigned int i=0; i<3; i++)
+      {
+        rho[i] = vInverse[3*i]*t[0] + vInverse[3*i + 1]*t[1] + vInverse[3*i + 2]*t[2];
+      }
+      return Velocity6D(static_cast<float>(rho[0]),
+                        static_cast<float>(rho[1]),
+                        static_cast<float>(rho[2]),
+                        static_cast<float>(w[0]),
+                        static_cast<float>(w[1]),
+                        static_cast<float>(w[2]));
+    }
+
+    LieGroup<Transform>::Matrix LieGroup<Transform>::adjoint(const Transform& pA)
+    {
+      double r[9];
+      xLieFromRotation(pA, r);
+      const double t[3] = {pA.r1_c4, pA.r2_c4, pA.r3_c4};
+      double k[9];
+      xLieSkew(t, k);
+      double tr[9];
+      xLieMultiply3(k, r, tr);
+
+      Matrix m;
+      m.fill(0.0f);
+      xLieSetBlock(r, 6, 0, 0, m);
+      xLieSetBlock(tr, 6, 0, 3, m);
+      xLieSetBlock(r, 6, 3, 3, m);
+      return m;
+    }
+
+    LieGroup<Transform>::Matrix LieGroup<Transform>::leftJacobian(const Tangent& pV)
+    {
+      const double rho[3] = {pV.xd, pV.yd, pV.zd};
+      const double w[3] = {pV.wxd, pV.wyd, pV.wzd};
+      double j[9];
+      xLieSO3LeftJacobian(w, j);
+
+      // Q(rho, w) of Barfoot, State Estimation for Robotics, 7.86
+      const double theta2 = w[0]*w[0] + w[1]*w[1] + w[2]*w[2];
+      const double theta = std::sqrt(theta2);
+      double c1, c2, c3;
+      if (theta < xLieSmallAngle)
+      {
+        c1 = 1.0/6.0 - theta2/120.0;
+        c2 = 1.0/24.0 - theta2/720.0;
+        c3 = 1.0/120.0 - theta2/2520.0;
+      }
+      else
+      {
+        const double s = std::sin(theta);
+        const double c = std::cos(theta);
+        const double theta4 = theta2*theta2;
+        c1 = (theta - s)/(theta2*theta);
+        c2 = (0.5*theta2 + c - 1.0)/theta4;
+        c3 = (2.0*theta - 3.0*s + theta*c)/(2.0*theta4*theta);
+      }
+
+      double p[9];
+      double k[9];
+      xLieSkew(rho, p);
+      xLieSkew(w, k);
+      double kp[9], pk[9], kpk[9], kkp[9], pkk[9], kpkk[9], kkpk[9];
+      xLieMultiply3(k, p, kp);
+      xLieMultiply3(p, k, pk);
+      xLieMultiply3(kp, k, kpk);
+      xLieMultiply3(k, kp, kkp);
+      xLieMultiply3(pk, k, pkk);
+      xLieMultiply3(kpk, k, kpkk);
+      xLieMultiply3(k, kpk, kkpk);
+
+      double q[9];
+      for (unsigned int i=0; i<9; i++)
+      {
+        q[i] = 0.5*p[i] +
+            c1*(kp[i] + pk[i] + kpk[i]) +
+            c2*(kkp[i] + pkk[i] - 3.0*kpk[i]) +
+            c3*(kpkk[i] + kkpk[i]);
+      }
+
+      Matrix m;
+      m.fill(0.0f);
+      xLieSetBlock(j, 6, 0, 0, m);
+      xLieSetBlock(q, 6, 0, 3, m);
+      xLieSetBlock(j, 6, 3, 3, m);
+      return m;
+    }
+
+    LieGroup<Transform>::Matrix LieGroup<Transform>::rightJacobian(const Tangent& pV)
+    {
+      return leftJacobian(pV*-1.0f);
+    }
+
+  } // namespace Math
+} // namespace AL
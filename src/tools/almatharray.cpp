@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/almatharray.h>
+#include <almath/tools/althreadpool.h>
+#include <cstring>
+
+namespace AL {
+namespace Math {
+
+/****************************
+PRIVATE FUNCTION
+****************************/
+// <summary> Number of floats of a type, checked against its size: all
+//  the ALMath types are made of floats only. </summary>
+template <class T>
+struct xArrayLayout
+{
+  static const unsigned int nbFloats = BinaryTraits<T>::nbFloats;
+  static_assert(sizeof(T) == nbFloats*sizeof(float),
+                "ALMath types are made of floats only");
+
+  static const float* data(const T* pValues)
+  {
+    return reinterpret_cast<const float*>(pValues);
+  }
+  static float* data(T* pValues)
+  {
+    return reinterpret_cast<float*>(pValues);
+  }
+};
+
+/****************************
+PUBLIC FUNCTION
+****************************/
+template <class T>
+typename FloatArray<T>::type toArray(const T& pValue)
+{
+  typename FloatArray<T>::type returnArray;
+  std::memcpy(returnArray.data(),
+              xArrayLayout<T>::data(&pValue),
+              xArrayLayout<T>::nbFloats*sizeof(float));
+  return returnArray;
+}
+
+
+template <class T>
+T fromArray(const typename FloatArray<T>::type& pArray)
+{
+  T returnValue;
+  std::memcpy(xArrayLayout<T>::data(&returnValue),
+              pArray.data(),
+              xArrayLayout<T>::nbFloats*sizeof(float));
+  return returnValue;
+}
+
+
+template <class T>
+void toFloats(
+  const T& pValue,
+  float*   pData)
+{
+  std::memcpy(pData,
+              xArrayLayout<T>::data(&pValue),
+              xArrayLayout<T>::nbFloats*sizeof(float));
+}
+
+
+template <class T>
+void fromFloats(
+  const float* pData,
+  T&           pValue)
+{
+  std::memcpy(xArrayLayout<T>::data(&pValue),
+              pData,
+              xArrayLayout<T>::nbFloats*sizeof(float));
+}
+
+
+template <class T>
+unsigned int toFloats(
+  const T*            pValues,
+  const unsigned int& pSize,
+  float*              pData,
+  const unsigned int& pNbFloats)
+{
+  const unsigned int nbFitting = pNbFloats/xArrayLayout<T>::nbFloats;
+  const unsigned int size = (pSize < nbFitting) ? pSize : nbFitting;
+  if (size > 0)
+  {
+    std::memcpy(pData,
+                xArrayLayout<T>::data(pValues),
+                size*xArrayLayout<T>::nbFloats*sizeof(float));
+  }
+  return size;
+}
+
+
+template <class T>
+unsigned int fromFloats(
+  const float*        pData,
+  const unsigned int& pNbFloats,
+  T*                  pValues,
+  const unsigned int& pSize)
+{
+  const unsigned int nbAvailable = pNbFloats/xArrayLayout<T>::nbFloats;
+  const unsigned int size = (pSize < nbAvailable) ? pSize : nbAvailable;
+  if (size > 0)
+  {
+    std::memcpy(xArrayLayout<T>::data(pValues),
+                pData,
+                size*xArrayLayout<T>::nbFloats*sizeof(float));
+  }
+  return size;
+}
+
+
+template <class T>
+unsigned int toFloats(
+  const T*               pValues,
+  const unsigned int&    pSize,
+  float*                 pData,
+  const unsigned int&    pNbFloats,
+  const ExecutionPolicy& pPolicy)
+{
+  const unsigned int nbFitting = pNbFloats/xArrayLayout<T>::nbFloats;
+  const unsigned int size = (pSize < nbFitting) ? pSize : nbFitting;
+  parallelFor(pPolicy, 0, size,
+              [&](const unsigned int& pBegin, const unsigned int& pEnd)
+  {
+    std::memcpy(pData + pBegin*xArrayLayout<T>::nbFloats,
+                xArrayLayout<T>::data(pValues + pBegin),
+                (pEnd - pBegin)*xArrayLayout<T>::nbFloats*sizeof(float));
+  });
+  return size;
+}
+
+
+template <class T>
+unsigned int fromFloats(
+  const float*           pData,
+  const unsigned int&    pNbFloats,
+  T*                     pValues,
+  const unsigned int&    pSize,
+  const ExecutionPolicy& pPolicy)
+{
+  const unsigned int nbAvailable = pNbFloats/xArrayLayout<T>::nbFloats;
+  const unsigned int size = (pSize < nbAvailable) ? pSize : nbAvailable;
+  parallelFor(pPolicy, 0, size,
+              [&](const unsigned int& pBegin, const unsigned int& pEnd)
+  {
+    std::memcpy(xArrayLayout<T>::data(pValues + pBegin),
+                pData + pBegin*xArrayLayout<T>::nbFloats,
+                (pEnd - pBegin)*xArrayLayout<T>::nbFloats*sizeof(float));
+  });
+  return size;
+}
+
+
+#define ALMATH_INSTANTIATE_ARRAY(T)                                        \
+template FloatArray<T>::type toArray<T>(const T&);                         \
+template T fromArray<T>(const FloatArray<T>::type&);                       \
+template void toFloats<T>(const T&, float*);                               \
+template void fromFloats<T>(const float*, T&);                             \
+template unsigned int toFloats<T>(                                         \
+  const T*, const unsigned int&, float*, const unsigned int&);             \
+template unsigned int fromFloats<T>(                                       \
+  const float*, const unsigned int&, T*, const unsigned int&);             \
+template unsigned int toFloats<T>(                                         \
+  const T*, const unsigned int&, float*, const unsigned int&,              \
+  const ExecutionPolicy&);                                                 \
+template unsigned int fromFloats<T>(                                       \
+  const float*, const unsigned int&, T*, const unsigned int&,              \
+  const ExecutionPolicy&);
+
+ALMATH_INSTANTIATE_ARRAY(Pose2D)
+ALMATH_INSTANTIATE_ARRAY(Position2D)
+ALMATH_INSTANTIATE_ARRAY(Position3D)
+ALMATH_INSTANTIATE_ARRAY(Position6D)
+ALMATH_INSTANTIATE_ARRAY(PositionAndVelocity)
+ALMATH_INSTANTIATE_ARRAY(Quaternion)
+ALMATH_INSTANTIATE_ARRAY(Rotation)
+ALMATH_INSTANTIATE_ARRAY(Rotation3D)
+ALMATH_INSTANTIATE_ARRAY(Transform)
+ALMATH_INSTANTIATE_ARRAY(TransformAndVelocity6D)
+ALMATH_INSTANTIATE_ARRAY(Velocity3D)
+ALMATH_INSTANTIATE_ARRAY(Velocity6D)
+#undef ALMATH_INSTANTIATE_ARRAY
+
+} // namespace Math
+} // namespace AL
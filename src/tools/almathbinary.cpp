@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/almathbinary.h>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <stdint.h>
+
+namespace AL {
+namespace Math {
+
+/****************************
+PRIVATE FUNCTION
+****************************/
+// <summary> Query if the host stores the floats in little endian. </summary>
+const bool xIsLittleEndian();
+
+// <summary> Write 4 bytes in little endian. </summary>
+void xWriteUInt32(
+  const unsigned int& pValue,
+  unsigned char*      pBuffer);
+
+// <summary> Read 4 bytes in little endian. </summary>
+unsigned int xReadUInt32(const unsigned char* pBuffer);
+
+// <summary> Number of bytes of pSize values, in 64 bits: it does not
+//  wrap for any pSize. </summary>
+template <class T>
+uint64_t xBinarySize(const uint64_t& pSize);
+
+// <summary> Get the number of bytes of a stream after its current
+//  position. </summary>
+// <returns> false if the stream cannot be measured. </returns>
+const bool xGetRemainingBytes(
+  std::istream& pStream,
+  uint64_t&     pNbBytes);
+
+// Number of values read or converted at once: reading a stream which
+// cannot be measured, a wrong count in the header only allocates as much
+// as the stream really holds.
+static const unsigned int xBinaryBlockSize = 65536;
+
+// <summary> Access to the floats of a value. All the ALMath types are
+//  made of floats only, which is checked at compile time. </summary>
+template <class T>
+struct xFloatLayout
+{
+  // compile error if the type has padding or other members
+  typedef char checkSize[
+    (sizeof(T) == BinaryTraits<T>::nbFloats*sizeof(float)) ? 1 : -1];
+
+  static const float* data(const T& pValue)
+  {
+    return reinterpret_cast<const float*>(&pValue);
+  }
+  static float* data(T& pValue)
+  {
+    return reinterpret_cast<float*>(&pValue);
+  }
+};
+
+
+const bool xIsLittleEndian()
+{
+  const unsigned int one = 1;
+  unsigned char bytes[sizeof(one)];
+  std::memcpy(bytes, &one, sizeof(one));
+  return (bytes[0] == 1);
+}
+
+
+void xWriteUInt32(
+  const unsigned int& pValue,
+  unsigned char*      pBuffer)
+{
+  pBuffer[0] = static_cast<unsigned char>(pValue & 0xFF);
+  pBuffer[1] = static_cast<unsigned char>((pValue >> 8) & 0xFF);
+  pBuffer[2] = static_cast<unsigned char>((pValue >> 16) & 0xFF);
+  pBuffer[3] = static_cast<unsigned char>((pValue >> 24) & 0xFF);
+}
+
+
+unsigned int xReadUInt32(const unsigned char* pBuffer)
+{
+  return static_cast<unsigned int>(pBuffer[0]) |
+      (static_cast<unsigned int>(pBuffer[1]) << 8) |
+      (static_cast<unsigned int>(pBuffer[2]) << 16) |
+      (static_cast<unsigned int>(pBuffer[3]) << 24);
+}
+
+
+template <class T>
+uint64_t xBinarySize(const uint64_t& pSize)
+{
+  return 4*static_cast<uint64_t>(BinaryTraits<T>::nbFloats)*pSize;
+}
+
+
+const bool xGetRemainingBytes(
+  std::istream& pStream,
+  uint64_t&     pNbBytes)
+{
+  const std::istream::pos_type position = pStream.tellg();
+  if (position == std::istream::pos_type(-1))
+  {
+    pStream.clear();
+    return false;
+  }
+  pStream.seekg(0, std::ios::end);
+  const std::istream::pos_type end = pStream.tellg();
+  pStream.clear();
+  pStream.seekg(position);
+  if ((end == std::istream::pos_type(-1)) || (end < position))
+  {
+    return false;
+  }
+  pNbBytes = static_cast<uint64_t>(end - position);
+  return true;
+}
+
+/****************************
+PUBLIC FUNCTION
+****************************/
+template <class T>
+unsigned int toBinary(
+  const T&       pValue,
+  unsigned char* pBuffer)
+{
+  return toBinary(&pValue, 1, pBuffer);
+}
+
+
+template <class T>
+unsigned int fromBinary(
+  const unsigned char* pBuffer,
+  T&                   pValue)
+{
+  return fromBinary(pBuffer, 1, &pValue);
+}
+
+
+template <class T>
+unsigned int toBinary(
+  const T*            pValues,
+  const unsigned int& pSize,
+  unsigned char*      pBuffer)
+{
+  // the number of bytes is returned as an unsigned int
+  if (xBinarySize<T>(pSize) > UINT_MAX)
+  {
+    throw std::invalid_argument("ALMath: toBinary too many values.");
+  }
+  const unsigned int nbFloats = pSize*BinaryTraits<T>::nbFloats;
+  if (nbFloats == 0)
+  {
+    return 0;
+  }
+
+  const float* floats = xFloatLayout<T>::data(pValues[0]);
+  if (xIsLittleEndian())
+  {
+    std::memcpy(pBuffer, floats, nbFloats*sizeof(float));
+  }
+  else
+  {
+    unsigned int bits;
+    for (unsigned int i=0; i<nbFloats; i++)
+    {
+      std::memcpy(&bits, &floats[i], sizeof(float));
+      xWriteUInt32(bits, &pBuffer[4*i]);
+    }
+  }
+  return 4*nbFloats;
+}
+
+
+template <class T>
+unsigned int fromBinary(
+  const unsigned char* pBuffer,
+  const unsigned int&  pSize,
+  T*                   pValues)
+{
+  // the number of bytes is returned as an unsigned int
+  if (xBinarySize<T>(pSize) > UINT_MAX)
+  {
+    throw std::invalid_argument("ALMath: fromBinary too many values.");
+  }
+  const unsigned int nbFloats = pSize*BinaryTraits<T>::nbFloats;
+  if (nbFloats == 0)
+  {
+    return 0;
+  }
+
+  float* floats = xFloatLayout<T>::data(pValues[0]);
+  if (xIsLittleEndian())
+  {
+    std::memcpy(floats, pBuffer, nbFloats*sizeof(float));
+  }
+  else
+  {
+    unsigned int bits;
+    for (unsigned int i=0; i<nbFloats; i++)
+    {
+      bits = xReadUInt32(&pBuffer[4*i]);
+      std::memcpy(&floats[i], &bits, sizeof(float));
+    }
+  }
+  return 4*nbFloats;
+}
+
+
+template <class T>
+void writeBinary(
+  std::ostream&         pStream,
+  const std::vector<T>& pValues)
+{
+  unsigned char header[BINARY_HEADER_SIZE];
+  header[0] = 'A';
+  header[1] = 'L';
+  header[2] = 'M';
+  header[3] = 'B';
+  header[4] = BINARY_FORMAT_VERSION;
+  header[5] = static_cast<unsigned char>(BinaryTraits<T>::type);
+  header[6] = 0;
+  header[7] = 0;
+  // the count of the header has 4 bytes
+  if (static_cast<uint64_t>(pValues.size()) > UINT_MAX)
+  {
+    throw std::invalid_argument("ALMath: writeBinary too many values.");
+  }
+  xWriteUInt32(static_cast<unsigned int>(pValues.size()), &header[8]);
+  pStream.write(reinterpret_cast<const char*>(header), BINARY_HEADER_SIZE);
+
+  if (pValues.empty())
+  {
+    return;
+  }
+
+  if (xIsLittleEndian())
+  {
+    // the values are already in the binary format
+    pStream.write(reinterpret_cast<const char*>(&pValues[0]),
+                  static_cast<std::streamsize>(xBinarySize<T>(pValues.size())));
+  }
+  else
+  {
+    // by blocks, so that each block size fits in toBinary
+    std::vector<unsigned char> buffer(
+      static_cast<std::size_t>(xBinarySize<T>(xBinaryBlockSize)));
+    for (std::size_t i=0; i<pValues.size(); i+=xBinaryBlockSize)
+    {
+      const unsigned int nbValues = static_cast<unsigned int>(
+        std::min<std::size_t>(xBinaryBlockSize, pValues.size() - i));
+      const unsigned int nbBytes = toBinary(&pValues[i], nbValues, &buffer[0]);
+      pStream.write(reinterpret_cast<const char*>(&buffer[0]), nbBytes);
+    }
+  }
+}
+
+
+template <class T>
+void readBinary(
+  std::istream&   pStream,
+  std::vector<T>& pValues)
+{
+  unsigned char header[BINARY_HEADER_SIZE];
+  pStream.read(reinterpret_cast<char*>(header), BINARY_HEADER_SIZE);
+  if (!pStream)
+  {
+    throw std::runtime_error("ALMath: readBinary stream too short.");
+  }
+  if ((header[0] != 'A') || (header[1] != 'L') ||
+      (header[2] != 'M') || (header[3] != 'B'))
+  {
+    throw std::runtime_error("ALMath: readBinary bad magic.");
+  }
+  if ((header[4] == 0) || (header[4] > BINARY_FORMAT_VERSION))
+  {
+    throw std::runtime_error("ALMath: readBinary unsupported version.");
+  }
+  if (header[5] != static_cast<unsigned char>(BinaryTraits<T>::type))
+  {
+    throw std::runtime_error("ALMath: readBinary wrong type.");
+  }
+
+  // the count comes from the stream: check it before allocating
+  const unsigned int size = xReadUInt32(&header[8]);
+  pValues.clear();
+  if (size > pValues.max_size())
+  {
+    throw std::runtime_error("ALMath: readBinary too many values.");
+  }
+  uint64_t nbRemainingBytes = 0;
+  if (xGetRemainingBytes(pStream, nbRemainingBytes))
+  {
+    if (nbRemainingBytes < xBinarySize<T>(size))
+    {
+      throw std::runtime_error("ALMath: readBinary stream too short.");
+    }
+    pValues.reserve(size);
+  }
+
+  std::vector<unsigned char> buffer;
+  unsigned int nbRead = 0;
+  while (nbRead < size)
+  {
+    const unsigned int nbValues = std::min(size - nbRead, xBinaryBlockSize);
+    pValues.resize(nbRead + nbValues);
+    const std::streamsize nbBytes =
+        static_cast<std::streamsize>(xBinarySize<T>(nbValues));
+    if (xIsLittleEndian())
+    {
+      pStream.read(reinterpret_cast<char*>(&pValues[nbRead]), nbBytes);
+    }
+    else
+    {
+      buffer.resize(static_cast<std::size_t>(nbBytes));
+      pStream.read(reinterpret_cast<char*>(&buffer[0]), nbBytes);
+      fromBinary(&buffer[0], nbValues, &pValues[nbRead]);
+    }
+    if (!pStream)
+    {
+      pValues.clear();
+      throw std::runtime_error("ALMath: readBinary stream too short.");
+    }
+    nbRead += nbValues;
+  }
+}
+
+
+#define ALMATH_INSTANTIATE_BINARY(T)                                  \
+template unsigned int toBinary<T>(const T&, unsigned char*);          \
+template unsigned int fromBinary<T>(const unsigned char*, T&);        \
+template unsigned int toBinary<T>(                                    \
+  const T*, const unsigned int&, unsigned char*);                     \
+template unsigned int fromBinary<T>(                                  \
+  const unsigned char*, const unsigned int&, T*);                     \
+template void writeBinary<T>(std::ostream&, const std::vector<T>&);   \
+template void readBinary<T>(std::istream&, std::vector<T>&);
+
+ALMATH_INSTANTIATE_BINARY(Pose2D)
+ALMATH_INSTANTIATE_BINARY(Position2D)
+ALMATH_INSTANTIATE_BINARY(Position3D)
+ALMATH_INSTANTIATE_BINARY(Position6D)
+ALMATH_INSTANTIATE_BINARY(PositionAndVelocity)
+ALMATH_INSTANTIATE_BINARY(Quaternion)
+ALMATH_INSTANTIATE_BINARY(Rotation)
+ALMATH_INSTANTIATE_BINARY(Rotation3D)
+ALMATH_INSTANTIATE_BINARY(Transform)
+ALMATH_INSTANTIATE_BINARY(TransformAndVelocity6D)
+ALMATH_INSTANTIATE_BINARY(Velocity3D)
+ALMATH_INSTANTIATE_BINARY(Velocity6D)
+#undef ALMATH_INSTANTIATE_BINARY
+
+} // namespace Math
+} // namespace AL
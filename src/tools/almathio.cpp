@@ -5,301 +5,1334 @@
  */
 
 #include <almath/tools/almathio.h>
+#include <almath/tools/almathbinary.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdint.h>
 
 namespace AL {
   namespace Math {
 
+    /****************************
+    PRIVATE FUNCTION
+    ****************************/
+    // <summary> Text written in a buffer. The characters which do not
+    //  fit in the buffer are only counted, as snprintf does. </summary>
+    struct xTextWriter
+    {
+      xTextWriter(
+        char*               pBuffer,
+        const unsigned int& pSize);
+
+      void put(const char& pChar);
+      void put(const char* pText);
 
-    std::ostream& operator<< (std::ostream& pStream, const Pose2D& p)
+      // <summary> Terminate the text and return its length. </summary>
+      unsigned int finish();
+
+      char* fBuffer;
+      unsigned int fSize;
+      unsigned int fLength;
+    };
+
+    // <summary> Text around the floats of a type, in each format.
+    //  The json pieces are optional: by default they are made from
+    //  the names. </summary>
+    struct xTextLayout
+    {
+      const char* const* stream;
+      const char* const* json;
+      const char* const* names;
+      const char* spaceSeparatedEnd;
+    };
+
+    template <class T>
+    xTextLayout xGetTextLayout();
+
+    // <summary> Multiply a value by a power of 10. </summary>
+    double xScaleByPow10(
+      const double& pValue,
+      const int&    pExponent);
+
+    // <summary> Round to the nearest integer, ties to even. </summary>
+    double xRoundHalfEven(const double& pValue);
+
+    // <summary> Round a positive float to pNbDigits significant digits:
+    //  pValue ~ pDigits*10^(pExponent - pNbDigits + 1). </summary>
+    void xDecimalDigits(
+      const float&   pValue,
+      const int&     pNbDigits,
+      unsigned long& pDigits,
+      int&           pExponent);
+
+    // <summary> Find the fewest significant digits which are read back
+    //  as the same positive float. </summary>
+    void xShortestDigits(
+      const float&   pValue,
+      unsigned long& pDigits,
+      int&           pNbDigits,
+      int&           pExponent);
+
+    // <summary> Write a float as %g does. The stream style writes it
+    //  as %+#g, or with a sign only for the shortest text. Json writes
+    //  null for NaN and infinity. </summary>
+    void xWriteFloat(
+      xTextWriter& pWriter,
+      const float& pValue,
+      const int&   pPrecision,
+      const bool&  pStreamStyle,
+      const bool&  pJson);
+
+    // <summary> Write a value in a format. </summary>
+    template <class T>
+    void xWriteValue(
+      xTextWriter&       pWriter,
+      const T&           pValue,
+      const TEXT_FORMAT& pFormat,
+      const int&         pPrecision);
+
+    // <summary> The stream layout of a value, in the fixed, scientific
+    //  or hexadecimal notation given by the float field of pFlags. Each
+    //  float is written by snprintf as the stream would write it with
+    //  showpos and showpoint, in the C locale. The precision is capped at
+    //  xMaxFloatFieldPrecision. </summary>
+    template <class T>
+    unsigned int xFormatWithFloatField(
+      const T&                       pValue,
+      char*                          pBuffer,
+      const unsigned int&            pSize,
+      const std::ios_base::fmtflags& pFlags,
+      const int&                     pPrecision);
+
+    // <summary> operator << without changing the flags of the stream.
+    //  The precision and the float field of the stream are used, and the
+    //  width pads the whole value, then is reset. </summary>
+    template <class T>
+    std::ostream& xWriteToStream(
+      std::ostream& pStream,
+      const T&      pValue);
+
+    // <summary> toSpaceSeparated with a precision of 6. </summary>
+    template <class T>
+    std::string xToSpaceSeparated(const T& pValue);
+
+    // <summary> Skip the spaces, tabulations and new lines. </summary>
+    void xSkipWhitespace(
+      const char*& pPosition,
+      const char*  pEnd);
+
+    // <summary> Match a text, the whitespace in the input and in the
+    //  text is free. On mismatch, pPosition is where it is. </summary>
+    const bool xMatchText(
+      const char*& pPosition,
+      const char*  pEnd,
+      const char*  pText);
+
+    // <summary> Match a word, ignoring the case. pPosition is moved
+    //  only if it matches. </summary>
+    const bool xMatchWord(
+      const char*& pPosition,
+      const char*  pEnd,
+      const char*  pWord);
+
+    // <summary> Parse a value in a format. On error, pPosition is where
+    //  it is and pValue is not modified. </summary>
+    template <class T>
+    PARSE_ERROR xParseValue(
+      const char*&       pPosition,
+      const char*        pEnd,
+      T&                 pValue,
+      const TEXT_FORMAT& pFormat);
+
+    // large enough for a TransformAndVelocity6D in any format
+    static const unsigned int xTextBufferSize = 512;
+
+    // digits after the point in fixed and scientific notations
+    static const int xMaxFloatFieldPrecision = 64;
+
+    // large enough for a TransformAndVelocity6D in fixed notation: 18
+    // floats of at most 39 digits, the point, the sign and the precision
+    static const unsigned int xFloatFieldBufferSize = 4096;
+
+    static const double xPow10[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+
+    xTextWriter::xTextWriter(
+      char*               pBuffer,
+      const unsigned int& pSize):
+      fBuffer(pBuffer),
+      fSize(pSize),
+      fLength(0)
+    {
+    }
+
+
+    void xTextWriter::put(const char& pChar)
+    {
+      if (fLength + 1 < fSize)
+      {
+        fBuffer[fLength] = pChar;
+      }
+      ++fLength;
+    }
+
+
+    void xTextWriter::put(const char* pText)
+    {
+      while (*pText != '\0')
+      {
+        put(*pText);
+        ++pText;
+      }
+    }
+
+
+    unsigned int xTextWriter::finish()
+    {
+      if (fSize > 0)
+      {
+        fBuffer[std::min(fLength, fSize - 1)] = '\0';
+      }
+      return fLength;
+    }
+
+
+    double xScaleByPow10(
+      const double& pValue,
+      const int&    pExponent)
+    {
+      double value = pValue;
+      int exponent = pExponent;
+      while (exponent > 22)
+      {
+        value *= xPow10[22];
+        exponent -= 22;
+      }
+      while (exponent < -22)
+      {
+        value /= xPow10[22];
+        exponent += 22;
+      }
+      return (exponent >= 0) ? value*xPow10[exponent] : value/xPow10[-exponent];
+    }
+
+
+    double xRoundHalfEven(const double& pValue)
+    {
+      const double integer = std::floor(pValue);
+      const double fraction = pValue - integer;
+      if ((fraction > 0.5) ||
+          ((fraction == 0.5) && (std::fmod(integer, 2.0) != 0.0)))
+      {
+        return integer + 1.0;
+      }
+      return integer;
+    }
+
+
+    void xDecimalDigits(
+      const float&   pValue,
+      const int&     pNbDigits,
+      unsigned long& pDigits,
+      int&           pExponent)
+    {
+      // log10 gives the exponent, or one less or more near a power of 10
+      pExponent = static_cast<int>(std::floor(std::log10(static_cast<double>(pValue))));
+      double digits = 0.0;
+      for (unsigned int i=0; i<3; i++)
+      {
+        digits = xRoundHalfEven(
+              xScaleByPow10(pValue, pNbDigits - 1 - pExponent));
+        if (digits >= xPow10[pNbDigits])
+        {
+          ++pExponent;
+        }
+        else if (digits < xPow10[pNbDigits - 1])
+        {
+          --pExponent;
+        }
+        else
+        {
+          break;
+        }
+      }
+      pDigits = static_cast<unsigned long>(digits);
+    }
+
+
+    void xShortestDigits(
+      const float&   pValue,
+      unsigned long& pDigits,
+      int&           pNbDigits,
+      int&           pExponent)
+    {
+      // the number must be strictly between the middles with the
+      // neighbour floats. The margin covers the rounding errors of the
+      // double computations, a number too close is rejected.
+      unsigned int bits;
+      std::memcpy(&bits, &pValue, sizeof(float));
+      float below;
+      float above;
+      const unsigned int bitsBelow = bits - 1;
+      const unsigned int bitsAbove = bits + 1;
+      std::memcpy(&below, &bitsBelow, sizeof(float));
+      std::memcpy(&above, &bitsAbove, sizeof(float));
+      const double margin = 1.0 + 1.0e-15;
+      const double lowMiddle = 0.5*(static_cast<double>(pValue) + below)*margin;
+      double highMiddle = 0.5*(static_cast<double>(pValue) + above)/margin;
+      if (bitsAbove == 0x7F800000u)
+      {
+        // above the largest float, the numbers are read as infinity
+        highMiddle = (1.5*pValue - 0.5*below)/margin;
+      }
+
+      for (pNbDigits=1; pNbDigits<9; pNbDigits++)
+      {
+        xDecimalDigits(pValue, pNbDigits, pDigits, pExponent);
+        const double number = xScaleByPow10(static_cast<double>(pDigits),
+                                            pExponent - pNbDigits + 1);
+        if ((number > lowMiddle) && (number < highMiddle))
+        {
+          return;
+        }
+      }
+      // 9 digits are always enough for a float
+      xDecimalDigits(pValue, pNbDigits, pDigits, pExponent);
+    }
+
+
+    void xWriteFloat(
+      xTextWriter& pWriter,
+      const float& pValue,
+      const int&   pPrecision,
+      const bool&  pStreamStyle,
+      const bool&  pJson)
+    {
+      unsigned int bits;
+      std::memcpy(&bits, &pValue, sizeof(float));
+      const bool isNegative = ((bits & 0x80000000u) != 0);
+      const bool isNan = (pValue != pValue);
+      const bool isInfinite = (!isNan) && ((bits & 0x7FFFFFFFu) == 0x7F800000u);
+
+      if ((isNan || isInfinite) && pJson)
+      {
+        pWriter.put("null");
+        return;
+      }
+      if (isNegative && !(isNan && !pStreamStyle))
+      {
+        pWriter.put('-');
+      }
+      else if (pStreamStyle)
+      {
+        pWriter.put('+');
+      }
+      if (isNan)
+      {
+        pWriter.put("nan");
+        return;
+      }
+      if (isInfinite)
+      {
+        pWriter.put("inf");
+        return;
+      }
+
+      // significant digits
+      const float value = std::fabs(pValue);
+      const int precision = std::min(pPrecision, 9);
+      unsigned long digits = 0;
+      int nbDigits = 1;
+      int exponent = 0;
+      if (value == 0.0f)
+      {
+        nbDigits = std::max(precision, 1);
+      }
+      else if (precision > 0)
+      {
+        nbDigits = precision;
+        xDecimalDigits(value, nbDigits, digits, exponent);
+      }
+      else
+      {
+        xShortestDigits(value, digits, nbDigits, exponent);
+      }
+
+      char text[9];
+      for (int i=nbDigits-1; i>=0; i--)
+      {
+        text[i] = static_cast<char>('0' + digits % 10);
+        digits /= 10;
+      }
+
+      // without showpoint, the trailing zeros are removed
+      const bool showPoint = pStreamStyle && (precision > 0);
+      int nbKept = nbDigits;
+      if (!showPoint)
+      {
+        while ((nbKept > 1) && (text[nbKept - 1] == '0'))
+        {
+          --nbKept;
+        }
+      }
+
+      // the choice of %g
+      const int maxExponent = (precision > 0) ? precision : 9;
+      if ((exponent < -4) || (exponent >= maxExponent))
+      {
+        pWriter.put(text[0]);
+        if ((nbKept > 1) || showPoint)
+        {
+          pWriter.put('.');
+        }
+        for (int i=1; i<nbKept; i++)
+        {
+          pWriter.put(text[i]);
+        }
+        pWriter.put('e');
+        pWriter.put((exponent < 0) ? '-' : '+');
+        const int absExponent = std::abs(exponent);
+        if (absExponent < 10)
+        {
+          pWriter.put('0');
+        }
+        if (absExponent >= 100)
+        {
+          pWriter.put(static_cast<char>('0' + absExponent/100));
+        }
+        if (absExponent >= 10)
+        {
+          pWriter.put(static_cast<char>('0' + (absExponent/10) % 10));
+        }
+        pWriter.put(static_cast<char>('0' + absExponent % 10));
+      }
+      else if (exponent >= 0)
+      {
+        for (int i=0; i<=exponent; i++)
+        {
+          pWriter.put((i < nbKept) ? text[i] : '0');
+        }
+        if ((nbKept > exponent + 1) || showPoint)
+        {
+          pWriter.put('.');
+        }
+        for (int i=exponent+1; i<nbKept; i++)
+        {
+          pWriter.put(text[i]);
+        }
+      }
+      else
+      {
+        pWriter.put("0.");
+        for (int i=-1; i>exponent; i--)
+        {
+          pWriter.put('0');
+        }
+        for (int i=0; i<nbKept; i++)
+        {
+          pWriter.put(text[i]);
+        }
+      }
+    }
+
+
+    template <>
+    xTextLayout xGetTextLayout<Pose2D>()
+    {
+      static const char* const stream[] = {"{x: ", ", y:", ", theta:", "}"};
+      static const char* const names[] = {"x", "y", "theta"};
+      const xTextLayout layout = {stream, 0, names, ""};
+      return layout;
+    }
+
+
+    template <>
+    xTextLayout xGetTextLayout<Position2D>()
+    {
+      static const char* const stream[] = {"{x: ", ", y:", "}"};
+      static const char* const names[] = {"x", "y"};
+      const xTextLayout layout = {stream, 0, names, ""};
+      return layout;
+    }
+
+
+    template <>
+    xTextLayout xGetTextLayout<Position3D>()
+    {
+      static const char* const stream[] = {"{x: ", ", y:", ", z:", "}"};
+      static const char* const names[] = {"x", "y", "z"};
+      const xTextLayout layout = {stream, 0, names, ""};
+      return layout;
+    }
+
+
+    template <>
+    xTextLayout xGetTextLayout<Position6D>()
+    {
+      static const char* const stream[] = {
+        "{x: ", ", y: ", ", z: ", ", wx: ", ", wy: ", ", wz: ", "}"};
+      static const char* const names[] = {"x", "y", "z", "wx", "wy", "wz"};
+      const xTextLayout layout = {stream, 0, names, ""};
+      return layout;
+    }
+
+
+    template <>
+    xTextLayout xGetTextLayout<PositionAndVelocity>()
+    {
+      static const char* const stream[] = {"{q: ", ", dq: ", "}"};
+      static const char* const names[] = {"q", "dq"};
+      const xTextLayout layout = {stream, 0, names, ""};
+      return layout;
+    }
+
+
+    template <>
+    xTextLayout xGetTextLayout<Quaternion>()
+    {
+      static const char* const stream[] = {"{w: ", ", x:", ", y:", ", z:", "}"};
+      static const char* const names[] = {"w", "x", "y", "z"};
+      const xTextLayout layout = {stream, 0, names, ""};
+      return layout;
+    }
+
+
+    template <>
+    xTextLayout xGetTextLayout<Rotation>()
+    {
+      static const char* const stream[] = {
+        "", " ", " ", " ", " ", " ", " ", " ", " ", "\n"};
+      static const char* const names[] = {
+        "r1_c1", "r1_c2", "r1_c3",
+        "r2_c1", "r2_c2", "r2_c3",
+        "r3_c1", "r3_c2", "r3_c3"};
+      const xTextLayout layout = {stream, 0, names, ""};
+      return layout;
+    }
+
+
+    template <>
+    xTextLayout xGetTextLayout<Rotation3D>()
+    {
+      static const char* const stream[] = {"{wx: ", " ,wy: ", " ,wz: ", "}"};
+      static const char* const names[] = {"wx", "wy", "wz"};
+      const xTextLayout layout = {stream, 0, names, ""};
+      return layout;
+    }
+
+
+    template <>
+    xTextLayout xGetTextLayout<Transform>()
+    {
+      static const char* const stream[] = {
+        "", " ", " ", " ",
+        "\n", " ", " ", " ",
+        "\n", " ", " ", " ",
+        "\n0.0 0.0 0.0 1.0\n"};
+      static const char* const names[] = {
+        "r1_c1", "r1_c2", "r1_c3", "r1_c4",
+        "r2_c1", "r2_c2", "r2_c3", "r2_c4",
+        "r3_c1", "r3_c2", "r3_c3", "r3_c4"};
+      const xTextLayout layout = {stream, 0, names, "0.0 0.0 0.0 1.0 "};
+      return layout;
+    }
+
+
+    template <>
+    xTextLayout xGetTextLayout<TransformAndVelocity6D>()
+    {
+      static const char* const stream[] = {
+        "", " ", " ", " ",
+        "\n", " ", " ", " ",
+        "\n", " ", " ", " ",
+        "\n0.0 0.0 0.0 1.0\n{xd: ", " ,yd: ", " ,zd: ",
+        " ,wxd: ", " ,wyd: ", " ,wzd: ", "}"};
+      static const char* const json[] = {
+        "{\"T\":{\"r1_c1\":", ",\"r1_c2\":", ",\"r1_c3\":", ",\"r1_c4\":",
+        ",\"r2_c1\":", ",\"r2_c2\":", ",\"r2_c3\":", ",\"r2_c4\":",
+        ",\"r3_c1\":", ",\"r3_c2\":", ",\"r3_c3\":", ",\"r3_c4\":",
+        "},\"V\":{\"xd\":", ",\"yd\":", ",\"zd\":",
+        ",\"wxd\":", ",\"wyd\":", ",\"wzd\":", "}}"};
+      static const char* const names[] = {
+        "T.r1_c1", "T.r1_c2", "T.r1_c3", "T.r1_c4",
+        "T.r2_c1", "T.r2_c2", "T.r2_c3", "T.r2_c4",
+        "T.r3_c1", "T.r3_c2", "T.r3_c3", "T.r3_c4",
+        "V.xd", "V.yd", "V.zd", "V.wxd", "V.wyd", "V.wzd"};
+      const xTextLayout layout = {stream, json, names, ""};
+      return layout;
+    }
+
+
+    template <>
+    xTextLayout xGetTextLayout<Velocity3D>()
+    {
+      static const char* const stream[] = {"{xd: ", ", yd:", ", zd:", "}"};
+      static const char* const names[] = {"xd", "yd", "zd"};
+      const xTextLayout layout = {stream, 0, names, ""};
+      return layout;
+    }
+
+
+    template <>
+    xTextLayout xGetTextLayout<Velocity6D>()
+    {
+      static const char* const stream[] = {
+        "{xd: ", " ,yd: ", " ,zd: ", " ,wxd: ", " ,wyd: ", " ,wzd: ", "}"};
+      static const char* const names[] = {"xd", "yd", "zd", "wxd", "wyd", "wzd"};
+      const xTextLayout layout = {stream, 0, names, ""};
+      return layout;
+    }
+
+
+    template <class T>
+    void xWriteValue(
+      xTextWriter&       pWriter,
+      const T&           pValue,
+      const TEXT_FORMAT& pFormat,
+      const int&         pPrecision)
+    {
+      const xTextLayout layout = xGetTextLayout<T>();
+      const unsigned int nbFloats = BinaryTraits<T>::nbFloats;
+      // the ALMath types are made of floats only, see almathbinary
+      const float* floats = reinterpret_cast<const float*>(&pValue);
+
+      for (unsigned int i=0; i<nbFloats; i++)
+      {
+        switch (pFormat)
+        {
+        case TEXT_FORMAT_STREAM:
+          pWriter.put(layout.stream[i]);
+          xWriteFloat(pWriter, floats[i], pPrecision, true, false);
+          break;
+        case TEXT_FORMAT_SPACE_SEPARATED:
+          xWriteFloat(pWriter, floats[i], pPrecision, true, false);
+          pWriter.put(' ');
+          break;
+        case TEXT_FORMAT_JSON:
+          if (layout.json != 0)
+          {
+            pWriter.put(layout.json[i]);
+          }
+          else
+          {
+            pWriter.put((i == 0) ? "{\"" : ",\"");
+            pWriter.put(layout.names[i]);
+            pWriter.put("\":");
+          }
+          xWriteFloat(pWriter, floats[i], pPrecision, false, true);
+          break;
+        case TEXT_FORMAT_CSV:
+          if (i > 0)
+          {
+            pWriter.put(',');
+          }
+          xWriteFloat(pWriter, floats[i], pPrecision, false, false);
+          break;
+        }
+      }
+
+      switch (pFormat)
+      {
+      case TEXT_FORMAT_STREAM:
+        pWriter.put(layout.stream[nbFloats]);
+        break;
+      case TEXT_FORMAT_SPACE_SEPARATED:
+        pWriter.put(layout.spaceSeparatedEnd);
+        break;
+      case TEXT_FORMAT_JSON:
+        pWriter.put((layout.json != 0) ? layout.json[nbFloats] : "}");
+        break;
+      case TEXT_FORMAT_CSV:
+        break;
+      }
+    }
+
+
+    template <class T>
+    unsigned int xFormatWithFloatField(
+      const T&                       pValue,
+      char*                          pBuffer,
+      const unsigned int&            pSize,
+      const std::ios_base::fmtflags& pFlags,
+      const int&                     pPrecision)
+    {
+      const std::ios_base::fmtflags floatField = pFlags & std::ios_base::floatfield;
+      const bool isUpperCase = ((pFlags & std::ios_base::uppercase) != 0);
+      const char* conversion = "%+#.*f";
+      if (floatField == std::ios_base::scientific)
+      {
+        conversion = isUpperCase ? "%+#.*E" : "%+#.*e";
+      }
+      else if (floatField != std::ios_base::fixed)
+      {
+        conversion = isUpperCase ? "%+A" : "%+a";
+      }
+      else if (isUpperCase)
+      {
+        conversion = "%+#.*F";
+      }
+      const int precision = std::max(0, std::min(pPrecision, xMaxFloatFieldPrecision));
+
+      xTextWriter writer(pBuffer, pSize);
+      const xTextLayout layout = xGetTextLayout<T>();
+      const unsigned int nbFloats = BinaryTraits<T>::nbFloats;
+      const float* floats = reinterpret_cast<const float*>(&pValue);
+      char text[128];
+      for (unsigned int i=0; i<nbFloats; i++)
+      {
+        writer.put(layout.stream[i]);
+        const double value = floats[i];
+        if (floatField == (std::ios_base::fixed | std::ios_base::scientific))
+        {
+          std::snprintf(text, sizeof(text), conversion, value);
+        }
+        else
+        {
+          std::snprintf(text, sizeof(text), conversion, precision, value);
+        }
+        writer.put(text);
+      }
+      writer.put(layout.stream[nbFloats]);
+      return writer.finish();
+    }
+
+
+    template <class T>
+    std::ostream& xWriteToStream(
+      std::ostream& pStream,
+      const T&      pValue)
     {
-      pStream.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      pStream << "{x: ";
-      pStream << p.x;
-      pStream << ", y:";
-      pStream << p.y;
-      pStream << ", theta:";
-      pStream << p.theta;
-      pStream << "}";
+      char buffer[xFloatFieldBufferSize];
+      const int precision = static_cast<int>(pStream.precision());
+      unsigned int length = 0;
+      if ((pStream.flags() & std::ios_base::floatfield) == 0)
+      {
+        length = format(pValue, buffer, xTextBufferSize,
+                        TEXT_FORMAT_STREAM, std::max(precision, 1));
+        length = std::min(length, xTextBufferSize - 1);
+      }
+      else
+      {
+        length = xFormatWithFloatField(pValue, buffer, xFloatFieldBufferSize,
+                                       pStream.flags(), precision);
+        length = std::min(length, xFloatFieldBufferSize - 1);
+      }
+
+      // as the inserters of the standard library, the width pads the
+      // whole value and is reset
+      const std::streamsize width = pStream.width();
+      pStream.width(0);
+      const std::streamsize nbFill = std::max(
+            static_cast<std::streamsize>(0), width - static_cast<std::streamsize>(length));
+      const bool isLeft =
+          ((pStream.flags() & std::ios_base::adjustfield) == std::ios_base::left);
+      if (!isLeft)
+      {
+        for (std::streamsize i=0; i<nbFill; i++)
+        {
+          pStream.put(pStream.fill());
+        }
+      }
+      pStream.write(buffer, length);
+      if (isLeft)
+      {
+        for (std::streamsize i=0; i<nbFill; i++)
+        {
+          pStream.put(pStream.fill());
+        }
+      }
       return pStream;
     }
 
+
+    template <class T>
+    std::string xToSpaceSeparated(const T& pValue)
+    {
+      char buffer[xTextBufferSize];
+      const unsigned int length = format(pValue, buffer, xTextBufferSize,
+                                         TEXT_FORMAT_SPACE_SEPARATED, 6);
+      return std::string(buffer, std::min(length, xTextBufferSize - 1));
+    }
+
+    void xSkipWhitespace(
+      const char*& pPosition,
+      const char*  pEnd)
+    {
+      while ((pPosition != pEnd) &&
+             ((*pPosition == ' ') || (*pPosition == '\t') ||
+              (*pPosition == '\r') || (*pPosition == '\n')))
+      {
+        ++pPosition;
+      }
+    }
+
+
+    const bool xMatchText(
+      const char*& pPosition,
+      const char*  pEnd,
+      const char*  pText)
+    {
+      for (; *pText != '\0'; ++pText)
+      {
+        if ((*pText == ' ') || (*pText == '\n'))
+        {
+          continue;
+        }
+        xSkipWhitespace(pPosition, pEnd);
+        if ((pPosition == pEnd) || (*pPosition != *pText))
+        {
+          return false;
+        }
+        ++pPosition;
+      }
+      return true;
+    }
+
+
+    const bool xMatchWord(
+      const char*& pPosition,
+      const char*  pEnd,
+      const char*  pWord)
+    {
+      const char* position = pPosition;
+      for (; *pWord != '\0'; ++pWord, ++position)
+      {
+        if ((position == pEnd) ||
+            ((*position != *pWord) && (*position != *pWord - 'a' + 'A')))
+        {
+          return false;
+        }
+      }
+      pPosition = position;
+      return true;
+    }
+
+
+    template <class T>
+    PARSE_ERROR xParseValue(
+      const char*&       pPosition,
+      const char*        pEnd,
+      T&                 pValue,
+      const TEXT_FORMAT& pFormat)
+    {
+      const xTextLayout layout = xGetTextLayout<T>();
+      const unsigned int nbFloats = BinaryTraits<T>::nbFloats;
+      T value = pValue;
+      float* floats = reinterpret_cast<float*>(&value);
+
+      for (unsigned int i=0; i<nbFloats; i++)
+      {
+        bool matched = true;
+        switch (pFormat)
+        {
+        case TEXT_FORMAT_STREAM:
+          matched = xMatchText(pPosition, pEnd, layout.stream[i]);
+          break;
+        case TEXT_FORMAT_SPACE_SEPARATED:
+          break;
+        case TEXT_FORMAT_JSON:
+          if (layout.json != 0)
+          {
+            matched = xMatchText(pPosition, pEnd, layout.json[i]);
+          }
+          else
+          {
+            matched = xMatchText(pPosition, pEnd, (i == 0) ? "{\"" : ",\"") &&
+                xMatchText(pPosition, pEnd, layout.names[i]) &&
+                xMatchText(pPosition, pEnd, "\":");
+          }
+          break;
+        case TEXT_FORMAT_CSV:
+          matched = (i == 0) || xMatchText(pPosition, pEnd, ",");
+          break;
+        }
+        if (!matched)
+        {
+          return PARSE_UNEXPECTED_TEXT;
+        }
+
+        xSkipWhitespace(pPosition, pEnd);
+        if ((pFormat == TEXT_FORMAT_JSON) && xMatchWord(pPosition, pEnd, "null"))
+        {
+          floats[i] = std::numeric_limits<float>::quiet_NaN();
+          continue;
+        }
+        const ParseResult result = parseFloat(pPosition, pEnd, floats[i]);
+        pPosition = result.ptr;
+        if (result.error != PARSE_OK)
+        {
+          return result.error;
+        }
+
+        // the numbers must be separated
+        if ((pFormat == TEXT_FORMAT_SPACE_SEPARATED) && (pPosition != pEnd))
+        {
+          const char* position = pPosition;
+          xSkipWhitespace(position, pEnd);
+          if (position == pPosition)
+          {
+            return PARSE_UNEXPECTED_TEXT;
+          }
+        }
+      }
+
+      bool matched = true;
+      switch (pFormat)
+      {
+      case TEXT_FORMAT_STREAM:
+        matched = xMatchText(pPosition, pEnd, layout.stream[nbFloats]);
+        break;
+      case TEXT_FORMAT_SPACE_SEPARATED:
+        matched = xMatchText(pPosition, pEnd, layout.spaceSeparatedEnd);
+        break;
+      case TEXT_FORMAT_JSON:
+        matched = xMatchText(pPosition, pEnd,
+                             (layout.json != 0) ? layout.json[nbFloats] : "}");
+        break;
+      case TEXT_FORMAT_CSV:
+        break;
+      }
+      if (!matched)
+      {
+        return PARSE_UNEXPECTED_TEXT;
+      }
+
+      pValue = value;
+      return PARSE_OK;
+    }
+
+    /****************************
+    PUBLIC FUNCTION
+    ****************************/
+    ParseResult parseFloat(
+      const char* pBegin,
+      const char* pEnd,
+      float&      pValue)
+    {
+      ParseResult result = {pBegin, PARSE_INVALID_NUMBER};
+      const char* position = pBegin;
+      bool isNegative = false;
+      if ((position != pEnd) && ((*position == '+') || (*position == '-')))
+      {
+        isNegative = (*position == '-');
+        ++position;
+      }
+
+      if (xMatchWord(position, pEnd, "nan"))
+      {
+        pValue = std::numeric_limits<float>::quiet_NaN();
+        pValue = isNegative ? -pValue : pValue;
+        result.ptr = position;
+        result.error = PARSE_OK;
+        return result;
+      }
+      if (xMatchWord(position, pEnd, "infinity") ||
+          xMatchWord(position, pEnd, "inf"))
+      {
+        pValue = std::numeric_limits<float>::infinity();
+        pValue = isNegative ? -pValue : pValue;
+        result.ptr = position;
+        result.error = PARSE_OK;
+        return result;
+      }
+
+      // the 17 first significant digits, enough for a float
+      uint64_t mantissa = 0;
+      int exponent = 0;
+      bool hasDigits = false;
+      for (; (position != pEnd) && (*position >= '0') && (*position <= '9');
+           ++position)
+      {
+        hasDigits = true;
+        if (mantissa < 10000000000000000ULL)
+        {
+          mantissa = 10*mantissa + static_cast<uint64_t>(*position - '0');
+        }
+        else
+        {
+          ++exponent;
+        }
+      }
+      if ((position != pEnd) && (*position == '.'))
+      {
+        ++position;
+        for (; (position != pEnd) && (*position >= '0') && (*position <= '9');
+             ++position)
+        {
+          hasDigits = true;
+          if (mantissa < 10000000000000000ULL)
+          {
+            mantissa = 10*mantissa + static_cast<uint64_t>(*position - '0');
+            --exponent;
+          }
+        }
+      }
+      if (!hasDigits)
+      {
+        return result;
+      }
+
+      // the exponent is optional
+      if ((position != pEnd) && ((*position == 'e') || (*position == 'E')))
+      {
+        const char* exponentPosition = position + 1;
+        bool isExponentNegative = false;
+        if ((exponentPosition != pEnd) &&
+            ((*exponentPosition == '+') || (*exponentPosition == '-')))
+        {
+          isExponentNegative = (*exponentPosition == '-');
+          ++exponentPosition;
+        }
+        if ((exponentPosition != pEnd) &&
+            (*exponentPosition >= '0') && (*exponentPosition <= '9'))
+        {
+          int exponentValue = 0;
+          for (; (exponentPosition != pEnd) &&
+               (*exponentPosition >= '0') && (*exponentPosition <= '9');
+               ++exponentPosition)
+          {
+            if (exponentValue < 10000)
+            {
+              exponentValue = 10*exponentValue + (*exponentPosition - '0');
+            }
+          }
+          exponent += isExponentNegative ? -exponentValue : exponentValue;
+          position = exponentPosition;
+        }
+      }
+      result.ptr = position;
+
+      float value = 0.0f;
+      if (mantissa != 0)
+      {
+        // beyond, the number is 0 or infinity for a float
+        exponent = std::max(-400, std::min(exponent, 400));
+        const double number = xScaleByPow10(static_cast<double>(mantissa),
+                                            exponent);
+        // the middle between the largest float and infinity
+        if (number >= 3.4028235677973366e+38)
+        {
+          result.error = PARSE_OUT_OF_RANGE;
+          return result;
+        }
+        value = static_cast<float>(number);
+        if (value == 0.0f)
+        {
+          result.error = PARSE_OUT_OF_RANGE;
+          return result;
+        }
+      }
+      pValue = isNegative ? -value : value;
+      result.error = PARSE_OK;
+      return result;
+    }
+
+
+    template <class T>
+    ParseResult parse(
+      const char*        pBegin,
+      const char*        pEnd,
+      T&                 pValue,
+      const TEXT_FORMAT& pFormat)
+    {
+      ParseResult result = {pBegin, PARSE_OK};
+      xSkipWhitespace(result.ptr, pEnd);
+      result.error = xParseValue(result.ptr, pEnd, pValue, pFormat);
+      return result;
+    }
+
+
+    template <class T>
+    ParseResult parseArray(
+      const char*        pBegin,
+      const char*        pEnd,
+      std::vector<T>&    pValues,
+      const TEXT_FORMAT& pFormat)
+    {
+      ParseResult result = {pBegin, PARSE_OK};
+      T value;
+
+      if (pFormat == TEXT_FORMAT_JSON)
+      {
+        if (!xMatchText(result.ptr, pEnd, "["))
+        {
+          result.error = PARSE_UNEXPECTED_TEXT;
+          return result;
+        }
+        xSkipWhitespace(result.ptr, pEnd);
+        if ((result.ptr != pEnd) && (*result.ptr == ']'))
+        {
+          ++result.ptr;
+          return result;
+        }
+        while (true)
+        {
+          xSkipWhitespace(result.ptr, pEnd);
+          result.error = xParseValue(result.ptr, pEnd, value, pFormat);
+          if (result.error != PARSE_OK)
+          {
+            return result;
+          }
+          pValues.push_back(value);
+
+          xSkipWhitespace(result.ptr, pEnd);
+          if ((result.ptr != pEnd) && (*result.ptr == ','))
+          {
+            ++result.ptr;
+          }
+          else if ((result.ptr != pEnd) && (*result.ptr == ']'))
+          {
+            ++result.ptr;
+            return result;
+          }
+          else
+          {
+            result.error = PARSE_UNEXPECTED_TEXT;
+            return result;
+          }
+        }
+      }
+
+      xSkipWhitespace(result.ptr, pEnd);
+      if (pFormat == TEXT_FORMAT_CSV)
+      {
+        char header[xTextBufferSize];
+        // without the new line
+        const unsigned int length = formatCsvHeader<T>(header, xTextBufferSize) - 1;
+        if ((static_cast<unsigned int>(pEnd - result.ptr) >= length) &&
+            (std::strncmp(result.ptr, header, length) == 0))
+        {
+          result.ptr += length;
+        }
+      }
+
+      while (true)
+      {
+        xSkipWhitespace(result.ptr, pEnd);
+        if (result.ptr == pEnd)
+        {
+          return result;
+        }
+        result.error = xParseValue(result.ptr, pEnd, value, pFormat);
+        if (result.error != PARSE_OK)
+        {
+          return result;
+        }
+        pValues.push_back(value);
+      }
+    }
+
+
+    unsigned int getLineNumber(
+      const char* pBegin,
+      const char* pPosition)
+    {
+      return 1 + static_cast<unsigned int>(std::count(pBegin, pPosition, '\n'));
+    }
+
+
+    unsigned int formatFloat(
+      const float&        pValue,
+      char*               pBuffer,
+      const unsigned int& pSize,
+      const int&          pPrecision)
+    {
+      xTextWriter writer(pBuffer, pSize);
+      xWriteFloat(writer, pValue, pPrecision, false, false);
+      return writer.finish();
+    }
+
+
+    template <class T>
+    unsigned int format(
+      const T&            pValue,
+      char*               pBuffer,
+      const unsigned int& pSize,
+      const TEXT_FORMAT&  pFormat,
+      const int&          pPrecision)
+    {
+      xTextWriter writer(pBuffer, pSize);
+      xWriteValue(writer, pValue, pFormat, pPrecision);
+      return writer.finish();
+    }
+
+
+    template <class T>
+    unsigned int formatArray(
+      const T*            pValues,
+      const unsigned int& pNbValues,
+      char*               pBuffer,
+      const unsigned int& pSize,
+      const TEXT_FORMAT&  pFormat,
+      const int&          pPrecision)
+    {
+      xTextWriter writer(pBuffer, pSize);
+      if (pFormat == TEXT_FORMAT_JSON)
+      {
+        writer.put('[');
+        for (unsigned int i=0; i<pNbValues; i++)
+        {
+          if (i > 0)
+          {
+            writer.put(',');
+          }
+          xWriteValue(writer, pValues[i], pFormat, pPrecision);
+        }
+        writer.put(']');
+        return writer.finish();
+      }
+
+      // the stream format of some types already ends with a new line
+      const char* end = xGetTextLayout<T>().stream[BinaryTraits<T>::nbFloats];
+      const bool endsWithNewLine = (pFormat == TEXT_FORMAT_STREAM) &&
+          (end[std::strlen(end) - 1] == '\n');
+      for (unsigned int i=0; i<pNbValues; i++)
+      {
+        xWriteValue(writer, pValues[i], pFormat, pPrecision);
+        if (!endsWithNewLine)
+        {
+          writer.put('\n');
+        }
+      }
+      return writer.finish();
+    }
+
+
+    template <class T>
+    unsigned int formatCsvHeader(
+      char*               pBuffer,
+      const unsigned int& pSize)
+    {
+      const xTextLayout layout = xGetTextLayout<T>();
+      xTextWriter writer(pBuffer, pSize);
+      for (unsigned int i=0; i<BinaryTraits<T>::nbFloats; i++)
+      {
+        if (i > 0)
+        {
+          writer.put(',');
+        }
+        writer.put(layout.names[i]);
+      }
+      writer.put('\n');
+      return writer.finish();
+    }
+
+
+    std::ostream& operator<< (std::ostream& pStream, const Pose2D& p)
+    {
+      return xWriteToStream(pStream, p);
+    }
+
     std::ostream& operator<< (std::ostream& pStream, const Position2D& p)
     {
-      pStream.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      pStream << "{x: ";
-      pStream << p.x;
-      pStream << ", y:";
-      pStream << p.y;
-      pStream << "}";
-      return pStream;
+      return xWriteToStream(pStream, p);
     }
 
     std::ostream& operator<< (std::ostream& pStream, const Position3D& p)
     {
-      pStream.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      pStream << "{x: ";
-      pStream << p.x;
-      pStream << ", y:";
-      pStream << p.y;
-      pStream << ", z:";
-      pStream << p.z;
-      pStream << "}";
-      return pStream;
+      return xWriteToStream(pStream, p);
     }
 
     std::ostream& operator<< (std::ostream& pStream, const Position6D& p)
     {
-      pStream.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      pStream << "{x: ";
-      pStream << p.x;
-      pStream << ", y: ";
-      pStream << p.y;
-      pStream << ", z: ";
-      pStream << p.z;
-      pStream << ", wx: ";
-      pStream << p.wx;
-      pStream << ", wy: ";
-      pStream << p.wy;
-      pStream << ", wz: ";
-      pStream << p.wz;
-      pStream << "}";
-      return pStream;
+      return xWriteToStream(pStream, p);
     }
 
     std::ostream& operator<< (std::ostream& pStream, const PositionAndVelocity& p)
     {
-      pStream.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      pStream << "{q: ";
-      pStream << p.q;
-      pStream << ", dq: ";
-      pStream << p.dq;
-      pStream << "}";
-      return pStream;
+      return xWriteToStream(pStream, p);
     }
 
-
     std::ostream& operator<< (std::ostream& pStream, const Rotation& p)
     {
-      pStream.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      pStream << p.r1_c1;
-      pStream << " ";
-      pStream << p.r1_c2;
-      pStream << " ";
-      pStream << p.r1_c3;
-      pStream << " ";
-      pStream << p.r2_c1;
-      pStream << " ";
-      pStream << p.r2_c2;
-      pStream << " ";
-      pStream << p.r2_c3;
-      pStream << " ";
-      pStream << p.r3_c1;
-      pStream << " ";
-      pStream << p.r3_c2;
-      pStream << " ";
-      pStream << p.r3_c3;
-      pStream << std::endl;
-      return pStream;
+      return xWriteToStream(pStream, p);
     }
 
-
     std::ostream& operator<< (std::ostream& pStream, const Rotation3D& p)
     {
-      pStream.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      pStream << "{wx: ";
-      pStream << p.wx;
-      pStream << " ,wy: ";
-      pStream << p.wy;
-      pStream << " ,wz: ";
-      pStream << p.wz;
-      pStream << "}";
-      return pStream;
+      return xWriteToStream(pStream, p);
     }
 
     std::ostream& operator<< (std::ostream& pStream, const Transform& pT)
     {
-      pStream.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      //pStream << std::setw(10) << std::setprecision(6);
-      pStream << pT.r1_c1;
-      pStream << " ";
-      pStream << pT.r1_c2;
-      pStream << " ";
-      pStream << pT.r1_c3;
-      pStream << " ";
-      pStream << pT.r1_c4;
-      pStream << std::endl;
-      pStream << pT.r2_c1;
-      pStream << " ";
-      pStream << pT.r2_c2;
-      pStream << " ";
-      pStream << pT.r2_c3;
-      pStream << " ";
-      pStream << pT.r2_c4;
-      pStream << std::endl;
-      pStream << pT.r3_c1;
-      pStream << " ";
-      pStream << pT.r3_c2;
-      pStream << " ";
-      pStream << pT.r3_c3;
-      pStream << " ";
-      pStream << pT.r3_c4;
-      pStream << std::endl;
-      pStream << "0.0 0.0 0.0 1.0";
-      pStream << std::endl;
-      return pStream;
+      return xWriteToStream(pStream, pT);
     }
 
-
     std::ostream& operator<< (std::ostream& pStream, const TransformAndVelocity6D& pDat)
     {
-      pStream.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      //pStream << std::setw(10) << std::setprecision(6);
-      pStream << pDat.T.r1_c1;
-      pStream << " ";
-      pStream << pDat.T.r1_c2;
-      pStream << " ";
-      pStream << pDat.T.r1_c3;
-      pStream << " ";
-      pStream << pDat.T.r1_c4;
-      pStream << std::endl;
-      pStream << pDat.T.r2_c1;
-      pStream << " ";
-      pStream << pDat.T.r2_c2;
-      pStream << " ";
-      pStream << pDat.T.r2_c3;
-      pStream << " ";
-      pStream << pDat.T.r2_c4;
-      pStream << std::endl;
-      pStream << pDat.T.r3_c1;
-      pStream << " ";
-      pStream << pDat.T.r3_c2;
-      pStream << " ";
-      pStream << pDat.T.r3_c3;
-      pStream << " ";
-      pStream << pDat.T.r3_c4;
-      pStream << std::endl;
-      pStream << "0.0 0.0 0.0 1.0";
-      pStream << std::endl;
-      pStream << "{xd: ";
-      pStream << pDat.V.xd;
-      pStream << " ,yd: ";
-      pStream << pDat.V.yd;
-      pStream << " ,zd: ";
-      pStream << pDat.V.zd;
-      pStream << " ,wxd: ";
-      pStream << pDat.V.wxd;
-      pStream << " ,wyd: ";
-      pStream << pDat.V.wyd;
-      pStream << " ,wzd: ";
-      pStream << pDat.V.wzd;
-      pStream << "}";
-      return pStream;
+      return xWriteToStream(pStream, pDat);
     }
 
     std::ostream& operator<< (std::ostream& pStream, const Velocity3D& p)
     {
-      pStream.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      pStream << "{xd: ";
-      pStream << p.xd;
-      pStream << ", yd:";
-      pStream << p.yd;
-      pStream << ", zd:";
-      pStream << p.zd;
-      pStream << "}";
-      return pStream;
+      return xWriteToStream(pStream, p);
     }
 
     std::ostream& operator<< (std::ostream& pStream, const Velocity6D& p)
     {
-      pStream.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      pStream << "{xd: ";
-      pStream << p.xd;
-      pStream << " ,yd: ";
-      pStream << p.yd;
-      pStream << " ,zd: ";
-      pStream << p.zd;
-      pStream << " ,wxd: ";
-      pStream << p.wxd;
-      pStream << " ,wyd: ";
-      pStream << p.wyd;
-      pStream << " ,wzd: ";
-      pStream << p.wzd;
-      pStream << "}";
-      return pStream;
+      return xWriteToStream(pStream, p);
     }
 
+    std::ostream& operator<< (std::ostream& pStream, const Quaternion& p)
+    {
+      return xWriteToStream(pStream, p);
+    }
 
 
     std::string toSpaceSeparated(const Velocity6D& p)
     {
-      std::stringstream os;
-      os.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      os << p.xd << " ";
-      os << p.yd << " ";
-      os << p.zd << " ";
-      os << p.wxd << " ";
-      os << p.wyd << " ";
-      os << p.wzd << " ";
-      return os.str();
+      return xToSpaceSeparated(p);
     }
 
     std::string toSpaceSeparated(const Transform& pT)
     {
-      std::stringstream os;
-      os.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      os << pT.r1_c1 << " ";
-      os << pT.r1_c2 << " ";
-      os << pT.r1_c3 << " ";
-      os << pT.r1_c4 << " ";
-      os << pT.r2_c1 << " ";
-      os << pT.r2_c2 << " ";
-      os << pT.r2_c3 << " ";
-      os << pT.r2_c4 << " ";
-      os << pT.r3_c1 << " ";
-      os << pT.r3_c2 << " ";
-      os << pT.r3_c3 << " ";
-      os << pT.r3_c4 << " ";
-      os << "0.0 0.0 0.0 1.0 ";
-      return os.str();
+      return xToSpaceSeparated(pT);
     }
 
     std::string toSpaceSeparated(const Position3D& p)
     {
-      std::stringstream os;
-      os.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      os << p.x << " ";
-      os << p.y << " ";
-      os << p.z << " ";
-      return os.str();
+      return xToSpaceSeparated(p);
     }
 
     std::string toSpaceSeparated(const Position6D& p)
     {
-      std::stringstream os;
-      os.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      os << p.x << " ";
-      os << p.y << " ";
-      os << p.z << " ";
-      os << p.wx << " ";
-      os << p.wy << " ";
-      os << p.wz << " ";
-      return os.str();
+      return xToSpaceSeparated(p);
     }
 
-    std::ostream& operator<< (std::ostream& pStream, const Quaternion& p)
-    {
-      pStream.setf(std::ios::showpoint | std::ios::left | std::ios::showpos);
-      pStream << "{w: ";
-      pStream << p.w;
-      pStream << ", x:";
-      pStream << p.x;
-      pStream << ", y:";
-      pStream << p.y;
-      pStream << ", z:";
-      pStream << p.z;
-      pStream << "}";
-      return pStream;
-    }
+
+#define ALMATH_INSTANTIATE_FORMAT(T)                                    \
+    template unsigned int format<T>(                                    \
+      const T&, char*, const unsigned int&,                             \
+      const TEXT_FORMAT&, const int&);                                  \
+    template unsigned int formatArray<T>(                               \
+      const T*, const unsigned int&, char*, const unsigned int&,        \
+      const TEXT_FORMAT&, const int&);                                  \
+    template unsigned int formatCsvHeader<T>(char*, const unsigned int&); \
+    template ParseResult parse<T>(                                      \
+      const char*, const char*, T&, const TEXT_FORMAT&);                \
+    template ParseResult parseArray<T>(                                 \
+      const char*, const char*, std::vector<T>&, const TEXT_FORMAT&);
+
+    ALMATH_INSTANTIATE_FORMAT(Pose2D)
+    ALMATH_INSTANTIATE_FORMAT(Position2D)
+    ALMATH_INSTANTIATE_FORMAT(Position3D)
+    ALMATH_INSTANTIATE_FORMAT(Position6D)
+    ALMATH_INSTANTIATE_FORMAT(PositionAndVelocity)
+    ALMATH_INSTANTIATE_FORMAT(Quaternion)
+    ALMATH_INSTANTIATE_FORMAT(Rotation)
+    ALMATH_INSTANTIATE_FORMAT(Rotation3D)
+    ALMATH_INSTANTIATE_FORMAT(Transform)
+    ALMATH_INSTANTIATE_FORMAT(TransformAndVelocity6D)
+    ALMATH_INSTANTIATE_FORMAT(Velocity3D)
+    ALMATH_INSTANTIATE_FORMAT(Velocity6D)
+#undef ALMATH_INSTANTIATE_FORMAT
 
   }
 }
@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alodometry.h>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace AL {
+  namespace Math {
+
+    /****************************
+    PRIVATE FUNCTION
+    ****************************/
+    static const double xOdometryPi = 3.14159265358979323846;
+
+    // <summary> Wrap an angle in [-pi, pi]. </summary>
+    double xWrapAngle(const double& pAngle)
+    {
+      return pAngle - 2.0*xOdometryPi*std::floor((pAngle + xOdometryPi)/(2.0*xOdometryPi));
+    }
+
+    // <summary> Check that the timestamps do not decrease, from the last
+    //  one if any. </summary>
+    void xCheckTimes(
+      const double*       pTimes,
+      const unsigned int& pSize,
+      const bool&         pHasSample,
+      const double&       pLastTime)
+    {
+      for (unsigned int i=0; i<pSize; i++)
+      {
+        const bool hasPrevious = (i > 0) || pHasSample;
+        const double previous = (i > 0) ? pTimes[i - 1] : pLastTime;
+        if (hasPrevious && (pTimes[i] < previous))
+        {
+          throw std::invalid_argument(
+            "ALOdometry: addVelocities timestamps must not decrease.");
+        }
+      }
+    }
+
+    // <summary> Exponential of a rotation vector pW, in double:
+    //  pRotation = exp([pW]), row major, and, if pV is not null,
+    //  pTranslation = V(pW)*pV, the translation of the SE(3) exponential
+    //  (same formulas as velocityExponentialInPlace). </summary>
+    void xOdometryExponential(
+      const double* pW,
+      const double* pV,
+      double*       pRotation,
+      double*       pTranslation)
+    {
+      const double angle2 = pW[0]*pW[0] + pW[1]*pW[1] + pW[2]*pW[2];
+      const double angle = std::sqrt(angle2);
+      double sc, cc, dsc;
+      if (angle > 1.0e-4)
+      {
+        sc  = std::sin(angle)/angle;
+        cc  = (1.0 - std::cos(angle))/angle2;
+        dsc = (angle - std::sin(angle))/(angle2*angle);
+      }
+      else
+      {
+        sc  = 1.0 - angle2/6.0;
+        cc  = 0.5 - angle2/24.0;
+        dsc = 1.0/6.0 - angle2/120.0;
+      }
+
+      // cross product matrix of pW
+      const double k[9] = {
+        0.0,    -pW[2],  pW[1],
+        pW[2],   0.0,   -pW[0],
+       -pW[1],   pW[0],  0.0};
+      for (unsigned int i=0; i<3; i++)
+      {
+        for (unsigned int j=0; j<3; j++)
+        {
+          const double diagonal = (i == j) ? 1.0 : 0.0;
+          pRotation[3*i + j] = diagonal*(1.0 - cc*angle2) + cc*pW[i]*pW[j] + sc*k[3*i + j];
+        }
+      }
+
+      if (pV != 0)
+      {
+        for (unsigned int i=0; i<3; i++)
+        {
+          pTranslation[i] = 0.0;
+          for (unsigned int j=0; j<3; j++)
+          {
+            const double diagonal = (i == j) ? 1.0 : 0.0;
+            pTranslation[i] += (diagonal*sc + dsc*pW[i]*pW[j] + cc*k[3*i + j])*pV[j];
+          }
+        }
+      }
+    }
+
+    // <summary> Make a rotation orthonormal, in double: Gram-Schmidt on
+    //  the rows. A float rotation is orthonormal to 1e-7 only, and its
+    //  error would grow along a chain of compositions. </summary>
+    void xOdometryOrthonormalize(double* pRotation)
+    {
+      double* r1 = &pRotation[0];
+      double* r2 = &pRotation[3];
+      double* r3 = &pRotation[6];
+
+      double norm = std::sqrt(r1[0]*r1[0] + r1[1]*r1[1] + r1[2]*r1[2]);
+      for (unsigned int i=0; i<3; i++)
+      {
+        r1[i] /= norm;
+      }
+      const double dot = r1[0]*r2[0] + r1[1]*r2[1] + r1[2]*r2[2];
+      for (unsigned int i=0; i<3; i++)
+      {
+        r2[i] -= dot*r1[i];
+      }
+      norm = std::sqrt(r2[0]*r2[0] + r2[1]*r2[1] + r2[2]*r2[2]);
+      for (unsigned int i=0; i<3; i++)
+      {
+        r2[i] /= norm;
+      }
+      r3[0] = r1[1]*r2[2] - r1[2]*r2[1];
+      r3[1] = r1[2]*r2[0] - r1[0]*r2[2];
+      r3[2] = r1[0]*r2[1] - r1[1]*r2[0];
+    }
+
+    // <summary> Convert a velocity to double: the linear velocity, then
+    //  the angular velocity. </summary>
+    void xOdometryVelocity(
+      const Velocity6D& pVelocity,
+      double*           pValues)
+    {
+      pValues[0] = pVelocity.xd;
+      pValues[1] = pVelocity.yd;
+      pValues[2] = pVelocity.zd;
+      pValues[3] = pVelocity.wxd;
+      pValues[4] = pVelocity.wyd;
+      pValues[5] = pVelocity.wzd;
+    }
+
+    /****************************
+    Pose2DIntegrator
+    ****************************/
+    Pose2DIntegrator::Pose2DIntegrator(const ODOMETRY_INTEGRATION_MODE& pMode):
+      fMode(pMode),
+      fX(0.0),
+      fY(0.0),
+      fTheta(0.0),
+      fHasSample(false),
+      fLastVelocity(),
+      fLastTime(0.0) {}
+
+    void Pose2DIntegrator::reset(const Pose2D& pPose)
+    {
+      fX = pPose.x;
+      fY = pPose.y;
+      fTheta = xWrapAngle(pPose.theta);
+      fHasSample = false;
+    }
+
+    void Pose2DIntegrator::addIncrement(const Pose2D& pIncrement)
+    {
+      const double cos = std::cos(fTheta);
+      const double sin = std::sin(fTheta);
+      fX += cos*pIncrement.x - sin*pIncrement.y;
+      fY += sin*pIncrement.x + cos*pIncrement.y;
+      fTheta = xWrapAngle(fTheta + pIncrement.theta);
+    }
+
+    void Pose2DIntegrator::addVelocity(
+      const Pose2D& pVelocity,
+      const float&  pDuration)
+    {
+      xMove(pVelocity.x, pVelocity.y, pVelocity.theta, pDuration);
+    }
+
+    void Pose2DIntegrator::addVelocities(
+      const Pose2D*       pVelocities,
+      const double*       pTimes,
+      const unsigned int& pSize)
+    {
+      xCheckTimes(pTimes, pSize, fHasSample, fLastTime);
+      for (unsigned int i=0; i<pSize; i++)
+      {
+        if (fHasSample)
+        {
+          const Pose2D& last = fLastVelocity;
+          const Pose2D& next = pVelocities[i];
+          const double duration = pTimes[i] - fLastTime;
+          if (fMode == ODOMETRY_INTEGRATION_MIDPOINT)
+          {
+            xMove(0.5*(static_cast<double>(last.x) + next.x),
+                  0.5*(static_cast<double>(last.y) + next.y),
+                  0.5*(static_cast<double>(last.theta) + next.theta),
+                  duration);
+          }
+          else
+          {
+            xMove(last.x, last.y, last.theta, duration);
+          }
+        }
+        fLastVelocity = pVelocities[i];
+        fLastTime = pTimes[i];
+        fHasSample = true;
+      }
+    }
+
+    Pose2D Pose2DIntegrator::getPose() const
+    {
+      return Pose2D(static_cast<float>(fX),
+                    static_cast<float>(fY),
+                    static_cast<float>(fTheta));
+    }
+
+    void Pose2DIntegrator::xMove(
+      const double& pVx,
+      const double& pVy,
+      const double& pVtheta,
+      const double& pDuration)
+    {
+      const double angle = pVtheta*pDuration;
+      double dx = pVx*pDuration;
+      double dy = pVy*pDuration;
+      double heading = fTheta;
+      if (fMode == ODOMETRY_INTEGRATION_MIDPOINT)
+      {
+        heading += 0.5*angle;
+      }
+      else if (fMode == ODOMETRY_INTEGRATION_EXPONENTIAL)
+      {
+        // exact motion on an arc
+        double sc, cc;
+        if (std::fabs(angle) > 1.0e-4)
+        {
+          sc = std::sin(angle)/angle;
+          cc = (1.0 - std::cos(angle))/angle;
+        }
+        else
+        {
+          sc = 1.0 - angle*angle/6.0;
+          cc = 0.5*angle - angle*angle*angle/24.0;
+        }
+        const double arcX = sc*dx - cc*dy;
+        const double arcY = cc*dx + sc*dy;
+        dx = arcX;
+        dy = arcY;
+      }
+
+      const double cos = std::cos(heading);
+      const double sin = std::sin(heading);
+      fX += cos*dx - sin*dy;
+      fY += sin*dx + cos*dy;
+      fTheta = xWrapAngle(fTheta + angle);
+    }
+
+    /****************************
+    TransformIntegrator
+    ****************************/
+    TransformIntegrator::TransformIntegrator(const ODOMETRY_INTEGRATION_MODE& pMode):
+      fMode(pMode),
+      fHasSample(false),
+      fLastVelocity(),
+      fLastTime(0.0)
+    {
+      reset();
+    }
+
+    void TransformIntegrator::reset(const Transform& pTransform)
+    {
+      fRotation[0] = pTransform.r1_c1;
+      fRotation[1] = pTransform.r1_c2;
+      fRotation[2] = pTransform.r1_c3;
+      fRotation[3] = pTransform.r2_c1;
+      fRotation[4] = pTransform.r2_c2;
+      fRotation[5] = pTransform.r2_c3;
+      fRotation[6] = pTransform.r3_c1;
+      fRotation[7] = pTransform.r3_c2;
+      fRotation[8] = pTransform.r3_c3;
+      fTranslation[0] = pTransform.r1_c4;
+      fTranslation[1] = pTransform.r2_c4;
+      fTranslation[2] = pTransform.r3_c4;
+      xOdometryOrthonormalize(fRotation);
+      fHasSample = false;
+    }
+
+    void TransformIntegrator::addIncrement(const Transform& pIncrement)
+    {
+      double rotation[9] = {
+        pIncrement.r1_c1, pIncrement.r1_c2, pIncrement.r1_c3,
+        pIncrement.r2_c1, pIncrement.r2_c2, pIncrement.r2_c3,
+        pIncrement.r3_c1, pIncrement.r3_c2, pIncrement.r3_c3};
+      xOdometryOrthonormalize(rotation);
+      const double translation[3] = {
+        pIncrement.r1_c4, pIncrement.r2_c4, pIncrement.r3_c4};
+      xCompose(rotation, translation);
+    }
+
+    void TransformIntegrator::addVelocity(
+      const Velocity6D& pVelocity,
+      const float&      pDuration)
+    {
+      double velocity[6];
+      xOdometryVelocity(pVelocity, velocity);
+      xMove(velocity, pDuration);
+    }
+
+    void TransformIntegrator::addVelocities(
+      const Velocity6D*   pVelocities,
+      const double*       pTimes,
+      const unsigned int& pSize)
+    {
+      xCheckTimes(pTimes, pSize, fHasSample, fLastTime);
+      for (unsigned int i=0; i<pSize; i++)
+      {
+        if (fHasSample)
+        {
+          const double duration = pTimes[i] - fLastTime;
+          double velocity[6];
+          xOdometryVelocity(fLastVelocity, velocity);
+          if (fMode == ODOMETRY_INTEGRATION_MIDPOINT)
+          {
+            double next[6];
+            xOdometryVelocity(pVelocities[i], next);
+            for (unsigned int j=0; j<6; j++)
+            {
+              velocity[j] = 0.5*(velocity[j] + next[j]);
+            }
+          }
+          xMove(velocity, duration);
+        }
+        fLastVelocity = pVelocities[i];
+        fLastTime = pTimes[i];
+        fHasSample = true;
+      }
+    }
+
+    Transform TransformIntegrator::getTransform() const
+    {
+      Transform result;
+      result.r1_c1 = static_cast<float>(fRotation[0]);
+      result.r1_c2 = static_cast<float>(fRotation[1]);
+      result.r1_c3 = static_cast<float>(fRotation[2]);
+      result.r2_c1 = static_cast<float>(fRotation[3]);
+      result.r2_c2 = static_cast<float>(fRotation[4]);
+      result.r2_c3 = static_cast<float>(fRotation[5]);
+      result.r3_c1 = static_cast<float>(fRotation[6]);
+      result.r3_c2 = static_cast<float>(fRotation[7]);
+      result.r3_c3 = static_cast<float>(fRotation[8]);
+      result.r1_c4 = static_cast<float>(fTranslation[0]);
+      result.r2_c4 = static_cast<float>(fTranslation[1]);
+      result.r3_c4 = static_cast<float>(fTranslation[2]);
+      return result;
+    }
+
+    void TransformIntegrator::xMove(
+      const double* pVelocity,
+      const double& pDuration)
+    {
+      const double w[3] = {
+        pVelocity[3]*pDuration, pVelocity[4]*pDuration, pVelocity[5]*pDuration};
+      const double v[3] = {
+        pVelocity[0]*pDuration, pVelocity[1]*pDuration, pVelocity[2]*pDuration};
+
+      double rotation[9];
+      double translation[3];
+      if (fMode == ODOMETRY_INTEGRATION_EXPONENTIAL)
+      {
+        xOdometryExponential(w, v, rotation, translation);
+      }
+      else
+      {
+        xOdometryExponential(w, 0, rotation, 0);
+        translation[0] = v[0];
+        translation[1] = v[1];
+        translation[2] = v[2];
+        if (fMode == ODOMETRY_INTEGRATION_MIDPOINT)
+        {
+          // translation with the rotation at the middle of the step
+          const double halfW[3] = {0.5*w[0], 0.5*w[1], 0.5*w[2]};
+          double halfRotation[9];
+          xOdometryExponential(halfW, 0, halfRotation, 0);
+          for (unsigned int i=0; i<3; i++)
+          {
+            translation[i] = halfRotation[3*i]*v[0] + halfRotation[3*i + 1]*v[1] +
+                halfRotation[3*i + 2]*v[2];
+          }
+        }
+      }
+      xCompose(rotation, translation);
+    }
+
+    void TransformIntegrator::xCompose(
+      const double* pRotation,
+      const double* pTranslation)
+    {
+      double rotation[9];
+      for (unsigned int i=0; i<3; i++)
+      {
+        fTranslation[i] += fRotation[3*i]*pTranslation[0] +
+            fRotation[3*i + 1]*pTranslation[1] + fRotation[3*i + 2]*pTranslation[2];
+        for (unsigned int j=0; j<3; j++)
+        {
+          rotation[3*i + j] = fRotation[3*i]*pRotation[j] +
+              fRotation[3*i + 1]*pRotation[3 + j] + fRotation[3*i + 2]*pRotation[6 + j];
+        }
+      }
+      for (unsigned int i=0; i<9; i++)
+      {
+        fRotation[i] = rotation[i];
+      }
+    }
+
+  } // namespace Math
+} // namespace AL
@@ -0,0 +1,769 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alpolygonbroadphase.h>
+#include <almath/tools/avoidfootcollision.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+
+namespace AL
+{
+  namespace Math
+  {
+    /****************************
+    PRIVATE FUNCTION
+    ****************************/
+    // <summary> Compute the bounding box of a polygon. </summary>
+    // <param name="pPolygon"> the polygon. </param>
+    // <param name="pMin">     the lower corner of the box. </param>
+    // <param name="pMax">     the upper corner of the box. </param>
+    void xPolygonBox(
+      const std::vector<AL::Math::Position2D>& pPolygon,
+      AL::Math::Position2D&                    pMin,
+      AL::Math::Position2D&                    pMax);
+
+    // <summary> Compute the perimeter of the union of two boxes. </summary>
+    float xUnionPerimeter(
+      const AL::Math::Position2D& pMinA,
+      const AL::Math::Position2D& pMaxA,
+      const AL::Math::Position2D& pMinB,
+      const AL::Math::Position2D& pMaxB);
+
+    // <summary> Query if two boxes overlap. </summary>
+    const bool xIsBoxOverlapping(
+      const AL::Math::Position2D& pMinA,
+      const AL::Math::Position2D& pMaxA,
+      const AL::Math::Position2D& pMinB,
+      const AL::Math::Position2D& pMaxB);
+
+    // <summary> Clip the fractions of a segment which are inside a box
+    //  (slab method). </summary>
+    // <param name="pStart">  the start of the segment. </param>
+    // <param name="pDelta">  the end minus the start of the segment. </param>
+    // <param name="pMin">    the lower corner of the box. </param>
+    // <param name="pMax">    the upper corner of the box. </param>
+    // <param name="pEnter">  the fraction where the segment enters the box. </param>
+    // <param name="pExit">   the fraction where the segment exits the box. </param>
+    // <returns> true if the segment crosses the box. </returns>
+    const bool xClipSegmentWithBox(
+      const AL::Math::Position2D& pStart,
+      const AL::Math::Position2D& pDelta,
+      const AL::Math::Position2D& pMin,
+      const AL::Math::Position2D& pMax,
+      float&                      pEnter,
+      float&                      pExit);
+
+    // <summary> Compute the fraction of a segment where it enters a convex
+    //  polygon (Cyrus-Beck). </summary>
+    // <param name="pStart">    the start of the segment. </param>
+    // <param name="pDelta">    the end minus the start of the segment. </param>
+    // <param name="pPolygon">  the convex polygon. </param>
+    // <param name="pFraction"> the fraction, 0 if the start is inside. </param>
+    // <returns> true if the segment crosses the polygon. </returns>
+    const bool xClipSegmentWithPolygon(
+      const AL::Math::Position2D&              pStart,
+      const AL::Math::Position2D&              pDelta,
+      const std::vector<AL::Math::Position2D>& pPolygon,
+      float&                                   pFraction);
+
+
+    void xPolygonBox(
+      const std::vector<AL::Math::Position2D>& pPolygon,
+      AL::Math::Position2D&                    pMin,
+      AL::Math::Position2D&                    pMax)
+    {
+      pMin = AL::Math::Position2D(FLT_MAX, FLT_MAX);
+      pMax = AL::Math::Position2D(-FLT_MAX, -FLT_MAX);
+      for (unsigned int i=0; i<pPolygon.size(); i++)
+      {
+        pMin.x = std::min(pMin.x, pPolygon[i].x);
+        pMin.y = std::min(pMin.y, pPolygon[i].y);
+        pMax.x = std::max(pMax.x, pPolygon[i].x);
+        pMax.y = std::max(pMax.y, pPolygon[i].y);
+      }
+    } // end xPolygonBox()
+
+
+    float xUnionPerimeter(
+      const AL::Math::Position2D& pMinA,
+      const AL::Math::Position2D& pMaxA,
+      const AL::Math::Position2D& pMinB,
+      const AL::Math::Position2D& pMaxB)
+    {
+      return 2.0f*(std::max(pMaxA.x, pMaxB.x) - std::min(pMinA.x, pMinB.x) +
+                   std::max(pMaxA.y, pMaxB.y) - std::min(pMinA.y, pMinB.y));
+    } // end xUnionPerimeter()
+
+
+    const bool xIsBoxOverlapping(
+      const AL::Math::Position2D& pMinA,
+      const AL::Math::Position2D& pMaxA,
+      const AL::Math::Position2D& pMinB,
+      const AL::Math::Position2D& pMaxB)
+    {
+      return (pMinA.x <= pMaxB.x) && (pMinB.x <= pMaxA.x) &&
+          (pMinA.y <= pMaxB.y) && (pMinB.y <= pMaxA.y);
+    } // end xIsBoxOverlapping()
+
+
+    const bool xClipSegmentWithBox(
+      const AL::Math::Position2D& pStart,
+      const AL::Math::Position2D& pDelta,
+      const AL::Math::Position2D& pMin,
+      const AL::Math::Position2D& pMax,
+      float&                      pEnter,
+      float&                      pExit)
+    {
+      pEnter = 0.0f;
+      pExit = 1.0f;
+
+      const float start[2] = {pStart.x, pStart.y};
+      const float delta[2] = {pDelta.x, pDelta.y};
+      const float boxMin[2] = {pMin.x, pMin.y};
+      const float boxMax[2] = {pMax.x, pMax.y};
+      for (unsigned int i=0; i<2; i++)
+      {
+        if (delta[i] == 0.0f)
+        {
+          if ((start[i] < boxMin[i]) || (start[i] > boxMax[i]))
+          {
+            return false;
+          }
+          continue;
+        }
+        float t1 = (boxMin[i] - start[i])/delta[i];
+        float t2 = (boxMax[i] - start[i])/delta[i];
+        if (t1 > t2)
+        {
+          std::swap(t1, t2);
+        }
+        pEnter = std::max(pEnter, t1);
+        pExit = std::min(pExit, t2);
+        if (pEnter > pExit)
+        {
+          return false;
+        }
+      }
+      return true;
+    } // end xClipSegmentWithBox()
+
+
+    const bool xClipSegmentWithPolygon(
+      const AL::Math::Position2D&              pStart,
+      const AL::Math::Position2D&              pDelta,
+      const std::vector<AL::Math::Position2D>& pPolygon,
+      float&                                   pFraction)
+    {
+      const unsigned int size = pPolygon.size();
+      float area = 0.0f;
+      for (unsigned int i=0; i<size; i++)
+      {
+        const AL::Math::Position2D& next = pPolygon[(i+1 == size) ? 0 : i+1];
+        area += pPolygon[i].x*next.y - next.x*pPolygon[i].y;
+      }
+      const float orientation = (area > 0.0f) ? 1.0f : -1.0f;
+
+      float enter = 0.0f;
+      float exit = 1.0f;
+      for (unsigned int i=0; i<size; i++)
+      {
+        const AL::Math::Position2D& next = pPolygon[(i+1 == size) ? 0 : i+1];
+        // outward normal, not normalized
+        const float normalX =  orientation*(next.y - pPolygon[i].y);
+        const float normalY = -orientation*(next.x - pPolygon[i].x);
+        const float numerator = normalX*(pPolygon[i].x - pStart.x) +
+            normalY*(pPolygon[i].y - pStart.y);
+        const float denominator = normalX*pDelta.x + normalY*pDelta.y;
+
+        if (denominator == 0.0f)
+        {
+          // parallel to the edge, outside of it
+          if (numerator < 0.0f)
+          {
+            return false;
+          }
+        }
+        else if (denominator < 0.0f)
+        {
+          enter = std::max(enter, numerator/denominator);
+        }
+        else
+        {
+          exit = std::min(exit, numerator/denominator);
+        }
+
+        if (enter > exit)
+        {
+          return false;
+        }
+      }
+      pFraction = enter;
+      return true;
+    } // end xClipSegmentWithPolygon()
+
+    /****************************
+    PUBLIC FUNCTION
+    ****************************/
+    bool PolygonBroadPhase::Node::isLeaf() const
+    {
+      return (child1 < 0);
+    }
+
+
+    PolygonBroadPhase::PolygonBroadPhase(const float& pMargin) :
+      fMargin(pMargin),
+      fRoot(-1),
+      fFreeList(-1),
+      fNbPolygons(0),
+      fNodes() {}
+
+
+    int PolygonBroadPhase::insert(const std::vector<Position2D>& pPolygon)
+    {
+      const int leaf = xAllocateNode();
+      fNodes[leaf].polygon = pPolygon;
+      fNodes[leaf].height = 0;
+      xSetFatBox(leaf, pPolygon);
+      xInsertLeaf(leaf);
+      ++fNbPolygons;
+      return leaf;
+    }
+
+
+    const bool PolygonBroadPhase::update(
+      const int&                     pId,
+      const std::vector<Position2D>& pPolygon)
+    {
+      xCheckId(pId);
+      fNodes[pId].polygon = pPolygon;
+
+      Position2D boxMin;
+      Position2D boxMax;
+      xPolygonBox(pPolygon, boxMin, boxMax);
+      const Node& leaf = fNodes[pId];
+      if ((leaf.boxMin.x <= boxMin.x) && (leaf.boxMin.y <= boxMin.y) &&
+          (boxMax.x <= leaf.boxMax.x) && (boxMax.y <= leaf.boxMax.y))
+      {
+        return false;
+      }
+
+      xRemoveLeaf(pId);
+      xSetFatBox(pId, pPolygon);
+      xInsertLeaf(pId);
+      return true;
+    }
+
+
+    void PolygonBroadPhase::remove(const int& pId)
+    {
+      xCheckId(pId);
+      xRemoveLeaf(pId);
+      xFreeNode(pId);
+      --fNbPolygons;
+    }
+
+
+    const std::vector<Position2D>& PolygonBroadPhase::getPolygon(
+      const int& pId) const
+    {
+      xCheckId(pId);
+      return fNodes[pId].polygon;
+    }
+
+
+    unsigned int PolygonBroadPhase::size() const
+    {
+      return fNbPolygons;
+    }
+
+
+    int PolygonBroadPhase::getHeight() const
+    {
+      return (fRoot < 0) ? 0 : fNodes[fRoot].height + 1;
+    }
+
+
+    void PolygonBroadPhase::queryBox(
+      const Position2D& pMin,
+      const Position2D& pMax,
+      std::vector<int>& pIds) const
+    {
+      pIds.clear();
+      if (fRoot < 0)
+      {
+        return;
+      }
+
+      std::vector<int> stack;
+      stack.reserve(64);
+      stack.push_back(fRoot);
+      while (!stack.empty())
+      {
+        const int index = stack.back();
+        stack.pop_back();
+        const Node& node = fNodes[index];
+        if (!xIsBoxOverlapping(node.boxMin, node.boxMax, pMin, pMax))
+        {
+          continue;
+        }
+        if (node.isLeaf())
+        {
+          pIds.push_back(index);
+        }
+        else
+        {
+          stack.push_back(node.child1);
+          stack.push_back(node.child2);
+        }
+      }
+    }
+
+
+    void PolygonBroadPhase::queryCollisions(
+      const std::vector<Position2D>& pPolygon,
+      std::vector<int>&              pIds) const
+    {
+      Position2D boxMin;
+      Position2D boxMax;
+      xPolygonBox(pPolygon, boxMin, boxMax);
+
+      std::vector<int> candidates;
+      queryBox(boxMin, boxMax, candidates);
+
+      pIds.clear();
+      for (unsigned int i=0; i<candidates.size(); i++)
+      {
+        if (areConvexPolygonsInCollision(pPolygon, fNodes[candidates[i]].polygon))
+        {
+          pIds.push_back(candidates[i]);
+        }
+      }
+    }
+
+
+    void PolygonBroadPhase::queryPairs(
+      std::vector<std::pair<int, int> >& pPairs) const
+    {
+      pPairs.clear();
+      std::vector<int> candidates;
+      for (unsigned int i=0; i<fNodes.size(); i++)
+      {
+        if ((fNodes[i].height != 0))
+        {
+          continue;
+        }
+        queryBox(fNodes[i].boxMin, fNodes[i].boxMax, candidates);
+        for (unsigned int j=0; j<candidates.size(); j++)
+        {
+          // each pair once
+          if (candidates[j] > static_cast<int>(i))
+          {
+            pPairs.push_back(std::make_pair(static_cast<int>(i), candidates[j]));
+          }
+        }
+      }
+    }
+
+
+    void PolygonBroadPhase::queryCollidingPairs(
+      std::vector<std::pair<int, int> >& pPairs) const
+    {
+      std::vector<std::pair<int, int> > candidates;
+      queryPairs(candidates);
+
+      pPairs.clear();
+      for (unsigned int i=0; i<candidates.size(); i++)
+      {
+        if (areConvexPolygonsInCollision(fNodes[candidates[i].first].polygon,
+                                         fNodes[candidates[i].second].polygon))
+        {
+          pPairs.push_back(candidates[i]);
+        }
+      }
+    }
+
+
+    void PolygonBroadPhase::queryRay(
+      const Position2D& pStart,
+      const Position2D& pEnd,
+      std::vector<int>& pIds) const
+    {
+      pIds.clear();
+      if (fRoot < 0)
+      {
+        return;
+      }
+
+      const Position2D delta = pEnd - pStart;
+      float enter, exit;
+      std::vector<int> stack;
+      stack.reserve(64);
+      stack.push_back(fRoot);
+      while (!stack.empty())
+      {
+        const int index = stack.back();
+        stack.pop_back();
+        const Node& node = fNodes[index];
+        if (!xClipSegmentWithBox(pStart, delta, node.boxMin, node.boxMax,
+                                 enter, exit))
+        {
+          continue;
+        }
+        if (node.isLeaf())
+        {
+          pIds.push_back(index);
+        }
+        else
+        {
+          stack.push_back(node.child1);
+          stack.push_back(node.child2);
+        }
+      }
+    }
+
+
+    const bool PolygonBroadPhase::raycast(
+      const Position2D& pStart,
+      const Position2D& pEnd,
+      int&              pId,
+      float&            pFraction) const
+    {
+      if (fRoot < 0)
+      {
+        return false;
+      }
+
+      const Position2D delta = pEnd - pStart;
+      float bestFraction = FLT_MAX;
+      int bestId = -1;
+      float enter, exit, fraction;
+      std::vector<int> stack;
+      stack.reserve(64);
+      stack.push_back(fRoot);
+      while (!stack.empty())
+      {
+        const int index = stack.back();
+        stack.pop_back();
+        const Node& node = fNodes[index];
+        // the boxes beyond the best hit are skipped
+        if (!xClipSegmentWithBox(pStart, delta, node.boxMin, node.boxMax,
+                                 enter, exit) ||
+            (enter >= bestFraction))
+        {
+          continue;
+        }
+        if (!node.isLeaf())
+        {
+          stack.push_back(node.child1);
+          stack.push_back(node.child2);
+          continue;
+        }
+        if (xClipSegmentWithPolygon(pStart, delta, node.polygon, fraction) &&
+            (fraction < bestFraction))
+        {
+          bestFraction = fraction;
+          bestId = index;
+        }
+      }
+
+      if (bestId < 0)
+      {
+        return false;
+      }
+      pId = bestId;
+      pFraction = bestFraction;
+      return true;
+    }
+
+
+    int PolygonBroadPhase::xAllocateNode()
+    {
+      int node;
+      if (fFreeList >= 0)
+      {
+        node = fFreeList;
+        fFreeList = fNodes[node].parent;
+      }
+      else
+      {
+        fNodes.push_back(Node());
+        node = static_cast<int>(fNodes.size()) - 1;
+      }
+      fNodes[node].parent = -1;
+      fNodes[node].child1 = -1;
+      fNodes[node].child2 = -1;
+      fNodes[node].height = 0;
+      return node;
+    }
+
+
+    void PolygonBroadPhase::xFreeNode(const int& pNode)
+    {
+      fNodes[pNode].polygon.clear();
+      fNodes[pNode].parent = fFreeList;
+      fNodes[pNode].child1 = -1;
+      fNodes[pNode].child2 = -1;
+      fNodes[pNode].height = -1;
+      fFreeList = pNode;
+    }
+
+
+    void PolygonBroadPhase::xSetFatBox(
+      const int&                     pNode,
+      const std::vector<Position2D>& pPolygon)
+    {
+      xPolygonBox(pPolygon, fNodes[pNode].boxMin, fNodes[pNode].boxMax);
+      fNodes[pNode].boxMin -= Position2D(fMargin, fMargin);
+      fNodes[pNode].boxMax += Position2D(fMargin, fMargin);
+    }
+
+
+    void PolygonBroadPhase::xCheckId(const int& pId) const
+    {
+      if ((pId < 0) || (pId >= static_cast<int>(fNodes.size())) ||
+          (fNodes[pId].height != 0))
+      {
+        throw std::invalid_argument(
+            "ALMath: PolygonBroadPhase invalid polygon id.");
+      }
+    }
+
+
+    void PolygonBroadPhase::xInsertLeaf(const int& pLeaf)
+    {
+      if (fRoot < 0)
+      {
+        fRoot = pLeaf;
+        fNodes[pLeaf].parent = -1;
+        return;
+      }
+
+      // find the best sibling: the one which minimizes the increase of the
+      // perimeters of the boxes
+      const Position2D leafMin = fNodes[pLeaf].boxMin;
+      const Position2D leafMax = fNodes[pLeaf].boxMax;
+      int index = fRoot;
+      while (!fNodes[index].isLeaf())
+      {
+        const Node& node = fNodes[index];
+        const float perimeter = 2.0f*(node.boxMax.x - node.boxMin.x +
+                                      node.boxMax.y - node.boxMin.y);
+        const float combined = xUnionPerimeter(node.boxMin, node.boxMax,
+                                               leafMin, leafMax);
+
+        // cost of a new parent for this node and the leaf
+        const float cost = 2.0f*combined;
+        // cost of pushing the leaf further down
+        const float inheritance = 2.0f*(combined - perimeter);
+
+        float childCost[2];
+        const int children[2] = {node.child1, node.child2};
+        for (unsigned int i=0; i<2; i++)
+        {
+          const Node& child = fNodes[children[i]];
+          childCost[i] = xUnionPerimeter(child.boxMin, child.boxMax,
+                                         leafMin, leafMax) + inheritance;
+          if (!child.isLeaf())
+          {
+            childCost[i] -= 2.0f*(child.boxMax.x - child.boxMin.x +
+                                  child.boxMax.y - child.boxMin.y);
+          }
+        }
+
+        if ((cost < childCost[0]) && (cost < childCost[1]))
+        {
+          break;
+        }
+        index = (childCost[0] < childCost[1]) ? children[0] : children[1];
+      }
+
+      const int sibling = index;
+      const int oldParent = fNodes[sibling].parent;
+      const int newParent = xAllocateNode();
+      fNodes[newParent].parent = oldParent;
+      fNodes[newParent].boxMin = Position2D(
+        std::min(leafMin.x, fNodes[sibling].boxMin.x),
+        std::min(leafMin.y, fNodes[sibling].boxMin.y));
+      fNodes[newParent].boxMax = Position2D(
+        std::max(leafMax.x, fNodes[sibling].boxMax.x),
+        std::max(leafMax.y, fNodes[sibling].boxMax.y));
+      fNodes[newParent].height = fNodes[sibling].height + 1;
+      fNodes[newParent].child1 = sibling;
+      fNodes[newParent].child2 = pLeaf;
+      fNodes[sibling].parent = newParent;
+      fNodes[pLeaf].parent = newParent;
+
+      if (oldParent >= 0)
+      {
+        if (fNodes[oldParent].child1 == sibling)
+        {
+          fNodes[oldParent].child1 = newParent;
+        }
+        else
+        {
+          fNodes[oldParent].child2 = newParent;
+        }
+      }
+      else
+      {
+        fRoot = newParent;
+      }
+
+      // refit and balance the ancestors
+      index = fNodes[pLeaf].parent;
+      while (index >= 0)
+      {
+        index = xBalance(index);
+        Node& node = fNodes[index];
+        const Node& child1 = fNodes[node.child1];
+        const Node& child2 = fNodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.boxMin = Position2D(std::min(child1.boxMin.x, child2.boxMin.x),
+                                 std::min(child1.boxMin.y, child2.boxMin.y));
+        node.boxMax = Position2D(std::max(child1.boxMax.x, child2.boxMax.x),
+                                 std::max(child1.boxMax.y, child2.boxMax.y));
+        index = node.parent;
+      }
+    }
+
+
+    void PolygonBroadPhase::xRemoveLeaf(const int& pLeaf)
+    {
+      if (pLeaf == fRoot)
+      {
+        fRoot = -1;
+        return;
+      }
+
+      const int parent = fNodes[pLeaf].parent;
+      const int grandParent = fNodes[parent].parent;
+      const int sibling = (fNodes[parent].child1 == pLeaf) ?
+            fNodes[parent].child2 : fNodes[parent].child1;
+
+      if (grandParent < 0)
+      {
+        fRoot = sibling;
+        fNodes[sibling].parent = -1;
+        xFreeNode(parent);
+        return;
+      }
+
+      // the sibling takes the place of the parent
+      if (fNodes[grandParent].child1 == parent)
+      {
+        fNodes[grandParent].child1 = sibling;
+      }
+      else
+      {
+        fNodes[grandParent].child2 = sibling;
+      }
+      fNodes[sibling].parent = grandParent;
+      xFreeNode(parent);
+
+      int index = grandParent;
+      while (index >= 0)
+      {
+        index = xBalance(index);
+        Node& node = fNodes[index];
+        const Node& child1 = fNodes[node.child1];
+        const Node& child2 = fNodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.boxMin = Position2D(std::min(child1.boxMin.x, child2.boxMin.x),
+                                 std::min(child1.boxMin.y, child2.boxMin.y));
+        node.boxMax = Position2D(std::max(child1.boxMax.x, child2.boxMax.x),
+                                 std::max(child1.boxMax.y, child2.boxMax.y));
+        index = node.parent;
+      }
+    }
+
+
+    int PolygonBroadPhase::xBalance(const int& pNode)
+    {
+      // rotate the highest child up if the two children heights differ by
+      // more than one
+      const int iA = pNode;
+      Node& a = fNodes[iA];
+      if (a.isLeaf() || (a.height < 2))
+      {
+        return iA;
+      }
+
+      const int iB = a.child1;
+      const int iC = a.child2;
+      Node& b = fNodes[iB];
+      Node& c = fNodes[iC];
+      const int balance = c.height - b.height;
+
+      if ((balance > -2) && (balance < 2))
+      {
+        return iA;
+      }
+
+      // the highest child is "up", the other one is "low"
+      const bool isCUp = (balance > 1);
+      const int iUp = isCUp ? iC : iB;
+      const int iLow = isCUp ? iB : iC;
+      Node& up = fNodes[iUp];
+      Node& low = fNodes[iLow];
+      const int iF = up.child1;
+      const int iG = up.child2;
+      Node& f = fNodes[iF];
+      Node& g = fNodes[iG];
+
+      // up takes the place of a
+      up.child1 = iA;
+      up.parent = a.parent;
+      a.parent = iUp;
+      if (up.parent >= 0)
+      {
+        if (fNodes[up.parent].child1 == iA)
+        {
+          fNodes[up.parent].child1 = iUp;
+        }
+        else
+        {
+          fNodes[up.parent].child2 = iUp;
+        }
+      }
+      else
+      {
+        fRoot = iUp;
+      }
+
+      // the highest grandchild stays under up, the other one goes under a
+      const bool isFHigher = (f.height > g.height);
+      const int iKept = isFHigher ? iF : iG;
+      const int iMoved = isFHigher ? iG : iF;
+      Node& kept = fNodes[iKept];
+      Node& moved = fNodes[iMoved];
+      up.child2 = iKept;
+      if (isCUp)
+      {
+        a.child2 = iMoved;
+      }
+      else
+      {
+        a.child1 = iMoved;
+      }
+      moved.parent = iA;
+
+      a.boxMin = Position2D(std::min(low.boxMin.x, moved.boxMin.x),
+                            std::min(low.boxMin.y, moved.boxMin.y));
+      a.boxMax = Position2D(std::max(low.boxMax.x, moved.boxMax.x),
+                            std::max(low.boxMax.y, moved.boxMax.y));
+      up.boxMin = Position2D(std::min(a.boxMin.x, kept.boxMin.x),
+                             std::min(a.boxMin.y, kept.boxMin.y));
+      up.boxMax = Position2D(std::max(a.boxMax.x, kept.boxMax.x),
+                             std::max(a.boxMax.y, kept.boxMax.y));
+      a.height = 1 + std::max(low.height, moved.height);
+      up.height = 1 + std::max(a.height, kept.height);
+      return iUp;
+    }
+
+  } // namespace Math
+} // namespace AL
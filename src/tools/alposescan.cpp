@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alposescan.h>
+#include <almath/tools/althreadpool.h>
+#include <almath/tools/altrigonometry.h>
+
+#include <cmath>
+#include <vector>
+
+namespace AL {
+  namespace Math {
+
+    /****************************
+    PRIVATE FUNCTION
+    ****************************/
+    // <summary> Number of poses of a block of the parallel scan, when
+    //  the policy does not give one. </summary>
+    static const unsigned int xDefaultScanBlockSize = 4096;
+
+    // <summary> Normalize a pose of a chain. </summary>
+    void xNormalizePose(Pose2D& pPose)
+    {
+      pPose.theta -= _2_PI_*floorf((pPose.theta + PI)/_2_PI_);
+    }
+
+    void xNormalizePose(Quaternion& pPose)
+    {
+      pPose = pPose.normalize();
+    }
+
+    void xNormalizePose(Transform& pPose)
+    {
+      // Gram-Schmidt on the rows of the rotation
+      float norm = sqrtf(pPose.r1_c1*pPose.r1_c1 + pPose.r1_c2*pPose.r1_c2 +
+                         pPose.r1_c3*pPose.r1_c3);
+      pPose.r1_c1 /= norm;
+      pPose.r1_c2 /= norm;
+      pPose.r1_c3 /= norm;
+
+      const float dot = pPose.r1_c1*pPose.r2_c1 + pPose.r1_c2*pPose.r2_c2 +
+          pPose.r1_c3*pPose.r2_c3;
+      pPose.r2_c1 -= dot*pPose.r1_c1;
+      pPose.r2_c2 -= dot*pPose.r1_c2;
+      pPose.r2_c3 -= dot*pPose.r1_c3;
+      norm = sqrtf(pPose.r2_c1*pPose.r2_c1 + pPose.r2_c2*pPose.r2_c2 +
+                   pPose.r2_c3*pPose.r2_c3);
+      pPose.r2_c1 /= norm;
+      pPose.r2_c2 /= norm;
+      pPose.r2_c3 /= norm;
+
+      pPose.r3_c1 = pPose.r1_c2*pPose.r2_c3 - pPose.r1_c3*pPose.r2_c2;
+      pPose.r3_c2 = pPose.r1_c3*pPose.r2_c1 - pPose.r1_c1*pPose.r2_c3;
+      pPose.r3_c3 = pPose.r1_c1*pPose.r2_c2 - pPose.r1_c2*pPose.r2_c1;
+    }
+
+    // <summary> Scan the indices [pBegin, pEnd) from the pose before
+    //  pBegin. The normalizations are at the same indices whatever the
+    //  blocks. </summary>
+    template <class T>
+    void xScanBlock(
+      const T*            pValues,
+      const unsigned int& pBegin,
+      const unsigned int& pEnd,
+      const T&            pStart,
+      const unsigned int& pNormalizationPeriod,
+      const bool&         pIsExclusive,
+      T*                  pResults)
+    {
+      T running = pStart;
+      for (unsigned int i=pBegin; i<pEnd; i++)
+      {
+        const T value = pValues[i];
+        if (pIsExclusive)
+        {
+          pResults[i] = running;
+        }
+        running = running*value;
+        if ((pNormalizationPeriod > 0) && ((i + 1) % pNormalizationPeriod == 0))
+        {
+          xNormalizePose(running);
+        }
+        if (!pIsExclusive)
+        {
+          pResults[i] = running;
+        }
+      }
+    }
+
+    // <summary> Sequential scan, or the three passes of the parallel
+    //  scan on a thread pool. </summary>
+    template <class T>
+    void xComposeScan(
+      const T*               pValues,
+      const unsigned int&    pSize,
+      T*                     pResults,
+      const ExecutionPolicy& pPolicy,
+      const unsigned int&    pNormalizationPeriod,
+      const bool&            pIsExclusive)
+    {
+      unsigned int blockSize =
+          (pPolicy.grainSize > 0) ? pPolicy.grainSize : xDefaultScanBlockSize;
+      // the blocks start on a normalization, as in the sequential scan:
+      // for a Pose2D, a theta wrapped elsewhere would differ by 2*pi
+      if (pNormalizationPeriod > 0)
+      {
+        blockSize = ((blockSize + pNormalizationPeriod - 1)/pNormalizationPeriod)*
+            pNormalizationPeriod;
+      }
+      if ((pPolicy.pool == 0) || (pSize <= blockSize))
+      {
+        xScanBlock(pValues, 0, pSize, T(), pNormalizationPeriod, pIsExclusive, pResults);
+        return;
+      }
+
+      // products of the blocks, the last one excepted
+      const unsigned int nbBlocks = (pSize + blockSize - 1)/blockSize;
+      std::vector<T> starts(nbBlocks);
+      pPolicy.pool->parallelFor(0, nbBlocks - 1, 1,
+                                [&](const unsigned int& pBegin, const unsigned int& pEnd)
+      {
+        for (unsigned int b=pBegin; b<pEnd; b++)
+        {
+          T product = pValues[b*blockSize];
+          for (unsigned int i=b*blockSize + 1; i<(b + 1)*blockSize; i++)
+          {
+            product = product*pValues[i];
+            if ((pNormalizationPeriod > 0) && ((i + 1) % pNormalizationPeriod == 0))
+            {
+              xNormalizePose(product);
+            }
+          }
+          starts[b + 1] = product;
+        }
+      });
+
+      // pose before each block
+      for (unsigned int b=1; b<nbBlocks; b++)
+      {
+        starts[b] = starts[b - 1]*starts[b];
+        if (pNormalizationPeriod > 0)
+        {
+          xNormalizePose(starts[b]);
+        }
+      }
+
+      pPolicy.pool->parallelFor(0, nbBlocks, 1,
+                                [&](const unsigned int& pBegin, const unsigned int& pEnd)
+      {
+        for (unsigned int b=pBegin; b<pEnd; b++)
+        {
+          const unsigned int end = (b + 1 < nbBlocks) ? (b + 1)*blockSize : pSize;
+          xScanBlock(pValues, b*blockSize, end, starts[b],
+                     pNormalizationPeriod, pIsExclusive, pResults);
+        }
+      });
+    }
+
+    /****************************
+    PUBLIC FUNCTION
+    ****************************/
+    template <class T>
+    void composeInclusiveScan(
+      const T*            pValues,
+      const unsigned int& pSize,
+      T*                  pResults,
+      const unsigned int& pNormalizationPeriod)
+    {
+      xScanBlock(pValues, 0, pSize, T(), pNormalizationPeriod, false, pResults);
+    }
+
+    template <class T>
+    void composeInclusiveScan(
+      const T*               pValues,
+      const unsigned int&    pSize,
+      T*                     pResults,
+      const ExecutionPolicy& pPolicy,
+      const unsigned int&    pNormalizationPeriod)
+    {
+      xComposeScan(pValues, pSize, pResults, pPolicy, pNormalizationPeriod, false);
+    }
+
+    template <class T>
+    void composeExclusiveScan(
+      const T*            pValues,
+      const unsigned int& pSize,
+      T*                  pResults,
+      const unsigned int& pNormalizationPeriod)
+    {
+      xScanBlock(pValues, 0, pSize, T(), pNormalizationPeriod, true, pResults);
+    }
+
+    template <class T>
+    void composeExclusiveScan(
+      const T*               pValues,
+      const unsigned int&    pSize,
+      T*                     pResults,
+      const ExecutionPolicy& pPolicy,
+      const unsigned int&    pNormalizationPeriod)
+    {
+      xComposeScan(pValues, pSize, pResults, pPolicy, pNormalizationPeriod, true);
+    }
+
+#define ALMATH_INSTANTIATE_SCAN(T)                                         \
+    template void composeInclusiveScan<T>(                                  \
+      const T*, const unsigned int&, T*, const unsigned int&);              \
+    template void composeInclusiveScan<T>(                                  \
+      const T*, const unsigned int&, T*, const ExecutionPolicy&,            \
+      const unsigned int&);                                                 \
+    template void composeExclusiveScan<T>(                                  \
+      const T*, const unsigned int&, T*, const unsigned int&);              \
+    template void composeExclusiveScan<T>(                                  \
+      const T*, const unsigned int&, T*, const ExecutionPolicy&,            \
+      const unsigned int&);
+
+    ALMATH_INSTANTIATE_SCAN(Pose2D)
+    ALMATH_INSTANTIATE_SCAN(Quaternion)
+    ALMATH_INSTANTIATE_SCAN(Transform)
+#undef ALMATH_INSTANTIATE_SCAN
+
+  } // namespace Math
+} // namespace AL
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alrealtime.h>
+
+namespace AL {
+  namespace Math {
+
+    /****************************
+    PRIVATE FUNCTION
+    ****************************/
+    // <summary> Copy pNbValues floats in a buffer of pSize floats. </summary>
+    const MATH_STATUS xCopyToBuffer(
+      const float*        pValues,
+      const unsigned int& pNbValues,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT;
+
+
+    const MATH_STATUS xCopyToBuffer(
+      const float*        pValues,
+      const unsigned int& pNbValues,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT
+    {
+      if ((pData == 0) || (pSize < pNbValues))
+      {
+        return MATH_BUFFER_TOO_SMALL;
+      }
+      for (unsigned int i=0; i<pNbValues; i++)
+      {
+        pData[i] = pValues[i];
+      }
+      return MATH_OK;
+    }
+
+
+    /****************************
+    PUBLIC FUNCTION
+    ****************************/
+    const MATH_STATUS toVectorInPlace(
+      const Pose2D&       pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT
+    {
+      const float values[3] = {pValue.x, pValue.y, pValue.theta};
+      return xCopyToBuffer(values, 3, pData, pSize);
+    }
+
+
+    const MATH_STATUS toVectorInPlace(
+      const Position2D&   pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT
+    {
+      const float values[2] = {pValue.x, pValue.y};
+      return xCopyToBuffer(values, 2, pData, pSize);
+    }
+
+
+    const MATH_STATUS toVectorInPlace(
+      const Position3D&   pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT
+    {
+      const float values[3] = {pValue.x, pValue.y, pValue.z};
+      return xCopyToBuffer(values, 3, pData, pSize);
+    }
+
+
+    const MATH_STATUS toVectorInPlace(
+      const Position6D&   pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT
+    {
+      const float values[6] = {pValue.x, pValue.y, pValue.z,
+                               pValue.wx, pValue.wy, pValue.wz};
+      return xCopyToBuffer(values, 6, pData, pSize);
+    }
+
+
+    const MATH_STATUS toVectorInPlace(
+      const Quaternion&   pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT
+    {
+      const float values[4] = {pValue.w, pValue.x, pValue.y, pValue.z};
+      return xCopyToBuffer(values, 4, pData, pSize);
+    }
+
+
+    const MATH_STATUS toVectorInPlace(
+      const Rotation&     pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT
+    {
+      const float values[9] = {
+        pValue.r1_c1, pValue.r1_c2, pValue.r1_c3,
+        pValue.r2_c1, pValue.r2_c2, pValue.r2_c3,
+        pValue.r3_c1, pValue.r3_c2, pValue.r3_c3};
+      return xCopyToBuffer(values, 9, pData, pSize);
+    }
+
+
+    const MATH_STATUS toVectorInPlace(
+      const Rotation3D&   pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT
+    {
+      const float values[3] = {pValue.wx, pValue.wy, pValue.wz};
+      return xCopyToBuffer(values, 3, pData, pSize);
+    }
+
+
+    const MATH_STATUS toVectorInPlace(
+      const Transform&    pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT
+    {
+      const float values[16] = {
+        pValue.r1_c1, pValue.r1_c2, pValue.r1_c3, pValue.r1_c4,
+        pValue.r2_c1, pValue.r2_c2, pValue.r2_c3, pValue.r2_c4,
+        pValue.r3_c1, pValue.r3_c2, pValue.r3_c3, pValue.r3_c4,
+        0.0f, 0.0f, 0.0f, 1.0f};
+      return xCopyToBuffer(values, 16, pData, pSize);
+    }
+
+
+    const MATH_STATUS toVectorInPlace(
+      const Velocity3D&   pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT
+    {
+      const float values[3] = {pValue.xd, pValue.yd, pValue.zd};
+      return xCopyToBuffer(values, 3, pData, pSize);
+    }
+
+
+    const MATH_STATUS toVectorInPlace(
+      const Velocity6D&   pValue,
+      float*              pData,
+      const unsigned int& pSize) ALMATH_NOEXCEPT
+    {
+      const float values[6] = {pValue.xd, pValue.yd, pValue.zd,
+                               pValue.wxd, pValue.wyd, pValue.wzd};
+      return xCopyToBuffer(values, 6, pData, pSize);
+    }
+
+  } // namespace Math
+} // namespace AL
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alsnapshot.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace AL {
+  namespace Math {
+
+    /****************************
+    PRIVATE FUNCTION
+    ****************************/
+    // <summary> Store a value in relaxed atomic words. </summary>
+    template <class T>
+    void xStoreSnapshotWords(
+      const T&               pValue,
+      std::atomic<uint32_t>* pWords);
+
+    // <summary> Load a value stored by xStoreSnapshotWords. </summary>
+    template <class T>
+    void xLoadSnapshotWords(
+      const std::atomic<uint32_t>* pWords,
+      T&                           pValue);
+
+
+    template <class T>
+    void xStoreSnapshotWords(
+      const T&               pValue,
+      std::atomic<uint32_t>* pWords)
+    {
+      uint32_t words[BinaryTraits<T>::nbFloats];
+      std::memcpy(words, &pValue, sizeof(words));
+      for (unsigned int i=0; i<BinaryTraits<T>::nbFloats; i++)
+      {
+        pWords[i].store(words[i], std::memory_order_relaxed);
+      }
+    }
+
+
+    template <class T>
+    void xLoadSnapshotWords(
+      const std::atomic<uint32_t>* pWords,
+      T&                           pValue)
+    {
+      uint32_t words[BinaryTraits<T>::nbFloats];
+      for (unsigned int i=0; i<BinaryTraits<T>::nbFloats; i++)
+      {
+        words[i] = pWords[i].load(std::memory_order_relaxed);
+      }
+      std::memcpy(&pValue, words, sizeof(words));
+    }
+
+
+    /****************************
+    SNAPSHOT
+    ****************************/
+    template <class T>
+    Snapshot<T>::Snapshot():
+      fSequence(0)
+    {
+      xStoreSnapshotWords(T(), fWords);
+    }
+
+
+    template <class T>
+    Snapshot<T>::Snapshot(const T& pValue):
+      fSequence(0)
+    {
+      xStoreSnapshotWords(pValue, fWords);
+    }
+
+
+    template <class T>
+    void Snapshot<T>::publish(const T& pValue)
+    {
+      const uint64_t sequence = fSequence.load(std::memory_order_relaxed);
+      fSequence.store(sequence + 1, std::memory_order_relaxed);
+      // the readers see the odd sequence before any word of the value
+      std::atomic_thread_fence(std::memory_order_release);
+      xStoreSnapshotWords(pValue, fWords);
+      fSequence.store(sequence + 2, std::memory_order_release);
+    }
+
+
+    template <class T>
+    uint64_t Snapshot<T>::read(T& pValue) const
+    {
+      uint64_t version = 0;
+      while (!xTryRead(pValue, version))
+      {
+      }
+      return version;
+    }
+
+
+    template <class T>
+    const bool Snapshot<T>::tryRead(T& pValue) const
+    {
+      uint64_t version = 0;
+      return xTryRead(pValue, version);
+    }
+
+
+    template <class T>
+    uint64_t Snapshot<T>::getVersion() const
+    {
+      return fSequence.load(std::memory_order_acquire)/2;
+    }
+
+
+    template <class T>
+    const bool Snapshot<T>::xTryRead(
+      T&        pValue,
+      uint64_t& pVersion) const
+    {
+      const uint64_t sequence = fSequence.load(std::memory_order_acquire);
+      if (sequence % 2 != 0)
+      {
+        return false;
+      }
+      T value;
+      xLoadSnapshotWords(fWords, value);
+      // the words are read before the sequence is checked again
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (fSequence.load(std::memory_order_relaxed) != sequence)
+      {
+        return false;
+      }
+      pValue = value;
+      pVersion = sequence/2;
+      return true;
+    }
+
+
+    /****************************
+    SNAPSHOT ARRAY
+    ****************************/
+    template <class T>
+    SnapshotArray<T>::SnapshotArray(const unsigned int& pSize):
+      fSize(pSize),
+      fVersion(0),
+      fWords(2*pSize*NB_WORDS)
+    {
+      if (pSize == 0)
+      {
+        throw std::invalid_argument(
+              "ALMath: SnapshotArray size must be positive.");
+      }
+      // the copy 1 holds no version yet
+      fSequences[0].store(0, std::memory_order_relaxed);
+      fSequences[1].store(1, std::memory_order_relaxed);
+      for (unsigned int i=0; i<2*fSize; i++)
+      {
+        xStoreSnapshotWords(T(), &fWords[i*NB_WORDS]);
+      }
+    }
+
+
+    template <class T>
+    void SnapshotArray<T>::publish(const T* pValues)
+    {
+      const uint64_t version = fVersion.load(std::memory_order_relaxed) + 1;
+      const unsigned int copy = static_cast<unsigned int>(version % 2);
+      std::atomic<uint32_t>* words = &fWords[copy*fSize*NB_WORDS];
+
+      fSequences[copy].store(2*version + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      for (unsigned int i=0; i<fSize; i++)
+      {
+        xStoreSnapshotWords(pValues[i], &words[i*NB_WORDS]);
+      }
+      fSequences[copy].store(2*version, std::memory_order_release);
+      fVersion.store(version, std::memory_order_release);
+    }
+
+
+    template <class T>
+    void SnapshotArray<T>::publish(const std::vector<T>& pValues)
+    {
+      if (pValues.size() != fSize)
+      {
+        throw std::invalid_argument(
+              "ALMath: SnapshotArray publish wrong number of values.");
+      }
+      publish(&pValues[0]);
+    }
+
+
+    template <class T>
+    uint64_t SnapshotArray<T>::read(T* pValues) const
+    {
+      return xRead(0, fSize, pValues);
+    }
+
+
+    template <class T>
+    uint64_t SnapshotArray<T>::read(std::vector<T>& pValues) const
+    {
+      pValues.resize(fSize);
+      return xRead(0, fSize, &pValues[0]);
+    }
+
+
+    template <class T>
+    uint64_t SnapshotArray<T>::read(
+      const unsigned int& pIndex,
+      T&                  pValue) const
+    {
+      if (pIndex >= fSize)
+      {
+        throw std::out_of_range("ALMath: SnapshotArray index out of range.");
+      }
+      return xRead(pIndex, pIndex + 1, &pValue);
+    }
+
+
+    template <class T>
+    uint64_t SnapshotArray<T>::getVersion() const
+    {
+      return fVersion.load(std::memory_order_acquire);
+    }
+
+
+    template <class T>
+    unsigned int SnapshotArray<T>::size() const
+    {
+      return fSize;
+    }
+
+
+    template <class T>
+    uint64_t SnapshotArray<T>::xRead(
+      const unsigned int& pBegin,
+      const unsigned int& pEnd,
+      T*                  pValues) const
+    {
+      while (true)
+      {
+        const uint64_t version = fVersion.load(std::memory_order_acquire);
+        const unsigned int copy = static_cast<unsigned int>(version % 2);
+        const uint64_t sequence = 2*version;
+        if (fSequences[copy].load(std::memory_order_acquire) != sequence)
+        {
+          // the writer already writes this copy again
+          continue;
+        }
+
+        const std::atomic<uint32_t>* words = &fWords[copy*fSize*NB_WORDS];
+        for (unsigned int i=pBegin; i<pEnd; i++)
+        {
+          xLoadSnapshotWords(&words[i*NB_WORDS], pValues[i - pBegin]);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (fSequences[copy].load(std::memory_order_relaxed) == sequence)
+        {
+          return version;
+        }
+      }
+    }
+
+
+#define ALMATH_SNAPSHOT_INSTANTIATE(T) \
+    template class Snapshot<T>;        \
+    template class SnapshotArray<T>;
+
+    ALMATH_SNAPSHOT_INSTANTIATE(Pose2D)
+    ALMATH_SNAPSHOT_INSTANTIATE(Position2D)
+    ALMATH_SNAPSHOT_INSTANTIATE(Position3D)
+    ALMATH_SNAPSHOT_INSTANTIATE(Position6D)
+    ALMATH_SNAPSHOT_INSTANTIATE(PositionAndVelocity)
+    ALMATH_SNAPSHOT_INSTANTIATE(Quaternion)
+    ALMATH_SNAPSHOT_INSTANTIATE(Rotation)
+    ALMATH_SNAPSHOT_INSTANTIATE(Rotation3D)
+    ALMATH_SNAPSHOT_INSTANTIATE(Transform)
+    ALMATH_SNAPSHOT_INSTANTIATE(TransformAndVelocity6D)
+    ALMATH_SNAPSHOT_INSTANTIATE(Velocity3D)
+    ALMATH_SNAPSHOT_INSTANTIATE(Velocity6D)
+
+#undef ALMATH_SNAPSHOT_INSTANTIATE
+
+  } // namespace Math
+} // namespace AL
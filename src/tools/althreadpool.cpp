@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/althreadpool.h>
+
+#include <exception>
+
+#ifdef __linux__
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+namespace AL {
+  namespace Math {
+
+    /****************************
+    PRIVATE FUNCTION
+    ****************************/
+    // <summary> The pool whose loop the current thread runs, to run the
+    //  nested loops on the current thread. </summary>
+    static thread_local const ThreadPool* xCurrentThreadPool = 0;
+
+    // <summary> Pack the front and the back of a range of chunks. </summary>
+    uint64_t xPackChunks(
+      const uint32_t& pFront,
+      const uint32_t& pBack);
+
+    // <summary> Pin the current thread to a core, modulo the number of
+    //  cores. </summary>
+    void xPinCurrentThread(const unsigned int& pCore);
+
+
+    uint64_t xPackChunks(
+      const uint32_t& pFront,
+      const uint32_t& pBack)
+    {
+      return (static_cast<uint64_t>(pFront) << 32) | pBack;
+    }
+
+
+    void xPinCurrentThread(const unsigned int& pCore)
+    {
+#ifdef __linux__
+      const unsigned int nbCores = std::thread::hardware_concurrency();
+      if (nbCores == 0)
+      {
+        return;
+      }
+      cpu_set_t cores;
+      CPU_ZERO(&cores);
+      CPU_SET(pCore % nbCores, &cores);
+      pthread_setaffinity_np(pthread_self(), sizeof(cores), &cores);
+#else
+      (void)pCore;
+#endif
+    }
+
+
+    /****************************
+    THREAD POOL
+    ****************************/
+    // a loop run by the pool
+    struct ThreadPool::Job
+    {
+      const RangeFunction* body;
+      unsigned int begin;
+      unsigned int end;
+      unsigned int grainSize;
+
+      std::atomic<bool> failed;
+      std::mutex exceptionMutex;
+      std::exception_ptr exception;
+    };
+
+
+    ThreadPool::ThreadPool(
+      const unsigned int& pNbWorkers,
+      const bool&         pPinThreads):
+      fWorkers(),
+      fChunks(pNbWorkers + 1),
+      fPinThreads(pPinThreads),
+      fJob(0),
+      fGeneration(0),
+      fNbActive(0),
+      fStop(false)
+    {
+      for (unsigned int i=0; i<fChunks.size(); i++)
+      {
+        fChunks[i].range.store(0, std::memory_order_relaxed);
+      }
+      for (unsigned int i=0; i<pNbWorkers; i++)
+      {
+        fWorkers.push_back(std::thread(&ThreadPool::xWorkerLoop, this, i + 1));
+      }
+    }
+
+
+    ThreadPool::~ThreadPool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fStop = true;
+      }
+      fWakeUp.notify_all();
+      for (unsigned int i=0; i<fWorkers.size(); i++)
+      {
+        fWorkers[i].join();
+      }
+    }
+
+
+    void ThreadPool::parallelFor(
+      const unsigned int&  pBegin,
+      const unsigned int&  pEnd,
+      const unsigned int&  pGrainSize,
+      const RangeFunction& pBody)
+    {
+      if (pEnd <= pBegin)
+      {
+        return;
+      }
+
+      const unsigned int nbThreads = getNbThreads();
+      const unsigned int size = pEnd - pBegin;
+      unsigned int grainSize = pGrainSize;
+      if (grainSize == 0)
+      {
+        grainSize = (size + 4*nbThreads - 1)/(4*nbThreads);
+      }
+      if ((nbThreads == 1) || (size <= grainSize) ||
+          (xCurrentThreadPool == this))
+      {
+        pBody(pBegin, pEnd);
+        return;
+      }
+
+      // one loop at a time
+      std::lock_guard<std::mutex> callLock(fCallMutex);
+
+      Job job;
+      job.body = &pBody;
+      job.begin = pBegin;
+      job.end = pEnd;
+      job.grainSize = grainSize;
+      job.failed.store(false, std::memory_order_relaxed);
+
+      // each thread starts with a contiguous part of the chunks
+      const uint64_t nbChunks = (size + grainSize - 1)/grainSize;
+      for (unsigned int i=0; i<nbThreads; i++)
+      {
+        fChunks[i].range.store(
+              xPackChunks(static_cast<uint32_t>(i*nbChunks/nbThreads),
+                          static_cast<uint32_t>((i + 1)*nbChunks/nbThreads)),
+              std::memory_order_relaxed);
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fJob = &job;
+        ++fGeneration;
+      }
+      fWakeUp.notify_all();
+
+      xRun(job, 0);
+
+      // the workers which did not start the job do not start it anymore
+      {
+        std::unique_lock<std::mutex> lock(fMutex);
+        fJob = 0;
+        while (fNbActive > 0)
+        {
+          fDone.wait(lock);
+        }
+      }
+
+      if (job.exception)
+      {
+        std::rethrow_exception(job.exception);
+      }
+    }
+
+
+    unsigned int ThreadPool::getNbThreads() const
+    {
+      return static_cast<unsigned int>(fWorkers.size() + 1);
+    }
+
+
+    unsigned int ThreadPool::getDefaultNbWorkers()
+    {
+      const unsigned int nbCores = std::thread::hardware_concurrency();
+      return (nbCores > 1) ? nbCores - 1 : 0;
+    }
+
+
+    void ThreadPool::xWorkerLoop(const unsigned int& pIndex)
+    {
+      if (fPinThreads)
+      {
+        xPinCurrentThread(pIndex);
+      }
+
+      uint64_t generation = 0;
+      while (true)
+      {
+        Job* job = 0;
+        {
+          std::unique_lock<std::mutex> lock(fMutex);
+          while (!fStop && (fGeneration == generation))
+          {
+            fWakeUp.wait(lock);
+          }
+          if (fStop)
+          {
+            return;
+          }
+          generation = fGeneration;
+          job = fJob;
+          if (job == 0)
+          {
+            continue;
+          }
+          ++fNbActive;
+        }
+
+        xRun(*job, pIndex);
+
+        {
+          std::lock_guard<std::mutex> lock(fMutex);
+          --fNbActive;
+        }
+        fDone.notify_all();
+      }
+    }
+
+
+    void ThreadPool::xRun(
+      Job&                pJob,
+      const unsigned int& pIndex)
+    {
+      const ThreadPool* previousPool = xCurrentThreadPool;
+      xCurrentThreadPool = this;
+
+      const unsigned int nbThreads = getNbThreads();
+      std::atomic<uint64_t>& own = fChunks[pIndex].range;
+      while (true)
+      {
+        // take the front chunk of the own range
+        uint64_t range = own.load(std::memory_order_acquire);
+        uint32_t front = static_cast<uint32_t>(range >> 32);
+        uint32_t back = static_cast<uint32_t>(range);
+        uint32_t chunk = 0;
+        bool found = false;
+        while (front < back)
+        {
+          if (own.compare_exchange_weak(range, xPackChunks(front + 1, back),
+                                        std::memory_order_acq_rel))
+          {
+            chunk = front;
+            found = true;
+            break;
+          }
+          front = static_cast<uint32_t>(range >> 32);
+          back = static_cast<uint32_t>(range);
+        }
+
+        // else steal the back half of the range of another thread
+        for (unsigned int i=1; (i<nbThreads) && !found; i++)
+        {
+          std::atomic<uint64_t>& other = fChunks[(pIndex + i) % nbThreads].range;
+          range = other.load(std::memory_order_acquire);
+          front = static_cast<uint32_t>(range >> 32);
+          back = static_cast<uint32_t>(range);
+          while (front < back)
+          {
+            const uint32_t middle = back - (back - front + 1)/2;
+            if (other.compare_exchange_weak(range, xPackChunks(front, middle),
+                                            std::memory_order_acq_rel))
+            {
+              // the own range is empty: no other thread changes it
+              own.store(xPackChunks(middle + 1, back), std::memory_order_release);
+              chunk = middle;
+              found = true;
+              break;
+            }
+            front = static_cast<uint32_t>(range >> 32);
+            back = static_cast<uint32_t>(range);
+          }
+        }
+
+        if (!found)
+        {
+          break;
+        }
+        if (pJob.failed.load(std::memory_order_relaxed))
+        {
+          continue;
+        }
+
+        const unsigned int chunkBegin = pJob.begin + chunk*pJob.grainSize;
+        const unsigned int chunkEnd = (pJob.end - chunkBegin > pJob.grainSize) ?
+              chunkBegin + pJob.grainSize : pJob.end;
+        try
+        {
+          (*pJob.body)(chunkBegin, chunkEnd);
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> lock(pJob.exceptionMutex);
+          if (!pJob.exception)
+          {
+            pJob.exception = std::current_exception();
+          }
+          pJob.failed.store(true, std::memory_order_relaxed);
+        }
+      }
+
+      xCurrentThreadPool = previousPool;
+    }
+
+
+    /****************************
+    EXECUTION POLICY
+    ****************************/
+    ExecutionPolicy::ExecutionPolicy():
+      pool(0),
+      grainSize(0)
+    {
+    }
+
+
+    ExecutionPolicy::ExecutionPolicy(
+      ThreadPool&         pPool,
+      const unsigned int& pGrainSize):
+      pool(&pPool),
+      grainSize(pGrainSize)
+    {
+    }
+
+
+    void parallelFor(
+      const ExecutionPolicy& pPolicy,
+      const unsigned int&    pBegin,
+      const unsigned int&    pEnd,
+      const RangeFunction&   pBody)
+    {
+      if (pPolicy.pool != 0)
+      {
+        pPolicy.pool->parallelFor(pBegin, pEnd, pPolicy.grainSize, pBody);
+      }
+      else if (pBegin < pEnd)
+      {
+        pBody(pBegin, pEnd);
+      }
+    }
+
+  } // namespace Math
+} // namespace AL
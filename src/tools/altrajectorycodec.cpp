@@ -0,0 +1,714 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/altrajectorycodec.h>
+#include <almath/tools/altransformhelpers.h>
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace AL {
+  namespace Math {
+
+    /****************************
+    PRIVATE FUNCTION
+    ****************************/
+    // <summary> Number of ones of the unary code which announce a residual
+    //  written on 64 bits instead of its Rice code. </summary>
+    static const unsigned int xTrajectoryCodecEscape = 16;
+
+    // <summary> Number of residuals after which the statistics of a
+    //  channel are halved, to follow the changes of the motion. </summary>
+    static const uint32_t xTrajectoryCodecMaxCount = 16;
+
+    // <summary> Largest quantized value, 2^60: the linear prediction and
+    //  the residual cannot overflow. </summary>
+    static const double xTrajectoryCodecMaxQuantum = 1152921504606846976.0;
+
+    // <summary> Write a float on 4 bytes in little endian. </summary>
+    void xWriteTrajectoryCodecFloat(
+      const float&   pValue,
+      unsigned char* pBuffer);
+
+    // <summary> Read a float written by xWriteTrajectoryCodecFloat. </summary>
+    float xReadTrajectoryCodecFloat(const unsigned char* pBuffer);
+
+    // <summary> Compute the quantization step of each channel. </summary>
+    template <class T>
+    void xTrajectoryCodecSteps(
+      const float& pPositionBound,
+      const float& pAngleBound,
+      double*      pSteps);
+
+    // <summary> Split a value in channels. pPrevious is the decoded
+    //  channels of the previous value, 0 for the first value. </summary>
+    template <class T>
+    void xTrajectoryCodecToChannels(
+      const T&      pValue,
+      const double* pPrevious,
+      double*       pChannels);
+
+    // <summary> Build a value from its channels. </summary>
+    template <class T>
+    void xTrajectoryCodecFromChannels(
+      const double* pChannels,
+      T&            pValue);
+
+    // <summary> Predict a quantized channel from its last two values. </summary>
+    int64_t xTrajectoryCodecPredict(
+      const int64_t&               pLast,
+      const int64_t&               pBeforeLast,
+      const unsigned int&          pNbValues,
+      const TRAJECTORY_PREDICTION& pPrediction);
+
+    // <summary> Return the Rice parameter of a channel: the number of low
+    //  bits written as is, from the mean of its last residuals. </summary>
+    unsigned int xTrajectoryCodecRiceParameter(
+      const uint64_t& pSum,
+      const uint32_t& pCount);
+
+    // <summary> Add a residual to the statistics of a channel. </summary>
+    void xTrajectoryCodecUpdateRice(
+      const uint64_t&     pResidual,
+      const unsigned int& pParameter,
+      uint64_t&           pSum,
+      uint32_t&           pCount);
+
+
+    void xWriteTrajectoryCodecFloat(
+      const float&   pValue,
+      unsigned char* pBuffer)
+    {
+      uint32_t bits = 0;
+      std::memcpy(&bits, &pValue, 4);
+      for (unsigned int i=0; i<4; i++)
+      {
+        pBuffer[i] = static_cast<unsigned char>((bits >> (8*i)) & 0xFF);
+      }
+    }
+
+
+    float xReadTrajectoryCodecFloat(const unsigned char* pBuffer)
+    {
+      uint32_t bits = 0;
+      for (unsigned int i=0; i<4; i++)
+      {
+        bits |= static_cast<uint32_t>(pBuffer[i]) << (8*i);
+      }
+      float value = 0.0f;
+      std::memcpy(&value, &bits, 4);
+      return value;
+    }
+
+
+    template <>
+    void xTrajectoryCodecSteps<Pose2D>(
+      const float& pPositionBound,
+      const float& pAngleBound,
+      double*      pSteps)
+    {
+      pSteps[0] = 2.0*pPositionBound;
+      pSteps[1] = 2.0*pPositionBound;
+      pSteps[2] = 2.0*pAngleBound;
+    }
+
+
+    template <>
+    void xTrajectoryCodecSteps<Position3D>(
+      const float& pPositionBound,
+      const float& /*pAngleBound*/,
+      double*      pSteps)
+    {
+      for (unsigned int i=0; i<3; i++)
+      {
+        pSteps[i] = 2.0*pPositionBound;
+      }
+    }
+
+
+    template <>
+    void xTrajectoryCodecSteps<Quaternion>(
+      const float& /*pPositionBound*/,
+      const float& pAngleBound,
+      double*      pSteps)
+    {
+      // an error e on each component moves a unit quaternion by at most
+      // 2e, which rotates by at most 4e
+      for (unsigned int i=0; i<4; i++)
+      {
+        pSteps[i] = 0.5*pAngleBound;
+      }
+    }
+
+
+    template <>
+    void xTrajectoryCodecSteps<Transform>(
+      const float& pPositionBound,
+      const float& pAngleBound,
+      double*      pSteps)
+    {
+      xTrajectoryCodecSteps<Position3D>(pPositionBound, pAngleBound, pSteps);
+      xTrajectoryCodecSteps<Quaternion>(pPositionBound, pAngleBound, &pSteps[3]);
+    }
+
+
+    template <>
+    void xTrajectoryCodecToChannels<Pose2D>(
+      const Pose2D& pValue,
+      const double* /*pPrevious*/,
+      double*       pChannels)
+    {
+      pChannels[0] = pValue.x;
+      pChannels[1] = pValue.y;
+      pChannels[2] = pValue.theta;
+    }
+
+
+    template <>
+    void xTrajectoryCodecToChannels<Position3D>(
+      const Position3D& pValue,
+      const double*     /*pPrevious*/,
+      double*           pChannels)
+    {
+      pChannels[0] = pValue.x;
+      pChannels[1] = pValue.y;
+      pChannels[2] = pValue.z;
+    }
+
+
+    template <>
+    void xTrajectoryCodecToChannels<Quaternion>(
+      const Quaternion& pValue,
+      const double*     /*pPrevious*/,
+      double*           pChannels)
+    {
+      pChannels[0] = pValue.w;
+      pChannels[1] = pValue.x;
+      pChannels[2] = pValue.y;
+      pChannels[3] = pValue.z;
+    }
+
+
+    template <>
+    void xTrajectoryCodecToChannels<Transform>(
+      const Transform& pValue,
+      const double*    pPrevious,
+      double*          pChannels)
+    {
+      pChannels[0] = pValue.r1_c4;
+      pChannels[1] = pValue.r2_c4;
+      pChannels[2] = pValue.r3_c4;
+
+      const Quaternion quaternion = quaternionFromTransform(pValue);
+      pChannels[3] = quaternion.w;
+      pChannels[4] = quaternion.x;
+      pChannels[5] = quaternion.y;
+      pChannels[6] = quaternion.z;
+
+      // q and -q are the same rotation: keep the one closest to the
+      // previous value, so that the prediction stays good
+      if (pPrevious != 0)
+      {
+        double dot = 0.0;
+        for (unsigned int i=3; i<7; i++)
+        {
+          dot += pChannels[i]*pPrevious[i];
+        }
+        if (dot < 0.0)
+        {
+          for (unsigned int i=3; i<7; i++)
+          {
+            pChannels[i] = -pChannels[i];
+          }
+        }
+      }
+    }
+
+
+    template <>
+    void xTrajectoryCodecFromChannels<Pose2D>(
+      const double* pChannels,
+      Pose2D&       pValue)
+    {
+      pValue.x     = static_cast<float>(pChannels[0]);
+      pValue.y     = static_cast<float>(pChannels[1]);
+      pValue.theta = static_cast<float>(pChannels[2]);
+    }
+
+
+    template <>
+    void xTrajectoryCodecFromChannels<Position3D>(
+      const double* pChannels,
+      Position3D&   pValue)
+    {
+      pValue.x = static_cast<float>(pChannels[0]);
+      pValue.y = static_cast<float>(pChannels[1]);
+      pValue.z = static_cast<float>(pChannels[2]);
+    }
+
+
+    template <>
+    void xTrajectoryCodecFromChannels<Quaternion>(
+      const double* pChannels,
+      Quaternion&   pValue)
+    {
+      pValue.w = static_cast<float>(pChannels[0]);
+      pValue.x = static_cast<float>(pChannels[1]);
+      pValue.y = static_cast<float>(pChannels[2]);
+      pValue.z = static_cast<float>(pChannels[3]);
+    }
+
+
+    template <>
+    void xTrajectoryCodecFromChannels<Transform>(
+      const double* pChannels,
+      Transform&    pValue)
+    {
+      Quaternion quaternion;
+      xTrajectoryCodecFromChannels<Quaternion>(&pChannels[3], quaternion);
+      pValue = transformFromQuaternion(quaternion.normalize());
+      pValue.r1_c4 = static_cast<float>(pChannels[0]);
+      pValue.r2_c4 = static_cast<float>(pChannels[1]);
+      pValue.r3_c4 = static_cast<float>(pChannels[2]);
+    }
+
+
+    int64_t xTrajectoryCodecPredict(
+      const int64_t&               pLast,
+      const int64_t&               pBeforeLast,
+      const unsigned int&          pNbValues,
+      const TRAJECTORY_PREDICTION& pPrediction)
+    {
+      if (pNbValues == 0)
+      {
+        return 0;
+      }
+      if ((pNbValues == 1) || (pPrediction == TRAJECTORY_PREDICTION_DELTA))
+      {
+        return pLast;
+      }
+      // unsigned arithmetic: a corrupted stream cannot overflow
+      return static_cast<int64_t>(2u*static_cast<uint64_t>(pLast) -
+                                  static_cast<uint64_t>(pBeforeLast));
+    }
+
+
+    unsigned int xTrajectoryCodecRiceParameter(
+      const uint64_t& pSum,
+      const uint32_t& pCount)
+    {
+      unsigned int parameter = 0;
+      while ((parameter < 31) &&
+             ((static_cast<uint64_t>(pCount) << parameter) < pSum))
+      {
+        ++parameter;
+      }
+      return parameter;
+    }
+
+
+    void xTrajectoryCodecUpdateRice(
+      const uint64_t&     pResidual,
+      const unsigned int& pParameter,
+      uint64_t&           pSum,
+      uint32_t&           pCount)
+    {
+      // an escaped residual counts as the largest Rice code, so that a
+      // single jump does not spoil the next residuals
+      const uint64_t largest =
+          static_cast<uint64_t>(xTrajectoryCodecEscape) << pParameter;
+      pSum += (pResidual < largest) ? pResidual : largest;
+      ++pCount;
+      if (pCount >= xTrajectoryCodecMaxCount)
+      {
+        pSum >>= 1;
+        pCount >>= 1;
+      }
+    }
+
+
+    /****************************
+    TRAJECTORY ENCODER
+    ****************************/
+    template <class T>
+    TrajectoryEncoder<T>::TrajectoryEncoder(
+      std::ostream&                pStream,
+      const float&                 pPositionBound,
+      const float&                 pAngleBound,
+      const TRAJECTORY_PREDICTION& pPrediction):
+      fStream(pStream),
+      fPrediction(pPrediction),
+      fBits(0),
+      fNbBits(0),
+      fNbValues(0),
+      fNbBytes(0),
+      fFinished(false)
+    {
+      // written this way, the tests also reject NaN
+      if (!(pPositionBound > 0.0f) || !(pAngleBound > 0.0f))
+      {
+        throw std::invalid_argument(
+              "ALMath: TrajectoryEncoder bounds must be positive.");
+      }
+
+      xTrajectoryCodecSteps<T>(pPositionBound, pAngleBound, fSteps);
+      for (unsigned int i=0; i<N; i++)
+      {
+        fLast[i]       = 0;
+        fBeforeLast[i] = 0;
+        fRiceSum[i]    = 0;
+        fRiceCount[i]  = 1;
+      }
+
+      unsigned char header[TRAJECTORY_CODEC_HEADER_SIZE];
+      std::memcpy(header, "ALMC", 4);
+      header[4] = TRAJECTORY_CODEC_VERSION;
+      header[5] = static_cast<unsigned char>(BinaryTraits<T>::type);
+      header[6] = static_cast<unsigned char>(pPrediction);
+      header[7] = 0;
+      xWriteTrajectoryCodecFloat(pPositionBound, &header[8]);
+      xWriteTrajectoryCodecFloat(pAngleBound, &header[12]);
+      fStream.write(reinterpret_cast<const char*>(header), sizeof(header));
+      if (!fStream)
+      {
+        throw std::runtime_error("ALMath: TrajectoryEncoder write failed.");
+      }
+      fNbBytes = sizeof(header);
+    }
+
+
+    template <class T>
+    TrajectoryEncoder<T>::~TrajectoryEncoder()
+    {
+      try
+      {
+        finish();
+      }
+      catch (...)
+      {
+      }
+    }
+
+
+    template <class T>
+    void TrajectoryEncoder<T>::encode(const T& pValue)
+    {
+      T decoded;
+      encode(pValue, decoded);
+    }
+
+
+    template <class T>
+    void TrajectoryEncoder<T>::encode(
+      const T& pValue,
+      T&       pDecoded)
+    {
+      if (fFinished)
+      {
+        throw std::runtime_error("ALMath: TrajectoryEncoder stream is finished.");
+      }
+
+      double channels[N];
+      for (unsigned int i=0; i<N; i++)
+      {
+        channels[i] = static_cast<double>(fLast[i])*fSteps[i];
+      }
+      xTrajectoryCodecToChannels<T>(pValue, (fNbValues > 0) ? channels : 0,
+                                    channels);
+
+      int64_t quanta[N];
+      uint64_t residuals[N];
+      bool allZero = true;
+      for (unsigned int i=0; i<N; i++)
+      {
+        const double quantum = channels[i]/fSteps[i];
+        if (!(std::fabs(quantum) < xTrajectoryCodecMaxQuantum))
+        {
+          throw std::invalid_argument(
+                "ALMath: TrajectoryEncoder value out of range.");
+        }
+        quanta[i] = static_cast<int64_t>(std::floor(quantum + 0.5));
+
+        const int64_t residual = quanta[i] - xTrajectoryCodecPredict(
+              fLast[i], fBeforeLast[i], fNbValues, fPrediction);
+        // zigzag: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+        residuals[i] = (static_cast<uint64_t>(residual) << 1) ^
+            static_cast<uint64_t>(residual >> 63);
+        allZero = allZero && (residuals[i] == 0);
+      }
+
+      // one bit for a value, one bit for a value with non zero residuals
+      xPutBits(allZero ? 2 : 3, 2);
+      for (unsigned int i=0; i<N; i++)
+      {
+        const unsigned int parameter =
+            xTrajectoryCodecRiceParameter(fRiceSum[i], fRiceCount[i]);
+        if (!allZero)
+        {
+          const uint64_t quotient = residuals[i] >> parameter;
+          if (quotient < xTrajectoryCodecEscape)
+          {
+            // unary quotient, then the low bits
+            const unsigned int nbOnes = static_cast<unsigned int>(quotient);
+            xPutBits(((1u << nbOnes) - 1u) << 1, nbOnes + 1);
+            xPutBits(static_cast<uint32_t>(residuals[i]) &
+                     ((1u << parameter) - 1u), parameter);
+          }
+          else
+          {
+            xPutBits((1u << xTrajectoryCodecEscape) - 1u, xTrajectoryCodecEscape);
+            xPutBits(static_cast<uint32_t>(residuals[i] >> 32), 32);
+            xPutBits(static_cast<uint32_t>(residuals[i]), 32);
+          }
+        }
+        xTrajectoryCodecUpdateRice(residuals[i], parameter,
+                                   fRiceSum[i], fRiceCount[i]);
+
+        fBeforeLast[i] = fLast[i];
+        fLast[i] = quanta[i];
+        channels[i] = static_cast<double>(quanta[i])*fSteps[i];
+      }
+      ++fNbValues;
+
+      if (!fStream)
+      {
+        throw std::runtime_error("ALMath: TrajectoryEncoder write failed.");
+      }
+      xTrajectoryCodecFromChannels<T>(channels, pDecoded);
+    }
+
+
+    template <class T>
+    void TrajectoryEncoder<T>::finish()
+    {
+      if (fFinished)
+      {
+        return;
+      }
+      fFinished = true;
+
+      // end marker, then pad the last byte
+      xPutBits(0, 1);
+      if (fNbBits > 0)
+      {
+        xPutBits(0, 8 - fNbBits);
+      }
+      fStream.flush();
+      if (!fStream)
+      {
+        throw std::runtime_error("ALMath: TrajectoryEncoder write failed.");
+      }
+    }
+
+
+    template <class T>
+    unsigned int TrajectoryEncoder<T>::size() const
+    {
+      return fNbValues;
+    }
+
+
+    template <class T>
+    unsigned long TrajectoryEncoder<T>::getNbBytes() const
+    {
+      return fNbBytes;
+    }
+
+
+    template <class T>
+    void TrajectoryEncoder<T>::xPutBits(
+      const uint32_t&     pBits,
+      const unsigned int& pNbBits)
+    {
+      if (pNbBits == 0)
+      {
+        return;
+      }
+      // the bits are written from the most significant one
+      fBits = (fBits << pNbBits) | pBits;
+      fNbBits += pNbBits;
+      while (fNbBits >= 8)
+      {
+        fNbBits -= 8;
+        fStream.put(static_cast<char>((fBits >> fNbBits) & 0xFF));
+        ++fNbBytes;
+      }
+    }
+
+
+    /****************************
+    TRAJECTORY DECODER
+    ****************************/
+    template <class T>
+    TrajectoryDecoder<T>::TrajectoryDecoder(std::istream& pStream):
+      fStream(pStream),
+      fPrediction(TRAJECTORY_PREDICTION_LINEAR),
+      fPositionBound(0.0f),
+      fAngleBound(0.0f),
+      fBits(0),
+      fNbBits(0),
+      fNbValues(0),
+      fFinished(false)
+    {
+      unsigned char header[TRAJECTORY_CODEC_HEADER_SIZE];
+      fStream.read(reinterpret_cast<char*>(header), sizeof(header));
+      if (static_cast<unsigned int>(fStream.gcount()) != sizeof(header))
+      {
+        throw std::runtime_error("ALMath: TrajectoryDecoder stream too short.");
+      }
+      if ((std::memcmp(header, "ALMC", 4) != 0) ||
+          (header[4] != TRAJECTORY_CODEC_VERSION))
+      {
+        throw std::runtime_error(
+              "ALMath: TrajectoryDecoder not a compressed trajectory.");
+      }
+      if (header[5] != BinaryTraits<T>::type)
+      {
+        throw std::runtime_error("ALMath: TrajectoryDecoder wrong type.");
+      }
+      if (header[6] > TRAJECTORY_PREDICTION_LINEAR)
+      {
+        throw std::runtime_error("ALMath: TrajectoryDecoder unknown prediction.");
+      }
+      fPrediction = static_cast<TRAJECTORY_PREDICTION>(header[6]);
+      fPositionBound = xReadTrajectoryCodecFloat(&header[8]);
+      fAngleBound = xReadTrajectoryCodecFloat(&header[12]);
+      if (!(fPositionBound > 0.0f) || !(fAngleBound > 0.0f))
+      {
+        throw std::runtime_error("ALMath: TrajectoryDecoder invalid bounds.");
+      }
+
+      xTrajectoryCodecSteps<T>(fPositionBound, fAngleBound, fSteps);
+      for (unsigned int i=0; i<N; i++)
+      {
+        fLast[i]       = 0;
+        fBeforeLast[i] = 0;
+        fRiceSum[i]    = 0;
+        fRiceCount[i]  = 1;
+      }
+    }
+
+
+    template <class T>
+    const bool TrajectoryDecoder<T>::decode(T& pValue)
+    {
+      if (fFinished)
+      {
+        return false;
+      }
+      if (xGetBits(1) == 0)
+      {
+        fFinished = true;
+        return false;
+      }
+
+      const bool allZero = (xGetBits(1) == 0);
+      double channels[N];
+      for (unsigned int i=0; i<N; i++)
+      {
+        const unsigned int parameter =
+            xTrajectoryCodecRiceParameter(fRiceSum[i], fRiceCount[i]);
+        uint64_t residual = 0;
+        if (!allZero)
+        {
+          unsigned int quotient = 0;
+          while ((quotient < xTrajectoryCodecEscape) && (xGetBits(1) == 1))
+          {
+            ++quotient;
+          }
+          if (quotient < xTrajectoryCodecEscape)
+          {
+            residual = (static_cast<uint64_t>(quotient) << parameter) |
+                xGetBits(parameter);
+          }
+          else
+          {
+            residual = static_cast<uint64_t>(xGetBits(32)) << 32;
+            residual |= xGetBits(32);
+          }
+        }
+        xTrajectoryCodecUpdateRice(residual, parameter,
+                                   fRiceSum[i], fRiceCount[i]);
+
+        const uint64_t prediction = static_cast<uint64_t>(xTrajectoryCodecPredict(
+              fLast[i], fBeforeLast[i], fNbValues, fPrediction));
+        const uint64_t delta = (residual >> 1) ^ (0u - (residual & 1u));
+        fBeforeLast[i] = fLast[i];
+        fLast[i] = static_cast<int64_t>(prediction + delta);
+        channels[i] = static_cast<double>(fLast[i])*fSteps[i];
+      }
+      ++fNbValues;
+
+      xTrajectoryCodecFromChannels<T>(channels, pValue);
+      return true;
+    }
+
+
+    template <class T>
+    unsigned int TrajectoryDecoder<T>::size() const
+    {
+      return fNbValues;
+    }
+
+
+    template <class T>
+    float TrajectoryDecoder<T>::getPositionBound() const
+    {
+      return fPositionBound;
+    }
+
+
+    template <class T>
+    float TrajectoryDecoder<T>::getAngleBound() const
+    {
+      return fAngleBound;
+    }
+
+
+    template <class T>
+    TRAJECTORY_PREDICTION TrajectoryDecoder<T>::getPrediction() const
+    {
+      return fPrediction;
+    }
+
+
+    template <class T>
+    uint32_t TrajectoryDecoder<T>::xGetBits(const unsigned int& pNbBits)
+    {
+      if (pNbBits == 0)
+      {
+        return 0;
+      }
+      while (fNbBits < pNbBits)
+      {
+        const std::istream::int_type byte = fStream.get();
+        if (byte == std::istream::traits_type::eof())
+        {
+          throw std::runtime_error("ALMath: TrajectoryDecoder stream truncated.");
+        }
+        fBits = (fBits << 8) | static_cast<unsigned char>(byte);
+        fNbBits += 8;
+      }
+      fNbBits -= pNbBits;
+      return static_cast<uint32_t>(
+            (fBits >> fNbBits) & ((static_cast<uint64_t>(1) << pNbBits) - 1u));
+    }
+
+
+#define ALMATH_TRAJECTORY_CODEC_INSTANTIATE(T) \
+    template class TrajectoryEncoder<T>;       \
+    template class TrajectoryDecoder<T>;
+
+    ALMATH_TRAJECTORY_CODEC_INSTANTIATE(Pose2D)
+    ALMATH_TRAJECTORY_CODEC_INSTANTIATE(Position3D)
+    ALMATH_TRAJECTORY_CODEC_INSTANTIATE(Quaternion)
+    ALMATH_TRAJECTORY_CODEC_INSTANTIATE(Transform)
+
+#undef ALMATH_TRAJECTORY_CODEC_INSTANTIATE
+
+  } // namespace Math
+} // namespace AL
@@ -0,0 +1,742 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// 64-bit offsets for fseeko, ftruncate and fstat on 32-bit systems; no
+// off_t crosses the interface of this file
+#if !defined(_WIN32) && !defined(_FILE_OFFSET_BITS)
+# define _FILE_OFFSET_BITS 64
+#endif
+
+#include <almath/tools/altrajectoryfile.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <stdint.h>
+
+#ifdef _WIN32
+# include <io.h>
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+namespace AL {
+  namespace Math {
+
+    /****************************
+    PRIVATE FUNCTION
+    ****************************/
+    // <summary> Write 4 bytes in little endian. </summary>
+    void xWriteTrajectoryUInt32(
+      const uint32_t& pValue,
+      unsigned char*  pBuffer);
+
+    // <summary> Read 4 bytes in little endian. </summary>
+    uint32_t xReadTrajectoryUInt32(const unsigned char* pBuffer);
+
+    // <summary> Write 8 bytes in little endian. </summary>
+    void xWriteTrajectoryUInt64(
+      const uint64_t& pValue,
+      unsigned char*  pBuffer);
+
+    // <summary> Read 8 bytes in little endian. </summary>
+    uint64_t xReadTrajectoryUInt64(const unsigned char* pBuffer);
+
+    // <summary> Write a timestamp as a little endian double. </summary>
+    void xWriteTrajectoryTime(
+      const double&  pTime,
+      unsigned char* pBuffer);
+
+    // <summary> Read a timestamp written by xWriteTrajectoryTime. </summary>
+    double xReadTrajectoryTime(const unsigned char* pBuffer);
+
+    // <summary> Check the fixed part of a header and return the
+    //  number of records between two entries of the index.
+    //  Throw a std::runtime_error if it does not match the type. </summary>
+    template <class T>
+    uint32_t xCheckTrajectoryHeader(const unsigned char* pHeader);
+
+    // <summary> Number of records of a file without index: the complete
+    //  records, up to the number of the header, written by the last
+    //  flush. </summary>
+    template <class T>
+    uint64_t xCountTrajectoryRecords(
+      const unsigned char* pHeader,
+      const uint64_t&      pFileSize);
+
+    // <summary> Cut a file after its first pSize bytes. </summary>
+    bool xTruncateTrajectoryFile(
+      std::FILE*      pFile,
+      const uint64_t& pSize);
+
+    // <summary> Query if a file cannot be mapped in the address space:
+    //  its size does not fit in a size_t. </summary>
+    bool xIsTrajectoryFileTooLarge(const uint64_t& pSize);
+
+    // <summary> Move to a 64-bit offset from the start of a file, as
+    //  fseek, which is limited to a long. </summary>
+    bool xSeekTrajectoryFile(
+      std::FILE*      pFile,
+      const uint64_t& pOffset);
+
+    // <summary> Size of a file, with a 64-bit offset. The position is
+    //  left at the end of the file. </summary>
+    uint64_t xGetTrajectoryFileSize(std::FILE* pFile);
+
+
+    void xWriteTrajectoryUInt32(
+      const uint32_t& pValue,
+      unsigned char*  pBuffer)
+    {
+      for (unsigned int i=0; i<4; i++)
+      {
+        pBuffer[i] = static_cast<unsigned char>((pValue >> (8*i)) & 0xFF);
+      }
+    }
+
+
+    uint32_t xReadTrajectoryUInt32(const unsigned char* pBuffer)
+    {
+      uint32_t value = 0;
+      for (unsigned int i=0; i<4; i++)
+      {
+        value |= static_cast<uint32_t>(pBuffer[i]) << (8*i);
+      }
+      return value;
+    }
+
+
+    void xWriteTrajectoryUInt64(
+      const uint64_t& pValue,
+      unsigned char*  pBuffer)
+    {
+      for (unsigned int i=0; i<8; i++)
+      {
+        pBuffer[i] = static_cast<unsigned char>((pValue >> (8*i)) & 0xFF);
+      }
+    }
+
+
+    uint64_t xReadTrajectoryUInt64(const unsigned char* pBuffer)
+    {
+      uint64_t value = 0;
+      for (unsigned int i=0; i<8; i++)
+      {
+        value |= static_cast<uint64_t>(pBuffer[i]) << (8*i);
+      }
+      return value;
+    }
+
+
+    void xWriteTrajectoryTime(
+      const double&  pTime,
+      unsigned char* pBuffer)
+    {
+      uint64_t bits;
+      std::memcpy(&bits, &pTime, sizeof(double));
+      xWriteTrajectoryUInt64(bits, pBuffer);
+    }
+
+
+    double xReadTrajectoryTime(const unsigned char* pBuffer)
+    {
+      const uint64_t bits = xReadTrajectoryUInt64(pBuffer);
+      double time;
+      std::memcpy(&time, &bits, sizeof(double));
+      return time;
+    }
+
+
+    template <class T>
+    uint32_t xCheckTrajectoryHeader(const unsigned char* pHeader)
+    {
+      if ((pHeader[0] != 'A') || (pHeader[1] != 'L') ||
+          (pHeader[2] != 'M') || (pHeader[3] != 'T'))
+      {
+        throw std::runtime_error("ALMath: trajectory file bad magic.");
+      }
+      if ((pHeader[4] == 0) || (pHeader[4] > TRAJECTORY_FORMAT_VERSION))
+      {
+        throw std::runtime_error("ALMath: trajectory file unsupported version.");
+      }
+      if ((pHeader[5] != static_cast<unsigned char>(BinaryTraits<T>::type)) ||
+          (xReadTrajectoryUInt32(&pHeader[8]) !=
+           static_cast<uint32_t>(TrajectoryRecordSize<T>::value)))
+      {
+        throw std::runtime_error("ALMath: trajectory file wrong type.");
+      }
+      const uint32_t indexStride = xReadTrajectoryUInt32(&pHeader[12]);
+      if (indexStride == 0)
+      {
+        throw std::runtime_error("ALMath: trajectory file bad index stride.");
+      }
+      return indexStride;
+    }
+
+
+    template <class T>
+    uint64_t xCountTrajectoryRecords(
+      const unsigned char* pHeader,
+      const uint64_t&      pFileSize)
+    {
+      if (pFileSize < TRAJECTORY_HEADER_SIZE)
+      {
+        return 0;
+      }
+      return std::min(xReadTrajectoryUInt64(&pHeader[16]),
+                      (pFileSize - TRAJECTORY_HEADER_SIZE)/TrajectoryRecordSize<T>::value);
+    }
+
+
+    bool xTruncateTrajectoryFile(
+      std::FILE*      pFile,
+      const uint64_t& pSize)
+    {
+      if (std::fflush(pFile) != 0)
+      {
+        return false;
+      }
+#ifdef _WIN32
+      return _chsize_s(_fileno(pFile), static_cast<__int64>(pSize)) == 0;
+#else
+      return ::ftruncate(fileno(pFile), static_cast<off_t>(pSize)) == 0;
+#endif
+    }
+
+
+    bool xSeekTrajectoryFile(
+      std::FILE*      pFile,
+      const uint64_t& pOffset)
+    {
+#ifdef _WIN32
+      return _fseeki64(pFile, static_cast<__int64>(pOffset), SEEK_SET) == 0;
+#else
+      return ::fseeko(pFile, static_cast<off_t>(pOffset), SEEK_SET) == 0;
+#endif
+    }
+
+
+    bool xIsTrajectoryFileTooLarge(const uint64_t& pSize)
+    {
+      return pSize > static_cast<uint64_t>(static_cast<size_t>(-1));
+    }
+
+
+    uint64_t xGetTrajectoryFileSize(std::FILE* pFile)
+    {
+#ifdef _WIN32
+      _fseeki64(pFile, 0, SEEK_END);
+      const __int64 size = _ftelli64(pFile);
+#else
+      ::fseeko(pFile, 0, SEEK_END);
+      const off_t size = ::ftello(pFile);
+#endif
+      return (size > 0) ? static_cast<uint64_t>(size) : 0;
+    }
+
+    /****************************
+    TRAJECTORY WRITER
+    ****************************/
+    template <class T>
+    TrajectoryWriter<T>::TrajectoryWriter(
+      const std::string&  pFileName,
+      const bool&         pAppend,
+      const unsigned int& pIndexStride):
+      fFile(0),
+      fIndexStride(pIndexStride),
+      fNbRecords(0),
+      fLastTime(0.0),
+      fIndex()
+    {
+      if (pIndexStride == 0)
+      {
+        throw std::invalid_argument(
+              "ALMath: TrajectoryWriter index stride must be positive.");
+      }
+
+      const uint64_t recordSize = TrajectoryRecordSize<T>::value;
+      if (pAppend)
+      {
+        fFile = std::fopen(pFileName.c_str(), "r+b");
+      }
+
+      if (fFile == 0)
+      {
+        fFile = std::fopen(pFileName.c_str(), "w+b");
+        if (fFile == 0)
+        {
+          throw std::runtime_error(
+                "ALMath: TrajectoryWriter cannot open " + pFileName + ".");
+        }
+        xWriteHeader(false);
+        return;
+      }
+
+      // append to an existing file
+      unsigned char header[TRAJECTORY_HEADER_SIZE];
+      const size_t headerSize = std::fread(header, 1, TRAJECTORY_HEADER_SIZE, fFile);
+      if (headerSize == 0)
+      {
+        // empty file
+        xWriteHeader(false);
+        return;
+      }
+      if (headerSize != TRAJECTORY_HEADER_SIZE)
+      {
+        std::fclose(fFile);
+        throw std::runtime_error("ALMath: TrajectoryWriter file too short.");
+      }
+      try
+      {
+        fIndexStride = xCheckTrajectoryHeader<T>(header);
+      }
+      catch (const std::runtime_error&)
+      {
+        std::fclose(fFile);
+        throw;
+      }
+
+      const uint64_t fileSize = xGetTrajectoryFileSize(fFile);
+      if (xReadTrajectoryUInt64(&header[24]) != 0)
+      {
+        // the records end where the index starts
+        fNbRecords = static_cast<unsigned int>(xReadTrajectoryUInt64(&header[16]));
+      }
+      else
+      {
+        fNbRecords = static_cast<unsigned int>(
+              xCountTrajectoryRecords<T>(header, fileSize));
+      }
+
+      // remove the old index, and what follows the last record, so that
+      // the file has no stale bytes until the next close
+      if (!xTruncateTrajectoryFile(
+            fFile, TRAJECTORY_HEADER_SIZE + fNbRecords*recordSize))
+      {
+        std::fclose(fFile);
+        throw std::runtime_error(
+              "ALMath: TrajectoryWriter cannot truncate " + pFileName + ".");
+      }
+
+      // timestamps of the index and of the last record
+      unsigned char time[8];
+      for (unsigned int i=0; i<fNbRecords; i+=fIndexStride)
+      {
+        xSeekTrajectoryFile(fFile, TRAJECTORY_HEADER_SIZE + i*recordSize);
+        std::fread(time, 1, 8, fFile);
+        fIndex.push_back(xReadTrajectoryTime(time));
+      }
+      if (fNbRecords > 0)
+      {
+        xSeekTrajectoryFile(fFile, TRAJECTORY_HEADER_SIZE + (fNbRecords-1)*recordSize);
+        std::fread(time, 1, 8, fFile);
+        fLastTime = xReadTrajectoryTime(time);
+      }
+
+      xWriteHeader(false);
+      std::fflush(fFile);
+    }
+
+
+    template <class T>
+    TrajectoryWriter<T>::~TrajectoryWriter()
+    {
+      try
+      {
+        close();
+      }
+      catch (...)
+      {
+      }
+    }
+
+
+    template <class T>
+    void TrajectoryWriter<T>::append(
+      const double& pTime,
+      const T&      pValue)
+    {
+      xCheckOpen();
+      if ((fNbRecords > 0) && (pTime < fLastTime))
+      {
+        throw std::invalid_argument(
+              "ALMath: TrajectoryWriter records must be sorted by time.");
+      }
+
+      unsigned char record[TrajectoryRecordSize<T>::value];
+      std::memset(record, 0, sizeof(record));
+      xWriteTrajectoryTime(pTime, record);
+      toBinary(pValue, &record[8]);
+      if (std::fwrite(record, 1, sizeof(record), fFile) != sizeof(record))
+      {
+        throw std::runtime_error("ALMath: TrajectoryWriter write failed.");
+      }
+
+      if (fNbRecords % fIndexStride == 0)
+      {
+        fIndex.push_back(pTime);
+      }
+      fLastTime = pTime;
+      ++fNbRecords;
+    }
+
+
+    template <class T>
+    void TrajectoryWriter<T>::flush()
+    {
+      xCheckOpen();
+      xWriteHeader(false);
+      std::fflush(fFile);
+    }
+
+
+    template <class T>
+    void TrajectoryWriter<T>::close()
+    {
+      if (fFile == 0)
+      {
+        return;
+      }
+
+      std::vector<unsigned char> index(8*fIndex.size());
+      for (unsigned int i=0; i<fIndex.size(); i++)
+      {
+        xWriteTrajectoryTime(fIndex[i], &index[8*i]);
+      }
+      bool ok = true;
+      if (!index.empty())
+      {
+        ok = (std::fwrite(&index[0], 1, index.size(), fFile) == index.size());
+      }
+      if (ok)
+      {
+        xWriteHeader(true);
+      }
+      ok = (std::fclose(fFile) == 0) && ok;
+      fFile = 0;
+      if (!ok)
+      {
+        throw std::runtime_error("ALMath: TrajectoryWriter write failed.");
+      }
+    }
+
+
+    template <class T>
+    unsigned int TrajectoryWriter<T>::size() const
+    {
+      return fNbRecords;
+    }
+
+
+    template <class T>
+    void TrajectoryWriter<T>::xWriteHeader(const bool& pWithIndex)
+    {
+      const uint64_t endOfRecords = TRAJECTORY_HEADER_SIZE +
+          static_cast<uint64_t>(fNbRecords)*TrajectoryRecordSize<T>::value;
+
+      unsigned char header[TRAJECTORY_HEADER_SIZE];
+      std::memset(header, 0, TRAJECTORY_HEADER_SIZE);
+      header[0] = 'A';
+      header[1] = 'L';
+      header[2] = 'M';
+      header[3] = 'T';
+      header[4] = TRAJECTORY_FORMAT_VERSION;
+      header[5] = static_cast<unsigned char>(BinaryTraits<T>::type);
+      xWriteTrajectoryUInt32(TrajectoryRecordSize<T>::value, &header[8]);
+      xWriteTrajectoryUInt32(fIndexStride, &header[12]);
+      xWriteTrajectoryUInt64(fNbRecords, &header[16]);
+      xWriteTrajectoryUInt64(pWithIndex ? endOfRecords : 0, &header[24]);
+
+      xSeekTrajectoryFile(fFile, 0);
+      std::fwrite(header, 1, TRAJECTORY_HEADER_SIZE, fFile);
+      xSeekTrajectoryFile(fFile, endOfRecords);
+    }
+
+
+    template <class T>
+    void TrajectoryWriter<T>::xCheckOpen() const
+    {
+      if (fFile == 0)
+      {
+        throw std::runtime_error("ALMath: TrajectoryWriter is closed.");
+      }
+    }
+
+    /****************************
+    TRAJECTORY READER
+    ****************************/
+    template <class T>
+    TrajectoryReader<T>::TrajectoryReader(const std::string& pFileName):
+      fData(0),
+      fDataSize(0),
+      fMapping(0),
+      fNbRecords(0),
+      fIndexStride(1),
+      fHasIndex(false),
+      fIndex()
+    {
+#ifdef _WIN32
+      HANDLE file = CreateFileA(pFileName.c_str(), GENERIC_READ,
+                                FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+      if (file == INVALID_HANDLE_VALUE)
+      {
+        throw std::runtime_error(
+              "ALMath: TrajectoryReader cannot open " + pFileName + ".");
+      }
+      LARGE_INTEGER fileSize;
+      GetFileSizeEx(file, &fileSize);
+      fDataSize = static_cast<uint64_t>(fileSize.QuadPart);
+      if (xIsTrajectoryFileTooLarge(fDataSize))
+      {
+        CloseHandle(file);
+        throw std::runtime_error(
+              "ALMath: TrajectoryReader file too large to map " + pFileName + ".");
+      }
+      if (fDataSize >= TRAJECTORY_HEADER_SIZE)
+      {
+        fMapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (fMapping != NULL)
+        {
+          fData = static_cast<const unsigned char*>(
+                MapViewOfFile(fMapping, FILE_MAP_READ, 0, 0, 0));
+        }
+      }
+      CloseHandle(file);
+#else
+      const int file = ::open(pFileName.c_str(), O_RDONLY);
+      if (file < 0)
+      {
+        throw std::runtime_error(
+              "ALMath: TrajectoryReader cannot open " + pFileName + ".");
+      }
+      struct stat status;
+      if (::fstat(file, &status) == 0)
+      {
+        fDataSize = static_cast<uint64_t>(status.st_size);
+      }
+      if (xIsTrajectoryFileTooLarge(fDataSize))
+      {
+        ::close(file);
+        throw std::runtime_error(
+              "ALMath: TrajectoryReader file too large to map " + pFileName + ".");
+      }
+      if (fDataSize >= TRAJECTORY_HEADER_SIZE)
+      {
+        void* data = ::mmap(0, static_cast<size_t>(fDataSize), PROT_READ,
+                            MAP_SHARED, file, 0);
+        if (data != MAP_FAILED)
+        {
+          fData = static_cast<const unsigned char*>(data);
+        }
+      }
+      ::close(file);
+#endif
+
+      if (fData == 0)
+      {
+#ifdef _WIN32
+        if (fMapping != 0)
+        {
+          CloseHandle(fMapping);
+        }
+#endif
+        if (fDataSize < TRAJECTORY_HEADER_SIZE)
+        {
+          throw std::runtime_error("ALMath: TrajectoryReader file too short.");
+        }
+        throw std::runtime_error(
+              "ALMath: TrajectoryReader cannot map " + pFileName + ".");
+      }
+
+      try
+      {
+        fIndexStride = xCheckTrajectoryHeader<T>(fData);
+      }
+      catch (const std::runtime_error&)
+      {
+        xUnmap();
+        throw;
+      }
+
+      const uint64_t recordSize = TrajectoryRecordSize<T>::value;
+      const uint64_t nbRecords = xReadTrajectoryUInt64(&fData[16]);
+      const uint64_t indexOffset = xReadTrajectoryUInt64(&fData[24]);
+      const uint64_t indexSize = 8*((nbRecords + fIndexStride - 1)/fIndexStride);
+      fHasIndex = (indexOffset != 0) &&
+          (indexOffset == TRAJECTORY_HEADER_SIZE + nbRecords*recordSize) &&
+          (indexOffset + indexSize <= fDataSize);
+
+      if (fHasIndex)
+      {
+        fNbRecords = static_cast<unsigned int>(nbRecords);
+        fIndex.resize(static_cast<unsigned int>(indexSize/8));
+        for (unsigned int i=0; i<fIndex.size(); i++)
+        {
+          fIndex[i] = xReadTrajectoryTime(&fData[indexOffset + 8*i]);
+        }
+      }
+      else
+      {
+        // not closed: the records written by the last flush
+        fNbRecords = static_cast<unsigned int>(
+              xCountTrajectoryRecords<T>(fData, fDataSize));
+        for (unsigned int i=0; i<fNbRecords; i+=fIndexStride)
+        {
+          fIndex.push_back(getTime(i));
+        }
+      }
+    }
+
+
+    template <class T>
+    TrajectoryReader<T>::~TrajectoryReader()
+    {
+      xUnmap();
+    }
+
+
+    template <class T>
+    void TrajectoryReader<T>::xUnmap()
+    {
+      if (fData == 0)
+      {
+        return;
+      }
+#ifdef _WIN32
+      UnmapViewOfFile(fData);
+      CloseHandle(fMapping);
+#else
+      ::munmap(const_cast<unsigned char*>(fData), static_cast<size_t>(fDataSize));
+#endif
+      fData = 0;
+    }
+
+
+    template <class T>
+    unsigned int TrajectoryReader<T>::size() const
+    {
+      return fNbRecords;
+    }
+
+
+    template <class T>
+    double TrajectoryReader<T>::getTime(const unsigned int& pIndex) const
+    {
+      return xReadTrajectoryTime(xRecord(pIndex));
+    }
+
+
+    template <class T>
+    void TrajectoryReader<T>::get(
+      const unsigned int& pIndex,
+      T&                  pValue) const
+    {
+      fromBinary(getPayload(pIndex), pValue);
+    }
+
+
+    template <class T>
+    const unsigned char* TrajectoryReader<T>::getPayload(
+      const unsigned int& pIndex) const
+    {
+      return xRecord(pIndex) + 8;
+    }
+
+
+    template <class T>
+    unsigned int TrajectoryReader<T>::findRecord(const double& pTime) const
+    {
+      if (fNbRecords == 0)
+      {
+        throw std::runtime_error("ALMath: TrajectoryReader is empty.");
+      }
+      if (pTime < fIndex[0])
+      {
+        return 0;
+      }
+
+      // the block of the index, then the record in the block
+      const unsigned int block = static_cast<unsigned int>(
+            std::upper_bound(fIndex.begin(), fIndex.end(), pTime) -
+            fIndex.begin()) - 1;
+      unsigned int first = block*fIndexStride;
+      unsigned int last = std::min(first + fIndexStride, fNbRecords);
+      while (last - first > 1)
+      {
+        const unsigned int middle = first + (last - first)/2;
+        if (getTime(middle) <= pTime)
+        {
+          first = middle;
+        }
+        else
+        {
+          last = middle;
+        }
+      }
+      return first;
+    }
+
+
+    template <class T>
+    double TrajectoryReader<T>::getAtTime(
+      const double& pTime,
+      T&            pValue) const
+    {
+      const unsigned int index = findRecord(pTime);
+      get(index, pValue);
+      return getTime(index);
+    }
+
+
+    template <class T>
+    const bool TrajectoryReader<T>::hasIndex() const
+    {
+      return fHasIndex;
+    }
+
+
+    template <class T>
+    const unsigned char* TrajectoryReader<T>::xRecord(
+      const unsigned int& pIndex) const
+    {
+      return fData + TRAJECTORY_HEADER_SIZE +
+          static_cast<size_t>(pIndex)*TrajectoryRecordSize<T>::value;
+    }
+
+
+    template class TrajectoryWriter<Pose2D>;
+    template class TrajectoryWriter<Position2D>;
+    template class TrajectoryWriter<Position3D>;
+    template class TrajectoryWriter<Position6D>;
+    template class TrajectoryWriter<PositionAndVelocity>;
+    template class TrajectoryWriter<Quaternion>;
+    template class TrajectoryWriter<Rotation>;
+    template class TrajectoryWriter<Rotation3D>;
+    template class TrajectoryWriter<Transform>;
+    template class TrajectoryWriter<TransformAndVelocity6D>;
+    template class TrajectoryWriter<Velocity3D>;
+    template class TrajectoryWriter<Velocity6D>;
+
+    template class TrajectoryReader<Pose2D>;
+    template class TrajectoryReader<Position2D>;
+    template class TrajectoryReader<Position3D>;
+    template class TrajectoryReader<Position6D>;
+    template class TrajectoryReader<PositionAndVelocity>;
+    template class TrajectoryReader<Quaternion>;
+    template class TrajectoryReader<Rotation>;
+    template class TrajectoryReader<Rotation3D>;
+    template class TrajectoryReader<Transform>;
+    template class TrajectoryReader<TransformAndVelocity6D>;
+    template class TrajectoryReader<Velocity3D>;
+    template class TrajectoryReader<Velocity6D>;
+
+  } // namespace Math
+} // namespace AL
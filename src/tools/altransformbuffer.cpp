@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/altransformbuffer.h>
+#include <almath/tools/altransformhelpers.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace AL {
+  namespace Math {
+
+    /****************************
+    PRIVATE FUNCTION
+    ****************************/
+    // <summary> Number of times a lookup is started again when the
+    //  writer replaces the samples it reads. </summary>
+    static const unsigned int xTransformBufferMaxAttempts = 8;
+
+
+    TransformBuffer::TransformBuffer(const unsigned int& pCapacity):
+      fSlots(pCapacity),
+      fNbSamples(0),
+      fLastTime(0.0),
+      fLastTransform()
+    {
+      if (pCapacity < 2)
+      {
+        throw std::invalid_argument(
+              "ALMath: TransformBuffer capacity must be at least 2.");
+      }
+      for (unsigned int i=0; i<fSlots.size(); i++)
+      {
+        fSlots[i].sequence.store(0, std::memory_order_relaxed);
+        for (unsigned int j=0; j<NB_WORDS; j++)
+        {
+          fSlots[i].words[j].store(0, std::memory_order_relaxed);
+        }
+      }
+    }
+
+
+    const bool TransformBuffer::push(
+      const double&    pTime,
+      const Transform& pTransform)
+    {
+      const uint64_t index = fNbSamples.load(std::memory_order_relaxed);
+      // written this way, the test also rejects NaN
+      if (!(pTime == pTime) || ((index > 0) && !(pTime > fLastTime)))
+      {
+        return false;
+      }
+
+      Sample sample;
+      sample.time = pTime;
+      sample.transform = pTransform;
+      if (index > 0)
+      {
+        Transform lastInverse;
+        transformInverse(fLastTransform, lastInverse);
+        transformLogarithmInPlace(lastInverse*pTransform, sample.motion);
+      }
+      uint64_t words[NB_WORDS];
+      words[NB_WORDS - 1] = 0;
+      std::memcpy(words, &sample, sizeof(Sample));
+
+      Slot& slot = fSlots[index % fSlots.size()];
+      slot.sequence.store(2*index + 1, std::memory_order_relaxed);
+      // the readers see the odd sequence before any word of the sample
+      std::atomic_thread_fence(std::memory_order_release);
+      for (unsigned int i=0; i<NB_WORDS; i++)
+      {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+      }
+      slot.sequence.store(2*index + 2, std::memory_order_release);
+      fNbSamples.store(index + 1, std::memory_order_release);
+
+      fLastTime = pTime;
+      fLastTransform = pTransform;
+      return true;
+    }
+
+
+    const bool TransformBuffer::getAtTime(
+      const double& pTime,
+      Transform&    pTransform) const
+    {
+      const uint64_t capacity = fSlots.size();
+      for (unsigned int attempt=0; attempt<xTransformBufferMaxAttempts; attempt++)
+      {
+        const uint64_t nbSamples = fNbSamples.load(std::memory_order_acquire);
+        if (nbSamples == 0)
+        {
+          return false;
+        }
+        const uint64_t first = (nbSamples > capacity) ? nbSamples - capacity : 0;
+        uint64_t last = nbSamples - 1;
+
+        Sample sample;
+        if (!xRead(last, sample))
+        {
+          continue;
+        }
+        if (pTime >= sample.time)
+        {
+          if (pTime > sample.time)
+          {
+            return false;
+          }
+          pTransform = sample.transform;
+          return true;
+        }
+
+        double time = 0.0;
+        if (xReadTime(first, time) && (pTime < time))
+        {
+          return false;
+        }
+
+        // time(first) <= pTime < time(last). A sample which cannot be read
+        // was replaced by the writer: it is older than pTime.
+        uint64_t before = first;
+        while (last - before > 1)
+        {
+          const uint64_t middle = before + (last - before)/2;
+          if (!xReadTime(middle, time) || (time <= pTime))
+          {
+            before = middle;
+          }
+          else
+          {
+            last = middle;
+          }
+        }
+
+        Sample previous;
+        if (!xRead(before, previous) || !xRead(last, sample))
+        {
+          continue;
+        }
+        const float ratio = static_cast<float>(
+              (pTime - previous.time)/(sample.time - previous.time));
+        pTransform = previous.transform*velocityExponential(ratio*sample.motion);
+        return true;
+      }
+
+      // the samples around pTime are replaced faster than they are read
+      return false;
+    }
+
+
+    const bool TransformBuffer::getLatest(
+      double&    pTime,
+      Transform& pTransform) const
+    {
+      for (unsigned int attempt=0; attempt<xTransformBufferMaxAttempts; attempt++)
+      {
+        const uint64_t nbSamples = fNbSamples.load(std::memory_order_acquire);
+        if (nbSamples == 0)
+        {
+          return false;
+        }
+        Sample sample;
+        if (xRead(nbSamples - 1, sample))
+        {
+          pTime = sample.time;
+          pTransform = sample.transform;
+          return true;
+        }
+      }
+      return false;
+    }
+
+
+    unsigned int TransformBuffer::size() const
+    {
+      const uint64_t nbSamples = fNbSamples.load(std::memory_order_acquire);
+      return static_cast<unsigned int>(
+            (nbSamples < fSlots.size()) ? nbSamples : fSlots.size());
+    }
+
+
+    unsigned int TransformBuffer::capacity() const
+    {
+      return static_cast<unsigned int>(fSlots.size());
+    }
+
+
+    const bool TransformBuffer::xRead(
+      const uint64_t& pIndex,
+      Sample&         pSample) const
+    {
+      const Slot& slot = fSlots[pIndex % fSlots.size()];
+      const uint64_t sequence = 2*pIndex + 2;
+      if (slot.sequence.load(std::memory_order_acquire) != sequence)
+      {
+        return false;
+      }
+      uint64_t words[NB_WORDS];
+      for (unsigned int i=0; i<NB_WORDS; i++)
+      {
+        words[i] = slot.words[i].load(std::memory_order_relaxed);
+      }
+      // the words are read before the sequence is checked again
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+      {
+        return false;
+      }
+      std::memcpy(&pSample, words, sizeof(Sample));
+      return true;
+    }
+
+
+    const bool TransformBuffer::xReadTime(
+      const uint64_t& pIndex,
+      double&         pTime) const
+    {
+      // the time is the first word of a sample
+      const Slot& slot = fSlots[pIndex % fSlots.size()];
+      const uint64_t sequence = 2*pIndex + 2;
+      if (slot.sequence.load(std::memory_order_acquire) != sequence)
+      {
+        return false;
+      }
+      const uint64_t word = slot.words[0].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+      {
+        return false;
+      }
+      std::memcpy(&pTime, &word, sizeof(double));
+      return true;
+    }
+
+  } // namespace Math
+} // namespace AL
@@ -67,10 +67,23 @@ namespace AL {
     }
 
 
-    void transformLogarithmInPlace(
+    template <int Mask>
+    void maskedTransformLogarithmInPlace(
         const Transform& pH,
         Velocity6D&      pVOut)
     {
+      // the masked-out axes are zero, and never computed
+      if (!(Mask & AXIS_MASK_X))  { pVOut.xd  = 0.0f; }
+      if (!(Mask & AXIS_MASK_Y))  { pVOut.yd  = 0.0f; }
+      if (!(Mask & AXIS_MASK_Z))  { pVOut.zd  = 0.0f; }
+      if (!(Mask & AXIS_MASK_WX)) { pVOut.wxd = 0.0f; }
+      if (!(Mask & AXIS_MASK_WY)) { pVOut.wyd = 0.0f; }
+      if (!(Mask & AXIS_MASK_WZ)) { pVOut.wzd = 0.0f; }
+      if (Mask == AXIS_MASK_NONE)
+      {
+        return;
+      }
+
       float epsilon = 0.001f; // new
 
       // square root of sum of squares of the elements
@@ -88,43 +101,43 @@ namespace AL {
         if (co > 1.0f - epsilon)
         {
           coeff = angle/( 2.0f*si + epsilon );
-          pVOut.wxd = coeff * (pH.r3_c2 - pH.r2_c3);
-          pVOut.wyd = coeff * (pH.r1_c3 - pH.r3_c1);
-          pVOut.wzd = coeff * (pH.r2_c1 - pH.r1_c2);
+          if (Mask & AXIS_MASK_WX) { pVOut.wxd = coeff * (pH.r3_c2 - pH.r2_c3); }
+          if (Mask & AXIS_MASK_WY) { pVOut.wyd = coeff * (pH.r1_c3 - pH.r3_c1); }
+          if (Mask & AXIS_MASK_WZ) { pVOut.wzd = coeff * (pH.r2_c1 - pH.r1_c2); }
         }
         else if (co < -1.0f + epsilon)
         {
           if (pH.r1_c1 > 1.0f - epsilon)
           {
             lambda    = 1.0f/(PI*PI);
-            pVOut.wxd = angle;
-            pVOut.wyd = 0.0f;
-            pVOut.wzd = 0.0f;
-            pVOut.xd  = pH.r1_c4;
-            pVOut.yd  = (1.0f-lambda*angle*angle)*pH.r2_c4 + 0.5f*angle*pH.r3_c4;
-            pVOut.zd  = -0.5f*angle*pH.r2_c4 + (1.0f-lambda*angle*angle)*pH.r3_c4;
+            if (Mask & AXIS_MASK_WX) { pVOut.wxd = angle; }
+            if (Mask & AXIS_MASK_WY) { pVOut.wyd = 0.0f; }
+            if (Mask & AXIS_MASK_WZ) { pVOut.wzd = 0.0f; }
+            if (Mask & AXIS_MASK_X)  { pVOut.xd  = pH.r1_c4; }
+            if (Mask & AXIS_MASK_Y)  { pVOut.yd  = (1.0f-lambda*angle*angle)*pH.r2_c4 + 0.5f*angle*pH.r3_c4; }
+            if (Mask & AXIS_MASK_Z)  { pVOut.zd  = -0.5f*angle*pH.r2_c4 + (1.0f-lambda*angle*angle)*pH.r3_c4; }
             return;
           }
           else if (pH.r2_c2 > 1.0f - epsilon)
           {
             lambda    = 1.0f/(PI*PI);
-            pVOut.wxd = 0.0f;
-            pVOut.wyd = angle;
-            pVOut.wzd = 0.0f;
-            pVOut.xd  = (1.0f-lambda*angle*angle)*pH.r1_c4 - 0.5f*angle*pH.r3_c4;
-            pVOut.yd  = pH.r2_c4;
-            pVOut.zd  = 0.5f*angle*pH.r1_c4 + (1.0f-lambda*angle*angle)*pH.r3_c4;
+            if (Mask & AXIS_MASK_WX) { pVOut.wxd = 0.0f; }
+            if (Mask & AXIS_MASK_WY) { pVOut.wyd = angle; }
+            if (Mask & AXIS_MASK_WZ) { pVOut.wzd = 0.0f; }
+            if (Mask & AXIS_MASK_X)  { pVOut.xd  = (1.0f-lambda*angle*angle)*pH.r1_c4 - 0.5f*angle*pH.r3_c4; }
+            if (Mask & AXIS_MASK_Y)  { pVOut.yd  = pH.r2_c4; }
+            if (Mask & AXIS_MASK_Z)  { pVOut.zd  = 0.5f*angle*pH.r1_c4 + (1.0f-lambda*angle*angle)*pH.r3_c4; }
             return;
           }
           else if (pH.r3_c3 > 1.0f - epsilon)
           {
             lambda    = 1.0f/(PI*PI);
-            pVOut.wxd = 0.0f;
-            pVOut.wyd = 0.0f;
-            pVOut.wzd = angle;
-            pVOut.xd  = (1.0f-lambda*angle*angle)*pH.r1_c4 + 0.5f*angle*pH.r2_c4;
-            pVOut.yd  = -0.5f*angle*pH.r1_c4 + (1.0f-lambda*angle*angle)*pH.r2_c4;
-            pVOut.zd  = pH.r3_c4;
+            if (Mask & AXIS_MASK_WX) { pVOut.wxd = 0.0f; }
+            if (Mask & AXIS_MASK_WY) { pVOut.wyd = 0.0f; }
+            if (Mask & AXIS_MASK_WZ) { pVOut.wzd = angle; }
+            if (Mask & AXIS_MASK_X)  { pVOut.xd  = (1.0f-lambda*angle*angle)*pH.r1_c4 + 0.5f*angle*pH.r2_c4; }
+            if (Mask & AXIS_MASK_Y)  { pVOut.yd  = -0.5f*angle*pH.r1_c4 + (1.0f-lambda*angle*angle)*pH.r2_c4; }
+            if (Mask & AXIS_MASK_Z)  { pVOut.zd  = pH.r3_c4; }
             return;
           }
           else
@@ -140,9 +153,14 @@ namespace AL {
       else
       {
         coeff = angle/(2.0f*si); // was pow(2.0f,-52)
-        pVOut.wxd = coeff * (pH.r3_c2 - pH.r2_c3);
-        pVOut.wyd = coeff * (pH.r1_c3 - pH.r3_c1);
-        pVOut.wzd = coeff * (pH.r2_c1 - pH.r1_c2);
+        if (Mask & AXIS_MASK_WX) { pVOut.wxd = coeff * (pH.r3_c2 - pH.r2_c3); }
+        if (Mask & AXIS_MASK_WY) { pVOut.wyd = coeff * (pH.r1_c3 - pH.r3_c1); }
+        if (Mask & AXIS_MASK_WZ) { pVOut.wzd = coeff * (pH.r2_c1 - pH.r1_c2); }
+      }
+
+      if (!(Mask & AXIS_MASK_VEL))
+      {
+        return;
       }
 
       float coeff_2 = powf(coeff, 2);
@@ -160,31 +178,56 @@ namespace AL {
         lambda = 0.5f*(2.0f*si - angle*(1.0f + co)) / (angle * angle * si);
       }
 
-      pVOut.xd = pH.r2_c4*(
-          coeff_2*(  pH.r1_c3 - pH.r3_c1 )*( pH.r3_c2 - pH.r2_c3 )*lambda -
-          0.5f*coeff*( pH.r1_c2 - pH.r2_c1 )) +
-          pH.r3_c4*( coeff_2*(  pH.r1_c2 - pH.r2_c1 )*( pH.r2_c3 - pH.r3_c2 )*lambda -
-                     0.5f*coeff*( pH.r1_c3 - pH.r3_c1 )) +
-          pH.r1_c4*( coeff_2*(( pH.r1_c3 - pH.r3_c1 )*( pH.r3_c1 - pH.r1_c3) +
-                              ( pH.r1_c2 - pH.r2_c1 )*( pH.r2_c1 - pH.r1_c2 ))*lambda + 1.0f );
-
-      pVOut.yd = pH.r2_c4*(
-          coeff_2*(( pH.r2_c3 - pH.r3_c2 )*( pH.r3_c2 - pH.r2_c3 ) +
-                   ( pH.r1_c2 - pH.r2_c1 )*( pH.r2_c1 - pH.r1_c2 ))*lambda + 1.0f) +
-          pH.r1_c4*( coeff_2*( pH.r3_c1 - pH.r1_c3 )*( pH.r2_c3 - pH.r3_c2 )*lambda -
-                     0.5f*coeff*( pH.r2_c1 - pH.r1_c2 )) +
-          pH.r3_c4*( coeff_2*( pH.r2_c1 - pH.r1_c2 )*( pH.r1_c3 - pH.r3_c1 )*lambda -
-                     0.5f*coeff*( pH.r2_c3 - pH.r3_c2 ));
-
-      pVOut.zd = pH.r3_c4*(
-          coeff_2*(( pH.r2_c3 - pH.r3_c2 )*( pH.r3_c2 - pH.r2_c3 ) +
-                   ( pH.r1_c3 - pH.r3_c1 )*( pH.r3_c1 - pH.r1_c3 ))*lambda + 1.0f ) +
-          pH.r1_c4*( coeff_2*( pH.r2_c1 - pH.r1_c2 )*( pH.r3_c2 - pH.r2_c3 )*lambda -
-                     0.5f*coeff*( pH.r3_c1 - pH.r1_c3 )) +
-          pH.r2_c4*( coeff_2*( pH.r1_c2 - pH.r2_c1 )*( pH.r3_c1 - pH.r1_c3 )*lambda -
-                     0.5f*coeff*( pH.r3_c2 - pH.r2_c3 ));
-
-    } // end transformLogarithmInPlace
+      if (Mask & AXIS_MASK_X)
+      {
+        pVOut.xd = pH.r2_c4*(
+            coeff_2*(  pH.r1_c3 - pH.r3_c1 )*( pH.r3_c2 - pH.r2_c3 )*lambda -
+            0.5f*coeff*( pH.r1_c2 - pH.r2_c1 )) +
+            pH.r3_c4*( coeff_2*(  pH.r1_c2 - pH.r2_c1 )*( pH.r2_c3 - pH.r3_c2 )*lambda -
+                       0.5f*coeff*( pH.r1_c3 - pH.r3_c1 )) +
+            pH.r1_c4*( coeff_2*(( pH.r1_c3 - pH.r3_c1 )*( pH.r3_c1 - pH.r1_c3) +
+                                ( pH.r1_c2 - pH.r2_c1 )*( pH.r2_c1 - pH.r1_c2 ))*lambda + 1.0f );
+      }
+
+      if (Mask & AXIS_MASK_Y)
+      {
+        pVOut.yd = pH.r2_c4*(
+            coeff_2*(( pH.r2_c3 - pH.r3_c2 )*( pH.r3_c2 - pH.r2_c3 ) +
+                     ( pH.r1_c2 - pH.r2_c1 )*( pH.r2_c1 - pH.r1_c2 ))*lambda + 1.0f) +
+            pH.r1_c4*( coeff_2*( pH.r3_c1 - pH.r1_c3 )*( pH.r2_c3 - pH.r3_c2 )*lambda -
+                       0.5f*coeff*( pH.r2_c1 - pH.r1_c2 )) +
+            pH.r3_c4*( coeff_2*( pH.r2_c1 - pH.r1_c2 )*( pH.r1_c3 - pH.r3_c1 )*lambda -
+                       0.5f*coeff*( pH.r2_c3 - pH.r3_c2 ));
+      }
+
+      if (Mask & AXIS_MASK_Z)
+      {
+        pVOut.zd = pH.r3_c4*(
+            coeff_2*(( pH.r2_c3 - pH.r3_c2 )*( pH.r3_c2 - pH.r2_c3 ) +
+                     ( pH.r1_c3 - pH.r3_c1 )*( pH.r3_c1 - pH.r1_c3 ))*lambda + 1.0f ) +
+            pH.r1_c4*( coeff_2*( pH.r2_c1 - pH.r1_c2 )*( pH.r3_c2 - pH.r2_c3 )*lambda -
+                       0.5f*coeff*( pH.r3_c1 - pH.r1_c3 )) +
+            pH.r2_c4*( coeff_2*( pH.r1_c2 - pH.r2_c1 )*( pH.r3_c1 - pH.r1_c3 )*lambda -
+                       0.5f*coeff*( pH.r3_c2 - pH.r2_c3 ));
+      }
+    } // end maskedTransformLogarithmInPlace
+
+
+    template <int Mask>
+    Velocity6D maskedTransformLogarithm(const Transform& pH)
+    {
+      Velocity6D pV;
+      maskedTransformLogarithmInPlace<Mask>(pH, pV);
+      return pV;
+    }
+
+
+    void transformLogarithmInPlace(
+        const Transform& pH,
+        Velocity6D&      pVOut)
+    {
+      maskedTransformLogarithmInPlace<AXIS_MASK_ALL>(pH, pVOut);
+    }
 
 
     Velocity6D transformLogarithm(const Transform& pH)
@@ -403,16 +446,15 @@ namespace AL {
     }
 
 
-    void transformMeanInPlace(
+    const MATH_STATUS tryTransformMeanInPlace(
         const AL::Math::Transform&  pHIn1,
         const AL::Math::Transform&  pHIn2,
         const float&                pDist,
-        AL::Math::Transform&        pHOut)
+        AL::Math::Transform&        pHOut) ALMATH_NOEXCEPT
     {
       if ((pDist>1.0f) || (pDist<0.0f))
       {
-        throw std::runtime_error(
-            "ALMath: transformMeanInPlace Distance must be between 0 and 1.");
+        return MATH_INVALID_ARGUMENT;
       }
 
       Velocity6D pV;
@@ -422,6 +464,21 @@ namespace AL {
       transformLogarithmInPlace(pHIn1i*pHIn2, pV);
       velocityExponentialInPlace(pDist*pV, pHOut);
       pHOut = pHIn1*pHOut;
+      return MATH_OK;
+    }
+
+
+    void transformMeanInPlace(
+        const AL::Math::Transform&  pHIn1,
+        const AL::Math::Transform&  pHIn2,
+        const float&                pDist,
+        AL::Math::Transform&        pHOut)
+    {
+      if (tryTransformMeanInPlace(pHIn1, pHIn2, pDist, pHOut) != MATH_OK)
+      {
+        throw std::runtime_error(
+            "ALMath: transformMeanInPlace Distance must be between 0 and 1.");
+      }
     }
 
 
@@ -586,25 +643,59 @@ namespace AL {
     }
 
 
+    template <int Mask>
+    void maskedPosition6DFromTransformDiffInPlace(
+        const Transform& pCurrent,
+        const Transform& pTarget,
+        Position6D&      result)
+    {
+      result.x = (Mask & AXIS_MASK_X) ? pTarget.r1_c4 - pCurrent.r1_c4 : 0.0f;
+      result.y = (Mask & AXIS_MASK_Y) ? pTarget.r2_c4 - pCurrent.r2_c4 : 0.0f;
+      result.z = (Mask & AXIS_MASK_Z) ? pTarget.r3_c4 - pCurrent.r3_c4 : 0.0f;
+
+      result.wx = 0.0f;
+      if (Mask & AXIS_MASK_WX)
+      {
+        result.wx = 0.5f * ( ((pCurrent.r2_c1 * pTarget.r3_c1) - (pCurrent.r3_c1 * pTarget.r2_c1)) +
+                             ((pCurrent.r2_c2 * pTarget.r3_c2) - (pCurrent.r3_c2 * pTarget.r2_c2)) +
+                             ((pCurrent.r2_c3 * pTarget.r3_c3) - (pCurrent.r3_c3 * pTarget.r2_c3)) );
+      }
+
+      result.wy = 0.0f;
+      if (Mask & AXIS_MASK_WY)
+      {
+        result.wy = 0.5f * ( ((pCurrent.r3_c1 * pTarget.r1_c1) - (pCurrent.r1_c1 * pTarget.r3_c1)) +
+                             ((pCurrent.r3_c2 * pTarget.r1_c2) - (pCurrent.r1_c2 * pTarget.r3_c2)) +
+                             ((pCurrent.r3_c3 * pTarget.r1_c3) - (pCurrent.r1_c3 * pTarget.r3_c3)) );
+      }
+
+      result.wz = 0.0f;
+      if (Mask & AXIS_MASK_WZ)
+      {
+        result.wz = 0.5f * ( ((pCurrent.r1_c1 * pTarget.r2_c1) - (pCurrent.r2_c1 * pTarget.r1_c1)) +
+                             ((pCurrent.r1_c2 * pTarget.r2_c2) - (pCurrent.r2_c2 * pTarget.r1_c2)) +
+                             ((pCurrent.r1_c3 * pTarget.r2_c3) - (pCurrent.r2_c3 * pTarget.r1_c3)) );
+      }
+    }
+
+
+    template <int Mask>
+    Position6D maskedPosition6DFromTransformDiff(
+        const Transform& pCurrent,
+        const Transform& pTarget)
+    {
+      Position6D result;
+      maskedPosition6DFromTransformDiffInPlace<Mask>(pCurrent, pTarget, result);
+      return result;
+    }
+
+
     void position6DFromTransformDiffInPlace(
         const Transform& pCurrent,
         const Transform& pTarget,
         Position6D&      result)
     {
-      result.x = pTarget.r1_c4 - pCurrent.r1_c4;
-      result.y = pTarget.r2_c4 - pCurrent.r2_c4;
-      result.z = pTarget.r3_c4 - pCurrent.r3_c4;
-      result.wx = 0.5f * ( ((pCurrent.r2_c1 * pTarget.r3_c1) - (pCurrent.r3_c1 * pTarget.r2_c1)) +
-                           ((pCurrent.r2_c2 * pTarget.r3_c2) - (pCurrent.r3_c2 * pTarget.r2_c2)) +
-                           ((pCurrent.r2_c3 * pTarget.r3_c3) - (pCurrent.r3_c3 * pTarget.r2_c3)) );
-
-      result.wy = 0.5f * ( ((pCurrent.r3_c1 * pTarget.r1_c1) - (pCurrent.r1_c1 * pTarget.r3_c1)) +
-                           ((pCurrent.r3_c2 * pTarget.r1_c2) - (pCurrent.r1_c2 * pTarget.r3_c2)) +
-                           ((pCurrent.r3_c3 * pTarget.r1_c3) - (pCurrent.r1_c3 * pTarget.r3_c3)) );
-
-      result.wz = 0.5f * ( ((pCurrent.r1_c1 * pTarget.r2_c1) - (pCurrent.r2_c1 * pTarget.r1_c1)) +
-                           ((pCurrent.r1_c2 * pTarget.r2_c2) - (pCurrent.r2_c2 * pTarget.r1_c2)) +
-                           ((pCurrent.r1_c3 * pTarget.r2_c3) - (pCurrent.r2_c3 * pTarget.r1_c3)) );
+      maskedPosition6DFromTransformDiffInPlace<AXIS_MASK_ALL>(pCurrent, pTarget, result);
     }
 
 
@@ -701,15 +792,14 @@ namespace AL {
     }
 
 
-    void axisRotationProjectionInPlace(
+    const MATH_STATUS tryAxisRotationProjectionInPlace(
         const Position3D& pAxis,
-        Rotation&         pRot)
+        Rotation&         pRot) ALMATH_NOEXCEPT
     {
       float inw = norm(pAxis);
       if (inw == 0.0f)
       {
-        throw std::runtime_error(
-            "ALMath: axisRotationProjectionInPlace Division by zeros.");
+        return MATH_DIVISION_BY_ZERO;
       }
 
       inw = 1.0f/inw;
@@ -741,9 +831,7 @@ namespace AL {
 
       if (d2<0)
       {
-        throw std::runtime_error(
-            "ALMath: axisRotationProjectionInPlace d2 < 0");
-        return;
+        return MATH_INVALID_ARGUMENT;
       }
 
       float alpha  = atan2f( b , a );
@@ -801,18 +889,36 @@ namespace AL {
         pRot.r3_c3 = cos_1*( - y_2 - x_2 ) + 1.0f;
 
       }
-    } // end axisRotationProjectionInPlace
+      return MATH_OK;
+    } // end tryAxisRotationProjectionInPlace
 
 
     void axisRotationProjectionInPlace(
         const Position3D& pAxis,
-        Transform&        pH)
+        Rotation&         pRot)
     {
-      float inw = norm(pAxis);
-      if (inw == 0.0f)
+      switch (tryAxisRotationProjectionInPlace(pAxis, pRot))
       {
+      case MATH_DIVISION_BY_ZERO:
         throw std::runtime_error(
             "ALMath: axisRotationProjectionInPlace Division by zeros.");
+      case MATH_INVALID_ARGUMENT:
+        throw std::runtime_error(
+            "ALMath: axisRotationProjectionInPlace d2 < 0");
+      default:
+        break;
+      }
+    } // end axisRotationProjectionInPlace
+
+
+    const MATH_STATUS tryAxisRotationProjectionInPlace(
+        const Position3D& pAxis,
+        Transform&        pH) ALMATH_NOEXCEPT
+    {
+      float inw = norm(pAxis);
+      if (inw == 0.0f)
+      {
+        return MATH_DIVISION_BY_ZERO;
       }
 
       inw = 1.0f/inw;
@@ -844,9 +950,7 @@ namespace AL {
 
       if (d2<0)
       {
-        throw std::runtime_error(
-            "ALMath: axisRotationProjectionInPlace d2 < 0");
-        return;
+        return MATH_INVALID_ARGUMENT;
       }
 
       float alpha  = atan2f(b, a);
@@ -903,6 +1007,25 @@ namespace AL {
         pH.r3_c2 = cos_1*y*z + sin_1*x;
         pH.r3_c3 = cos_1*( - y_2 - x_2 ) + 1.0f;
       }
+      return MATH_OK;
+    } // end tryAxisRotationProjectionInPlace
+
+
+    void axisRotationProjectionInPlace(
+        const Position3D& pAxis,
+        Transform&        pH)
+    {
+      switch (tryAxisRotationProjectionInPlace(pAxis, pH))
+      {
+      case MATH_DIVISION_BY_ZERO:
+        throw std::runtime_error(
+            "ALMath: axisRotationProjectionInPlace Division by zeros.");
+      case MATH_INVALID_ARGUMENT:
+        throw std::runtime_error(
+            "ALMath: axisRotationProjectionInPlace d2 < 0");
+      default:
+        break;
+      }
     } // end axisRotationProjectionInPlace
 
 
@@ -1146,5 +1269,82 @@ namespace AL {
       return quaOut;
     } // end quaternionFromTransform
 
+
+    template <int Mask>
+    void maskedVelocity6DProjectionInPlace(Velocity6D& pVel)
+    {
+      if (!(Mask & AXIS_MASK_X))  { pVel.xd  = 0.0f; }
+      if (!(Mask & AXIS_MASK_Y))  { pVel.yd  = 0.0f; }
+      if (!(Mask & AXIS_MASK_Z))  { pVel.zd  = 0.0f; }
+      if (!(Mask & AXIS_MASK_WX)) { pVel.wxd = 0.0f; }
+      if (!(Mask & AXIS_MASK_WY)) { pVel.wyd = 0.0f; }
+      if (!(Mask & AXIS_MASK_WZ)) { pVel.wzd = 0.0f; }
+    }
+
+
+    template <int Mask>
+    Velocity6D maskedVelocity6DProjection(const Velocity6D& pVel)
+    {
+      Velocity6D result = pVel;
+      maskedVelocity6DProjectionInPlace<Mask>(result);
+      return result;
+    }
+
+
+    template <int Mask>
+    float maskedDistanceSquared(
+        const Position6D& pPos1,
+        const Position6D& pPos2)
+    {
+      float result = 0.0f;
+      if (Mask & AXIS_MASK_X)  { result += (pPos1.x - pPos2.x)*(pPos1.x - pPos2.x); }
+      if (Mask & AXIS_MASK_Y)  { result += (pPos1.y - pPos2.y)*(pPos1.y - pPos2.y); }
+      if (Mask & AXIS_MASK_Z)  { result += (pPos1.z - pPos2.z)*(pPos1.z - pPos2.z); }
+      if (Mask & AXIS_MASK_WX) { result += (pPos1.wx - pPos2.wx)*(pPos1.wx - pPos2.wx); }
+      if (Mask & AXIS_MASK_WY) { result += (pPos1.wy - pPos2.wy)*(pPos1.wy - pPos2.wy); }
+      if (Mask & AXIS_MASK_WZ) { result += (pPos1.wz - pPos2.wz)*(pPos1.wz - pPos2.wz); }
+      return result;
+    }
+
+
+    template <int Mask>
+    float maskedDistance(
+        const Position6D& pPos1,
+        const Position6D& pPos2)
+    {
+      return sqrtf(maskedDistanceSquared<Mask>(pPos1, pPos2));
+    }
+
+
+#define ALMATH_INSTANTIATE_MASK(Mask)                                      \
+    template void maskedTransformLogarithmInPlace<Mask>(                    \
+      const Transform&, Velocity6D&);                                       \
+    template Velocity6D maskedTransformLogarithm<Mask>(const Transform&);   \
+    template void maskedPosition6DFromTransformDiffInPlace<Mask>(           \
+      const Transform&, const Transform&, Position6D&);                     \
+    template Position6D maskedPosition6DFromTransformDiff<Mask>(            \
+      const Transform&, const Transform&);                                  \
+    template void maskedVelocity6DProjectionInPlace<Mask>(Velocity6D&);     \
+    template Velocity6D maskedVelocity6DProjection<Mask>(const Velocity6D&);\
+    template float maskedDistanceSquared<Mask>(                             \
+      const Position6D&, const Position6D&);                                \
+    template float maskedDistance<Mask>(                                    \
+      const Position6D&, const Position6D&);
+#define ALMATH_INSTANTIATE_MASK_4(Mask)                                    \
+    ALMATH_INSTANTIATE_MASK(Mask)     ALMATH_INSTANTIATE_MASK(Mask + 1)     \
+    ALMATH_INSTANTIATE_MASK(Mask + 2) ALMATH_INSTANTIATE_MASK(Mask + 3)
+#define ALMATH_INSTANTIATE_MASK_16(Mask)                                   \
+    ALMATH_INSTANTIATE_MASK_4(Mask)     ALMATH_INSTANTIATE_MASK_4(Mask + 4) \
+    ALMATH_INSTANTIATE_MASK_4(Mask + 8) ALMATH_INSTANTIATE_MASK_4(Mask + 12)
+
+    // all the 64 masks, from AXIS_MASK_NONE to AXIS_MASK_ALL
+    ALMATH_INSTANTIATE_MASK_16(0)
+    ALMATH_INSTANTIATE_MASK_16(16)
+    ALMATH_INSTANTIATE_MASK_16(32)
+    ALMATH_INSTANTIATE_MASK_16(48)
+#undef ALMATH_INSTANTIATE_MASK_16
+#undef ALMATH_INSTANTIATE_MASK_4
+#undef ALMATH_INSTANTIATE_MASK
+
   } // namespace Math
 } // namespace AL
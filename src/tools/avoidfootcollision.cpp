@@ -5,7 +5,12 @@
  */
 
 #include <almath/tools/avoidfootcollision.h>
+#include <almath/tools/altrigonometry.h>
+#include <almath/tools/althreadpool.h>
+#include <algorithm>
+#include <cfloat>
 #include <cmath>
+#include <stdexcept>
 
 namespace AL
 {
@@ -22,6 +27,94 @@ namespace AL
       const std::vector<AL::Math::Pose2D>&  pBoxA,
       const AL::Math::Pose2D&               pPointB);
 
+    // <summary> Rigid motion (rotation then translation) applied on the
+    //  fly to the vertices of a polygon, to avoid building the moved
+    //  polygon. </summary>
+    struct xMotion2D
+    {
+      float cosTheta, sinTheta, x, y;
+
+      xMotion2D() :
+        cosTheta(1.0f),
+        sinTheta(0.0f),
+        x(0.0f),
+        y(0.0f) {}
+
+      explicit xMotion2D(const AL::Math::Pose2D& pPose) :
+        cosTheta(cosf(pPose.theta)),
+        sinTheta(sinf(pPose.theta)),
+        x(pPose.x),
+        y(pPose.y) {}
+    };
+
+    // <summary> Access to the vertices of a polygon stored in a
+    //  vector<Pose2D> or a vector<Position2D>. The edge normals are
+    //  computed on the fly and are not normalized. </summary>
+    template <class T>
+    struct xVectorPolygon
+    {
+      const std::vector<T>& polygon;
+
+      explicit xVectorPolygon(const std::vector<T>& pPolygon) :
+        polygon(pPolygon) {}
+
+      unsigned int size() const { return polygon.size(); }
+      float x(const unsigned int i) const { return polygon[i].x; }
+      float y(const unsigned int i) const { return polygon[i].y; }
+      float normalX(const unsigned int i) const
+      {
+        return polygon[i].y - polygon[(i+1 == polygon.size()) ? 0 : i+1].y;
+      }
+      float normalY(const unsigned int i) const
+      {
+        return polygon[(i+1 == polygon.size()) ? 0 : i+1].x - polygon[i].x;
+      }
+    };
+    typedef xVectorPolygon<AL::Math::Pose2D> xPose2DPolygon;
+
+    // <summary> Access to the vertices of a FootPolygon, with its
+    //  precomputed edge normals. </summary>
+    template <unsigned int N>
+    struct xFootPolygonAccess
+    {
+      const AL::Math::FootPolygon<N>& polygon;
+
+      explicit xFootPolygonAccess(const AL::Math::FootPolygon<N>& pPolygon) :
+        polygon(pPolygon) {}
+
+      unsigned int size() const { return N; }
+      float x(const unsigned int i) const { return polygon.vertices[i].x; }
+      float y(const unsigned int i) const { return polygon.vertices[i].y; }
+      float normalX(const unsigned int i) const { return polygon.normals[i].x; }
+      float normalY(const unsigned int i) const { return polygon.normals[i].y; }
+    };
+
+    // <summary> Query if one of the edge normals of the polygon A is a
+    //  separating axis between the polygon A and the polygon B. </summary>
+    // <param name="pPolygonA"> the convex polygon A. </param>
+    // <param name="pMotionA">  motion applied to the polygon A. </param>
+    // <param name="pPolygonB"> the convex polygon B. </param>
+    // <param name="pMotionB">  motion applied to the polygon B. </param>
+    // <returns> true if a separating axis is found. </returns>
+    template <class PolygonA, class PolygonB>
+    const bool xHasSeparatingAxis(
+      const PolygonA&                       pPolygonA,
+      const xMotion2D&                      pMotionA,
+      const PolygonB&                       pPolygonB,
+      const xMotion2D&                      pMotionB);
+
+    // <summary> Query if the moving box, moved by pMove, is in collision
+    //  with the fixed box. </summary>
+    // <param name="pFixedBox">  the fixed box. </param>
+    // <param name="pMovingBox"> the moving box. </param>
+    // <param name="pMove">      the move of the moving box. </param>
+    // <returns> true if the boxes are in collision. </returns>
+    template <class PolygonA, class PolygonB>
+    const bool xIsMovedBoxInCollision(
+      const PolygonA&                       pFixedBox,
+      const PolygonB&                       pMovingBox,
+      const AL::Math::Pose2D&               pMove);
+
     // <summary> Query if the box A and the box B are in collision. </summary>
     // <param name="pBoxA"> vector<Pose2D> of the box A. </param>
     // <param name="pBoxB"> vector<Pose2D> of the box B. </param>
@@ -30,25 +123,244 @@ namespace AL
       const std::vector<AL::Math::Pose2D>&  pBoxA,
       const std::vector<AL::Math::Pose2D>&  pBoxB);
 
-    // <summary> Compute the box point due to a move. </summary>
+    // <summary> Compute the box point due to a move. The output box
+    //  keeps its capacity, so it is allocated once only. </summary>
     // <param name="pInitBox">  vector<Pose2D> of the fixed box. </param>
     // <param name="pMove">      Pose2D the initial move. </param>
-    // <returns> vector<Pose2D> the new box with pose2D transformation. </returns>
-    const std::vector<AL::Math::Pose2D> xComputeBox(
+    // <param name="pNewBox">    vector<Pose2D> the new box with pose2D transformation. </param>
+    void xComputeBox(
       const std::vector<AL::Math::Pose2D>&  pInitBox,
-      const AL::Math::Pose2D&               pMove);
+      const AL::Math::Pose2D&               pMove,
+      std::vector<AL::Math::Pose2D>&        pNewBox);
 
     // <summary> Compute the best orientation of the moving box without
     //  collsion with fixed box. </summary>
     // <param name="pFixesBox">  vector<Pose2D> of the fixed box. </param>
     // <param name="pMovingBox"> vector<Pose2D> of the moving box. </param>
     // <param name="pMove">       Pose2D the initial move. </param>
+    // <param name="pTmpBox">     vector<Pose2D> work buffer of the moved box. </param>
     // <returns> Pose2D, the best position. </returns>
     const void xDichotomie(
       const std::vector<AL::Math::Pose2D>&  pFixesBox,
       const std::vector<AL::Math::Pose2D>&  pMovingBox,
+      AL::Math::Pose2D&                     pMove,
+      std::vector<AL::Math::Pose2D>&        pTmpBox);
+
+    // <summary> Compute the angles of the rotations around the origin
+    //  which bring the vertex V on the segment [A, B]. </summary>
+    // <param name="pVx">     x of the vertex V. </param>
+    // <param name="pVy">     y of the vertex V. </param>
+    // <param name="pAx">     x of the first point of the segment. </param>
+    // <param name="pAy">     y of the first point of the segment. </param>
+    // <param name="pBx">     x of the second point of the segment. </param>
+    // <param name="pBy">     y of the second point of the segment. </param>
+    // <param name="pAngles"> the contact angles. </param>
+    // <returns> the number of contact angles: 0, 1 or 2. </returns>
+    unsigned int xVertexSegmentContactAngles(
+      const float& pVx,
+      const float& pVy,
+      const float& pAx,
+      const float& pAy,
+      const float& pBx,
+      const float& pBy,
+      float        pAngles[2]);
+
+    // <summary> Keep pAngle in pNext if it is the first angle after
+    //  pAfter. </summary>
+    // <param name="pAngle">  the candidate angle, of any sign. </param>
+    // <param name="pAfter">  the lower bound, in [0, 2pi[. </param>
+    // <param name="pStrict"> true if pAfter itself must be rejected. </param>
+    // <param name="pFound">  true if pNext is already set. </param>
+    // <param name="pNext">   the first angle after pAfter. </param>
+    void xKeepNextAngle(
+      float         pAngle,
+      const float&  pAfter,
+      const bool&   pStrict,
+      bool&         pFound,
+      float&        pNext);
+
+    // <summary> Compute the first contact angle between the fixed box and
+    //  the moving box rotating around (pMove.x, pMove.y), in the
+    //  direction of pMove.theta. </summary>
+    // <param name="pFixedBox">  the fixed box. </param>
+    // <param name="pMovingBox"> the moving box. </param>
+    // <param name="pMove">      the move of the moving box. </param>
+    // <param name="pAfter">     the returned angle is after this one. </param>
+    // <param name="pStrict">    true if pAfter itself must be rejected. </param>
+    // <param name="pNext">      the first contact angle, positive. </param>
+    // <returns> true if a contact angle is found. </returns>
+    template <class PolygonA, class PolygonB>
+    const bool xNextContactAngle(
+      const PolygonA&                       pFixedBox,
+      const PolygonB&                       pMovingBox,
+      const AL::Math::Pose2D&               pMove,
+      const float&                          pAfter,
+      const bool&                           pStrict,
+      float&                                pNext);
+
+    // <summary> Compute the largest orientation of the moving box, between
+    //  0 and pMove.theta, without collision with the fixed box. The
+    //  orientation is computed from the contact angles between the
+    //  vertices of a box and the edges of the other one, without any
+    //  allocation. </summary>
+    // <param name="pFixedBox">  the fixed box. </param>
+    // <param name="pMovingBox"> the moving box. </param>
+    // <param name="pMove">      Pose2D the initial move. </param>
+    template <class PolygonA, class PolygonB>
+    const void xMaximalRotation(
+      const PolygonA&                       pFixedBox,
+      const PolygonB&                       pMovingBox,
       AL::Math::Pose2D&                     pMove);
 
+    // <summary> Same as xDichotomie, but the collision tests move the
+    //  vertices on the fly instead of building the moved box. </summary>
+    // <param name="pFixedBox">  the fixed box. </param>
+    // <param name="pMovingBox"> the moving box. </param>
+    // <param name="pMove">      Pose2D the initial move. </param>
+    template <class PolygonA, class PolygonB>
+    const void xMovedBoxDichotomie(
+      const PolygonA&                       pFixedBox,
+      const PolygonB&                       pMovingBox,
+      AL::Math::Pose2D&                     pMove);
+
+    // <summary> Clip moves in place with a rotated and offset ellipse and
+    //  clamp their orientation. The clip is a radial scale from the center
+    //  of the ellipse, computed without trigonometry. </summary>
+    // <param name="pMaxFootX">     float of the half axis along x axis of the ellipse. </param>
+    // <param name="pMaxFootY">     float of the half axis along y axis of the ellipse. </param>
+    // <param name="pCenterX">      float of the x of the center of the ellipse. </param>
+    // <param name="pCenterY">      float of the y of the center of the ellipse. </param>
+    // <param name="pCosTheta">     float of the cosinus of the ellipse orientation. </param>
+    // <param name="pSinTheta">     float of the sinus of the ellipse orientation. </param>
+    // <param name="pMinFootTheta"> float of the min orientation of the moves. </param>
+    // <param name="pMaxFootTheta"> float of the max orientation of the moves. </param>
+    // <param name="pMoves">        the moves to clip. </param>
+    // <param name="pSize">         the number of moves. </param>
+    // <returns> the number of clamped moves. </returns>
+    unsigned int xClipWithEllipse(
+      const float&                          pMaxFootX,
+      const float&                          pMaxFootY,
+      const float&                          pCenterX,
+      const float&                          pCenterY,
+      const float&                          pCosTheta,
+      const float&                          pSinTheta,
+      const float&                          pMinFootTheta,
+      const float&                          pMaxFootTheta,
+      AL::Math::Pose2D*                     pMoves,
+      const unsigned int&                   pSize);
+
+    // <summary> Query if the moving box, moved by pMove, may be in
+    //  collision with the fixed box, by comparing the bounding box of the
+    //  fixed box with the bounding circle of the moving box. </summary>
+    // <param name="pFixedBox">    the fixed box. </param>
+    // <param name="pMovingRadius2"> the squared radius of the bounding circle
+    //   of the moving box, centered on its origin. </param>
+    // <param name="pMove">        the move of the moving box. </param>
+    // <returns> false if the boxes are surely not in collision. </returns>
+    template <unsigned int N>
+    const bool xIsCollisionPossible(
+      const AL::Math::FootPolygon<N>&       pFixedBox,
+      const float&                          pMovingRadius2,
+      const AL::Math::Pose2D&               pMove);
+
+    // <summary> Evaluate the footstep candidates from pBegin to pEnd, as
+    //  evaluateFootCandidates. The outputs are already resized. </summary>
+    template <unsigned int N>
+    void xEvaluateFootCandidates(
+      const AL::Math::FootPolygon<N>&       pSupportFoot,
+      const AL::Math::FootPolygon<N>&       pSwingFoot,
+      const float&                          pMaxFootX,
+      const float&                          pMaxFootY,
+      const std::vector<AL::Math::Pose2D>&  pCandidates,
+      std::vector<AL::Math::Pose2D>&        pMoves,
+      std::vector<bool>&                    pCollisions,
+      const AVOID_FOOT_COLLISION_MODE&      pMode,
+      const unsigned int&                   pBegin,
+      const unsigned int&                   pEnd);
+
+    // <summary> Deepest point of a polygon along the edge normal of
+    //  another one. </summary>
+    struct xAxisQuery
+    {
+      // signed distance along the normal, negative when penetrating
+      float separation;
+      unsigned int edge;
+      unsigned int vertex;
+      bool isValid;
+
+      xAxisQuery() :
+        separation(-FLT_MAX),
+        edge(0),
+        vertex(0),
+        isValid(false) {}
+    };
+
+    // <summary> Compute the outward unit normal of an edge of a convex
+    //  polygon. </summary>
+    // <param name="pPolygon">     the convex polygon. </param>
+    // <param name="pOrientation"> 1 for a counterclockwise polygon, -1 else. </param>
+    // <param name="pEdge">        the edge, from the vertex pEdge to the next one. </param>
+    // <param name="pNormal">      the outward unit normal. </param>
+    // <returns> false if the edge is degenerated. </returns>
+    template <class T>
+    const bool xOutwardNormal(
+      const std::vector<T>&                 pPolygon,
+      const float&                          pOrientation,
+      const unsigned int&                   pEdge,
+      AL::Math::Position2D&                 pNormal);
+
+    // <summary> Find the edge normal of the polygon A along which the
+    //  polygon B is the most separated from A. Stop on the first
+    //  separating axis. </summary>
+    // <param name="pPolygonA"> the convex polygon A. </param>
+    // <param name="pPolygonB"> the convex polygon B. </param>
+    // <param name="pQuery">    the best axis. </param>
+    // <returns> true if a separating axis is found. </returns>
+    template <class T>
+    const bool xMaxSeparation(
+      const std::vector<T>&                 pPolygonA,
+      const std::vector<T>&                 pPolygonB,
+      xAxisQuery&                           pQuery);
+
+    // <summary> Update the closest points with the distances between the
+    //  vertices of the polygon A and the edges of the polygon B. </summary>
+    // <param name="pPolygonA">     the convex polygon A. </param>
+    // <param name="pPolygonB">     the convex polygon B. </param>
+    // <param name="pDistance2">    the smallest squared distance. </param>
+    // <param name="pWitnessA">     the closest point of A. </param>
+    // <param name="pWitnessB">     the closest point of B. </param>
+    template <class T>
+    void xClosestVertexEdge(
+      const std::vector<T>&                 pPolygonA,
+      const std::vector<T>&                 pPolygonB,
+      float&                                pDistance2,
+      AL::Math::Position2D&                 pWitnessA,
+      AL::Math::Position2D&                 pWitnessB);
+
+    // <summary> Compute the signed distance between two convex polygons.
+    //  </summary>
+    // <param name="pPolygonA"> the convex polygon A. </param>
+    // <param name="pPolygonB"> the convex polygon B. </param>
+    // <param name="pWitnessA"> the witness point on A. </param>
+    // <param name="pWitnessB"> the witness point on B. </param>
+    // <returns> the signed distance. </returns>
+    template <class T>
+    float xSignedDistance(
+      const std::vector<T>&                 pPolygonA,
+      const std::vector<T>&                 pPolygonB,
+      AL::Math::Position2D&                 pWitnessA,
+      AL::Math::Position2D&                 pWitnessB);
+
+    // <summary> Policy whose chunks start on a multiple of 64: the bits of
+    //  a vector<bool> share words, which must not be written from two
+    //  threads. </summary>
+    // <param name="pPolicy"> the execution policy. </param>
+    // <param name="pSize">   the number of indices of the loop. </param>
+    // <returns> pPolicy with an aligned grain size. </returns>
+    ExecutionPolicy xBitAlignedPolicy(
+      const ExecutionPolicy& pPolicy,
+      const unsigned int&    pSize);
+
     const bool xPointsInsideBox(
       const std::vector<AL::Math::Pose2D>&  pBoxA,
       const AL::Math::Pose2D&               pPointB)
@@ -89,10 +401,111 @@ namespace AL
     } // end xPointsInsideBox()
 
 
+    template <class PolygonA, class PolygonB>
+    const bool xHasSeparatingAxis(
+      const PolygonA&                       pPolygonA,
+      const xMotion2D&                      pMotionA,
+      const PolygonB&                       pPolygonB,
+      const xMotion2D&                      pMotionB)
+    {
+      // project both polygons on the normal of each edge of A.
+      // If the two projected intervals do not overlap, the edge
+      // normal is a separating axis and the polygons are disjoint.
+      // Touching intervals are not counted as a collision, like in
+      // xPointsInsideBox.
+      // The projections are done in the frame of A, so only the
+      // vertices of B have to be moved.
+      unsigned int lengthA = pPolygonA.size();
+      unsigned int lengthB = pPolygonB.size();
+
+      // motion of B expressed in the frame of A
+      float dx = pMotionB.x - pMotionA.x;
+      float dy = pMotionB.y - pMotionA.y;
+      float c = pMotionA.cosTheta*pMotionB.cosTheta + pMotionA.sinTheta*pMotionB.sinTheta;
+      float s = pMotionA.cosTheta*pMotionB.sinTheta - pMotionA.sinTheta*pMotionB.cosTheta;
+      float tx = pMotionA.cosTheta*dx + pMotionA.sinTheta*dy;
+      float ty = pMotionA.cosTheta*dy - pMotionA.sinTheta*dx;
+
+      float Nx, Ny;
+      float Bx, By;
+      float proj;
+      float minA, maxA;
+      float minB = 0.0f;
+      float maxB = 0.0f;
+
+      for(unsigned int i=0; i<lengthA; i++)
+      {
+        // edge normal, no need to normalize it
+        Nx = pPolygonA.normalX(i);
+        Ny = pPolygonA.normalY(i);
+        if ((Nx == 0.0f) && (Ny == 0.0f))
+        {
+          // degenerated edge
+          continue;
+        }
+
+        minA = Nx*pPolygonA.x(0) + Ny*pPolygonA.y(0);
+        maxA = minA;
+        for(unsigned int j=1; j<lengthA; j++)
+        {
+          proj = Nx*pPolygonA.x(j) + Ny*pPolygonA.y(j);
+          if (proj < minA)
+            minA = proj;
+          else if (proj > maxA)
+            maxA = proj;
+        }
+
+        for(unsigned int j=0; j<lengthB; j++)
+        {
+          Bx = tx + c*pPolygonB.x(j) - s*pPolygonB.y(j);
+          By = ty + s*pPolygonB.x(j) + c*pPolygonB.y(j);
+          proj = Nx*Bx + Ny*By;
+          if (j == 0)
+          {
+            minB = proj;
+            maxB = proj;
+          }
+          else if (proj < minB)
+            minB = proj;
+          else if (proj > maxB)
+            maxB = proj;
+        }
+
+        if ((maxA <= minB) || (maxB <= minA))
+        {
+          return true;
+        }
+      }
+      return false;
+    } // end xHasSeparatingAxis()
+
+
+    template <class PolygonA, class PolygonB>
+    const bool xIsMovedBoxInCollision(
+      const PolygonA&                       pFixedBox,
+      const PolygonB&                       pMovingBox,
+      const AL::Math::Pose2D&               pMove)
+    {
+      if ((pFixedBox.size() == 0) || (pMovingBox.size() == 0))
+      {
+        return false;
+      }
+
+      const xMotion2D fixedMotion;
+      const xMotion2D movingMotion(pMove);
+      if (xHasSeparatingAxis(pFixedBox, fixedMotion, pMovingBox, movingMotion))
+      {
+        return false;
+      }
+      return !xHasSeparatingAxis(pMovingBox, movingMotion, pFixedBox, fixedMotion);
+    } // end xIsMovedBoxInCollision()
+
+
     const bool xIsTwoBoxesAreInCollision(
       const std::vector<AL::Math::Pose2D>&  pBoxA,
       const std::vector<AL::Math::Pose2D>&  pBoxB)
     {
+#ifdef ALMATH_LEGACY_FOOT_COLLISION
       bool test = false;
       // test if all points of box A is outside of box B
       for(unsigned i=0; i<pBoxA.size();i++)
@@ -109,26 +522,30 @@ namespace AL
           return test;
       }
       return test;
+#else
+      return areConvexPolygonsInCollision(pBoxA, pBoxB);
+#endif
     } // end xIsTwoBoxesAreInCollision()
 
 
-    const std::vector<AL::Math::Pose2D> xComputeBox(
+    void xComputeBox(
       const std::vector<AL::Math::Pose2D>&  pInitBox,
-      const AL::Math::Pose2D&               pMove)
+      const AL::Math::Pose2D&               pMove,
+      std::vector<AL::Math::Pose2D>&        pNewBox)
     {
-      std::vector<AL::Math::Pose2D> returnNewBox;
+      pNewBox.resize(pInitBox.size());
       for(unsigned int i=0; i < pInitBox.size();i++)
       {
-        returnNewBox.push_back(pMove * pInitBox[i]);
+        pNewBox[i] = pMove * pInitBox[i];
       }
-      return returnNewBox;
     } // end xComputeBox()
 
 
     const void xDichotomie(
       const std::vector<AL::Math::Pose2D>&  pFixesBox,
       const std::vector<AL::Math::Pose2D>&  pMovingBox,
-      AL::Math::Pose2D&                     pMove)
+      AL::Math::Pose2D&                     pMove,
+      std::vector<AL::Math::Pose2D>&        pTmpBox)
     {
       // the dichotomie number of iteration = precision
       unsigned int nbIteration = 5;
@@ -137,16 +554,14 @@ namespace AL
       float max = pMove.theta;
       float middle = 0.0f;
 
-      std::vector<AL::Math::Pose2D> tmpMovingBox;
-
       for(unsigned int i=0; i<nbIteration; i++)
       {
         middle = (min + max)/2.0f;
         pMove.theta = middle;
         // compute nex box position
-        tmpMovingBox = xComputeBox(pMovingBox, pMove);
+        xComputeBox(pMovingBox, pMove, pTmpBox);
         // test collision
-        if( xIsTwoBoxesAreInCollision(pFixesBox, tmpMovingBox) )
+        if( xIsTwoBoxesAreInCollision(pFixesBox, pTmpBox) )
           max = middle;
         else
           min = middle;
@@ -154,6 +569,510 @@ namespace AL
       pMove.theta = (min + max)/2.0f;
     } // end xDichotomie()
 
+    unsigned int xVertexSegmentContactAngles(
+      const float& pVx,
+      const float& pVy,
+      const float& pAx,
+      const float& pAy,
+      const float& pBx,
+      const float& pBy,
+      float        pAngles[2])
+    {
+      float Dx = pBx - pAx;
+      float Dy = pBy - pAy;
+      float D2 = Dx*Dx + Dy*Dy;
+      if (D2 == 0.0f)
+      {
+        return 0;
+      }
+
+      // N.R(angle).V = N.A with N the normal of the segment
+      // can be written as r*cos(angle - phi) = N.A
+      float A = Dx*pVy - Dy*pVx;
+      float B = Dy*pVy + Dx*pVx;
+      float C = Dx*pAy - Dy*pAx;
+      float r = sqrtf(A*A + B*B);
+      if ((r == 0.0f) || (fabsf(C) > r))
+      {
+        // the circle of the vertex never crosses the segment line
+        return 0;
+      }
+
+      float phi   = atan2f(B, A);
+      float delta = acosf(C/r);
+
+      unsigned int nbAngles = 0;
+      float angle, cosAngle, sinAngle;
+      float Px, Py, u;
+      for (unsigned int i=0; i<2; i++)
+      {
+        angle = (i == 0) ? phi + delta : phi - delta;
+        cosAngle = cosf(angle);
+        sinAngle = sinf(angle);
+        Px = cosAngle*pVx - sinAngle*pVy;
+        Py = sinAngle*pVx + cosAngle*pVy;
+
+        // keep only the contacts inside the segment
+        u = (Dx*(Px - pAx) + Dy*(Py - pAy))/D2;
+        if ((u >= -0.00001f) && (u <= 1.00001f))
+        {
+          pAngles[nbAngles] = angle;
+          nbAngles++;
+        }
+        if (delta == 0.0f)
+        {
+          break;
+        }
+      }
+      return nbAngles;
+    } // end xVertexSegmentContactAngles()
+
+
+    void xKeepNextAngle(
+      float         pAngle,
+      const float&  pAfter,
+      const bool&   pStrict,
+      bool&         pFound,
+      float&        pNext)
+    {
+      // wrap in [0, 2pi[
+      pAngle = fmodf(pAngle, 2.0f*PI);
+      if (pAngle < 0.0f)
+      {
+        pAngle += 2.0f*PI;
+      }
+      if (pAngle > 2.0f*PI - 0.00001f)
+      {
+        pAngle = 0.0f;
+      }
+
+      if ((pAngle < pAfter) || (pStrict && (pAngle == pAfter)))
+      {
+        return;
+      }
+      if (!pFound || (pAngle < pNext))
+      {
+        pNext  = pAngle;
+        pFound = true;
+      }
+    } // end xKeepNextAngle()
+
+
+    template <class PolygonA, class PolygonB>
+    const bool xNextContactAngle(
+      const PolygonA&                       pFixedBox,
+      const PolygonB&                       pMovingBox,
+      const AL::Math::Pose2D&               pMove,
+      const float&                          pAfter,
+      const bool&                           pStrict,
+      float&                                pNext)
+    {
+      const float sign = (pMove.theta < 0.0f) ? -1.0f : 1.0f;
+      const unsigned int lengthFixed  = pFixedBox.size();
+      const unsigned int lengthMoving = pMovingBox.size();
+      unsigned int iPlusOne = 0;
+      unsigned int nbAngles = 0;
+      float angles[2];
+      bool found = false;
+
+      // vertices of the moving box against edges of the fixed box,
+      // expressed relatively to the center of rotation
+      for(unsigned int i=0; i<lengthFixed; i++)
+      {
+        iPlusOne = (i+1 == lengthFixed) ? 0 : i+1;
+        for(unsigned int j=0; j<lengthMoving; j++)
+        {
+          nbAngles = xVertexSegmentContactAngles(
+                pMovingBox.x(j), pMovingBox.y(j),
+                pFixedBox.x(i) - pMove.x, pFixedBox.y(i) - pMove.y,
+                pFixedBox.x(iPlusOne) - pMove.x, pFixedBox.y(iPlusOne) - pMove.y,
+                angles);
+          for(unsigned int k=0; k<nbAngles; k++)
+          {
+            xKeepNextAngle(sign*angles[k], pAfter, pStrict, found, pNext);
+          }
+        }
+      }
+
+      // vertices of the fixed box against edges of the moving box:
+      // in the moving box frame, the fixed vertices rotate backward
+      for(unsigned int i=0; i<lengthMoving; i++)
+      {
+        iPlusOne = (i+1 == lengthMoving) ? 0 : i+1;
+        for(unsigned int j=0; j<lengthFixed; j++)
+        {
+          nbAngles = xVertexSegmentContactAngles(
+                pFixedBox.x(j) - pMove.x, pFixedBox.y(j) - pMove.y,
+                pMovingBox.x(i), pMovingBox.y(i),
+                pMovingBox.x(iPlusOne), pMovingBox.y(iPlusOne),
+                angles);
+          for(unsigned int k=0; k<nbAngles; k++)
+          {
+            xKeepNextAngle(-sign*angles[k], pAfter, pStrict, found, pNext);
+          }
+        }
+      }
+      return found;
+    } // end xNextContactAngle()
+
+
+    template <class PolygonA, class PolygonB>
+    const void xMaximalRotation(
+      const PolygonA&                       pFixedBox,
+      const PolygonB&                       pMovingBox,
+      AL::Math::Pose2D&                     pMove)
+    {
+      const float sign   = (pMove.theta < 0.0f) ? -1.0f : 1.0f;
+      const float target = fabsf(pMove.theta);
+
+      AL::Math::Pose2D tmpMove = pMove;
+      tmpMove.theta = 0.0f;
+      if (xIsMovedBoxInCollision(pFixedBox, pMovingBox, tmpMove))
+      {
+        // no rotation can be collision free
+        pMove.theta = 0.0f;
+        return;
+      }
+
+      // The collision state can only change at a contact angle. So for
+      // each contact angle, test the collision just after it (between it
+      // and the next contact angle).
+      float current = 0.0f;
+      bool  strict  = false;
+      float contact = 0.0f;
+      float nextContact = 0.0f;
+      float upper = 0.0f;
+      while (xNextContactAngle(pFixedBox, pMovingBox, pMove, current, strict, contact) &&
+             (contact < target))
+      {
+        upper = target;
+        if (xNextContactAngle(pFixedBox, pMovingBox, pMove, contact, true, nextContact) &&
+            (nextContact < target))
+        {
+          upper = nextContact;
+        }
+
+        tmpMove.theta = sign*0.5f*(contact + upper);
+        if (xIsMovedBoxInCollision(pFixedBox, pMovingBox, tmpMove))
+        {
+          pMove.theta = sign*contact;
+          return;
+        }
+        current = contact;
+        strict  = true;
+      }
+
+      // no collision found before the target: only numerical precision
+      // can lead here, so be conservative.
+      if (xIsMovedBoxInCollision(pFixedBox, pMovingBox, pMove))
+      {
+        pMove.theta = sign*current;
+      }
+    } // end xMaximalRotation()
+
+    template <class PolygonA, class PolygonB>
+    const void xMovedBoxDichotomie(
+      const PolygonA&                       pFixedBox,
+      const PolygonB&                       pMovingBox,
+      AL::Math::Pose2D&                     pMove)
+    {
+      // the dichotomie number of iteration = precision
+      unsigned int nbIteration = 5;
+
+      float min = 0.0f;
+      float max = pMove.theta;
+      float middle = 0.0f;
+
+      for(unsigned int i=0; i<nbIteration; i++)
+      {
+        middle = (min + max)/2.0f;
+        pMove.theta = middle;
+        // test collision
+        if( xIsMovedBoxInCollision(pFixedBox, pMovingBox, pMove) )
+          max = middle;
+        else
+          min = middle;
+      }
+      pMove.theta = (min + max)/2.0f;
+    } // end xMovedBoxDichotomie()
+
+    unsigned int xClipWithEllipse(
+      const float&                          pMaxFootX,
+      const float&                          pMaxFootY,
+      const float&                          pCenterX,
+      const float&                          pCenterY,
+      const float&                          pCosTheta,
+      const float&                          pSinTheta,
+      const float&                          pMinFootTheta,
+      const float&                          pMaxFootTheta,
+      AL::Math::Pose2D*                     pMoves,
+      const unsigned int&                   pSize)
+    {
+      // the point on the ellipse in the direction of (u, v), in the ellipse
+      // frame, is (u, v)/sqrt(u*u/(a*a) + v*v/(b*b))
+      const float invA2 = 1.0f/(pMaxFootX*pMaxFootX);
+      const float invB2 = 1.0f/(pMaxFootY*pMaxFootY);
+
+      unsigned int nbClamped = 0;
+      float dx, dy, u, v, norm, scale, theta;
+      bool isClamped;
+      for(unsigned int i=0; i<pSize; i++)
+      {
+        dx = pMoves[i].x - pCenterX;
+        dy = pMoves[i].y - pCenterY;
+        u =  pCosTheta*dx + pSinTheta*dy;
+        v = -pSinTheta*dx + pCosTheta*dy;
+        norm = u*u*invA2 + v*v*invB2;
+        // same threshold as the original polar clip
+        isClamped = (norm >= 1.00001f);
+        scale = isClamped ? 1.0f/sqrtf(norm) : 1.0f;
+        // a radial scale is the same in the ellipse frame and in the
+        // frame of the moves
+        pMoves[i].x = pCenterX + dx*scale;
+        pMoves[i].y = pCenterY + dy*scale;
+
+        theta = pMoves[i].theta;
+        if (theta < pMinFootTheta)
+        {
+          theta = pMinFootTheta;
+          isClamped = true;
+        }
+        else if (theta > pMaxFootTheta)
+        {
+          theta = pMaxFootTheta;
+          isClamped = true;
+        }
+        pMoves[i].theta = theta;
+        nbClamped += isClamped ? 1 : 0;
+      }
+      return nbClamped;
+    } // end xClipWithEllipse()
+
+
+    template <unsigned int N>
+    const bool xIsCollisionPossible(
+      const AL::Math::FootPolygon<N>&       pFixedBox,
+      const float&                          pMovingRadius2,
+      const AL::Math::Pose2D&               pMove)
+    {
+      float dx = 0.0f;
+      float dy = 0.0f;
+      if (pMove.x < pFixedBox.boxMin.x)
+        dx = pFixedBox.boxMin.x - pMove.x;
+      else if (pMove.x > pFixedBox.boxMax.x)
+        dx = pMove.x - pFixedBox.boxMax.x;
+      if (pMove.y < pFixedBox.boxMin.y)
+        dy = pFixedBox.boxMin.y - pMove.y;
+      else if (pMove.y > pFixedBox.boxMax.y)
+        dy = pMove.y - pFixedBox.boxMax.y;
+      return (dx*dx + dy*dy < pMovingRadius2);
+    } // end xIsCollisionPossible()
+
+    template <class T>
+    const bool xOutwardNormal(
+      const std::vector<T>&                 pPolygon,
+      const float&                          pOrientation,
+      const unsigned int&                   pEdge,
+      AL::Math::Position2D&                 pNormal)
+    {
+      const T& start = pPolygon[pEdge];
+      const T& end = pPolygon[(pEdge+1 == pPolygon.size()) ? 0 : pEdge+1];
+      const float dx = end.x - start.x;
+      const float dy = end.y - start.y;
+      const float norm = sqrtf(dx*dx + dy*dy);
+      if (norm <= 0.0f)
+      {
+        return false;
+      }
+      pNormal.x =  pOrientation*dy/norm;
+      pNormal.y = -pOrientation*dx/norm;
+      return true;
+    } // end xOutwardNormal()
+
+
+    template <class T>
+    const bool xMaxSeparation(
+      const std::vector<T>&                 pPolygonA,
+      const std::vector<T>&                 pPolygonB,
+      xAxisQuery&                           pQuery)
+    {
+      // the sign of the area gives the orientation of the polygon
+      const unsigned int sizeA = pPolygonA.size();
+      float area = 0.0f;
+      for (unsigned int i=0; i<sizeA; i++)
+      {
+        const T& next = pPolygonA[(i+1 == sizeA) ? 0 : i+1];
+        area += pPolygonA[i].x*next.y - next.x*pPolygonA[i].y;
+      }
+      const float orientation = (area > 0.0f) ? 1.0f : -1.0f;
+
+      AL::Math::Position2D normal;
+      for (unsigned int i=0; i<sizeA; i++)
+      {
+        if (!xOutwardNormal(pPolygonA, orientation, i, normal))
+        {
+          continue;
+        }
+
+        // the deepest vertex of B along the normal
+        float separation = FLT_MAX;
+        unsigned int vertex = 0;
+        for (unsigned int j=0; j<pPolygonB.size(); j++)
+        {
+          const float d = normal.x*(pPolygonB[j].x - pPolygonA[i].x) +
+              normal.y*(pPolygonB[j].y - pPolygonA[i].y);
+          if (d < separation)
+          {
+            separation = d;
+            vertex = j;
+          }
+        }
+
+        if (!pQuery.isValid || (separation > pQuery.separation))
+        {
+          pQuery.separation = separation;
+          pQuery.edge = i;
+          pQuery.vertex = vertex;
+          pQuery.isValid = true;
+        }
+        if (separation >= 0.0f)
+        {
+          return true;
+        }
+      }
+      return false;
+    } // end xMaxSeparation()
+
+
+    template <class T>
+    void xClosestVertexEdge(
+      const std::vector<T>&                 pPolygonA,
+      const std::vector<T>&                 pPolygonB,
+      float&                                pDistance2,
+      AL::Math::Position2D&                 pWitnessA,
+      AL::Math::Position2D&                 pWitnessB)
+    {
+      const unsigned int sizeB = pPolygonB.size();
+      for (unsigned int j=0; j<sizeB; j++)
+      {
+        const T& start = pPolygonB[j];
+        const T& end = pPolygonB[(j+1 == sizeB) ? 0 : j+1];
+        const float dx = end.x - start.x;
+        const float dy = end.y - start.y;
+        const float length2 = dx*dx + dy*dy;
+
+        for (unsigned int i=0; i<pPolygonA.size(); i++)
+        {
+          // closest point of the segment to the vertex
+          float t = 0.0f;
+          if (length2 > 0.0f)
+          {
+            t = ((pPolygonA[i].x - start.x)*dx +
+                 (pPolygonA[i].y - start.y)*dy)/length2;
+            t = std::min(1.0f, std::max(0.0f, t));
+          }
+          const float x = start.x + t*dx;
+          const float y = start.y + t*dy;
+          const float distance2 =
+              (pPolygonA[i].x - x)*(pPolygonA[i].x - x) +
+              (pPolygonA[i].y - y)*(pPolygonA[i].y - y);
+          if (distance2 < pDistance2)
+          {
+            pDistance2 = distance2;
+            pWitnessA = AL::Math::Position2D(pPolygonA[i].x, pPolygonA[i].y);
+            pWitnessB = AL::Math::Position2D(x, y);
+          }
+        }
+      }
+    } // end xClosestVertexEdge()
+
+
+    template <class T>
+    float xSignedDistance(
+      const std::vector<T>&                 pPolygonA,
+      const std::vector<T>&                 pPolygonB,
+      AL::Math::Position2D&                 pWitnessA,
+      AL::Math::Position2D&                 pWitnessB)
+    {
+      if (pPolygonA.empty() || pPolygonB.empty())
+      {
+        throw std::invalid_argument(
+            "ALMath: signedDistanceBetweenConvexPolygons "
+            "Input polygons must not be empty.");
+      }
+
+      xAxisQuery queryA;
+      xAxisQuery queryB;
+      const bool isSeparated =
+          xMaxSeparation(pPolygonA, pPolygonB, queryA) ||
+          xMaxSeparation(pPolygonB, pPolygonA, queryB) ||
+          (!queryA.isValid && !queryB.isValid);
+
+      if (isSeparated)
+      {
+        // the closest points of two disjoint convex polygons are a vertex
+        // of one of them and a point of an edge of the other one
+        float distance2 = FLT_MAX;
+        xClosestVertexEdge(pPolygonA, pPolygonB, distance2, pWitnessA, pWitnessB);
+        AL::Math::Position2D witnessB;
+        AL::Math::Position2D witnessA;
+        float distance2B = distance2;
+        xClosestVertexEdge(pPolygonB, pPolygonA, distance2B, witnessB, witnessA);
+        if (distance2B < distance2)
+        {
+          distance2 = distance2B;
+          pWitnessA = witnessA;
+          pWitnessB = witnessB;
+        }
+        return sqrtf(distance2);
+      }
+
+      // penetration: the axis of the least penetration gives the depth,
+      // the deepest vertex is one witness point, its projection on the
+      // edge of the other polygon is the other one
+      const bool isEdgeOfA = (!queryB.isValid) ||
+          (queryA.isValid && (queryA.separation >= queryB.separation));
+      const std::vector<T>& edgePolygon = isEdgeOfA ? pPolygonA : pPolygonB;
+      const std::vector<T>& vertexPolygon = isEdgeOfA ? pPolygonB : pPolygonA;
+      const xAxisQuery& query = isEdgeOfA ? queryA : queryB;
+
+      float area = 0.0f;
+      for (unsigned int i=0; i<edgePolygon.size(); i++)
+      {
+        const T& next = edgePolygon[(i+1 == edgePolygon.size()) ? 0 : i+1];
+        area += edgePolygon[i].x*next.y - next.x*edgePolygon[i].y;
+      }
+      AL::Math::Position2D normal;
+      xOutwardNormal(edgePolygon, (area > 0.0f) ? 1.0f : -1.0f,
+                     query.edge, normal);
+
+      const AL::Math::Position2D vertex(vertexPolygon[query.vertex].x,
+                                        vertexPolygon[query.vertex].y);
+      const AL::Math::Position2D projection(
+        vertex.x - query.separation*normal.x,
+        vertex.y - query.separation*normal.y);
+      pWitnessA = isEdgeOfA ? projection : vertex;
+      pWitnessB = isEdgeOfA ? vertex : projection;
+      return query.separation;
+    } // end xSignedDistance()
+
+
+    ExecutionPolicy xBitAlignedPolicy(
+      const ExecutionPolicy& pPolicy,
+      const unsigned int&    pSize)
+    {
+      unsigned int grainSize = pPolicy.grainSize;
+      if ((grainSize == 0) && (pPolicy.pool != 0))
+      {
+        const unsigned int nbChunks = 4*pPolicy.pool->getNbThreads();
+        grainSize = (pSize + nbChunks - 1)/nbChunks;
+      }
+      ExecutionPolicy returnPolicy(pPolicy);
+      returnPolicy.grainSize = ((grainSize + 63)/64)*64;
+      return returnPolicy;
+    } // end xBitAlignedPolicy()
+
+
     /****************************
     PUBLIC FUNCTION
     ****************************/
@@ -161,71 +1080,530 @@ namespace AL
       const std::vector<AL::Math::Pose2D>&  pLFootBoundingBox,
       const std::vector<AL::Math::Pose2D>&  pRFootBoundingBox,
       const bool&                           pIsLeftSupport,
-      AL::Math::Pose2D&                     pMove)
+      AL::Math::Pose2D&                     pMove,
+      const AVOID_FOOT_COLLISION_MODE&      pMode)
     {
+      const std::vector<AL::Math::Pose2D>& fixedBox =
+          pIsLeftSupport ? pLFootBoundingBox : pRFootBoundingBox;
+      const std::vector<AL::Math::Pose2D>& movingBox =
+          pIsLeftSupport ? pRFootBoundingBox : pLFootBoundingBox;
+
+      if (pMode == AVOID_FOOT_COLLISION_EXACT)
+      {
+        // test collision without building the new box
+        const xPose2DPolygon fixedPolygon(fixedBox);
+        const xPose2DPolygon movingPolygon(movingBox);
+        if (xIsMovedBoxInCollision(fixedPolygon, movingPolygon, pMove))
+        {
+          xMaximalRotation(fixedPolygon, movingPolygon, pMove);
+          return true;
+        }
+        return false;
+      }
+
       bool returnCollisionResult = false;
       std::vector<AL::Math::Pose2D> tmpMovingBox;
-      if (pIsLeftSupport)
+      // compute nex box position
+      xComputeBox(movingBox, pMove, tmpMovingBox);
+      // test collision
+      if (xIsTwoBoxesAreInCollision(fixedBox, tmpMovingBox))
       {
-        // compute nex box position
-        tmpMovingBox = xComputeBox(pRFootBoundingBox, pMove);
-        // test collision
-        if (xIsTwoBoxesAreInCollision(pLFootBoundingBox, tmpMovingBox))
+        returnCollisionResult = true;
+        xDichotomie(fixedBox, movingBox, pMove, tmpMovingBox);
+      }
+      return returnCollisionResult;
+    } // end avoidFootCollision()
+
+
+    const bool areConvexPolygonsInCollision(
+      const std::vector<AL::Math::Pose2D>&  pPolygonA,
+      const std::vector<AL::Math::Pose2D>&  pPolygonB)
+    {
+      if (pPolygonA.empty() || pPolygonB.empty())
+      {
+        return false;
+      }
+
+      const xPose2DPolygon polygonA(pPolygonA);
+      const xPose2DPolygon polygonB(pPolygonB);
+      const xMotion2D identity;
+      if (xHasSeparatingAxis(polygonA, identity, polygonB, identity))
+      {
+        return false;
+      }
+      return !xHasSeparatingAxis(polygonB, identity, polygonA, identity);
+    } // end areConvexPolygonsInCollision()
+
+
+    const bool areConvexPolygonsInCollision(
+      const std::vector<AL::Math::Position2D>&  pPolygonA,
+      const std::vector<AL::Math::Position2D>&  pPolygonB)
+    {
+      if (pPolygonA.empty() || pPolygonB.empty())
+      {
+        return false;
+      }
+
+      const xVectorPolygon<AL::Math::Position2D> polygonA(pPolygonA);
+      const xVectorPolygon<AL::Math::Position2D> polygonB(pPolygonB);
+      const xMotion2D identity;
+      if (xHasSeparatingAxis(polygonA, identity, polygonB, identity))
+      {
+        return false;
+      }
+      return !xHasSeparatingAxis(polygonB, identity, polygonA, identity);
+    } // end areConvexPolygonsInCollision()
+
+
+    void areConvexPolygonsInCollision(
+      const std::vector<AL::Math::Pose2D>&                pPolygonA,
+      const std::vector<std::vector<AL::Math::Pose2D> >&  pPolygonsB,
+      std::vector<bool>&                                  pCollisions)
+    {
+      pCollisions.resize(pPolygonsB.size());
+      for(unsigned int i=0; i<pPolygonsB.size(); i++)
+      {
+        pCollisions[i] = areConvexPolygonsInCollision(pPolygonA, pPolygonsB[i]);
+      }
+    } // end areConvexPolygonsInCollision()
+
+
+    void areConvexPolygonsInCollision(
+      const std::vector<AL::Math::Pose2D>&                pPolygonA,
+      const std::vector<std::vector<AL::Math::Pose2D> >&  pPolygonsB,
+      std::vector<bool>&                                  pCollisions,
+      const ExecutionPolicy&                              pPolicy)
+    {
+      const unsigned int nbPolygons = pPolygonsB.size();
+      pCollisions.resize(nbPolygons);
+      parallelFor(xBitAlignedPolicy(pPolicy, nbPolygons), 0, nbPolygons,
+                  [&](const unsigned int& pBegin, const unsigned int& pEnd)
+      {
+        for(unsigned int i=pBegin; i<pEnd; i++)
         {
-          returnCollisionResult = true;
-          xDichotomie(pLFootBoundingBox, pRFootBoundingBox, pMove);
+          pCollisions[i] = areConvexPolygonsInCollision(pPolygonA, pPolygonsB[i]);
         }
+      });
+    } // end areConvexPolygonsInCollision()
+
+
+    const float signedDistanceBetweenConvexPolygons(
+      const std::vector<AL::Math::Pose2D>&  pPolygonA,
+      const std::vector<AL::Math::Pose2D>&  pPolygonB,
+      AL::Math::Position2D&                 pWitnessA,
+      AL::Math::Position2D&                 pWitnessB)
+    {
+      return xSignedDistance(pPolygonA, pPolygonB, pWitnessA, pWitnessB);
+    } // end signedDistanceBetweenConvexPolygons()
+
+
+    const float signedDistanceBetweenConvexPolygons(
+      const std::vector<AL::Math::Position2D>&  pPolygonA,
+      const std::vector<AL::Math::Position2D>&  pPolygonB,
+      AL::Math::Position2D&                     pWitnessA,
+      AL::Math::Position2D&                     pWitnessB)
+    {
+      return xSignedDistance(pPolygonA, pPolygonB, pWitnessA, pWitnessB);
+    } // end signedDistanceBetweenConvexPolygons()
+
+
+    void signedDistanceBetweenConvexPolygons(
+      const std::vector<AL::Math::Pose2D>&                pPolygonA,
+      const std::vector<std::vector<AL::Math::Pose2D> >&  pPolygonsB,
+      std::vector<float>&                                 pDistances)
+    {
+      AL::Math::Position2D witnessA;
+      AL::Math::Position2D witnessB;
+      pDistances.resize(pPolygonsB.size());
+      for(unsigned int i=0; i<pPolygonsB.size(); i++)
+      {
+        pDistances[i] = xSignedDistance(pPolygonA, pPolygonsB[i],
+                                        witnessA, witnessB);
       }
-      else
+    } // end signedDistanceBetweenConvexPolygons()
+
+
+    void signedDistanceBetweenConvexPolygons(
+      const std::vector<AL::Math::Pose2D>&                pPolygonA,
+      const std::vector<std::vector<AL::Math::Pose2D> >&  pPolygonsB,
+      std::vector<float>&                                 pDistances,
+      const ExecutionPolicy&                              pPolicy)
+    {
+      const unsigned int nbPolygons = pPolygonsB.size();
+      pDistances.resize(nbPolygons);
+      parallelFor(pPolicy, 0, nbPolygons,
+                  [&](const unsigned int& pBegin, const unsigned int& pEnd)
       {
-        // compute nex box position
-        tmpMovingBox = xComputeBox(pLFootBoundingBox, pMove);
-        // test collision
-        if (xIsTwoBoxesAreInCollision(pRFootBoundingBox, tmpMovingBox))
+        AL::Math::Position2D witnessA;
+        AL::Math::Position2D witnessB;
+        for(unsigned int i=pBegin; i<pEnd; i++)
         {
-          returnCollisionResult = true;
-          xDichotomie(pRFootBoundingBox, pLFootBoundingBox, pMove);
+          pDistances[i] = xSignedDistance(pPolygonA, pPolygonsB[i],
+                                          witnessA, witnessB);
         }
+      });
+    } // end signedDistanceBetweenConvexPolygons()
+
+
+    const bool computeTimeOfContact(
+      const std::vector<AL::Math::Pose2D>&  pFixedPolygon,
+      const std::vector<AL::Math::Pose2D>&  pMovingPolygon,
+      const AL::Math::Pose2D&               pStartMove,
+      const AL::Math::Pose2D&               pEndMove,
+      float&                                pTimeOfContact,
+      const float&                          pTolerance)
+    {
+      // bound of the speed of the points of the moving polygon: the
+      // translation plus the rotation around its origin
+      float radius2 = 0.0f;
+      for (unsigned int i=0; i<pMovingPolygon.size(); i++)
+      {
+        radius2 = std::max(radius2,
+                           pMovingPolygon[i].x*pMovingPolygon[i].x +
+                           pMovingPolygon[i].y*pMovingPolygon[i].y);
       }
-      return returnCollisionResult;
+      const AL::Math::Pose2D delta = pEndMove - pStartMove;
+      const float maxSpeed = sqrtf(delta.x*delta.x + delta.y*delta.y) +
+          fabsf(delta.theta)*sqrtf(radius2);
+
+      AL::Math::Position2D witnessA;
+      AL::Math::Position2D witnessB;
+      std::vector<AL::Math::Pose2D> movedPolygon(pMovingPolygon.size());
+      float time = 0.0f;
+      for (unsigned int iteration=0; iteration<100; iteration++)
+      {
+        const AL::Math::Pose2D move = pStartMove + delta*time;
+        for (unsigned int i=0; i<pMovingPolygon.size(); i++)
+        {
+          movedPolygon[i] = move*pMovingPolygon[i];
+        }
+
+        const float distance = xSignedDistance(pFixedPolygon, movedPolygon,
+                                               witnessA, witnessB);
+        if (distance <= pTolerance)
+        {
+          pTimeOfContact = time;
+          return true;
+        }
+
+        // no point can travel the distance before this time
+        time = (maxSpeed > 0.0f) ? time + distance/maxSpeed : 2.0f;
+        if (time > 1.0f)
+        {
+          pTimeOfContact = 1.0f;
+          return false;
+        }
+      }
+
+      // still grazing the fixed polygon after all the iterations:
+      // report the contact to stay on the safe side
+      pTimeOfContact = time;
+      return true;
+    } // end computeTimeOfContact()
+
+
+    const bool sweptFootCollision(
+      const std::vector<AL::Math::Pose2D>&  pLFootBoundingBox,
+      const std::vector<AL::Math::Pose2D>&  pRFootBoundingBox,
+      const bool&                           pIsLeftSupport,
+      const AL::Math::Pose2D&               pStartMove,
+      const AL::Math::Pose2D&               pMove,
+      float&                                pTimeOfContact)
+    {
+      return computeTimeOfContact(
+        pIsLeftSupport ? pLFootBoundingBox : pRFootBoundingBox,
+        pIsLeftSupport ? pRFootBoundingBox : pLFootBoundingBox,
+        pStartMove, pMove, pTimeOfContact);
+    } // end sweptFootCollision()
+
+
+    template <unsigned int N>
+    const bool avoidFootCollision(
+      const AL::Math::FootPolygon<N>&       pLFootBoundingBox,
+      const AL::Math::FootPolygon<N>&       pRFootBoundingBox,
+      const bool&                           pIsLeftSupport,
+      AL::Math::Pose2D&                     pMove,
+      const AVOID_FOOT_COLLISION_MODE&      pMode)
+    {
+      const xFootPolygonAccess<N> fixedPolygon(
+            pIsLeftSupport ? pLFootBoundingBox : pRFootBoundingBox);
+      const xFootPolygonAccess<N> movingPolygon(
+            pIsLeftSupport ? pRFootBoundingBox : pLFootBoundingBox);
+
+      if (!xIsMovedBoxInCollision(fixedPolygon, movingPolygon, pMove))
+      {
+        return false;
+      }
+
+      if (pMode == AVOID_FOOT_COLLISION_EXACT)
+      {
+        xMaximalRotation(fixedPolygon, movingPolygon, pMove);
+      }
+      else
+      {
+        xMovedBoxDichotomie(fixedPolygon, movingPolygon, pMove);
+      }
+      return true;
     } // end avoidFootCollision()
 
 
+    template <unsigned int N>
+    const bool areConvexPolygonsInCollision(
+      const AL::Math::FootPolygon<N>&       pPolygonA,
+      const AL::Math::FootPolygon<N>&       pPolygonB)
+    {
+      if (!pPolygonA.isBoundingBoxOverlapping(pPolygonB))
+      {
+        return false;
+      }
+
+      const xFootPolygonAccess<N> polygonA(pPolygonA);
+      const xFootPolygonAccess<N> polygonB(pPolygonB);
+      const xMotion2D identity;
+      if (xHasSeparatingAxis(polygonA, identity, polygonB, identity))
+      {
+        return false;
+      }
+      return !xHasSeparatingAxis(polygonB, identity, polygonA, identity);
+    } // end areConvexPolygonsInCollision()
+
+
+    template <unsigned int N>
+    void xEvaluateFootCandidates(
+      const AL::Math::FootPolygon<N>&       pSupportFoot,
+      const AL::Math::FootPolygon<N>&       pSwingFoot,
+      const float&                          pMaxFootX,
+      const float&                          pMaxFootY,
+      const std::vector<AL::Math::Pose2D>&  pCandidates,
+      std::vector<AL::Math::Pose2D>&        pMoves,
+      std::vector<bool>&                    pCollisions,
+      const AVOID_FOOT_COLLISION_MODE&      pMode,
+      const unsigned int&                   pBegin,
+      const unsigned int&                   pEnd)
+    {
+      if (pEnd <= pBegin)
+      {
+        return;
+      }
+
+      // first clip all the candidates at once
+      std::copy(pCandidates.begin() + pBegin, pCandidates.begin() + pEnd,
+                pMoves.begin() + pBegin);
+      clipFootWithEllipse(pMaxFootX, pMaxFootY, &pMoves[pBegin], pEnd - pBegin);
+
+      // the swing foot rotates around its origin, so it always stays
+      // inside this circle
+      float radius2 = 0.0f;
+      for(unsigned int i=0; i<N; i++)
+      {
+        const float r2 = pSwingFoot.vertices[i].x*pSwingFoot.vertices[i].x +
+            pSwingFoot.vertices[i].y*pSwingFoot.vertices[i].y;
+        if (r2 > radius2)
+        {
+          radius2 = r2;
+        }
+      }
+
+      const xFootPolygonAccess<N> supportPolygon(pSupportFoot);
+      const xFootPolygonAccess<N> swingPolygon(pSwingFoot);
+      for(unsigned int i=pBegin; i<pEnd; i++)
+      {
+        if (!xIsCollisionPossible(pSupportFoot, radius2, pMoves[i]) ||
+            !xIsMovedBoxInCollision(supportPolygon, swingPolygon, pMoves[i]))
+        {
+          pCollisions[i] = false;
+          continue;
+        }
+
+        pCollisions[i] = true;
+        if (pMode == AVOID_FOOT_COLLISION_EXACT)
+        {
+          xMaximalRotation(supportPolygon, swingPolygon, pMoves[i]);
+        }
+        else
+        {
+          xMovedBoxDichotomie(supportPolygon, swingPolygon, pMoves[i]);
+        }
+      }
+    } // end xEvaluateFootCandidates()
+
+
+    template <unsigned int N>
+    void evaluateFootCandidates(
+      const AL::Math::FootPolygon<N>&       pSupportFoot,
+      const AL::Math::FootPolygon<N>&       pSwingFoot,
+      const float&                          pMaxFootX,
+      const float&                          pMaxFootY,
+      const std::vector<AL::Math::Pose2D>&  pCandidates,
+      std::vector<AL::Math::Pose2D>&        pMoves,
+      std::vector<bool>&                    pCollisions,
+      const AVOID_FOOT_COLLISION_MODE&      pMode)
+    {
+      const unsigned int nbCandidates = pCandidates.size();
+      pMoves.resize(nbCandidates);
+      pCollisions.resize(nbCandidates);
+      xEvaluateFootCandidates(pSupportFoot, pSwingFoot, pMaxFootX, pMaxFootY,
+                              pCandidates, pMoves, pCollisions, pMode,
+                              0, nbCandidates);
+    } // end evaluateFootCandidates()
+
+
+    template <unsigned int N>
+    void evaluateFootCandidates(
+      const AL::Math::FootPolygon<N>&       pSupportFoot,
+      const AL::Math::FootPolygon<N>&       pSwingFoot,
+      const float&                          pMaxFootX,
+      const float&                          pMaxFootY,
+      const std::vector<AL::Math::Pose2D>&  pCandidates,
+      std::vector<AL::Math::Pose2D>&        pMoves,
+      std::vector<bool>&                    pCollisions,
+      const AVOID_FOOT_COLLISION_MODE&      pMode,
+      const ExecutionPolicy&                pPolicy)
+    {
+      const unsigned int nbCandidates = pCandidates.size();
+      pMoves.resize(nbCandidates);
+      pCollisions.resize(nbCandidates);
+
+      parallelFor(xBitAlignedPolicy(pPolicy, nbCandidates), 0, nbCandidates,
+                  [&](const unsigned int& pBegin, const unsigned int& pEnd)
+      {
+        xEvaluateFootCandidates(pSupportFoot, pSwingFoot, pMaxFootX, pMaxFootY,
+                                pCandidates, pMoves, pCollisions, pMode,
+                                pBegin, pEnd);
+      });
+    } // end evaluateFootCandidates()
+
+
+    // The FootPolygon functions are compiled for the usual sizes only.
+#define ALMATH_INSTANTIATE_FOOT_POLYGON(N)                  \
+    template const bool avoidFootCollision<N>(              \
+      const AL::Math::FootPolygon<N>&,                      \
+      const AL::Math::FootPolygon<N>&,                      \
+      const bool&,                                          \
+      AL::Math::Pose2D&,                                    \
+      const AVOID_FOOT_COLLISION_MODE&);                    \
+    template const bool areConvexPolygonsInCollision<N>(    \
+      const AL::Math::FootPolygon<N>&,                      \
+      const AL::Math::FootPolygon<N>&);                     \
+    template void evaluateFootCandidates<N>(                \
+      const AL::Math::FootPolygon<N>&,                      \
+      const AL::Math::FootPolygon<N>&,                      \
+      const float&,                                         \
+      const float&,                                         \
+      const std::vector<AL::Math::Pose2D>&,                 \
+      std::vector<AL::Math::Pose2D>&,                       \
+      std::vector<bool>&,                                   \
+      const AVOID_FOOT_COLLISION_MODE&);                    \
+    template void evaluateFootCandidates<N>(                \
+      const AL::Math::FootPolygon<N>&,                      \
+      const AL::Math::FootPolygon<N>&,                      \
+      const float&,                                         \
+      const float&,                                         \
+      const std::vector<AL::Math::Pose2D>&,                 \
+      std::vector<AL::Math::Pose2D>&,                       \
+      std::vector<bool>&,                                   \
+      const AVOID_FOOT_COLLISION_MODE&,                     \
+      const ExecutionPolicy&);
+
+    ALMATH_INSTANTIATE_FOOT_POLYGON(3)
+    ALMATH_INSTANTIATE_FOOT_POLYGON(4)
+    ALMATH_INSTANTIATE_FOOT_POLYGON(5)
+    ALMATH_INSTANTIATE_FOOT_POLYGON(6)
+    ALMATH_INSTANTIATE_FOOT_POLYGON(7)
+    ALMATH_INSTANTIATE_FOOT_POLYGON(8)
+
+#undef ALMATH_INSTANTIATE_FOOT_POLYGON
+
+
+    const bool clipFootWithEllipse(
+      const float&    pMaxFootX,
+      const float&    pMaxFootY,
+      Pose2D&         pMove)
+    {
+      return (clipFootWithEllipse(pMaxFootX, pMaxFootY, &pMove, 1) == 1);
+    }
+
+
     const bool clipFootWithEllipse(
       const float&    pMaxFootX,
       const float&    pMaxFootY,
+      const Pose2D&   pEllipsePose,
+      const float&    pMinFootTheta,
+      const float&    pMaxFootTheta,
       Pose2D&         pMove)
     {
-      // described ellipse parameters
-      float a = fabsf(pMaxFootX);
-      float b = fabsf(pMaxFootY);
-      float a2 = a*a;
-      float b2 = b*b;
+      return (clipFootWithEllipse(pMaxFootX, pMaxFootY, pEllipsePose,
+                                  pMinFootTheta, pMaxFootTheta,
+                                  &pMove, 1) == 1);
+    }
+
+
+    unsigned int clipFootWithEllipse(
+      const float&        pMaxFootX,
+      const float&        pMaxFootY,
+      Pose2D*             pMoves,
+      const unsigned int& pSize)
+    {
+      return xClipWithEllipse(fabsf(pMaxFootX), fabsf(pMaxFootY),
+                              0.0f, 0.0f, 1.0f, 0.0f,
+                              -FLT_MAX, FLT_MAX, pMoves, pSize);
+    }
 
-      float norm = pMove.x*pMove.x/a2 + pMove.y*pMove.y/b2;
 
-      // first compute is point is outside ellipse or not
-      if (norm < 1.00001f)
+    unsigned int clipFootWithEllipse(
+      const float&        pMaxFootX,
+      const float&        pMaxFootY,
+      const Pose2D&       pEllipsePose,
+      const float&        pMinFootTheta,
+      const float&        pMaxFootTheta,
+      Pose2D*             pMoves,
+      const unsigned int& pSize)
+    {
+      // the only trigonometry, once for all the moves
+      float cosTheta = 1.0f;
+      float sinTheta = 0.0f;
+      if (pEllipsePose.theta != 0.0f)
       {
-        // pMove is inside ellipse
-        return false;
+        cosTheta = cosf(pEllipsePose.theta);
+        sinTheta = sinf(pEllipsePose.theta);
       }
-      else
-      {
-        // we have to clip pMove
-        // compute angle
-        float theta = atan2(pMove.y, pMove.x);
+      return xClipWithEllipse(fabsf(pMaxFootX), fabsf(pMaxFootY),
+                              pEllipsePose.x, pEllipsePose.y,
+                              cosTheta, sinTheta,
+                              pMinFootTheta, pMaxFootTheta, pMoves, pSize);
+    }
 
-        // then compute polar equation
-        float cosTheta = cosf(theta);
-        float sinTheta = sinf(theta);
-        float t = (a*b)/( sqrtf(b2*cosTheta*cosTheta + a2*sinTheta*sinTheta) );
 
-        // finally compute new pMove
-        pMove.x = t*cosTheta;
-        pMove.y = t*sinTheta;
-        return true;
+    unsigned int clipFootWithEllipse(
+      const float&            pMaxFootX,
+      const float&            pMaxFootY,
+      const Pose2D&           pEllipsePose,
+      const float&            pMinFootTheta,
+      const float&            pMaxFootTheta,
+      Pose2D*                 pMoves,
+      const unsigned int&     pSize,
+      const ExecutionPolicy&  pPolicy)
+    {
+      float cosTheta = 1.0f;
+      float sinTheta = 0.0f;
+      if (pEllipsePose.theta != 0.0f)
+      {
+        cosTheta = cosf(pEllipsePose.theta);
+        sinTheta = sinf(pEllipsePose.theta);
       }
+
+      // an integer sum: the same for any split of the moves
+      std::atomic<unsigned int> nbClamped(0);
+      parallelFor(pPolicy, 0, pSize,
+                  [&](const unsigned int& pBegin, const unsigned int& pEnd)
+      {
+        nbClamped += xClipWithEllipse(fabsf(pMaxFootX), fabsf(pMaxFootY),
+                                      pEllipsePose.x, pEllipsePose.y,
+                                      cosTheta, sinTheta,
+                                      pMinFootTheta, pMaxFootTheta,
+                                      &pMoves[pBegin], pEnd - pBegin);
+      });
+      return nbClamped.load();
     }
   } // namespace Math
 } // namespace AL
@@ -434,17 +434,23 @@ namespace AL {
           (pFloats.size() == 12) ||
           (pFloats.size() == 16))
       {
-        det = pFloats[0] * pFloats[5] * pFloats[10] +
-            pFloats[1] * pFloats[6] * pFloats[8] +
-            pFloats[2] * pFloats[4] * pFloats[9] -
-            pFloats[0] * pFloats[6] * pFloats[9] -
-            pFloats[1] * pFloats[4] * pFloats[10] -
-            pFloats[2] * pFloats[5] * pFloats[8];
+        det = determinant(&pFloats[0]);
       }
       return det;
     }
 
 
+    float determinant(const float* pFloats)
+    {
+      return pFloats[0] * pFloats[5] * pFloats[10] +
+          pFloats[1] * pFloats[6] * pFloats[8] +
+          pFloats[2] * pFloats[4] * pFloats[9] -
+          pFloats[0] * pFloats[6] * pFloats[9] -
+          pFloats[1] * pFloats[4] * pFloats[10] -
+          pFloats[2] * pFloats[5] * pFloats[8];
+    }
+
+
     void transformInverse(
       const Transform& pT,
       Transform&       pTOut)
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/types/altransform2d.h>
+#include <cmath>
+#include <stdexcept>
+
+namespace AL {
+  namespace Math {
+
+    Transform2D::Transform2D():
+      x(0.0f),
+      y(0.0f),
+      cosTheta(1.0f),
+      sinTheta(0.0f) {}
+
+    Transform2D::Transform2D(const Pose2D& pPose):
+      x(pPose.x),
+      y(pPose.y),
+      cosTheta(cosf(pPose.theta)),
+      sinTheta(sinf(pPose.theta)) {}
+
+    Transform2D::Transform2D(
+      const float& pX,
+      const float& pY,
+      const float& pTheta):
+      x(pX),
+      y(pY),
+      cosTheta(cosf(pTheta)),
+      sinTheta(sinf(pTheta)) {}
+
+    Transform2D Transform2D::operator*(const Transform2D& pT2) const
+    {
+      Transform2D pOut;
+      pOut.x = x + cosTheta * pT2.x - sinTheta * pT2.y;
+      pOut.y = y + sinTheta * pT2.x + cosTheta * pT2.y;
+      pOut.cosTheta = cosTheta * pT2.cosTheta - sinTheta * pT2.sinTheta;
+      pOut.sinTheta = sinTheta * pT2.cosTheta + cosTheta * pT2.sinTheta;
+      return pOut;
+    }
+
+    Transform2D& Transform2D::operator*=(const Transform2D& pT2)
+    {
+      *this = *this * pT2;
+      return *this;
+    }
+
+    Position2D Transform2D::operator*(const Position2D& pPos) const
+    {
+      Position2D pOut;
+      pOut.x = x + cosTheta * pPos.x - sinTheta * pPos.y;
+      pOut.y = y + sinTheta * pPos.x + cosTheta * pPos.y;
+      return pOut;
+    }
+
+    bool Transform2D::operator==(const Transform2D& pT2) const
+    {
+      return ((x == pT2.x) &&
+              (y == pT2.y) &&
+              (cosTheta == pT2.cosTheta) &&
+              (sinTheta == pT2.sinTheta));
+    }
+
+    bool Transform2D::operator!=(const Transform2D& pT2) const
+    {
+      return ! (*this==pT2);
+    }
+
+    bool Transform2D::isNear(
+      const Transform2D& pT2,
+      const float&       pEpsilon) const
+    {
+      if (
+        (fabsf(x - pT2.x) > pEpsilon) ||
+        (fabsf(y - pT2.y) > pEpsilon) ||
+        (fabsf(cosTheta - pT2.cosTheta) > pEpsilon) ||
+        (fabsf(sinTheta - pT2.sinTheta) > pEpsilon))
+      {
+        return false;
+      }
+      else
+      {
+        return true;
+      }
+    }
+
+    Transform2D Transform2D::inverse() const
+    {
+      return Math::transform2DInverse(*this);
+    }
+
+    Pose2D Transform2D::toPose2D() const
+    {
+      return Math::pose2DFromTransform2D(*this);
+    }
+
+    void transform2DInverse(
+      const Transform2D& pT,
+      Transform2D&       pTOut)
+    {
+      const float x = pT.x;
+      const float y = pT.y;
+      pTOut.cosTheta = pT.cosTheta;
+      pTOut.sinTheta = -pT.sinTheta;
+      pTOut.x = -(pTOut.cosTheta*x - pTOut.sinTheta*y);
+      pTOut.y = -(pTOut.cosTheta*y + pTOut.sinTheta*x);
+    }
+
+    Transform2D transform2DInverse(const Transform2D& pT)
+    {
+      Transform2D pTOut;
+      transform2DInverse(pT, pTOut);
+      return pTOut;
+    }
+
+    void transform2DNormalizeInPlace(Transform2D& pT)
+    {
+      const float norm = sqrtf(pT.cosTheta*pT.cosTheta + pT.sinTheta*pT.sinTheta);
+      if (norm == 0.0f)
+      {
+        throw std::runtime_error(
+          "ALTransform2D: transform2DNormalizeInPlace Division by zeros.");
+      }
+      pT.cosTheta /= norm;
+      pT.sinTheta /= norm;
+    }
+
+    Transform2D transform2DFromPose2D(const Pose2D& pPose)
+    {
+      return Transform2D(pPose);
+    }
+
+    Pose2D pose2DFromTransform2D(const Transform2D& pT)
+    {
+      return Pose2D(pT.x, pT.y, atan2f(pT.sinTheta, pT.cosTheta));
+    }
+
+    void transform2DCompose(
+      const Transform2D*  pLeft,
+      const Transform2D*  pRight,
+      const unsigned int& pSize,
+      Transform2D*        pResults)
+    {
+      for (unsigned int i=0; i<pSize; i++)
+      {
+        pResults[i] = pLeft[i] * pRight[i];
+      }
+    }
+
+    void transform2DCompose(
+      const Transform2D&  pT,
+      const Transform2D*  pRight,
+      const unsigned int& pSize,
+      Transform2D*        pResults)
+    {
+      // a copy, in case pT is one of the results
+      const Transform2D left = pT;
+      for (unsigned int i=0; i<pSize; i++)
+      {
+        pResults[i] = left * pRight[i];
+      }
+    }
+
+    void transform2DApply(
+      const Transform2D&  pT,
+      const Position2D*   pPositions,
+      const unsigned int& pSize,
+      Position2D*         pResults)
+    {
+      for (unsigned int i=0; i<pSize; i++)
+      {
+        pResults[i] = pT * pPositions[i];
+      }
+    }
+
+  } // end namespace Math
+} // end namespace AL
@@ -7,8 +7,10 @@
 #include <almath/tools/avoidfootcollision.h>
 #include <almath/types/alpose2d.h>
 #include <almath/tools/altrigonometry.h>
+#include <almath/tools/althreadpool.h>
 
 #include <gtest/gtest.h>
+#include <algorithm>
 
 TEST(avoidFootCollisionTest, Log)
 {
@@ -128,3 +130,637 @@ TEST(clipFootWithEllipse, Log)
   EXPECT_FALSE(pResult);
 }
 
+
+TEST(clipFootWithEllipse, batch)
+{
+  std::vector<AL::Math::Pose2D> pMoves;
+  pMoves.push_back(AL::Math::Pose2D( 0.05f,  0.04f,  0.1f));
+  pMoves.push_back(AL::Math::Pose2D( 0.08f,  0.06f,  0.5f));
+  pMoves.push_back(AL::Math::Pose2D(-0.08f, -0.05f,  0.5f));
+  pMoves.push_back(AL::Math::Pose2D(-0.04f,  0.06f, -0.5f));
+  pMoves.push_back(AL::Math::Pose2D( 0.0f,   0.0f,   0.0f));
+
+  std::vector<AL::Math::Pose2D> pClipped = pMoves;
+  unsigned int pNbClamped = AL::Math::clipFootWithEllipse(
+        0.08f, 0.06f, &pClipped[0], pClipped.size());
+
+  unsigned int pExpectedNbClamped = 0;
+  for (unsigned int i=0; i<pMoves.size(); i++)
+  {
+    AL::Math::Pose2D pMove = pMoves[i];
+    if (AL::Math::clipFootWithEllipse(0.08f, 0.06f, pMove))
+    {
+      ++pExpectedNbClamped;
+    }
+    EXPECT_TRUE(pClipped[i].isNear(pMove, 0.00001f));
+  }
+  EXPECT_EQ(pExpectedNbClamped, pNbClamped);
+  EXPECT_EQ(3u, pNbClamped);
+
+  // an identity ellipse pose and no theta limits give the same result
+  pClipped = pMoves;
+  pNbClamped = AL::Math::clipFootWithEllipse(
+        0.08f, 0.06f, AL::Math::Pose2D(), -AL::Math::PI, AL::Math::PI,
+        &pClipped[0], pClipped.size());
+  EXPECT_EQ(pExpectedNbClamped, pNbClamped);
+}
+
+
+TEST(clipFootWithEllipse, rotatedEllipse)
+{
+  AL::Math::Pose2D pMove;
+  bool pResult;
+
+  // ellipse centered on the nominal position of the left foot
+  const AL::Math::Pose2D pCenter(0.0f, 0.1f, 0.0f);
+  pMove = AL::Math::Pose2D(0.02f, 0.11f, 0.1f);
+  pResult = AL::Math::clipFootWithEllipse(0.04f, 0.02f, pCenter,
+                                          -0.3f, 0.3f, pMove);
+  EXPECT_FALSE(pResult);
+  EXPECT_TRUE(pMove.isNear(AL::Math::Pose2D(0.02f, 0.11f, 0.1f), 0.0001f));
+
+  pMove = AL::Math::Pose2D(0.08f, 0.1f, 0.1f);
+  pResult = AL::Math::clipFootWithEllipse(0.04f, 0.02f, pCenter,
+                                          -0.3f, 0.3f, pMove);
+  EXPECT_TRUE(pResult);
+  EXPECT_TRUE(pMove.isNear(AL::Math::Pose2D(0.04f, 0.1f, 0.1f), 0.0001f));
+
+  // only the orientation is clamped
+  pMove = AL::Math::Pose2D(0.0f, 0.1f, 0.5f);
+  pResult = AL::Math::clipFootWithEllipse(0.04f, 0.02f, pCenter,
+                                          -0.3f, 0.3f, pMove);
+  EXPECT_TRUE(pResult);
+  EXPECT_TRUE(pMove.isNear(AL::Math::Pose2D(0.0f, 0.1f, 0.3f), 0.0001f));
+
+  // with a quarter turn, the long axis of the ellipse is along y
+  const AL::Math::Pose2D pRotatedCenter(0.0f, 0.1f, AL::Math::PI_2);
+  pMove = AL::Math::Pose2D(0.0f, 0.13f, -0.1f);
+  pResult = AL::Math::clipFootWithEllipse(0.04f, 0.02f, pRotatedCenter,
+                                          -0.3f, 0.3f, pMove);
+  EXPECT_FALSE(pResult);
+
+  pMove = AL::Math::Pose2D(0.03f, 0.1f, -0.1f);
+  pResult = AL::Math::clipFootWithEllipse(0.04f, 0.02f, pRotatedCenter,
+                                          -0.3f, 0.3f, pMove);
+  EXPECT_TRUE(pResult);
+  EXPECT_TRUE(pMove.isNear(AL::Math::Pose2D(0.02f, 0.1f, -0.1f), 0.0001f));
+}
+
+
+
+TEST(areConvexPolygonsInCollision, Log)
+{
+  std::vector<AL::Math::Pose2D> pBoxA;
+  pBoxA.push_back(AL::Math::Pose2D( 0.10f,  0.02f, 0.0f));
+  pBoxA.push_back(AL::Math::Pose2D( 0.10f, -0.02f, 0.0f));
+  pBoxA.push_back(AL::Math::Pose2D(-0.10f, -0.02f, 0.0f));
+  pBoxA.push_back(AL::Math::Pose2D(-0.10f,  0.02f, 0.0f));
+
+  // cross-shaped overlap: no vertex of a box is inside the other one
+  std::vector<AL::Math::Pose2D> pBoxB;
+  pBoxB.push_back(AL::Math::Pose2D( 0.02f,  0.10f, 0.0f));
+  pBoxB.push_back(AL::Math::Pose2D( 0.02f, -0.10f, 0.0f));
+  pBoxB.push_back(AL::Math::Pose2D(-0.02f, -0.10f, 0.0f));
+  pBoxB.push_back(AL::Math::Pose2D(-0.02f,  0.10f, 0.0f));
+  EXPECT_TRUE(AL::Math::areConvexPolygonsInCollision(pBoxA, pBoxB));
+  EXPECT_TRUE(AL::Math::areConvexPolygonsInCollision(pBoxB, pBoxA));
+
+  // separated boxes
+  std::vector<AL::Math::Pose2D> pBoxC;
+  pBoxC.push_back(AL::Math::Pose2D( 0.10f,  0.10f, 0.0f));
+  pBoxC.push_back(AL::Math::Pose2D( 0.10f,  0.03f, 0.0f));
+  pBoxC.push_back(AL::Math::Pose2D(-0.10f,  0.03f, 0.0f));
+  pBoxC.push_back(AL::Math::Pose2D(-0.10f,  0.10f, 0.0f));
+  EXPECT_FALSE(AL::Math::areConvexPolygonsInCollision(pBoxA, pBoxC));
+
+  // touching boxes are not in collision
+  std::vector<AL::Math::Pose2D> pBoxD;
+  pBoxD.push_back(AL::Math::Pose2D( 0.10f,  0.10f, 0.0f));
+  pBoxD.push_back(AL::Math::Pose2D( 0.10f,  0.02f, 0.0f));
+  pBoxD.push_back(AL::Math::Pose2D(-0.10f,  0.02f, 0.0f));
+  pBoxD.push_back(AL::Math::Pose2D(-0.10f,  0.10f, 0.0f));
+  EXPECT_FALSE(AL::Math::areConvexPolygonsInCollision(pBoxA, pBoxD));
+
+  // triangle crossing the box along a diagonal
+  std::vector<AL::Math::Pose2D> pTriangle;
+  pTriangle.push_back(AL::Math::Pose2D( 0.00f,  0.05f, 0.0f));
+  pTriangle.push_back(AL::Math::Pose2D( 0.05f,  0.00f, 0.0f));
+  pTriangle.push_back(AL::Math::Pose2D( 0.05f,  0.05f, 0.0f));
+  EXPECT_TRUE(AL::Math::areConvexPolygonsInCollision(pBoxA, pTriangle));
+
+  // batch
+  std::vector<std::vector<AL::Math::Pose2D> > pPolygons;
+  pPolygons.push_back(pBoxB);
+  pPolygons.push_back(pBoxC);
+  pPolygons.push_back(pBoxD);
+  pPolygons.push_back(pTriangle);
+
+  std::vector<bool> pCollisions;
+  AL::Math::areConvexPolygonsInCollision(pBoxA, pPolygons, pCollisions);
+  ASSERT_EQ(4u, pCollisions.size());
+  EXPECT_TRUE(pCollisions[0]);
+  EXPECT_FALSE(pCollisions[1]);
+  EXPECT_FALSE(pCollisions[2]);
+  EXPECT_TRUE(pCollisions[3]);
+}
+
+
+TEST(signedDistanceBetweenConvexPolygons, Log)
+{
+  std::vector<AL::Math::Pose2D> pBoxA;
+  pBoxA.push_back(AL::Math::Pose2D(1.0f, 1.0f, 0.0f));
+  pBoxA.push_back(AL::Math::Pose2D(1.0f, 0.0f, 0.0f));
+  pBoxA.push_back(AL::Math::Pose2D(0.0f, 0.0f, 0.0f));
+  pBoxA.push_back(AL::Math::Pose2D(0.0f, 1.0f, 0.0f));
+
+  AL::Math::Position2D pWitnessA;
+  AL::Math::Position2D pWitnessB;
+  std::vector<std::vector<AL::Math::Pose2D> > pBoxesB;
+
+  // separated along x
+  std::vector<AL::Math::Pose2D> pBoxB;
+  for (unsigned int i=0; i<pBoxA.size(); i++)
+  {
+    pBoxB.push_back(pBoxA[i] + AL::Math::Pose2D(1.1f, 0.5f, 0.0f));
+  }
+  pBoxesB.push_back(pBoxB);
+  EXPECT_NEAR(AL::Math::signedDistanceBetweenConvexPolygons(
+                pBoxA, pBoxB, pWitnessA, pWitnessB), 0.1f, 0.0001f);
+  EXPECT_NEAR(pWitnessA.x, 1.0f, 0.0001f);
+  EXPECT_NEAR(pWitnessB.x, 1.1f, 0.0001f);
+  EXPECT_NEAR(pWitnessA.y, pWitnessB.y, 0.0001f);
+  EXPECT_GE(pWitnessA.y, 0.5f);
+
+  // separated by the corners
+  for (unsigned int i=0; i<pBoxA.size(); i++)
+  {
+    pBoxB[i] = pBoxA[i] + AL::Math::Pose2D(2.0f, 2.0f, 0.0f);
+  }
+  pBoxesB.push_back(pBoxB);
+  EXPECT_NEAR(AL::Math::signedDistanceBetweenConvexPolygons(
+                pBoxA, pBoxB, pWitnessA, pWitnessB), sqrtf(2.0f), 0.0001f);
+  EXPECT_TRUE(pWitnessA.isNear(AL::Math::Position2D(1.0f, 1.0f), 0.0001f));
+  EXPECT_TRUE(pWitnessB.isNear(AL::Math::Position2D(2.0f, 2.0f), 0.0001f));
+
+  // touching
+  for (unsigned int i=0; i<pBoxA.size(); i++)
+  {
+    pBoxB[i] = pBoxA[i] + AL::Math::Pose2D(1.0f, 0.0f, 0.0f);
+  }
+  pBoxesB.push_back(pBoxB);
+  EXPECT_NEAR(AL::Math::signedDistanceBetweenConvexPolygons(
+                pBoxA, pBoxB, pWitnessA, pWitnessB), 0.0f, 0.0001f);
+
+  // penetration of 0.2 along x
+  for (unsigned int i=0; i<pBoxA.size(); i++)
+  {
+    pBoxB[i] = pBoxA[i] + AL::Math::Pose2D(0.8f, 0.1f, 0.0f);
+  }
+  pBoxesB.push_back(pBoxB);
+  EXPECT_NEAR(AL::Math::signedDistanceBetweenConvexPolygons(
+                pBoxA, pBoxB, pWitnessA, pWitnessB), -0.2f, 0.0001f);
+  EXPECT_NEAR(AL::Math::distance(pWitnessA, pWitnessB), 0.2f, 0.0001f);
+  EXPECT_NEAR(pWitnessA.x, 1.0f, 0.0001f);
+  EXPECT_NEAR(pWitnessB.x, 0.8f, 0.0001f);
+
+  // same with Position2D
+  std::vector<AL::Math::Position2D> pPolygonA;
+  std::vector<AL::Math::Position2D> pPolygonB;
+  for (unsigned int i=0; i<pBoxA.size(); i++)
+  {
+    pPolygonA.push_back(AL::Math::Position2D(pBoxA[i].x, pBoxA[i].y));
+    pPolygonB.push_back(AL::Math::Position2D(pBoxB[i].x, pBoxB[i].y));
+  }
+  EXPECT_NEAR(AL::Math::signedDistanceBetweenConvexPolygons(
+                pPolygonA, pPolygonB, pWitnessA, pWitnessB), -0.2f, 0.0001f);
+
+  // a rotated triangle inside the box
+  pBoxB.clear();
+  pBoxB.push_back(AL::Math::Pose2D(0.5f, 0.4f, 0.0f));
+  pBoxB.push_back(AL::Math::Pose2D(0.7f, 0.6f, 0.0f));
+  pBoxB.push_back(AL::Math::Pose2D(0.4f, 0.7f, 0.0f));
+  pBoxesB.push_back(pBoxB);
+  EXPECT_NEAR(AL::Math::signedDistanceBetweenConvexPolygons(
+                pBoxA, pBoxB, pWitnessA, pWitnessB), -0.6f, 0.0001f);
+
+  // batch, the sign agrees with areConvexPolygonsInCollision
+  std::vector<float> pDistances;
+  std::vector<bool> pCollisions;
+  AL::Math::signedDistanceBetweenConvexPolygons(pBoxA, pBoxesB, pDistances);
+  AL::Math::areConvexPolygonsInCollision(pBoxA, pBoxesB, pCollisions);
+  ASSERT_EQ(pBoxesB.size(), pDistances.size());
+  for (unsigned int i=0; i<pBoxesB.size(); i++)
+  {
+    EXPECT_FLOAT_EQ(pDistances[i],
+                    AL::Math::signedDistanceBetweenConvexPolygons(
+                      pBoxA, pBoxesB[i], pWitnessA, pWitnessB));
+    EXPECT_EQ(pCollisions[i], pDistances[i] < 0.0f);
+  }
+
+  EXPECT_THROW(AL::Math::signedDistanceBetweenConvexPolygons(
+                 pBoxA, std::vector<AL::Math::Pose2D>(), pWitnessA, pWitnessB),
+               std::invalid_argument);
+}
+
+
+TEST(computeTimeOfContact, Log)
+{
+  std::vector<AL::Math::Pose2D> pBox;
+  pBox.push_back(AL::Math::Pose2D( 0.5f,  0.5f, 0.0f));
+  pBox.push_back(AL::Math::Pose2D( 0.5f, -0.5f, 0.0f));
+  pBox.push_back(AL::Math::Pose2D(-0.5f, -0.5f, 0.0f));
+  pBox.push_back(AL::Math::Pose2D(-0.5f,  0.5f, 0.0f));
+
+  float pTime = 0.0f;
+
+  // translation through the fixed box
+  EXPECT_TRUE(AL::Math::computeTimeOfContact(
+                pBox, pBox,
+                AL::Math::Pose2D(-3.0f, 0.0f, 0.0f),
+                AL::Math::Pose2D( 3.0f, 0.0f, 0.0f),
+                pTime));
+  EXPECT_NEAR(pTime, 2.0f/6.0f, 0.001f);
+  EXPECT_LE(pTime, 2.0f/6.0f);
+
+  // passing by
+  EXPECT_FALSE(AL::Math::computeTimeOfContact(
+                 pBox, pBox,
+                 AL::Math::Pose2D(-3.0f, 1.1f, 0.0f),
+                 AL::Math::Pose2D( 3.0f, 1.1f, 0.0f),
+                 pTime));
+  EXPECT_FLOAT_EQ(pTime, 1.0f);
+
+  // already in collision
+  EXPECT_TRUE(AL::Math::computeTimeOfContact(
+                pBox, pBox,
+                AL::Math::Pose2D(0.5f, 0.0f, 0.0f),
+                AL::Math::Pose2D(3.0f, 0.0f, 0.0f),
+                pTime));
+  EXPECT_FLOAT_EQ(pTime, 0.0f);
+
+  // no move
+  EXPECT_FALSE(AL::Math::computeTimeOfContact(
+                 pBox, pBox,
+                 AL::Math::Pose2D(2.0f, 0.0f, 0.0f),
+                 AL::Math::Pose2D(2.0f, 0.0f, 0.0f),
+                 pTime));
+}
+
+
+TEST(sweptFootCollision, Log)
+{
+  std::vector<AL::Math::Pose2D> pRFootBoundingBox;
+  pRFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f,  0.038f, 0.0f));
+  pRFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f, -0.050f, 0.0f));
+  pRFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f, -0.050f, 0.0f));
+  pRFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f,  0.038f, 0.0f));
+
+  std::vector<AL::Math::Pose2D> pLFootBoundingBox;
+  pLFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f,  0.050f, 0.0f));
+  pLFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f, -0.038f, 0.0f));
+  pLFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f, -0.038f, 0.0f));
+  pLFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f,  0.050f, 0.0f));
+
+  float pTime = 0.0f;
+
+  // a normal step forward
+  EXPECT_FALSE(AL::Math::sweptFootCollision(
+                 pLFootBoundingBox, pRFootBoundingBox, true,
+                 AL::Math::Pose2D(-0.04f, -0.1f, 0.0f),
+                 AL::Math::Pose2D( 0.06f, -0.1f, 0.0f),
+                 pTime));
+
+  // the final position is free, but the swing foot crosses the support foot
+  AL::Math::Pose2D pMove(0.15f, 0.0f, 0.0f);
+  EXPECT_FALSE(AL::Math::avoidFootCollision(
+                 pLFootBoundingBox, pRFootBoundingBox, true, pMove));
+  EXPECT_TRUE(AL::Math::sweptFootCollision(
+                pLFootBoundingBox, pRFootBoundingBox, true,
+                AL::Math::Pose2D(-0.15f, 0.0f, 0.0f), pMove, pTime));
+  EXPECT_NEAR(pTime, 0.023f/0.3f, 0.001f);
+
+  // with a rotation, compare with a dense sampling of the move
+  const AL::Math::Pose2D pStart(0.0f, -0.1f, 0.0f);
+  const AL::Math::Pose2D pEnd(0.03f, -0.1f, 1.2f);
+  float pSampledTime = 1.0f;
+  std::vector<AL::Math::Pose2D> pBox(4);
+  for (unsigned int i=0; i<=10000; i++)
+  {
+    const float t = static_cast<float>(i)/10000.0f;
+    const AL::Math::Pose2D pPose = pStart + (pEnd - pStart)*t;
+    for (unsigned int j=0; j<4; j++)
+    {
+      pBox[j] = pPose*pRFootBoundingBox[j];
+    }
+    if (AL::Math::areConvexPolygonsInCollision(pLFootBoundingBox, pBox))
+    {
+      pSampledTime = t;
+      break;
+    }
+  }
+  ASSERT_LT(pSampledTime, 1.0f);
+  EXPECT_TRUE(AL::Math::sweptFootCollision(
+                pLFootBoundingBox, pRFootBoundingBox, true,
+                pStart, pEnd, pTime));
+  EXPECT_LE(pTime, pSampledTime);
+  EXPECT_NEAR(pTime, pSampledTime, 0.002f);
+}
+
+TEST(avoidFootCollisionTest, exactMode)
+{
+  std::vector<AL::Math::Pose2D> pRFootBoundingBox;
+  pRFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f,  0.038f, 0.0f));
+  pRFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f, -0.050f, 0.0f));
+  pRFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f, -0.050f, 0.0f));
+  pRFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f,  0.038f, 0.0f));
+
+  std::vector<AL::Math::Pose2D> pLFootBoundingBox;
+  pLFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f,  0.050f, 0.0f));
+  pLFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f, -0.038f, 0.0f));
+  pLFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f, -0.038f, 0.0f));
+  pLFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f,  0.050f, 0.0f));
+
+  AL::Math::Pose2D pMove;
+  bool pResult;
+
+  // no collision: pMove is not modified
+  pMove = AL::Math::Pose2D(0.0f, 0.1f, 0.0f);
+  pResult = avoidFootCollision(pLFootBoundingBox,
+                               pRFootBoundingBox,
+                               false,
+                               pMove,
+                               AL::Math::AVOID_FOOT_COLLISION_EXACT);
+  EXPECT_FALSE(pResult);
+  EXPECT_TRUE(pMove.isNear(AL::Math::Pose2D(0.0f, 0.1f, 0.0f)));
+
+  // same case as the dichotomy, which is precise to theta/32
+  pMove = AL::Math::Pose2D(0.0f, 0.085f, 40.0f*AL::Math::TO_RAD);
+  pResult = avoidFootCollision(pLFootBoundingBox,
+                               pRFootBoundingBox,
+                               false,
+                               pMove,
+                               AL::Math::AVOID_FOOT_COLLISION_EXACT);
+  EXPECT_TRUE(pResult);
+  EXPECT_NEAR(pMove.x, 0.0f, 0.0001f);
+  EXPECT_NEAR(pMove.y, 0.085f, 0.0001f);
+  EXPECT_NEAR(pMove.theta, 0.210979f, 0.0001f);
+
+  // just before the result, no collision, just after, collision
+  AL::Math::Pose2D pMovingFoot;
+  std::vector<AL::Math::Pose2D> pMovedBox(4);
+  pMovingFoot = AL::Math::Pose2D(pMove.x, pMove.y, pMove.theta - 0.0001f);
+  for (unsigned int i=0; i<4; i++)
+    pMovedBox[i] = pMovingFoot * pLFootBoundingBox[i];
+  EXPECT_FALSE(AL::Math::areConvexPolygonsInCollision(pRFootBoundingBox, pMovedBox));
+  pMovingFoot = AL::Math::Pose2D(pMove.x, pMove.y, pMove.theta + 0.0001f);
+  for (unsigned int i=0; i<4; i++)
+    pMovedBox[i] = pMovingFoot * pLFootBoundingBox[i];
+  EXPECT_TRUE(AL::Math::areConvexPolygonsInCollision(pRFootBoundingBox, pMovedBox));
+
+  // negative rotation, left support
+  pMove = AL::Math::Pose2D(0.0f, -0.085f, -40.0f*AL::Math::TO_RAD);
+  pResult = avoidFootCollision(pLFootBoundingBox,
+                               pRFootBoundingBox,
+                               true,
+                               pMove,
+                               AL::Math::AVOID_FOOT_COLLISION_EXACT);
+  EXPECT_TRUE(pResult);
+  EXPECT_NEAR(pMove.theta, -0.210979f, 0.0001f);
+
+  // the feet are already in collision without rotation
+  pMove = AL::Math::Pose2D(0.0f, 0.05f, 0.3f);
+  pResult = avoidFootCollision(pLFootBoundingBox,
+                               pRFootBoundingBox,
+                               false,
+                               pMove,
+                               AL::Math::AVOID_FOOT_COLLISION_EXACT);
+  EXPECT_TRUE(pResult);
+  EXPECT_NEAR(pMove.theta, 0.0f, 0.0001f);
+}
+
+
+TEST(avoidFootCollisionTest, footPolygon)
+{
+  std::vector<AL::Math::Pose2D> pRFootBoundingBox;
+  pRFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f,  0.038f, 0.0f));
+  pRFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f, -0.050f, 0.0f));
+  pRFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f, -0.050f, 0.0f));
+  pRFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f,  0.038f, 0.0f));
+
+  std::vector<AL::Math::Pose2D> pLFootBoundingBox;
+  pLFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f,  0.050f, 0.0f));
+  pLFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f, -0.038f, 0.0f));
+  pLFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f, -0.038f, 0.0f));
+  pLFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f,  0.050f, 0.0f));
+
+  const AL::Math::FootBox pRFoot = AL::Math::FootBox(pRFootBoundingBox);
+  const AL::Math::FootBox pLFoot = AL::Math::FootBox(pLFootBoundingBox);
+
+  // same results as the std::vector version, for both modes
+  const AL::Math::Pose2D pMoves[4] = {
+    AL::Math::Pose2D(0.0f,  0.1f,    0.0f),
+    AL::Math::Pose2D(0.0f,  0.085f,  40.0f*AL::Math::TO_RAD),
+    AL::Math::Pose2D(0.0f,  0.085f, -40.0f*AL::Math::TO_RAD),
+    AL::Math::Pose2D(0.02f, 0.09f,   60.0f*AL::Math::TO_RAD)};
+
+  AL::Math::Pose2D pMove;
+  AL::Math::Pose2D pMoveVector;
+  for (unsigned int i=0; i<4; i++)
+  {
+    for (unsigned int mode=0; mode<2; mode++)
+    {
+      pMove = pMoves[i];
+      pMoveVector = pMoves[i];
+      EXPECT_EQ(
+        avoidFootCollision(pLFootBoundingBox, pRFootBoundingBox, false, pMoveVector,
+                           AL::Math::AVOID_FOOT_COLLISION_MODE(mode)),
+        avoidFootCollision(pLFoot, pRFoot, false, pMove,
+                           AL::Math::AVOID_FOOT_COLLISION_MODE(mode)));
+      EXPECT_TRUE(pMove.isNear(pMoveVector));
+    }
+  }
+
+  // collision between foot polygons
+  AL::Math::FootBox pMoved;
+  pLFoot.transform(AL::Math::Pose2D(0.0f, 0.1f, 0.0f), pMoved);
+  EXPECT_FALSE(AL::Math::areConvexPolygonsInCollision(pRFoot, pMoved));
+  pLFoot.transform(AL::Math::Pose2D(0.0f, 0.085f, 40.0f*AL::Math::TO_RAD), pMoved);
+  EXPECT_TRUE(AL::Math::areConvexPolygonsInCollision(pRFoot, pMoved));
+}
+
+
+TEST(evaluateFootCandidates, Log)
+{
+  std::vector<AL::Math::Pose2D> pRFootBoundingBox;
+  pRFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f,  0.038f, 0.0f));
+  pRFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f, -0.050f, 0.0f));
+  pRFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f, -0.050f, 0.0f));
+  pRFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f,  0.038f, 0.0f));
+
+  std::vector<AL::Math::Pose2D> pLFootBoundingBox;
+  pLFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f,  0.050f, 0.0f));
+  pLFootBoundingBox.push_back(AL::Math::Pose2D( 0.080f, -0.038f, 0.0f));
+  pLFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f, -0.038f, 0.0f));
+  pLFootBoundingBox.push_back(AL::Math::Pose2D(-0.047f,  0.050f, 0.0f));
+
+  const AL::Math::FootBox pRFoot = AL::Math::FootBox(pRFootBoundingBox);
+  const AL::Math::FootBox pLFoot = AL::Math::FootBox(pLFootBoundingBox);
+
+  const float pMaxFootX = 0.08f;
+  const float pMaxFootY = 0.16f;
+
+  // grid of candidates for the left foot, right support
+  std::vector<AL::Math::Pose2D> pCandidates;
+  for (int i=-4; i<=4; i++)
+  {
+    for (int j=0; j<=8; j++)
+    {
+      for (int k=-2; k<=2; k++)
+      {
+        pCandidates.push_back(AL::Math::Pose2D(0.025f*i, 0.025f*j, 0.3f*k));
+      }
+    }
+  }
+
+  std::vector<AL::Math::Pose2D> pMoves;
+  std::vector<bool> pCollisions;
+  AL::Math::Pose2D pMove;
+  unsigned int pNbCollisions = 0;
+  for (unsigned int mode=0; mode<2; mode++)
+  {
+    AL::Math::evaluateFootCandidates(pRFoot, pLFoot, pMaxFootX, pMaxFootY,
+                                     pCandidates, pMoves, pCollisions,
+                                     AL::Math::AVOID_FOOT_COLLISION_MODE(mode));
+    ASSERT_EQ(pCandidates.size(), pMoves.size());
+    ASSERT_EQ(pCandidates.size(), pCollisions.size());
+
+    // same result as one call of each function per candidate
+    for (unsigned int i=0; i<pCandidates.size(); i++)
+    {
+      pMove = pCandidates[i];
+      AL::Math::clipFootWithEllipse(pMaxFootX, pMaxFootY, pMove);
+      EXPECT_EQ(
+        AL::Math::avoidFootCollision(pLFootBoundingBox, pRFootBoundingBox, false, pMove,
+                                     AL::Math::AVOID_FOOT_COLLISION_MODE(mode)),
+        pCollisions[i]);
+      EXPECT_TRUE(pMove.isNear(pMoves[i]));
+      pNbCollisions += pCollisions[i];
+    }
+  }
+  EXPECT_TRUE(pNbCollisions > 0u);
+
+  // no candidate
+  pCandidates.clear();
+  AL::Math::evaluateFootCandidates(pRFoot, pLFoot, pMaxFootX, pMaxFootY,
+                                   pCandidates, pMoves, pCollisions);
+  EXPECT_TRUE(pMoves.empty());
+  EXPECT_TRUE(pCollisions.empty());
+}
+
+
+TEST(evaluateFootCandidates, Parallel)
+{
+  AL::Math::FootBox pRFoot;
+  pRFoot.vertices[0] = AL::Math::Position2D( 0.080f,  0.038f);
+  pRFoot.vertices[1] = AL::Math::Position2D( 0.080f, -0.050f);
+  pRFoot.vertices[2] = AL::Math::Position2D(-0.047f, -0.050f);
+  pRFoot.vertices[3] = AL::Math::Position2D(-0.047f,  0.038f);
+  pRFoot.update();
+  AL::Math::FootBox pLFoot;
+  pLFoot.vertices[0] = AL::Math::Position2D( 0.080f,  0.050f);
+  pLFoot.vertices[1] = AL::Math::Position2D( 0.080f, -0.038f);
+  pLFoot.vertices[2] = AL::Math::Position2D(-0.047f, -0.038f);
+  pLFoot.vertices[3] = AL::Math::Position2D(-0.047f,  0.050f);
+  pLFoot.update();
+
+  std::vector<AL::Math::Pose2D> pCandidates;
+  for (int i=0; i<1000; i++)
+  {
+    pCandidates.push_back(AL::Math::Pose2D(0.0002f*(i - 500), 0.0003f*i,
+                                           0.001f*(i % 600) - 0.3f));
+  }
+
+  std::vector<AL::Math::Pose2D> pMoves;
+  std::vector<bool> pCollisions;
+  AL::Math::evaluateFootCandidates(pRFoot, pLFoot, 0.08f, 0.16f,
+                                   pCandidates, pMoves, pCollisions);
+
+  // the same result for any number of threads and grain size
+  AL::Math::ThreadPool pPool(3);
+  const unsigned int pGrainSizes[] = {0, 1, 100, 5000};
+  for (unsigned int g=0; g<4; g++)
+  {
+    std::vector<AL::Math::Pose2D> pParallelMoves;
+    std::vector<bool> pParallelCollisions;
+    AL::Math::evaluateFootCandidates(pRFoot, pLFoot, 0.08f, 0.16f,
+                                     pCandidates, pParallelMoves, pParallelCollisions,
+                                     AL::Math::AVOID_FOOT_COLLISION_DICHOTOMY,
+                                     AL::Math::ExecutionPolicy(pPool, pGrainSizes[g]));
+    EXPECT_TRUE(pCollisions == pParallelCollisions);
+    ASSERT_EQ(pMoves.size(), pParallelMoves.size());
+    for (unsigned int i=0; i<pMoves.size(); i++)
+    {
+      EXPECT_TRUE(pMoves[i].isNear(pParallelMoves[i], 0.0f));
+    }
+  }
+
+  std::vector<AL::Math::Pose2D> pClipped(pCandidates);
+  std::vector<AL::Math::Pose2D> pParallelClipped(pCandidates);
+  const AL::Math::Pose2D pEllipse(0.01f, 0.1f, 0.2f);
+  EXPECT_EQ(AL::Math::clipFootWithEllipse(0.08f, 0.06f, pEllipse, -0.2f, 0.4f,
+                                          &pClipped[0], pClipped.size()),
+            AL::Math::clipFootWithEllipse(0.08f, 0.06f, pEllipse, -0.2f, 0.4f,
+                                          &pParallelClipped[0], pParallelClipped.size(),
+                                          AL::Math::ExecutionPolicy(pPool, 7)));
+  for (unsigned int i=0; i<pClipped.size(); i++)
+  {
+    EXPECT_TRUE(pClipped[i].isNear(pParallelClipped[i], 0.0f));
+  }
+}
+
+
+TEST(areConvexPolygonsInCollision, Parallel)
+{
+  std::vector<AL::Math::Pose2D> pBoxA;
+  pBoxA.push_back(AL::Math::Pose2D( 0.10f,  0.02f, 0.0f));
+  pBoxA.push_back(AL::Math::Pose2D( 0.10f, -0.02f, 0.0f));
+  pBoxA.push_back(AL::Math::Pose2D(-0.10f, -0.02f, 0.0f));
+  pBoxA.push_back(AL::Math::Pose2D(-0.10f,  0.02f, 0.0f));
+
+  // boxes around A, some of them in collision
+  std::vector<std::vector<AL::Math::Pose2D> > pBoxesB;
+  for (int i=0; i<1000; i++)
+  {
+    const AL::Math::Pose2D pMove(0.0004f*(i - 500), 0.0004f*(i % 700) - 0.14f,
+                                 0.003f*i);
+    std::vector<AL::Math::Pose2D> pBoxB;
+    for (unsigned int j=0; j<pBoxA.size(); j++)
+    {
+      pBoxB.push_back(pMove*pBoxA[j]);
+    }
+    pBoxesB.push_back(pBoxB);
+  }
+
+  std::vector<bool> pCollisions;
+  std::vector<float> pDistances;
+  AL::Math::areConvexPolygonsInCollision(pBoxA, pBoxesB, pCollisions);
+  AL::Math::signedDistanceBetweenConvexPolygons(pBoxA, pBoxesB, pDistances);
+  EXPECT_NE(std::count(pCollisions.begin(), pCollisions.end(), true), 0);
+  EXPECT_NE(std::count(pCollisions.begin(), pCollisions.end(), false), 0);
+
+  // the same result for any number of threads and grain size
+  AL::Math::ThreadPool pPool(3);
+  const unsigned int pGrainSizes[] = {0, 1, 100, 5000};
+  for (unsigned int g=0; g<4; g++)
+  {
+    const AL::Math::ExecutionPolicy pPolicy(pPool, pGrainSizes[g]);
+    std::vector<bool> pParallelCollisions;
+    std::vector<float> pParallelDistances;
+    AL::Math::areConvexPolygonsInCollision(pBoxA, pBoxesB, pParallelCollisions,
+                                           pPolicy);
+    AL::Math::signedDistanceBetweenConvexPolygons(pBoxA, pBoxesB,
+                                                  pParallelDistances, pPolicy);
+    EXPECT_TRUE(pCollisions == pParallelCollisions);
+    EXPECT_TRUE(pDistances == pParallelDistances);
+  }
+}
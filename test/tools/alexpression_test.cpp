@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alexpression.h>
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using AL::Math::lazy;
+
+TEST(ALExpressionTest, sameAsOperators)
+{
+  const AL::Math::Position3D a(1.0f, 2.0f, 3.0f);
+  const AL::Math::Position3D b(-0.5f, 0.25f, 4.0f);
+  const AL::Math::Position3D c(0.1f, 0.2f, 0.3f);
+
+  const AL::Math::Position3D expected = a + b*0.5f - c;
+  const AL::Math::Position3D result = lazy(a) + lazy(b)*0.5f - c;
+  EXPECT_TRUE(result.isNear(expected, 0.0f));
+
+  // plain values on both sides, unary minus and division
+  const AL::Math::Position3D mixed = c - (-lazy(a) + b)/2.0f;
+  EXPECT_TRUE(mixed.isNear(c - (-a + b)/2.0f, 0.0f));
+  const AL::Math::Position3D scaled = 2.0f*(lazy(a) - lazy(b));
+  EXPECT_TRUE(scaled.isNear((a - b)*2.0f, 0.0f));
+
+  // a control law on all the members of a Velocity6D
+  const AL::Math::Velocity6D feedForward(0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f);
+  const AL::Math::Velocity6D reference(1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+  const AL::Math::Velocity6D measure(0.9f, 1.2f, 0.7f, 1.1f, 1.0f, 0.2f);
+  const AL::Math::Velocity6D rate(0.01f, -0.02f, 0.03f, 0.0f, 0.1f, -0.1f);
+  const AL::Math::Velocity6D command =
+      lazy(feedForward) + (lazy(reference) - measure)*2.5f - lazy(rate)*0.3f;
+  EXPECT_TRUE(command.isNear(
+                feedForward + (reference - measure)*2.5f - rate*0.3f, 0.0f));
+
+  const AL::Math::Pose2D p0(0.1f, 0.2f, 0.3f);
+  const AL::Math::Pose2D p1(1.1f, -0.2f, 1.3f);
+  const AL::Math::Pose2D pose = lazy(p0) + (lazy(p1) - p0)*0.25f;
+  EXPECT_TRUE(pose.isNear(p0 + (p1 - p0)*0.25f, 0.0f));
+  EXPECT_NEAR(0.55f, pose.theta, 0.00001f);
+
+  const AL::Math::Position6D q(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f);
+  const AL::Math::Position6D q2 = lazy(q)*3.0f - q;
+  EXPECT_TRUE(q2.isNear(q*2.0f, 0.0f));
+
+  const AL::Math::Position2D r(1.0f, 2.0f);
+  const AL::Math::Velocity3D v(1.0f, 2.0f, 3.0f);
+  EXPECT_TRUE(AL::Math::Position2D(lazy(r) + r).isNear(r*2.0f, 0.0f));
+  EXPECT_TRUE(AL::Math::Velocity3D(-lazy(v)).isNear(-v, 0.0f));
+}
+
+
+TEST(ALExpressionTest, aliasingAndErrors)
+{
+  // the result may be an operand
+  AL::Math::Position3D a(1.0f, 2.0f, 3.0f);
+  const AL::Math::Position3D b(1.0f, 1.0f, 1.0f);
+  (lazy(a)*2.0f + b).evaluate(a);
+  EXPECT_TRUE(a.isNear(AL::Math::Position3D(3.0f, 5.0f, 7.0f), 0.0f));
+  a = lazy(a) - lazy(a)*0.5f;
+  EXPECT_TRUE(a.isNear(AL::Math::Position3D(1.5f, 2.5f, 3.5f), 0.0f));
+
+  EXPECT_THROW(AL::Math::Position3D(lazy(a)/0.0f), std::runtime_error);
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alfootstepplanner.h>
+#include <almath/tools/avoidfootcollision.h>
+#include <almath/types/alpose2d.h>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+  std::vector<AL::Math::Pose2D> makeBox(
+    const float& pXMin,
+    const float& pXMax,
+    const float& pYMin,
+    const float& pYMax)
+  {
+    std::vector<AL::Math::Pose2D> box;
+    box.push_back(AL::Math::Pose2D(pXMax, pYMax, 0.0f));
+    box.push_back(AL::Math::Pose2D(pXMax, pYMin, 0.0f));
+    box.push_back(AL::Math::Pose2D(pXMin, pYMin, 0.0f));
+    box.push_back(AL::Math::Pose2D(pXMin, pYMax, 0.0f));
+    return box;
+  }
+
+  std::vector<AL::Math::Pose2D> moveBox(
+    const std::vector<AL::Math::Pose2D>& pBox,
+    const AL::Math::Pose2D&              pPose)
+  {
+    std::vector<AL::Math::Pose2D> box(pBox.size());
+    for (unsigned int i=0; i<pBox.size(); i++)
+    {
+      box[i] = pPose*pBox[i];
+    }
+    return box;
+  }
+
+  class FootstepPlannerTest : public ::testing::Test
+  {
+  protected:
+    FootstepPlannerTest() :
+      lFootBox(makeBox(-0.047f, 0.080f, -0.038f, 0.050f)),
+      rFootBox(makeBox(-0.047f, 0.080f, -0.050f, 0.038f)),
+      lFoot(0.0f, 0.05f, 0.0f),
+      rFoot(0.0f, -0.05f, 0.0f)
+    {
+      const float dx[] = {-0.04f, 0.0f, 0.02f, 0.04f, 0.06f};
+      const float dy[] = {0.0f, 0.02f, 0.04f};
+      const float dtheta[] = {-0.2f, 0.0f, 0.2f};
+      for (unsigned int i=0; i<5; i++)
+      {
+        for (unsigned int j=0; j<3; j++)
+        {
+          for (unsigned int k=0; k<3; k++)
+          {
+            actions.push_back(AL::Math::Pose2D(dx[i], dy[j], dtheta[k]));
+          }
+        }
+      }
+    }
+
+    // check the feasibility of each step of the sequence
+    void checkSequence(
+      const std::vector<AL::Math::Footstep>&               pFootsteps,
+      const AL::Math::Pose2D&                              pGoal,
+      const std::vector<std::vector<AL::Math::Pose2D> >&   pObstacles)
+    {
+      ASSERT_FALSE(pFootsteps.empty());
+
+      AL::Math::Pose2D support = lFoot;
+      for (unsigned int i=0; i<pFootsteps.size(); i++)
+      {
+        const AL::Math::Footstep& step = pFootsteps[i];
+        // the feet alternate, the right foot moves first
+        EXPECT_EQ(i%2 == 1, step.isLeft);
+
+        AL::Math::Pose2D move = step.move;
+        EXPECT_FALSE(AL::Math::avoidFootCollision(
+                       lFootBox, rFootBox, !step.isLeft, move,
+                       AL::Math::AVOID_FOOT_COLLISION_EXACT));
+        EXPECT_NEAR(AL::Math::distance(support*step.move, step.pose),
+                    0.0f, 0.0001f);
+
+        const std::vector<AL::Math::Pose2D> foot =
+            moveBox(step.isLeft ? lFootBox : rFootBox, step.pose);
+        for (unsigned int j=0; j<pObstacles.size(); j++)
+        {
+          EXPECT_FALSE(AL::Math::areConvexPolygonsInCollision(
+                         foot, pObstacles[j]));
+        }
+        support = step.pose;
+      }
+
+      // both feet end near the goal
+      const AL::Math::Footstep& last = pFootsteps.back();
+      const AL::Math::Pose2D lastGoal = pGoal*AL::Math::Pose2D(
+            0.0f, last.isLeft ? 0.05f : -0.05f, 0.0f);
+      EXPECT_NEAR(AL::Math::distance(last.pose, lastGoal), 0.0f, 0.04f);
+    }
+
+    std::vector<AL::Math::Pose2D> lFootBox;
+    std::vector<AL::Math::Pose2D> rFootBox;
+    std::vector<AL::Math::Pose2D> actions;
+    AL::Math::Pose2D lFoot;
+    AL::Math::Pose2D rFoot;
+  };
+}
+
+
+TEST_F(FootstepPlannerTest, plan)
+{
+  AL::Math::FootstepPlanner planner(
+        lFootBox, rFootBox, 0.06f, 0.04f, 0.1f, actions);
+  std::vector<AL::Math::Footstep> footsteps;
+  const std::vector<std::vector<AL::Math::Pose2D> > noObstacles;
+
+  // already at the goal
+  EXPECT_TRUE(planner.plan(lFoot, rFoot, true, AL::Math::Pose2D(),
+                           footsteps));
+  EXPECT_TRUE(footsteps.empty());
+
+  // straight ahead: a step moves a foot about 0.06 ahead of the other one
+  const AL::Math::Pose2D goal(0.5f, 0.0f, 0.0f);
+  EXPECT_TRUE(planner.plan(lFoot, rFoot, true, goal, footsteps));
+  checkSequence(footsteps, goal, noObstacles);
+  EXPECT_GE(footsteps.size(), 7u);
+  EXPECT_LE(footsteps.size(), 10u);
+  EXPECT_FLOAT_EQ(planner.getWeight(), 1.0f);
+  EXPECT_GT(planner.getNbExpansions(), 0u);
+
+  // turn in place
+  const AL::Math::Pose2D turn(0.0f, 0.0f, 0.6f);
+  EXPECT_TRUE(planner.plan(lFoot, rFoot, true, turn, footsteps));
+  checkSequence(footsteps, turn, noObstacles);
+}
+
+
+TEST_F(FootstepPlannerTest, obstacles)
+{
+  AL::Math::FootstepPlanner planner(
+        lFootBox, rFootBox, 0.06f, 0.04f, 0.1f, actions);
+  std::vector<AL::Math::Footstep> footsteps;
+
+  // a wall in front of the left foot
+  std::vector<std::vector<AL::Math::Pose2D> > obstacles;
+  obstacles.push_back(makeBox(0.2f, 0.3f, -0.02f, 0.5f));
+  planner.setObstacles(obstacles);
+
+  const AL::Math::Pose2D goal(0.5f, 0.0f, 0.0f);
+  EXPECT_TRUE(planner.planAnytime(lFoot, rFoot, true, goal, 1.0f, 3.0f,
+                                  footsteps));
+  checkSequence(footsteps, goal, obstacles);
+  EXPECT_GE(planner.getWeight(), 1.0f);
+  EXPECT_LE(planner.getWeight(), 3.0f);
+
+  // the goal is inside an obstacle
+  obstacles.push_back(makeBox(0.4f, 0.6f, -0.2f, 0.2f));
+  planner.setObstacles(obstacles);
+  planner.setMaxExpansions(500);
+  EXPECT_FALSE(planner.plan(lFoot, rFoot, true, goal, footsteps));
+  EXPECT_TRUE(footsteps.empty());
+  EXPECT_EQ(planner.getNbExpansions(), 500u);
+}
+
+
+TEST_F(FootstepPlannerTest, anytime)
+{
+  AL::Math::FootstepPlanner planner(
+        lFootBox, rFootBox, 0.06f, 0.04f, 0.1f, actions);
+  std::vector<AL::Math::Footstep> optimal;
+  std::vector<AL::Math::Footstep> footsteps;
+  const std::vector<std::vector<AL::Math::Pose2D> > noObstacles;
+
+  const AL::Math::Pose2D goal(0.4f, 0.2f, 0.4f);
+  EXPECT_TRUE(planner.plan(lFoot, rFoot, true, goal, optimal));
+  checkSequence(optimal, goal, noObstacles);
+
+  // with enough time, ARA* ends with the optimal cost
+  EXPECT_TRUE(planner.planAnytime(lFoot, rFoot, true, goal, 10.0f, 3.0f,
+                                  footsteps));
+  checkSequence(footsteps, goal, noObstacles);
+  EXPECT_FLOAT_EQ(planner.getWeight(), 1.0f);
+  EXPECT_EQ(footsteps.size(), optimal.size());
+
+  // no expansion allowed
+  planner.setMaxExpansions(0);
+  EXPECT_FALSE(planner.planAnytime(lFoot, rFoot, true, goal, 10.0f, 3.0f,
+                                   footsteps));
+}
+
+
+
+TEST_F(FootstepPlannerTest, lateral)
+{
+  // short forward steps, long side steps
+  std::vector<AL::Math::Pose2D> sideActions;
+  const float dx[] = {-0.02f, 0.0f, 0.02f};
+  const float dy[] = {0.0f, 0.05f, 0.1f};
+  for (unsigned int i=0; i<3; i++)
+  {
+    for (unsigned int j=0; j<3; j++)
+    {
+      sideActions.push_back(AL::Math::Pose2D(dx[i], dy[j], 0.0f));
+    }
+  }
+  AL::Math::FootstepPlanner planner(
+        lFootBox, rFootBox, 0.02f, 0.1f, 0.1f, sideActions);
+  std::vector<AL::Math::Footstep> footsteps;
+  const std::vector<std::vector<AL::Math::Pose2D> > noObstacles;
+
+  // a step can move a foot of 0.1 to the side: the heuristic must not
+  // count steps of 0.02, or the plan is not the optimal one
+  const AL::Math::Pose2D goal(0.3f, 0.5f, 0.0f);
+  EXPECT_TRUE(planner.plan(lFoot, rFoot, true, goal, footsteps));
+  checkSequence(footsteps, goal, noObstacles);
+  EXPECT_LE(footsteps.size(), 17u);
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alliegroup.h>
+#include <almath/tools/altransformhelpers.h>
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+  // matrix times tangent
+  template <class G>
+  std::vector<float> multiply(
+    const typename AL::Math::LieGroup<G>::Matrix& pM,
+    const std::vector<float>&                     pV)
+  {
+    const unsigned int dof = AL::Math::LieGroup<G>::dof;
+    std::vector<float> result(dof, 0.0f);
+    for (unsigned int i=0; i<dof; i++)
+    {
+      for (unsigned int j=0; j<dof; j++)
+      {
+        result[i] += pM[dof*i + j]*pV[j];
+      }
+    }
+    return result;
+  }
+
+  void expectNear(
+    const std::vector<float>& pA,
+    const std::vector<float>& pB,
+    const float&              pEpsilon)
+  {
+    ASSERT_EQ(pA.size(), pB.size());
+    for (unsigned int i=0; i<pA.size(); i++)
+    {
+      EXPECT_NEAR(pA[i], pB[i], pEpsilon) << "at " << i;
+    }
+  }
+
+  // log and exp, adjoint, and the jacobians by finite differences
+  template <class G>
+  void checkGroup(
+    const typename AL::Math::LieGroup<G>::Tangent& pV,
+    const G&                                       pG)
+  {
+    typedef AL::Math::LieGroup<G> Lie;
+    typedef typename Lie::Tangent Tangent;
+
+    const G g = Lie::exp(pV);
+    expectNear(Lie::log(g).toVector(), pV.toVector(), 0.0001f);
+    expectNear(AL::Math::lieMinus(Lie::compose(g, Lie::inverse(g)), Lie::identity()).toVector(),
+               Tangent().toVector(), 0.0001f);
+
+    // pG*exp(v)*inverse(pG) = exp(adjoint(pG)*v)
+    const G conjugate = Lie::compose(Lie::compose(pG, g), Lie::inverse(pG));
+    const Tangent adjointV(multiply<G>(Lie::adjoint(pG), pV.toVector()));
+    expectNear(AL::Math::lieMinus(conjugate, Lie::exp(adjointV)).toVector(),
+               Tangent().toVector(), 0.0001f);
+
+    const typename Lie::Matrix left = Lie::leftJacobian(pV);
+    const typename Lie::Matrix right = Lie::rightJacobian(pV);
+    const float step = 0.001f;
+    for (unsigned int k=0; k<Lie::dof; k++)
+    {
+      std::vector<float> delta(Lie::dof, 0.0f);
+      delta[k] = step;
+      const G moved = Lie::exp(pV + Tangent(delta));
+      // exp(v + dv) = exp(Jl*dv)*exp(v) = exp(v)*exp(Jr*dv)
+      const std::vector<float> leftStep =
+          Lie::log(Lie::compose(moved, Lie::inverse(g))).toVector();
+      const std::vector<float> rightStep =
+          AL::Math::lieMinus(moved, g).toVector();
+      expectNear(leftStep, multiply<G>(left, delta), 0.00002f);
+      expectNear(rightStep, multiply<G>(right, delta), 0.00002f);
+    }
+  }
+}
+
+TEST(ALLieGroupTest, pose2D)
+{
+  const AL::Math::Pose2D g(0.5f, -1.2f, 2.0f);
+  checkGroup(AL::Math::Pose2D(0.3f, -0.4f, 1.2f), g);
+  checkGroup(AL::Math::Pose2D(-0.7f, 0.2f, -2.9f), g);
+  checkGroup(AL::Math::Pose2D(0.3f, 0.1f, 0.001f), g);
+  checkGroup(AL::Math::Pose2D(0.3f, 0.1f, 0.0f), g);
+
+  // log wraps theta
+  const AL::Math::Pose2D turned = AL::Math::LieGroup<AL::Math::Pose2D>::log(
+        AL::Math::Pose2D(0.0f, 0.0f, 7.0f));
+  EXPECT_NEAR(turned.theta, 7.0f - 8.0f*std::atan(1.0f), 0.00001f);
+}
+
+TEST(ALLieGroupTest, transform2D)
+{
+  const AL::Math::Transform2D g(0.5f, -1.2f, 2.0f);
+  checkGroup(AL::Math::Pose2D(0.3f, -0.4f, 1.2f), g);
+  checkGroup(AL::Math::Pose2D(-0.7f, 0.2f, -2.9f), g);
+  checkGroup(AL::Math::Pose2D(0.3f, 0.1f, 0.0f), g);
+
+  // same exponential as on Pose2D
+  const AL::Math::Pose2D v(0.3f, -0.4f, 1.2f);
+  EXPECT_TRUE(AL::Math::LieGroup<AL::Math::Transform2D>::exp(v).toPose2D().isNear(
+                AL::Math::LieGroup<AL::Math::Pose2D>::exp(v), 0.00001f));
+}
+
+TEST(ALLieGroupTest, rotation)
+{
+  const AL::Math::Rotation g = AL::Math::rotationFromRotY(0.8f)*
+      AL::Math::rotationFromRotZ(-1.5f);
+  checkGroup(AL::Math::Position3D(0.3f, -0.4f, 1.2f), g);
+  checkGroup(AL::Math::Position3D(0.001f, 0.0f, -0.002f), g);
+  checkGroup(AL::Math::Position3D(0.0f, 0.0f, 0.0f), g);
+  checkGroup(AL::Math::Position3D(0.0f, 3.0f, 0.0f), g);
+  checkGroup(AL::Math::Position3D(1.5f, -2.0f, 1.0f), g);
+
+  // pi around an axis: the sign of the axis is free
+  const AL::Math::Position3D w = AL::Math::LieGroup<AL::Math::Rotation>::log(
+        AL::Math::rotationFromRotX(3.14159265f));
+  EXPECT_NEAR(std::fabs(w.x), 3.14159265f, 0.0001f);
+  EXPECT_NEAR(w.y, 0.0f, 0.0001f);
+  EXPECT_NEAR(w.z, 0.0f, 0.0001f);
+}
+
+TEST(ALLieGroupTest, quaternion)
+{
+  const AL::Math::Quaternion g = AL::Math::quaternionFromAngleAndAxisRotation(
+        0.8f, 0.0f, 0.6f, 0.8f);
+  checkGroup(AL::Math::Position3D(0.3f, -0.4f, 1.2f), g);
+  checkGroup(AL::Math::Position3D(0.001f, 0.0f, -0.002f), g);
+  checkGroup(AL::Math::Position3D(0.0f, 0.0f, 0.0f), g);
+  checkGroup(AL::Math::Position3D(1.5f, -2.0f, 1.0f), g);
+
+  // same rotation as on Rotation
+  const AL::Math::Position3D v(0.3f, -0.4f, 1.2f);
+  const AL::Math::Quaternion q = AL::Math::LieGroup<AL::Math::Quaternion>::exp(v);
+  EXPECT_TRUE(AL::Math::rotationFromQuaternion(q.w, q.x, q.y, q.z).isNear(
+                AL::Math::LieGroup<AL::Math::Rotation>::exp(v), 0.00001f));
+  // q and -q give the same velocity
+  expectNear(AL::Math::LieGroup<AL::Math::Quaternion>::log(
+               AL::Math::Quaternion(-q.w, -q.x, -q.y, -q.z)).toVector(),
+             v.toVector(), 0.00001f);
+}
+
+TEST(ALLieGroupTest, transform)
+{
+  const AL::Math::Transform g = AL::Math::transformFromRotY(0.8f)*
+      AL::Math::Transform(0.5f, -1.2f, 0.3f);
+  checkGroup(AL::Math::Velocity6D(0.3f, -0.4f, 0.2f, 0.5f, -0.2f, 1.1f), g);
+  checkGroup(AL::Math::Velocity6D(0.3f, -0.4f, 0.2f, 0.001f, 0.0f, -0.002f), g);
+  checkGroup(AL::Math::Velocity6D(0.3f, -0.4f, 0.2f, 0.0f, 0.0f, 0.0f), g);
+  checkGroup(AL::Math::Velocity6D(-1.0f, 0.5f, 0.7f, 1.2f, -1.5f, 0.6f), g);
+
+  // same exponential as velocityExponential
+  const AL::Math::Velocity6D v(0.3f, -0.4f, 0.2f, 0.5f, -0.2f, 1.1f);
+  EXPECT_TRUE(AL::Math::LieGroup<AL::Math::Transform>::exp(v).isNear(
+                AL::Math::velocityExponential(v), 0.00001f));
+}
+
+TEST(ALLieGroupTest, interpolate)
+{
+  const AL::Math::Transform a = AL::Math::transformFromRotZ(0.3f)*
+      AL::Math::Transform(0.1f, 0.2f, 0.3f);
+  const AL::Math::Transform b = AL::Math::transformFromRotY(-0.5f)*
+      AL::Math::Transform(0.4f, -0.2f, 0.5f);
+  EXPECT_TRUE(AL::Math::lieInterpolate(a, b, 0.0f).isNear(a, 0.0001f));
+  EXPECT_TRUE(AL::Math::lieInterpolate(a, b, 1.0f).isNear(b, 0.0001f));
+  EXPECT_TRUE(AL::Math::lieInterpolate(a, b, 0.3f).isNear(
+                AL::Math::transformMean(a, b, 0.3f), 0.0001f));
+
+  const AL::Math::Pose2D p(1.0f, 0.0f, 3.0f);
+  const AL::Math::Pose2D q(1.0f, 0.0f, -3.0f);
+  // through pi, not through 0
+  EXPECT_NEAR(std::fabs(AL::Math::lieInterpolate(p, q, 0.5f).theta),
+              4.0f*std::atan(1.0f), 0.0001f);
+}
+
+TEST(ALLieGroupTest, mean)
+{
+  // symmetric around a pose: the mean is this pose
+  const AL::Math::Pose2D center(1.0f, -2.0f, 3.0f);
+  std::vector<AL::Math::Pose2D> poses;
+  poses.push_back(center*AL::Math::Pose2D(0.2f, 0.1f, 0.3f));
+  poses.push_back(center*AL::Math::pose2DInverse(AL::Math::Pose2D(0.2f, 0.1f, 0.3f)));
+  poses.push_back(center*AL::Math::Pose2D(-0.1f, 0.3f, -0.2f));
+  poses.push_back(center*AL::Math::pose2DInverse(AL::Math::Pose2D(-0.1f, 0.3f, -0.2f)));
+  const AL::Math::Pose2D mean = AL::Math::lieMean(&poses[0], poses.size());
+  EXPECT_TRUE(mean.isNear(center, 0.0001f));
+
+  const AL::Math::Quaternion q = AL::Math::quaternionFromAngleAndAxisRotation(
+        0.8f, 0.0f, 0.6f, 0.8f);
+  std::vector<AL::Math::Quaternion> rotations;
+  for (unsigned int i=0; i<3; i++)
+  {
+    AL::Math::Position3D w;
+    w.x = (i == 0) ? 0.2f : 0.0f;
+    w.y = (i == 1) ? 0.2f : 0.0f;
+    w.z = (i == 2) ? 0.2f : 0.0f;
+    rotations.push_back(q*AL::Math::LieGroup<AL::Math::Quaternion>::exp(w));
+    rotations.push_back(q*AL::Math::LieGroup<AL::Math::Quaternion>::exp(w*-1.0f));
+  }
+  EXPECT_TRUE(AL::Math::lieMean(&rotations[0], rotations.size()).isNear(q, 0.0001f));
+
+  const AL::Math::Transform t = AL::Math::transformFromRotZ(0.4f);
+  EXPECT_TRUE(AL::Math::lieMean(&t, 1).isNear(t, 0.00001f));
+  EXPECT_THROW(AL::Math::lieMean(&t, 0), std::invalid_argument);
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/almatharray.h>
+#include <almath/tools/althreadpool.h>
+
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(ALMathArrayTest, toArray)
+{
+  // same layout as toVector and the std::vector<float> constructors
+  const AL::Math::Transform transform =
+      AL::Math::Transform::fromPosition(0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f);
+  const AL::Math::FloatArray<AL::Math::Transform>::type transformArray =
+      AL::Math::toArray(transform);
+  const std::vector<float> transformVector = transform.toVector();
+  EXPECT_EQ(12u, transformArray.size());
+  for (unsigned int i=0; i<12; i++)
+  {
+    EXPECT_EQ(transformVector[i], transformArray[i]);
+  }
+  EXPECT_TRUE(AL::Math::fromArray<AL::Math::Transform>(transformArray).isNear(
+                AL::Math::Transform(transformVector), 0.0f));
+  EXPECT_NEAR(AL::Math::determinant(transform),
+              AL::Math::determinant(transformArray.data()), 0.00001f);
+
+  const AL::Math::Quaternion quaternion(0.5f, 0.5f, -0.5f, 0.5f);
+  const AL::Math::FloatArray<AL::Math::Quaternion>::type quaternionArray =
+      AL::Math::toArray(quaternion);
+  EXPECT_EQ(quaternion.toVector(),
+            std::vector<float>(quaternionArray.begin(), quaternionArray.end()));
+
+  const AL::Math::Position6D position(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f);
+  const AL::Math::FloatArray<AL::Math::Position6D>::type positionArray =
+      AL::Math::toArray(position);
+  EXPECT_EQ(position.toVector(),
+            std::vector<float>(positionArray.begin(), positionArray.end()));
+  EXPECT_TRUE(AL::Math::fromArray<AL::Math::Position6D>(positionArray).isNear(position, 0.0f));
+
+  AL::Math::Rotation rotation;
+  const float rotationFloats[9] = {0.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+  AL::Math::fromFloats(rotationFloats, rotation);
+  EXPECT_TRUE(rotation.isNear(AL::Math::Rotation(
+                std::vector<float>(rotationFloats, rotationFloats + 9)), 0.0f));
+  float pose[3];
+  AL::Math::toFloats(AL::Math::Pose2D(0.1f, 0.2f, 0.3f), pose);
+  EXPECT_EQ(0.3f, pose[2]);
+}
+
+
+TEST(ALMathArrayTest, bulk)
+{
+  float buffer[20];
+  for (unsigned int i=0; i<20; i++)
+  {
+    buffer[i] = static_cast<float>(i);
+  }
+
+  // 6 poses in 20 floats, the last 2 floats are not read
+  AL::Math::Pose2D poses[8];
+  EXPECT_EQ(6u, AL::Math::fromFloats(buffer, 20, poses, 8));
+  for (unsigned int i=0; i<6; i++)
+  {
+    EXPECT_TRUE(poses[i].isNear(AL::Math::Pose2D(3.0f*i, 3.0f*i + 1.0f, 3.0f*i + 2.0f), 0.0f));
+  }
+  EXPECT_TRUE(poses[6].isNear(AL::Math::Pose2D(), 0.0f));
+  EXPECT_EQ(2u, AL::Math::fromFloats(buffer, 20, poses, 2));
+
+  float written[20] = {0.0f};
+  EXPECT_EQ(6u, AL::Math::toFloats(poses, 8, written, 20));
+  EXPECT_EQ(17.0f, written[17]);
+  EXPECT_EQ(0.0f, written[18]);
+  EXPECT_EQ(1u, AL::Math::toFloats(poses, 1, written, 20));
+  EXPECT_EQ(0u, AL::Math::toFloats(poses, 8, written, 2));
+
+  AL::Math::Transform transforms[2];
+  transforms[1] = AL::Math::Transform::fromPosition(0.1f, 0.2f, 0.3f);
+  float transformBuffer[24];
+  EXPECT_EQ(2u, AL::Math::toFloats(transforms, 2, transformBuffer, 24));
+  EXPECT_EQ(0.1f, transformBuffer[12 + 3]);
+  EXPECT_EQ(1.0f, AL::Math::determinant(transformBuffer + 12));
+}
+
+
+TEST(ALMathArrayTest, bulkParallel)
+{
+  std::vector<AL::Math::Transform> transforms(1000);
+  for (unsigned int i=0; i<transforms.size(); i++)
+  {
+    transforms[i] = AL::Math::Transform::from3DRotation(0.001f*i, 0.0f, -0.002f*i)*
+        AL::Math::Transform::fromPosition(0.01f*i, 0.0f, 1.0f);
+  }
+
+  // the same buffer for any number of threads and grain size, and the
+  // values which do not fit are not written
+  std::vector<float> buffer(12*transforms.size() + 5, 0.0f);
+  EXPECT_EQ(1000u, AL::Math::toFloats(&transforms[0], transforms.size(),
+                                      &buffer[0], buffer.size()));
+  AL::Math::ThreadPool pool(3);
+  const unsigned int grainSizes[] = {0, 1, 7, 5000};
+  for (unsigned int g=0; g<4; g++)
+  {
+    const AL::Math::ExecutionPolicy policy(pool, grainSizes[g]);
+    std::vector<float> parallelBuffer(buffer.size(), 0.0f);
+    EXPECT_EQ(1000u, AL::Math::toFloats(&transforms[0], transforms.size(),
+                                        &parallelBuffer[0], parallelBuffer.size(),
+                                        policy));
+    EXPECT_TRUE(buffer == parallelBuffer);
+    EXPECT_EQ(500u, AL::Math::toFloats(&transforms[0], transforms.size(),
+                                       &parallelBuffer[0], 12*500 + 11, policy));
+
+    std::vector<AL::Math::Transform> read(transforms.size() + 1);
+    EXPECT_EQ(1000u, AL::Math::fromFloats(&buffer[0], buffer.size(),
+                                          &read[0], read.size(), policy));
+    for (unsigned int i=0; i<transforms.size(); i++)
+    {
+      EXPECT_TRUE(read[i].isNear(transforms[i], 0.0f));
+    }
+    EXPECT_TRUE(read[1000].isNear(AL::Math::Transform(), 0.0f));
+  }
+  EXPECT_EQ(0u, AL::Math::fromFloats(&buffer[0], 11, &transforms[0], 1,
+                                     AL::Math::ExecutionPolicy()));
+}
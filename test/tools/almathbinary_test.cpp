@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/almathbinary.h>
+#include <almath/tools/altransformhelpers.h>
+
+#include <gtest/gtest.h>
+#include <climits>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+
+namespace
+{
+  template <class T>
+  void checkRoundTrip(const T& pValue)
+  {
+    unsigned char buffer[4*AL::Math::BinaryTraits<T>::nbFloats];
+    EXPECT_EQ(sizeof(buffer), AL::Math::toBinary(pValue, buffer));
+
+    T result;
+    EXPECT_EQ(sizeof(buffer), AL::Math::fromBinary(buffer, result));
+    // bit exact
+    EXPECT_EQ(0, std::memcmp(&pValue, &result, sizeof(T)));
+  }
+
+  // a stream which cannot seek, as a pipe
+  class PipeBuffer: public std::streambuf
+  {
+  public:
+    explicit PipeBuffer(const std::string& pData):
+      fData(pData)
+    {
+      char* begin = &fData[0];
+      setg(begin, begin, begin + fData.size());
+    }
+
+  private:
+    std::string fData;
+  };
+}
+
+
+TEST(ALMathBinaryTest, roundTrip)
+{
+  checkRoundTrip(AL::Math::Pose2D(0.1f, -0.2f, 0.3f));
+  checkRoundTrip(AL::Math::Position2D(0.1f, -0.2f));
+  checkRoundTrip(AL::Math::Position3D(0.1f, -0.2f, 0.3f));
+  checkRoundTrip(AL::Math::Position6D(0.1f, -0.2f, 0.3f, 0.4f, 0.5f, 0.6f));
+  checkRoundTrip(AL::Math::PositionAndVelocity(0.1f, -0.2f));
+  checkRoundTrip(AL::Math::Quaternion(0.5f, 0.5f, -0.5f, 0.5f));
+  checkRoundTrip(AL::Math::Rotation::fromRotZ(0.7f));
+  checkRoundTrip(AL::Math::Rotation3D(0.1f, -0.2f, 0.3f));
+  checkRoundTrip(AL::Math::Transform::fromRotY(0.3f)*
+                 AL::Math::Transform(0.1f, -0.2f, 0.3f));
+  checkRoundTrip(AL::Math::Velocity3D(0.1f, -0.2f, 0.3f));
+  checkRoundTrip(AL::Math::Velocity6D(0.1f, -0.2f, 0.3f, 0.4f, 0.5f, 0.6f));
+
+  AL::Math::TransformAndVelocity6D tv;
+  tv.T = AL::Math::Transform::fromRotX(0.2f);
+  tv.V = AL::Math::Velocity6D(0.1f, -0.2f, 0.3f, 0.4f, 0.5f, 0.6f);
+  checkRoundTrip(tv);
+}
+
+
+TEST(ALMathBinaryTest, layout)
+{
+  // little endian IEEE 754 floats, in the order of the members
+  unsigned char buffer[12];
+  AL::Math::toBinary(AL::Math::Pose2D(1.0f, -2.0f, 0.0f), buffer);
+  const unsigned char expected[12] = {
+    0x00, 0x00, 0x80, 0x3F,
+    0x00, 0x00, 0x00, 0xC0,
+    0x00, 0x00, 0x00, 0x00};
+  for (unsigned int i=0; i<12; i++)
+  {
+    EXPECT_EQ(expected[i], buffer[i]);
+  }
+}
+
+
+TEST(ALMathBinaryTest, bulk)
+{
+  std::vector<AL::Math::Transform> transforms;
+  for (unsigned int i=0; i<20; i++)
+  {
+    transforms.push_back(AL::Math::Transform::from3DRotation(0.1f*i, 0.2f, -0.1f*i));
+    transforms.back().r3_c4 = 0.01f*i;
+  }
+
+  std::vector<unsigned char> buffer(48*transforms.size());
+  EXPECT_EQ(buffer.size(), AL::Math::toBinary(&transforms[0],
+                                              transforms.size(),
+                                              &buffer[0]));
+
+  std::vector<AL::Math::Transform> result(transforms.size());
+  EXPECT_EQ(buffer.size(), AL::Math::fromBinary(&buffer[0],
+                                                result.size(),
+                                                &result[0]));
+  for (unsigned int i=0; i<transforms.size(); i++)
+  {
+    EXPECT_TRUE(transforms[i].isNear(result[i], 0.0f));
+  }
+
+  EXPECT_EQ(0u, AL::Math::toBinary(&transforms[0], 0, &buffer[0]));
+}
+
+
+TEST(ALMathBinaryTest, stream)
+{
+  std::vector<AL::Math::Pose2D> poses;
+  for (unsigned int i=0; i<100; i++)
+  {
+    poses.push_back(AL::Math::Pose2D(0.01f*i, -0.02f*i, 0.03f*i));
+  }
+
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  AL::Math::writeBinary(stream, poses);
+  EXPECT_EQ(AL::Math::BINARY_HEADER_SIZE + 12*poses.size(), stream.str().size());
+
+  std::vector<AL::Math::Pose2D> result;
+  AL::Math::readBinary(stream, result);
+  ASSERT_EQ(poses.size(), result.size());
+  for (unsigned int i=0; i<poses.size(); i++)
+  {
+    EXPECT_TRUE(poses[i].isNear(result[i], 0.0f));
+  }
+
+  // empty vector
+  std::stringstream empty(std::ios::in | std::ios::out | std::ios::binary);
+  AL::Math::writeBinary(empty, std::vector<AL::Math::Position3D>());
+  std::vector<AL::Math::Position3D> positions(3);
+  AL::Math::readBinary(empty, positions);
+  EXPECT_TRUE(positions.empty());
+}
+
+
+TEST(ALMathBinaryTest, badStream)
+{
+  std::vector<AL::Math::Pose2D> poses(10, AL::Math::Pose2D(0.1f, 0.2f, 0.3f));
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  AL::Math::writeBinary(stream, poses);
+  const std::string data = stream.str();
+
+  // wrong type
+  std::vector<AL::Math::Position3D> positions;
+  std::istringstream wrongType(data);
+  EXPECT_THROW(AL::Math::readBinary(wrongType, positions), std::runtime_error);
+
+  // bad magic
+  std::string badMagic = data;
+  badMagic[0] = 'X';
+  std::vector<AL::Math::Pose2D> result;
+  std::istringstream badMagicStream(badMagic);
+  EXPECT_THROW(AL::Math::readBinary(badMagicStream, result), std::runtime_error);
+
+  // future version
+  std::string badVersion = data;
+  badVersion[4] = static_cast<char>(AL::Math::BINARY_FORMAT_VERSION + 1);
+  std::istringstream badVersionStream(badVersion);
+  EXPECT_THROW(AL::Math::readBinary(badVersionStream, result), std::runtime_error);
+
+  // truncated
+  std::istringstream truncated(data.substr(0, data.size() - 1));
+  EXPECT_THROW(AL::Math::readBinary(truncated, result), std::runtime_error);
+  EXPECT_TRUE(result.empty());
+
+  std::istringstream tooShort(data.substr(0, 5));
+  EXPECT_THROW(AL::Math::readBinary(tooShort, result), std::runtime_error);
+}
+
+
+TEST(ALMathBinaryTest, badCount)
+{
+  std::vector<AL::Math::Transform> transforms(10);
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  AL::Math::writeBinary(stream, transforms);
+  std::string data = stream.str();
+
+  // a stream which cannot seek is read as well
+  {
+    PipeBuffer buffer(data);
+    std::istream pipe(&buffer);
+    std::vector<AL::Math::Transform> result;
+    AL::Math::readBinary(pipe, result);
+    EXPECT_EQ(10u, result.size());
+  }
+
+  // the count of a corrupted header is rejected before the allocation
+  // of its 0xFFFFFFFF transforms
+  data[8] = data[9] = data[10] = data[11] = static_cast<char>(0xFF);
+  std::vector<AL::Math::Transform> result(3);
+  std::istringstream huge(data);
+  EXPECT_THROW(AL::Math::readBinary(huge, result), std::runtime_error);
+  EXPECT_TRUE(result.empty());
+
+  PipeBuffer buffer(data);
+  std::istream hugePipe(&buffer);
+  EXPECT_THROW(AL::Math::readBinary(hugePipe, result), std::runtime_error);
+  EXPECT_TRUE(result.empty());
+
+  // the number of bytes does not fit in the unsigned int returned
+  unsigned char bytes[48];
+  EXPECT_THROW(AL::Math::toBinary(&transforms[0], UINT_MAX/48 + 1, bytes),
+               std::invalid_argument);
+  EXPECT_THROW(AL::Math::fromBinary(bytes, UINT_MAX/48 + 1, &transforms[0]),
+               std::invalid_argument);
+}
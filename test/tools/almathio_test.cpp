@@ -0,0 +1,431 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/almathio.h>
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <string>
+
+namespace
+{
+  std::string formatFloat(
+    const float& pValue,
+    const int&   pPrecision = AL::Math::TEXT_PRECISION_SHORTEST)
+  {
+    char buffer[32];
+    const unsigned int length = AL::Math::formatFloat(pValue, buffer,
+                                                      sizeof(buffer), pPrecision);
+    EXPECT_EQ(std::strlen(buffer), length);
+    return buffer;
+  }
+
+  template <class T>
+  std::string format(
+    const T&                     pValue,
+    const AL::Math::TEXT_FORMAT& pFormat,
+    const int&                   pPrecision = AL::Math::TEXT_PRECISION_SHORTEST)
+  {
+    char buffer[512];
+    AL::Math::format(pValue, buffer, sizeof(buffer), pFormat, pPrecision);
+    return buffer;
+  }
+}
+
+
+TEST(ALMathIOTest, formatFloat)
+{
+  EXPECT_EQ("0", formatFloat(0.0f));
+  EXPECT_EQ("-0", formatFloat(-0.0f));
+  EXPECT_EQ("0.1", formatFloat(0.1f));
+  EXPECT_EQ("-0.2", formatFloat(-0.2f));
+  EXPECT_EQ("1", formatFloat(1.0f));
+  EXPECT_EQ("123456.7", formatFloat(123456.7f));
+  EXPECT_EQ("100000000", formatFloat(1e8f));
+  EXPECT_EQ("1e+10", formatFloat(1e10f));
+  EXPECT_EQ("0.0001", formatFloat(1e-4f));
+  EXPECT_EQ("1e-05", formatFloat(1e-5f));
+  EXPECT_EQ("3.4028235e+38", formatFloat(std::numeric_limits<float>::max()));
+  EXPECT_EQ("1e-45", formatFloat(std::numeric_limits<float>::denorm_min()));
+  EXPECT_EQ("nan", formatFloat(std::numeric_limits<float>::quiet_NaN()));
+  EXPECT_EQ("inf", formatFloat(std::numeric_limits<float>::infinity()));
+  EXPECT_EQ("-inf", formatFloat(-std::numeric_limits<float>::infinity()));
+
+  // precision
+  EXPECT_EQ("0.1", formatFloat(0.1f, 6));
+  EXPECT_EQ("3.14", formatFloat(3.14159f, 3));
+  EXPECT_EQ("0.12", formatFloat(0.125f, 2));
+  EXPECT_EQ("1e+03", formatFloat(999.9f, 2));
+  EXPECT_EQ("0.100000001", formatFloat(0.1f, 9));
+  EXPECT_EQ("0.100000001", formatFloat(0.1f, 17));
+}
+
+
+TEST(ALMathIOTest, shortestRoundTrip)
+{
+  // the shortest text is read back as the same float
+  unsigned int bits = 0x00000001u;
+  while (bits < 0x7F800000u)
+  {
+    float value;
+    std::memcpy(&value, &bits, sizeof(float));
+    const std::string text = formatFloat(value);
+    EXPECT_EQ(value, std::strtof(text.c_str(), 0)) << text;
+    if (text.find_first_of("123456789") != std::string::npos)
+    {
+      // no shorter text is read back as the same float
+      const std::string shorter = formatFloat(value, 1);
+      const int nbDigits = static_cast<int>(
+            text.find('e') == std::string::npos ?
+              text.size() : text.find('e'));
+      EXPECT_LE(static_cast<int>(shorter.size()), nbDigits + 5);
+    }
+    bits += 0x00012345u;
+  }
+}
+
+
+TEST(ALMathIOTest, format)
+{
+  const AL::Math::Pose2D pose(0.1f, -0.2f, 0.0f);
+  EXPECT_EQ("{\"x\":0.1,\"y\":-0.2,\"theta\":0}",
+            format(pose, AL::Math::TEXT_FORMAT_JSON));
+  EXPECT_EQ("0.1,-0.2,0", format(pose, AL::Math::TEXT_FORMAT_CSV));
+  EXPECT_EQ("{x: +0.100000, y:-0.200000, theta:+0.00000}",
+            format(pose, AL::Math::TEXT_FORMAT_STREAM, 6));
+  EXPECT_EQ("+0.100000 -0.200000 +0.00000 ",
+            format(pose, AL::Math::TEXT_FORMAT_SPACE_SEPARATED, 6));
+  EXPECT_EQ("{x: +0.1, y:-0.2, theta:+0}",
+            format(pose, AL::Math::TEXT_FORMAT_STREAM));
+
+  AL::Math::TransformAndVelocity6D tv;
+  tv.V.xd = 0.5f;
+  EXPECT_EQ("{\"T\":{\"r1_c1\":1,\"r1_c2\":0,\"r1_c3\":0,\"r1_c4\":0,"
+            "\"r2_c1\":0,\"r2_c2\":1,\"r2_c3\":0,\"r2_c4\":0,"
+            "\"r3_c1\":0,\"r3_c2\":0,\"r3_c3\":1,\"r3_c4\":0},"
+            "\"V\":{\"xd\":0.5,\"yd\":0,\"zd\":0,\"wxd\":0,\"wyd\":0,\"wzd\":0}}",
+            format(tv, AL::Math::TEXT_FORMAT_JSON));
+
+  AL::Math::Position3D nan(std::numeric_limits<float>::quiet_NaN());
+  EXPECT_EQ("{\"x\":null,\"y\":null,\"z\":null}",
+            format(nan, AL::Math::TEXT_FORMAT_JSON));
+
+  char header[64];
+  AL::Math::formatCsvHeader<AL::Math::Velocity6D>(header, sizeof(header));
+  EXPECT_STREQ("xd,yd,zd,wxd,wyd,wzd\n", header);
+}
+
+
+TEST(ALMathIOTest, buffer)
+{
+  const AL::Math::Position2D position(0.25f, 1.5f);
+  const std::string expected = "{\"x\":0.25,\"y\":1.5}";
+
+  // the length is returned even if the buffer is too small
+  EXPECT_EQ(expected.size(), AL::Math::format(position, 0, 0));
+
+  char buffer[8];
+  std::memset(buffer, 'X', sizeof(buffer));
+  EXPECT_EQ(expected.size(), AL::Math::format(position, buffer, sizeof(buffer)));
+  EXPECT_EQ(expected.substr(0, 7), std::string(buffer));
+
+  // arrays
+  std::vector<AL::Math::Position2D> positions(3, position);
+  char text[256];
+  AL::Math::formatArray(&positions[0], positions.size(), text, sizeof(text));
+  EXPECT_EQ("[" + expected + "," + expected + "," + expected + "]",
+            std::string(text));
+  AL::Math::formatArray(&positions[0], positions.size(), text, sizeof(text),
+                        AL::Math::TEXT_FORMAT_CSV);
+  EXPECT_STREQ("0.25,1.5\n0.25,1.5\n0.25,1.5\n", text);
+  AL::Math::formatArray(&positions[0], 0, text, sizeof(text));
+  EXPECT_STREQ("[]", text);
+}
+
+
+TEST(ALMathIOTest, stream)
+{
+  // the stream operators keep their format, with the precision of the stream
+  std::ostringstream stream;
+  stream << AL::Math::Position3D(0.1f, -2.0f, 1234567.0f);
+  EXPECT_EQ("{x: +0.100000, y:-2.00000, z:+1.23457e+06}", stream.str());
+
+  stream.str("");
+  stream.precision(3);
+  stream << AL::Math::Velocity6D(0.5f, 0.0f, -0.25f, 1.0f, 2.0f, 3.0f);
+  EXPECT_EQ("{xd: +0.500 ,yd: +0.00 ,zd: -0.250 ,wxd: +1.00 ,wyd: +2.00 ,wzd: +3.00}",
+            stream.str());
+
+  stream.str("");
+  stream.precision(6);
+  stream << AL::Math::Transform();
+  EXPECT_EQ("+1.00000 +0.00000 +0.00000 +0.00000\n"
+            "+0.00000 +1.00000 +0.00000 +0.00000\n"
+            "+0.00000 +0.00000 +1.00000 +0.00000\n"
+            "0.0 0.0 0.0 1.0\n", stream.str());
+
+  EXPECT_EQ("+1.00000 +0.00000 +0.00000 +0.00000 "
+            "+0.00000 +1.00000 +0.00000 +0.00000 "
+            "+0.00000 +0.00000 +1.00000 +0.00000 "
+            "0.0 0.0 0.0 1.0 ", AL::Math::toSpaceSeparated(AL::Math::Transform()));
+}
+
+
+TEST(ALMathIOTest, streamFlags)
+{
+  const AL::Math::Position2D position(1234567.0f, 0.5f);
+
+  // the float field of the stream is used
+  std::ostringstream stream;
+  stream << std::fixed << std::setprecision(2) << position;
+  EXPECT_EQ("{x: +1234567.00, y:+0.50}", stream.str());
+
+  stream.str("");
+  stream << std::scientific << std::setprecision(3) << position;
+  EXPECT_EQ("{x: +1.235e+06, y:+5.000e-01}", stream.str());
+
+  stream.str("");
+  stream << std::uppercase << position << std::nouppercase;
+  EXPECT_EQ("{x: +1.235E+06, y:+5.000E-01}", stream.str());
+
+  // the width pads the whole value, and only it
+  const AL::Math::Position2D small(1.0f, 2.0f);
+  stream.str("");
+  stream.unsetf(std::ios_base::floatfield);
+  stream << std::setprecision(6);
+  stream << "[" << std::setw(30) << small << "][";
+  EXPECT_EQ("[     {x: +1.00000, y:+2.00000}][", stream.str());
+
+  stream.str("");
+  stream << "[" << std::left << std::setfill('.') << std::setw(30) << small << "][";
+  EXPECT_EQ("[{x: +1.00000, y:+2.00000}.....][", stream.str());
+  EXPECT_EQ(0, stream.width());
+
+  stream.str("");
+  stream << std::setw(4) << small;
+  EXPECT_EQ("{x: +1.00000, y:+2.00000}", stream.str());
+}
+
+
+namespace
+{
+  AL::Math::ParseResult parseFloat(
+    const std::string& pText,
+    float&             pValue)
+  {
+    return AL::Math::parseFloat(pText.data(), pText.data() + pText.size(), pValue);
+  }
+
+  template <class T>
+  void checkParse(const T& pValue)
+  {
+    const AL::Math::TEXT_FORMAT formats[] = {
+      AL::Math::TEXT_FORMAT_STREAM, AL::Math::TEXT_FORMAT_SPACE_SEPARATED,
+      AL::Math::TEXT_FORMAT_JSON, AL::Math::TEXT_FORMAT_CSV};
+    for (unsigned int i=0; i<4; i++)
+    {
+      const std::string text = format(pValue, formats[i]);
+      T result;
+      const AL::Math::ParseResult parsed = AL::Math::parse(
+            text.data(), text.data() + text.size(), result, formats[i]);
+      EXPECT_EQ(AL::Math::PARSE_OK, parsed.error) << text;
+      // the trailing whitespace is not parsed
+      EXPECT_EQ(std::string::npos, std::string(
+                  parsed.ptr, text.data() + text.size()).find_first_not_of(" \n"));
+      EXPECT_EQ(0, std::memcmp(&pValue, &result, sizeof(T))) << text;
+    }
+  }
+}
+
+
+TEST(ALMathIOTest, parseFloat)
+{
+  float value = 0.0f;
+  EXPECT_EQ(AL::Math::PARSE_OK, parseFloat("0.1", value).error);
+  EXPECT_EQ(0.1f, value);
+  EXPECT_EQ(AL::Math::PARSE_OK, parseFloat("+1.23457e+06", value).error);
+  EXPECT_EQ(1234570.0f, value);
+  EXPECT_EQ(AL::Math::PARSE_OK, parseFloat("-.5", value).error);
+  EXPECT_EQ(-0.5f, value);
+  EXPECT_EQ(AL::Math::PARSE_OK, parseFloat("1.e-05", value).error);
+  EXPECT_EQ(1e-5f, value);
+  EXPECT_EQ(AL::Math::PARSE_OK, parseFloat("3.4028235e+38", value).error);
+  EXPECT_EQ(std::numeric_limits<float>::max(), value);
+  EXPECT_EQ(AL::Math::PARSE_OK, parseFloat("0.000000000000000000001234567890123456789", value).error);
+  EXPECT_EQ(1.23456789e-21f, value);
+  EXPECT_EQ(AL::Math::PARSE_OK, parseFloat("-inf", value).error);
+  EXPECT_EQ(-std::numeric_limits<float>::infinity(), value);
+  EXPECT_EQ(AL::Math::PARSE_OK, parseFloat("NaN", value).error);
+  EXPECT_NE(value, value);
+
+  // the number stops at the first character which is not part of it
+  const std::string text = "12.5e3x";
+  AL::Math::ParseResult result = parseFloat(text, value);
+  EXPECT_EQ(AL::Math::PARSE_OK, result.error);
+  EXPECT_EQ(12500.0f, value);
+  EXPECT_EQ(text.data() + 6, result.ptr);
+  const std::string noExponent = "2e+";
+  result = parseFloat(noExponent, value);
+  EXPECT_EQ(2.0f, value);
+  EXPECT_EQ(noExponent.data() + 1, result.ptr);
+
+  // errors
+  value = 7.0f;
+  const std::string invalid = "-.e5";
+  result = parseFloat(invalid, value);
+  EXPECT_EQ(AL::Math::PARSE_INVALID_NUMBER, result.error);
+  EXPECT_EQ(invalid.data(), result.ptr);
+  EXPECT_EQ(AL::Math::PARSE_INVALID_NUMBER, parseFloat("", value).error);
+  EXPECT_EQ(AL::Math::PARSE_INVALID_NUMBER, parseFloat(" 1", value).error);
+  EXPECT_EQ(AL::Math::PARSE_OUT_OF_RANGE, parseFloat("3.5e38", value).error);
+  EXPECT_EQ(AL::Math::PARSE_OUT_OF_RANGE, parseFloat("1e-50", value).error);
+  EXPECT_EQ(AL::Math::PARSE_OUT_OF_RANGE, parseFloat("1e999999999", value).error);
+  EXPECT_EQ(7.0f, value);
+  EXPECT_EQ(AL::Math::PARSE_OK, parseFloat("0e999999999", value).error);
+  EXPECT_EQ(0.0f, value);
+}
+
+
+TEST(ALMathIOTest, parseRoundTrip)
+{
+  // every float written by formatFloat is read back exactly
+  unsigned int bits = 0x00000001u;
+  while (bits < 0x7F800000u)
+  {
+    float value;
+    std::memcpy(&value, &bits, sizeof(float));
+    float result = 0.0f;
+    const std::string text = formatFloat(value);
+    EXPECT_EQ(AL::Math::PARSE_OK, parseFloat(text, result).error);
+    EXPECT_EQ(value, result) << text;
+    bits += 0x00012345u;
+  }
+
+  checkParse(AL::Math::Pose2D(0.1f, -0.2f, 3.0f));
+  checkParse(AL::Math::Position2D(0.1f, -2e-7f));
+  checkParse(AL::Math::Position3D(0.1f, -0.2f, 1e20f));
+  checkParse(AL::Math::Position6D(0.1f, -0.2f, 0.3f, 0.4f, 0.5f, 0.6f));
+  checkParse(AL::Math::PositionAndVelocity(0.1f, -0.2f));
+  checkParse(AL::Math::Quaternion(0.5f, 0.5f, -0.5f, 0.5f));
+  checkParse(AL::Math::Rotation::fromRotZ(0.7f));
+  checkParse(AL::Math::Rotation3D(0.1f, -0.2f, 0.3f));
+  checkParse(AL::Math::Transform::fromRotY(0.3f)*
+             AL::Math::Transform(0.1f, -0.2f, 0.3f));
+  checkParse(AL::Math::Velocity3D(0.1f, -0.2f, 0.3f));
+  checkParse(AL::Math::Velocity6D(0.1f, -0.2f, 0.3f, 0.4f, 0.5f, 0.6f));
+  AL::Math::TransformAndVelocity6D tv;
+  tv.T = AL::Math::Transform::fromRotX(0.2f);
+  tv.V = AL::Math::Velocity6D(0.1f, -0.2f, 0.3f, 0.4f, 0.5f, 0.6f);
+  checkParse(tv);
+}
+
+
+TEST(ALMathIOTest, parse)
+{
+  // the output of the stream operators and of toSpaceSeparated
+  std::ostringstream stream;
+  stream << AL::Math::Pose2D(0.1f, -0.2f, 0.3f);
+  std::string text = stream.str();
+  AL::Math::Pose2D pose;
+  EXPECT_EQ(AL::Math::PARSE_OK, AL::Math::parse(
+              text.data(), text.data() + text.size(), pose,
+              AL::Math::TEXT_FORMAT_STREAM).error);
+  EXPECT_TRUE(pose.isNear(AL::Math::Pose2D(0.1f, -0.2f, 0.3f), 1e-6f));
+
+  text = AL::Math::toSpaceSeparated(AL::Math::Position6D(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f));
+  AL::Math::Position6D position;
+  EXPECT_EQ(AL::Math::PARSE_OK, AL::Math::parse(
+              text.data(), text.data() + text.size(), position,
+              AL::Math::TEXT_FORMAT_SPACE_SEPARATED).error);
+  EXPECT_FLOAT_EQ(6.0f, position.wz);
+
+  // free whitespace, null
+  text = " { \"x\" : 1.5 ,\n \"y\":null }";
+  AL::Math::Position2D position2D;
+  EXPECT_EQ(AL::Math::PARSE_OK, AL::Math::parse(
+              text.data(), text.data() + text.size(), position2D).error);
+  EXPECT_FLOAT_EQ(1.5f, position2D.x);
+  EXPECT_NE(position2D.y, position2D.y);
+
+  // errors
+  text = "{\"x\":1.5,\"z\":2}";
+  position2D = AL::Math::Position2D(3.0f, 4.0f);
+  AL::Math::ParseResult result = AL::Math::parse(
+        text.data(), text.data() + text.size(), position2D);
+  EXPECT_EQ(AL::Math::PARSE_UNEXPECTED_TEXT, result.error);
+  EXPECT_EQ(text.data() + 10, result.ptr);
+  EXPECT_FLOAT_EQ(3.0f, position2D.x);
+
+  text = "1.5,abc";
+  result = AL::Math::parse(text.data(), text.data() + text.size(),
+                           position2D, AL::Math::TEXT_FORMAT_CSV);
+  EXPECT_EQ(AL::Math::PARSE_INVALID_NUMBER, result.error);
+  EXPECT_EQ(text.data() + 4, result.ptr);
+
+  text = "1.5 2.5.3";
+  result = AL::Math::parse(text.data(), text.data() + text.size(),
+                           position2D, AL::Math::TEXT_FORMAT_SPACE_SEPARATED);
+  EXPECT_EQ(AL::Math::PARSE_UNEXPECTED_TEXT, result.error);
+
+  text = "{\"x\":1";
+  result = AL::Math::parse(text.data(), text.data() + text.size(), position2D);
+  EXPECT_EQ(AL::Math::PARSE_UNEXPECTED_TEXT, result.error);
+  EXPECT_EQ(text.data() + text.size(), result.ptr);
+}
+
+
+TEST(ALMathIOTest, parseArray)
+{
+  std::vector<AL::Math::Pose2D> poses;
+  for (unsigned int i=0; i<1000; i++)
+  {
+    poses.push_back(AL::Math::Pose2D(0.01f*i, -0.001f*i, 0.5f));
+  }
+
+  const AL::Math::TEXT_FORMAT formats[] = {
+    AL::Math::TEXT_FORMAT_STREAM, AL::Math::TEXT_FORMAT_SPACE_SEPARATED,
+    AL::Math::TEXT_FORMAT_JSON, AL::Math::TEXT_FORMAT_CSV};
+  std::vector<char> text(100000);
+  std::vector<AL::Math::Pose2D> result;
+  for (unsigned int i=0; i<4; i++)
+  {
+    unsigned int length = 0;
+    if (formats[i] == AL::Math::TEXT_FORMAT_CSV)
+    {
+      length = AL::Math::formatCsvHeader<AL::Math::Pose2D>(&text[0], text.size());
+    }
+    length += AL::Math::formatArray(&poses[0], poses.size(), &text[length],
+                                    text.size() - length, formats[i]);
+    ASSERT_LT(length, text.size());
+
+    result.clear();
+    const AL::Math::ParseResult parsed = AL::Math::parseArray(
+          &text[0], &text[0] + length, result, formats[i]);
+    EXPECT_EQ(AL::Math::PARSE_OK, parsed.error);
+    EXPECT_EQ(&text[0] + length, parsed.ptr);
+    ASSERT_EQ(poses.size(), result.size());
+    EXPECT_EQ(0, std::memcmp(&poses[0], &result[0],
+                             poses.size()*sizeof(AL::Math::Pose2D)));
+  }
+
+  // the line of an error
+  const std::string csv = "x,y,theta\n1,2,3\r\n4,5,6\n7,8\n9,10,11\n";
+  result.clear();
+  const AL::Math::ParseResult parsed = AL::Math::parseArray(
+        csv.data(), csv.data() + csv.size(), result, AL::Math::TEXT_FORMAT_CSV);
+  EXPECT_EQ(AL::Math::PARSE_UNEXPECTED_TEXT, parsed.error);
+  EXPECT_EQ(5u, AL::Math::getLineNumber(csv.data(), parsed.ptr));
+  EXPECT_EQ(2u, result.size());
+
+  const std::string json = "[ ]";
+  result.clear();
+  EXPECT_EQ(AL::Math::PARSE_OK, AL::Math::parseArray(
+              json.data(), json.data() + json.size(), result).error);
+  EXPECT_TRUE(result.empty());
+}
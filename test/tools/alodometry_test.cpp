@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alodometry.h>
+#include <almath/tools/altransformhelpers.h>
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+TEST(ALOdometryTest, pose2D)
+{
+  // 100 s on a circle of radius 0.4 m, in steps of 1 ms
+  const AL::Math::Pose2D velocity(0.2f, 0.0f, 0.5f);
+  const unsigned int nbSteps = 100000;
+  const float dt = 0.001f;
+  const double time = nbSteps*static_cast<double>(dt);
+  const AL::Math::Pose2D expected(static_cast<float>(0.4*std::sin(0.5*time)),
+                                  static_cast<float>(0.4*(1.0 - std::cos(0.5*time))),
+                                  static_cast<float>(std::remainder(0.5*time, 8.0*std::atan(1.0))));
+
+  AL::Math::Pose2DIntegrator exponential;
+  AL::Math::Pose2DIntegrator midpoint(AL::Math::ODOMETRY_INTEGRATION_MIDPOINT);
+  AL::Math::Pose2DIntegrator euler(AL::Math::ODOMETRY_INTEGRATION_EULER);
+  AL::Math::Pose2D chain;
+  for (unsigned int i=0; i<nbSteps; i++)
+  {
+    exponential.addVelocity(velocity, dt);
+    midpoint.addVelocity(velocity, dt);
+    euler.addVelocity(velocity, dt);
+    chain *= velocity*dt;
+  }
+  EXPECT_TRUE(exponential.getPose().isNear(expected, 0.00001f));
+  EXPECT_TRUE(midpoint.getPose().isNear(expected, 0.0001f));
+  EXPECT_TRUE(euler.getPose().isNear(expected, 0.001f));
+  // a chain of float increments drifts
+  EXPECT_GT(std::fabs(chain.x - expected.x),
+            10.0f*std::fabs(exponential.getPose().x - expected.x));
+
+  // timestamped velocities, the first one starts the integration
+  std::vector<AL::Math::Pose2D> velocities(11, velocity);
+  std::vector<double> times;
+  for (unsigned int i=0; i<11; i++)
+  {
+    times.push_back(1000.0 + 0.01*i);
+  }
+  AL::Math::Pose2DIntegrator timed;
+  timed.addVelocities(&velocities[0], &times[0], 6);
+  timed.addVelocities(&velocities[6], &times[6], 5);
+  AL::Math::Pose2DIntegrator constant;
+  constant.addVelocity(velocity, 0.1f);
+  EXPECT_TRUE(timed.getPose().isNear(constant.getPose(), 0.000001f));
+
+  // the pose is unchanged on error
+  const AL::Math::Pose2D before = timed.getPose();
+  times[1] = times[0] - 1.0;
+  EXPECT_THROW(timed.addVelocities(&velocities[0], &times[0], 2), std::invalid_argument);
+  EXPECT_TRUE(timed.getPose().isNear(before, 0.0f));
+
+  timed.reset(AL::Math::Pose2D(1.0f, 2.0f, 0.0f));
+  timed.addIncrement(AL::Math::Pose2D(0.5f, 0.0f, 0.1f));
+  EXPECT_TRUE(timed.getPose().isNear(AL::Math::Pose2D(1.5f, 2.0f, 0.1f)));
+}
+
+
+TEST(ALOdometryTest, transform)
+{
+  const AL::Math::Velocity6D velocity(0.2f, 0.05f, -0.1f, 0.3f, -0.2f, 0.5f);
+
+  // one step: same as velocityExponential
+  AL::Math::TransformIntegrator exponential;
+  exponential.addVelocity(velocity, 0.5f);
+  EXPECT_TRUE(exponential.getTransform().isNear(
+                AL::Math::velocityExponential(velocity*0.5f), 0.00001f));
+
+  // a constant velocity: exp(n*v*dt) = exp(v*dt)^n
+  exponential.reset();
+  AL::Math::TransformIntegrator midpoint(AL::Math::ODOMETRY_INTEGRATION_MIDPOINT);
+  AL::Math::TransformIntegrator euler(AL::Math::ODOMETRY_INTEGRATION_EULER);
+  for (unsigned int i=0; i<20000; i++)
+  {
+    exponential.addVelocity(velocity, 0.001f);
+    midpoint.addVelocity(velocity, 0.001f);
+    euler.addVelocity(velocity, 0.001f);
+  }
+  const AL::Math::Transform expected = AL::Math::velocityExponential(velocity*20.0f);
+  EXPECT_TRUE(exponential.getTransform().isNear(expected, 0.00001f));
+  EXPECT_TRUE(midpoint.getTransform().isNear(expected, 0.0001f));
+  EXPECT_TRUE(euler.getTransform().isNear(expected, 0.001f));
+  EXPECT_NEAR(1.0f, exponential.getTransform().determinant(), 0.00001f);
+
+  // timestamped velocities
+  const AL::Math::Velocity6D velocities[3] = {velocity, velocity, velocity};
+  const double times[3] = {10.0, 10.25, 10.5};
+  AL::Math::TransformIntegrator timed;
+  timed.addVelocities(velocities, times, 3);
+  EXPECT_TRUE(timed.getTransform().isNear(
+                AL::Math::velocityExponential(velocity*0.5f), 0.00001f));
+
+  const AL::Math::Transform increment =
+      AL::Math::Transform::fromPosition(0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f);
+  timed.reset(increment);
+  timed.addIncrement(increment);
+  EXPECT_TRUE(timed.getTransform().isNear(increment*increment, 0.00001f));
+}
+
+
+TEST(ALOdometryTest, transformIncrements)
+{
+  // a long chain of float increments keeps an orthonormal rotation
+  const AL::Math::Transform increment =
+      AL::Math::Transform::from3DRotation(0.0007f, 0.0003f, 0.001f);
+  AL::Math::TransformIntegrator integrator;
+  for (unsigned int i=0; i<1000000; i++)
+  {
+    integrator.addIncrement(increment);
+  }
+  const AL::Math::Transform result = integrator.getTransform();
+  EXPECT_NEAR(1.0f, result.determinant(), 0.00001f);
+  EXPECT_NEAR(1.0f, result.r1_c1*result.r1_c1 + result.r1_c2*result.r1_c2 +
+              result.r1_c3*result.r1_c3, 0.00001f);
+  EXPECT_TRUE(result.isTransform(0.00001f));
+}
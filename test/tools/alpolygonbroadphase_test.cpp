@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alpolygonbroadphase.h>
+#include <almath/tools/avoidfootcollision.h>
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+  std::vector<AL::Math::Position2D> makeSquare(
+    const float& pX,
+    const float& pY,
+    const float& pHalfSize)
+  {
+    std::vector<AL::Math::Position2D> square;
+    square.push_back(AL::Math::Position2D(pX + pHalfSize, pY + pHalfSize));
+    square.push_back(AL::Math::Position2D(pX - pHalfSize, pY + pHalfSize));
+    square.push_back(AL::Math::Position2D(pX - pHalfSize, pY - pHalfSize));
+    square.push_back(AL::Math::Position2D(pX + pHalfSize, pY - pHalfSize));
+    return square;
+  }
+}
+
+
+TEST(PolygonBroadPhaseTest, insertRemove)
+{
+  AL::Math::PolygonBroadPhase broadPhase(0.0f);
+  EXPECT_EQ(0u, broadPhase.size());
+  EXPECT_EQ(0, broadPhase.getHeight());
+
+  std::vector<int> ids;
+  for (unsigned int i=0; i<16; i++)
+  {
+    for (unsigned int j=0; j<16; j++)
+    {
+      ids.push_back(broadPhase.insert(makeSquare(0.1f*i, 0.1f*j, 0.02f)));
+    }
+  }
+  EXPECT_EQ(256u, broadPhase.size());
+  // the tree stays balanced when the polygons are inserted in order
+  EXPECT_LE(broadPhase.getHeight(), 16);
+
+  std::vector<int> found;
+  broadPhase.queryBox(AL::Math::Position2D(0.25f, 0.25f),
+                      AL::Math::Position2D(0.45f, 0.45f), found);
+  EXPECT_EQ(4u, found.size());
+
+  for (unsigned int i=0; i<ids.size(); i+=2)
+  {
+    broadPhase.remove(ids[i]);
+  }
+  EXPECT_EQ(128u, broadPhase.size());
+  EXPECT_LE(broadPhase.getHeight(), 16);
+  EXPECT_THROW(broadPhase.getPolygon(ids[0]), std::invalid_argument);
+  EXPECT_THROW(broadPhase.remove(ids[0]), std::invalid_argument);
+  EXPECT_THROW(broadPhase.remove(-1), std::invalid_argument);
+
+  broadPhase.queryBox(AL::Math::Position2D(0.25f, 0.25f),
+                      AL::Math::Position2D(0.45f, 0.45f), found);
+  EXPECT_EQ(2u, found.size());
+
+  // the ids of the removed polygons are given again
+  const int id = broadPhase.insert(makeSquare(5.0f, 5.0f, 0.1f));
+  EXPECT_LT(id, static_cast<int>(2*ids.size()));
+  EXPECT_FLOAT_EQ(5.1f, broadPhase.getPolygon(id)[0].x);
+
+  for (unsigned int i=1; i<ids.size(); i+=2)
+  {
+    broadPhase.remove(ids[i]);
+  }
+  broadPhase.remove(id);
+  EXPECT_EQ(0u, broadPhase.size());
+  EXPECT_EQ(0, broadPhase.getHeight());
+}
+
+
+TEST(PolygonBroadPhaseTest, queries)
+{
+  AL::Math::PolygonBroadPhase broadPhase;
+
+  // overlapping squares along a spiral
+  std::vector<std::vector<AL::Math::Position2D> > polygons;
+  std::vector<int> ids;
+  for (unsigned int i=0; i<60; i++)
+  {
+    const float r = 0.02f*i;
+    polygons.push_back(makeSquare(r*cosf(0.5f*i), r*sinf(0.5f*i), 0.06f));
+    ids.push_back(broadPhase.insert(polygons.back()));
+  }
+
+  // narrow phase
+  const std::vector<AL::Math::Position2D> query = makeSquare(0.3f, 0.1f, 0.15f);
+  std::vector<int> found;
+  std::vector<int> expected;
+  broadPhase.queryCollisions(query, found);
+  for (unsigned int i=0; i<polygons.size(); i++)
+  {
+    if (AL::Math::areConvexPolygonsInCollision(query, polygons[i]))
+    {
+      expected.push_back(ids[i]);
+    }
+  }
+  std::sort(found.begin(), found.end());
+  std::sort(expected.begin(), expected.end());
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(expected, found);
+
+  // all the pairs
+  std::vector<std::pair<int, int> > pairs;
+  std::vector<std::pair<int, int> > expectedPairs;
+  broadPhase.queryCollidingPairs(pairs);
+  for (unsigned int i=0; i<polygons.size(); i++)
+  {
+    for (unsigned int j=i+1; j<polygons.size(); j++)
+    {
+      if (AL::Math::areConvexPolygonsInCollision(polygons[i], polygons[j]))
+      {
+        expectedPairs.push_back(std::make_pair(std::min(ids[i], ids[j]),
+                                               std::max(ids[i], ids[j])));
+      }
+    }
+  }
+  std::sort(pairs.begin(), pairs.end());
+  std::sort(expectedPairs.begin(), expectedPairs.end());
+  EXPECT_FALSE(expectedPairs.empty());
+  EXPECT_EQ(expectedPairs, pairs);
+
+  std::vector<std::pair<int, int> > candidates;
+  broadPhase.queryPairs(candidates);
+  EXPECT_GE(candidates.size(), pairs.size());
+  EXPECT_LT(candidates.size(), 60u*59u/2u);
+}
+
+
+TEST(PolygonBroadPhaseTest, update)
+{
+  AL::Math::PolygonBroadPhase broadPhase(0.05f);
+  const int id1 = broadPhase.insert(makeSquare(0.0f, 0.0f, 0.1f));
+  const int id2 = broadPhase.insert(makeSquare(1.0f, 0.0f, 0.1f));
+
+  // a small move stays inside the enlarged box
+  EXPECT_FALSE(broadPhase.update(id1, makeSquare(0.02f, 0.0f, 0.1f)));
+  EXPECT_FLOAT_EQ(0.12f, broadPhase.getPolygon(id1)[0].x);
+
+  std::vector<std::pair<int, int> > pairs;
+  broadPhase.queryCollidingPairs(pairs);
+  EXPECT_TRUE(pairs.empty());
+
+  EXPECT_TRUE(broadPhase.update(id1, makeSquare(0.9f, 0.0f, 0.1f)));
+  broadPhase.queryCollidingPairs(pairs);
+  ASSERT_EQ(1u, pairs.size());
+  EXPECT_EQ(std::min(id1, id2), pairs[0].first);
+  EXPECT_EQ(std::max(id1, id2), pairs[0].second);
+
+  std::vector<int> found;
+  broadPhase.queryCollisions(makeSquare(0.0f, 0.0f, 0.1f), found);
+  EXPECT_TRUE(found.empty());
+}
+
+
+TEST(PolygonBroadPhaseTest, raycast)
+{
+  AL::Math::PolygonBroadPhase broadPhase;
+  int id = -1;
+  float fraction = 0.0f;
+  EXPECT_FALSE(broadPhase.raycast(AL::Math::Position2D(0.0f, 0.0f),
+                                  AL::Math::Position2D(1.0f, 0.0f),
+                                  id, fraction));
+
+  const int near = broadPhase.insert(makeSquare(0.5f, 0.0f, 0.1f));
+  const int far = broadPhase.insert(makeSquare(0.8f, 0.0f, 0.1f));
+  broadPhase.insert(makeSquare(0.5f, 0.5f, 0.1f));
+
+  std::vector<int> found;
+  broadPhase.queryRay(AL::Math::Position2D(0.0f, 0.0f),
+                      AL::Math::Position2D(1.0f, 0.0f), found);
+  EXPECT_EQ(2u, found.size());
+
+  EXPECT_TRUE(broadPhase.raycast(AL::Math::Position2D(0.0f, 0.0f),
+                                 AL::Math::Position2D(1.0f, 0.0f),
+                                 id, fraction));
+  EXPECT_EQ(near, id);
+  EXPECT_NEAR(0.4f, fraction, 0.0001f);
+
+  // from the other side
+  EXPECT_TRUE(broadPhase.raycast(AL::Math::Position2D(2.0f, 0.0f),
+                                 AL::Math::Position2D(0.0f, 0.0f),
+                                 id, fraction));
+  EXPECT_EQ(far, id);
+  EXPECT_NEAR(0.55f, fraction, 0.0001f);
+
+  // the segment stops before the polygons
+  EXPECT_FALSE(broadPhase.raycast(AL::Math::Position2D(0.0f, 0.0f),
+                                  AL::Math::Position2D(0.3f, 0.0f),
+                                  id, fraction));
+
+  // passing between the polygons
+  EXPECT_FALSE(broadPhase.raycast(AL::Math::Position2D(0.0f, 0.25f),
+                                  AL::Math::Position2D(2.0f, 0.25f),
+                                  id, fraction));
+
+  // start inside a polygon
+  EXPECT_TRUE(broadPhase.raycast(AL::Math::Position2D(0.5f, 0.5f),
+                                 AL::Math::Position2D(0.5f, 2.0f),
+                                 id, fraction));
+  EXPECT_FLOAT_EQ(0.0f, fraction);
+}
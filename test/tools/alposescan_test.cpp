@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alposescan.h>
+#include <almath/tools/althreadpool.h>
+#include <almath/tools/altrigonometry.h>
+
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(ALPoseScanTest, sequential)
+{
+  std::vector<AL::Math::Pose2D> steps;
+  for (unsigned int i=0; i<100; i++)
+  {
+    steps.push_back(AL::Math::Pose2D(0.01f, 0.001f*i, 0.05f));
+  }
+
+  std::vector<AL::Math::Pose2D> inclusive(100);
+  std::vector<AL::Math::Pose2D> exclusive(100);
+  AL::Math::composeInclusiveScan(&steps[0], 100, &inclusive[0]);
+  AL::Math::composeExclusiveScan(&steps[0], 100, &exclusive[0]);
+  AL::Math::Pose2D expected;
+  for (unsigned int i=0; i<100; i++)
+  {
+    EXPECT_TRUE(exclusive[i].isNear(expected, 0.0f));
+    expected = expected*steps[i];
+    EXPECT_TRUE(inclusive[i].isNear(expected, 0.0f));
+  }
+
+  // in place, with theta wrapped every 10 steps
+  std::vector<AL::Math::Pose2D> wrapped = steps;
+  AL::Math::composeInclusiveScan(&wrapped[0], 100, &wrapped[0], 10);
+  EXPECT_NEAR(5.0f - AL::Math::_2_PI_, wrapped[99].theta, 0.0001f);
+  EXPECT_NEAR(inclusive[99].x, wrapped[99].x, 0.0001f);
+  EXPECT_NEAR(inclusive[99].y, wrapped[99].y, 0.0001f);
+
+  // quaternions and transforms
+  const AL::Math::Quaternion quaternions[3] = {
+    AL::Math::Quaternion::fromAngleAndAxisRotation(0.1f, 0.0f, 0.0f, 1.0f),
+    AL::Math::Quaternion::fromAngleAndAxisRotation(0.2f, 1.0f, 0.0f, 0.0f),
+    AL::Math::Quaternion::fromAngleAndAxisRotation(0.3f, 0.0f, 1.0f, 0.0f)};
+  AL::Math::Quaternion cumulative[3];
+  AL::Math::composeInclusiveScan(quaternions, 3, cumulative, 1);
+  EXPECT_TRUE(cumulative[2].isNear(quaternions[0]*quaternions[1]*quaternions[2], 0.00001f));
+
+  const AL::Math::Transform transforms[2] = {
+    AL::Math::Transform::fromPosition(0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f),
+    AL::Math::Transform::fromPosition(0.3f, -0.2f, 0.1f, -0.4f, 0.2f, 0.1f)};
+  AL::Math::Transform before[2];
+  AL::Math::composeExclusiveScan(transforms, 2, before, 1);
+  EXPECT_TRUE(before[0].isNear(AL::Math::Transform(), 0.0f));
+  EXPECT_TRUE(before[1].isNear(transforms[0], 0.00001f));
+}
+
+
+TEST(ALPoseScanTest, parallel)
+{
+  const unsigned int size = 10000;
+  std::vector<AL::Math::Transform> steps;
+  for (unsigned int i=0; i<size; i++)
+  {
+    steps.push_back(AL::Math::Transform::fromPosition(
+                      0.001f, 0.0f, 0.0001f*(i % 7), 0.0f, 0.0001f, 0.0003f*(i % 5)));
+  }
+  std::vector<AL::Math::Transform> sequential(size);
+  AL::Math::composeInclusiveScan(&steps[0], size, &sequential[0], 100);
+
+  // the results do not depend on the number of threads
+  std::vector<AL::Math::Transform> reference;
+  for (unsigned int nbWorkers=0; nbWorkers<4; nbWorkers++)
+  {
+    AL::Math::ThreadPool pool(nbWorkers);
+    const AL::Math::ExecutionPolicy policy(pool, 333);
+    std::vector<AL::Math::Transform> results(size);
+    AL::Math::composeInclusiveScan(&steps[0], size, &results[0], policy, 100);
+    if (nbWorkers == 0)
+    {
+      reference = results;
+    }
+    for (unsigned int i=0; i<size; i++)
+    {
+      ASSERT_TRUE(results[i].isNear(reference[i], 0.0f)) << i;
+      ASSERT_TRUE(results[i].isNear(sequential[i], 0.001f)) << i;
+    }
+
+    // in place, exclusive
+    std::vector<AL::Math::Transform> before = steps;
+    AL::Math::composeExclusiveScan(&before[0], size, &before[0], policy, 100);
+    EXPECT_TRUE(before[0].isNear(AL::Math::Transform(), 0.0f));
+    for (unsigned int i=1; i<size; i++)
+    {
+      ASSERT_TRUE(before[i].isNear(results[i - 1], 0.0001f)) << i;
+    }
+  }
+
+  // without a pool, the same as the sequential scan
+  std::vector<AL::Math::Transform> results(size);
+  AL::Math::composeInclusiveScan(&steps[0], size, &results[0],
+                                 AL::Math::ExecutionPolicy(), 100);
+  EXPECT_TRUE(results[size - 1].isNear(sequential[size - 1], 0.0f));
+}
+
+
+TEST(ALPoseScanTest, parallelPose2D)
+{
+  const unsigned int size = 2000;
+  std::vector<AL::Math::Pose2D> steps;
+  for (unsigned int i=0; i<size; i++)
+  {
+    steps.push_back(AL::Math::Pose2D(0.01f, 0.002f*(i % 3), 0.05f + 0.001f*(i % 7)));
+  }
+
+  // theta is wrapped at the same indices as in the sequential scan,
+  // whatever the period and the blocks
+  AL::Math::ThreadPool pool(3);
+  const unsigned int periods[] = {1000, 100, 64};
+  const unsigned int grainSizes[] = {256, 256, 64};
+  for (unsigned int k=0; k<3; k++)
+  {
+    std::vector<AL::Math::Pose2D> sequential(size);
+    AL::Math::composeInclusiveScan(&steps[0], size, &sequential[0], periods[k]);
+    const AL::Math::ExecutionPolicy policy(pool, grainSizes[k]);
+    std::vector<AL::Math::Pose2D> results(size);
+    AL::Math::composeInclusiveScan(&steps[0], size, &results[0], policy, periods[k]);
+    std::vector<AL::Math::Pose2D> before(size);
+    AL::Math::composeExclusiveScan(&steps[0], size, &before[0], policy, periods[k]);
+    for (unsigned int i=0; i<size; i++)
+    {
+      ASSERT_NEAR(results[i].theta, sequential[i].theta, 0.001f) << i;
+      ASSERT_NEAR(results[i].x, sequential[i].x, 0.001f) << i;
+      ASSERT_NEAR(results[i].y, sequential[i].y, 0.001f) << i;
+      if (i > 0)
+      {
+        ASSERT_NEAR(before[i].theta, sequential[i - 1].theta, 0.001f) << i;
+      }
+    }
+  }
+}
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alrealtime.h>
+#include <almath/tools/almatharray.h>
+#include <almath/tools/aldubinscurve.h>
+#include <almath/tools/altransformhelpers.h>
+#include <almath/tools/avoidfootcollision.h>
+#include <almath/tools/altrigonometry.h>
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Audit of the real-time API set: the functions are run with a hooked
+// operator new, and must neither allocate nor throw.
+namespace
+{
+  // only the allocations of the audited thread are counted
+  thread_local bool gIsAudited = false;
+  thread_local unsigned int gNbAllocations = 0;
+
+  template <class Function>
+  unsigned int countAllocations(const Function& pFunction)
+  {
+    gNbAllocations = 0;
+    gIsAudited = true;
+    try
+    {
+      pFunction();
+    }
+    catch (...)
+    {
+      ADD_FAILURE() << "the audited function throws";
+    }
+    gIsAudited = false;
+    return gNbAllocations;
+  }
+
+  std::vector<AL::Math::Pose2D> makeFoot(const float& pOffsetY)
+  {
+    std::vector<AL::Math::Pose2D> foot;
+    foot.push_back(AL::Math::Pose2D( 0.080f,  0.038f + pOffsetY, 0.0f));
+    foot.push_back(AL::Math::Pose2D( 0.080f, -0.050f + pOffsetY, 0.0f));
+    foot.push_back(AL::Math::Pose2D(-0.047f, -0.050f + pOffsetY, 0.0f));
+    foot.push_back(AL::Math::Pose2D(-0.047f,  0.038f + pOffsetY, 0.0f));
+    return foot;
+  }
+}
+
+void* operator new(std::size_t pSize)
+{
+  if (gIsAudited)
+  {
+    ++gNbAllocations;
+  }
+  void* data = std::malloc((pSize > 0) ? pSize : 1);
+  if (data == 0)
+  {
+    throw std::bad_alloc();
+  }
+  return data;
+}
+
+// Once inlined, gcc sees the free of a pointer from operator new: the
+// warning does not know that the hooked operator new uses malloc.
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* pData) noexcept
+{
+  std::free(pData);
+}
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+# pragma GCC diagnostic pop
+#endif
+
+
+TEST(RealTimeTest, auditHook)
+{
+  // the hook sees the allocations of the usual API
+  std::vector<float> values;
+  EXPECT_LT(0u, countAllocations([&values]()
+  {
+    values = AL::Math::Pose2D(1.0f, 2.0f, 3.0f).toVector();
+  }));
+  EXPECT_EQ(3u, values.size());
+
+  std::vector<AL::Math::Pose2D> solutions;
+  EXPECT_LT(0u, countAllocations([&solutions]()
+  {
+    solutions = AL::Math::getDubinsSolutions(AL::Math::Pose2D(0.5f, 0.5f, 0.0f), 0.1f);
+  }));
+}
+
+
+TEST(RealTimeTest, dubins)
+{
+  const AL::Math::Pose2D target(-0.5f, 0.5f, 0.3f);
+  const std::vector<AL::Math::Pose2D> expected =
+      AL::Math::getDubinsSolutions(target, 0.1f);
+
+  AL::Math::Pose2D solutions[3];
+  AL::Math::MATH_STATUS status = AL::Math::MATH_OK;
+  EXPECT_TRUE(noexcept(AL::Math::tryGetDubinsSolutions(target, 0.1f, solutions, 3)));
+  EXPECT_EQ(0u, countAllocations([&]()
+  {
+    status = AL::Math::tryGetDubinsSolutions(target, 0.1f, solutions, 3);
+  }));
+  EXPECT_EQ(AL::Math::MATH_OK, status);
+  for (unsigned int i=0; i<3; i++)
+  {
+    EXPECT_TRUE(solutions[i].isNear(expected[i], 0.0f));
+  }
+
+  EXPECT_EQ(0u, countAllocations([&]()
+  {
+    status = AL::Math::tryGetDubinsSolutions(target, 0.1f, solutions, 2);
+  }));
+  EXPECT_EQ(AL::Math::MATH_BUFFER_TOO_SMALL, status);
+
+  EXPECT_EQ(0u, countAllocations([&]()
+  {
+    status = AL::Math::tryGetDubinsSolutions(AL::Math::Pose2D(0.1f, 0.1f, 0.0f),
+                                             0.1f, solutions, 3);
+  }));
+  EXPECT_EQ(AL::Math::MATH_INVALID_ARGUMENT, status);
+  EXPECT_THROW(AL::Math::getDubinsSolutions(AL::Math::Pose2D(0.1f, 0.1f, 0.0f), 0.1f),
+               std::invalid_argument);
+}
+
+
+TEST(RealTimeTest, transformHelpers)
+{
+  const AL::Math::Transform t1 = AL::Math::Transform::fromPosition(0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f);
+  const AL::Math::Transform t2 = AL::Math::Transform::fromPosition(0.3f, -0.2f, 0.1f, -0.4f, 0.2f, 0.1f);
+  const AL::Math::Transform expected = AL::Math::transformMean(t1, t2, 0.3f);
+
+  AL::Math::Transform mean;
+  AL::Math::MATH_STATUS status = AL::Math::MATH_OK;
+  EXPECT_TRUE(noexcept(AL::Math::tryTransformMeanInPlace(t1, t2, 0.3f, mean)));
+  EXPECT_EQ(0u, countAllocations([&]()
+  {
+    status = AL::Math::tryTransformMeanInPlace(t1, t2, 0.3f, mean);
+  }));
+  EXPECT_EQ(AL::Math::MATH_OK, status);
+  EXPECT_TRUE(mean.isNear(expected, 0.0f));
+
+  // the output is unchanged on error
+  EXPECT_EQ(0u, countAllocations([&]()
+  {
+    status = AL::Math::tryTransformMeanInPlace(t1, t2, 1.5f, mean);
+  }));
+  EXPECT_EQ(AL::Math::MATH_INVALID_ARGUMENT, status);
+  EXPECT_TRUE(mean.isNear(expected, 0.0f));
+
+  const AL::Math::Position3D axis(0.0f, 0.0f, 1.0f);
+  AL::Math::Transform projected = t1;
+  AL::Math::Rotation rotation = AL::Math::Rotation::fromRotZ(0.3f);
+  const AL::Math::Rotation expectedRotation = rotation;
+  EXPECT_EQ(0u, countAllocations([&]()
+  {
+    status = AL::Math::tryAxisRotationProjectionInPlace(axis, projected);
+  }));
+  EXPECT_EQ(AL::Math::MATH_OK, status);
+  EXPECT_TRUE(projected.isNear(AL::Math::axisRotationProjection(axis, t1), 0.0f));
+
+  EXPECT_EQ(0u, countAllocations([&]()
+  {
+    status = AL::Math::tryAxisRotationProjectionInPlace(axis, rotation);
+  }));
+  EXPECT_EQ(AL::Math::MATH_OK, status);
+  EXPECT_TRUE(rotation.isNear(expectedRotation, 0.0001f));
+
+  EXPECT_EQ(0u, countAllocations([&]()
+  {
+    status = AL::Math::tryAxisRotationProjectionInPlace(AL::Math::Position3D(), rotation);
+  }));
+  EXPECT_EQ(AL::Math::MATH_DIVISION_BY_ZERO, status);
+  EXPECT_THROW(AL::Math::axisRotationProjectionInPlace(AL::Math::Position3D(), rotation),
+               std::runtime_error);
+}
+
+
+TEST(RealTimeTest, toVectorInPlace)
+{
+  float data[16];
+  unsigned int nbErrors = 0;
+  const AL::Math::Transform transform =
+      AL::Math::Transform::fromPosition(0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f);
+  const AL::Math::Quaternion quaternion(0.5f, 0.5f, -0.5f, 0.5f);
+  EXPECT_EQ(0u, countAllocations([&]()
+  {
+    nbErrors += (AL::Math::toVectorInPlace(transform, data, 16) != AL::Math::MATH_OK);
+  }));
+  EXPECT_EQ(0u, nbErrors);
+  const std::vector<float> expected = transform.toVector();
+  for (unsigned int i=0; i<16; i++)
+  {
+    EXPECT_EQ(expected[i], data[i]);
+  }
+
+  EXPECT_EQ(0u, countAllocations([&]()
+  {
+    nbErrors += (AL::Math::toVectorInPlace(quaternion, data, 4) != AL::Math::MATH_OK);
+    nbErrors += (AL::Math::toVectorInPlace(AL::Math::Pose2D(), data, 3) != AL::Math::MATH_OK);
+    nbErrors += (AL::Math::toVectorInPlace(AL::Math::Position2D(), data, 2) != AL::Math::MATH_OK);
+    nbErrors += (AL::Math::toVectorInPlace(AL::Math::Position3D(), data, 3) != AL::Math::MATH_OK);
+    nbErrors += (AL::Math::toVectorInPlace(AL::Math::Position6D(), data, 6) != AL::Math::MATH_OK);
+    nbErrors += (AL::Math::toVectorInPlace(AL::Math::Rotation(), data, 9) != AL::Math::MATH_OK);
+    nbErrors += (AL::Math::toVectorInPlace(AL::Math::Rotation3D(), data, 3) != AL::Math::MATH_OK);
+    nbErrors += (AL::Math::toVectorInPlace(AL::Math::Velocity3D(), data, 3) != AL::Math::MATH_OK);
+    nbErrors += (AL::Math::toVectorInPlace(AL::Math::Velocity6D(), data, 6) != AL::Math::MATH_OK);
+  }));
+  EXPECT_EQ(0u, nbErrors);
+
+  // the array conversions
+  AL::Math::Transform transforms[4];
+  float buffer[48];
+  unsigned int nbConverted = 0;
+  EXPECT_EQ(0u, countAllocations([&]()
+  {
+    AL::Math::FloatArray<AL::Math::Transform>::type floats = AL::Math::toArray(transform);
+    transforms[0] = AL::Math::fromArray<AL::Math::Transform>(floats);
+    AL::Math::toFloats(transform, buffer);
+    AL::Math::fromFloats(buffer, transforms[1]);
+    nbConverted += AL::Math::toFloats(transforms, 4, buffer, 48);
+    nbConverted += AL::Math::fromFloats(buffer, 48, transforms, 4);
+  }));
+  EXPECT_EQ(8u, nbConverted);
+  EXPECT_TRUE(transforms[1].isNear(transform, 0.0f));
+
+  EXPECT_EQ(AL::Math::MATH_BUFFER_TOO_SMALL, AL::Math::toVectorInPlace(transform, data, 12));
+  EXPECT_EQ(AL::Math::MATH_BUFFER_TOO_SMALL, AL::Math::toVectorInPlace(quaternion, 0, 4));
+  AL::Math::toVectorInPlace(quaternion, data, 4);
+  EXPECT_EQ(quaternion.toVector(), std::vector<float>(data, data + 4));
+}
+
+
+TEST(RealTimeTest, footCollision)
+{
+  const std::vector<AL::Math::Pose2D> rFoot = makeFoot(0.0f);
+  const std::vector<AL::Math::Pose2D> lFoot = makeFoot(0.012f);
+  const AL::Math::FootBox rFootBox(rFoot);
+  const AL::Math::FootBox lFootBox(lFoot);
+
+  AL::Math::Pose2D move(0.0f, 0.085f, 40.0f*AL::Math::TO_RAD);
+  AL::Math::Pose2D moveBox = move;
+  bool isClamped = false;
+  bool isBoxClamped = false;
+  bool isInCollision = false;
+  EXPECT_EQ(0u, countAllocations([&]()
+  {
+    isClamped = AL::Math::avoidFootCollision(lFoot, rFoot, false, move,
+                                             AL::Math::AVOID_FOOT_COLLISION_EXACT);
+    isBoxClamped = AL::Math::avoidFootCollision(lFootBox, rFootBox, false, moveBox,
+                                                AL::Math::AVOID_FOOT_COLLISION_EXACT);
+    isInCollision = AL::Math::areConvexPolygonsInCollision(rFootBox, lFootBox);
+  }));
+  EXPECT_TRUE(isClamped);
+  EXPECT_TRUE(isBoxClamped);
+  EXPECT_TRUE(isInCollision);
+  EXPECT_TRUE(move.isNear(moveBox));
+}
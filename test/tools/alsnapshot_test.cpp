@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alsnapshot.h>
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  // all the members of the transform are the same
+  AL::Math::Transform makeTransform(const float& pValue)
+  {
+    AL::Math::Transform transform;
+    float* data = &transform.r1_c1;
+    for (unsigned int i=0; i<12; i++)
+    {
+      data[i] = pValue;
+    }
+    return transform;
+  }
+
+  const bool isConsistent(const AL::Math::Transform& pTransform)
+  {
+    const float* data = &pTransform.r1_c1;
+    for (unsigned int i=1; i<12; i++)
+    {
+      if (data[i] != data[0])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+
+TEST(SnapshotTest, publishRead)
+{
+  AL::Math::Snapshot<AL::Math::Pose2D> snapshot;
+  AL::Math::Pose2D pose(1.0f, 2.0f, 3.0f);
+  EXPECT_EQ(0u, snapshot.getVersion());
+  EXPECT_EQ(0u, snapshot.read(pose));
+  EXPECT_TRUE(pose.isNear(AL::Math::Pose2D(), 0.0f));
+
+  snapshot.publish(AL::Math::Pose2D(0.1f, 0.2f, 0.3f));
+  snapshot.publish(AL::Math::Pose2D(0.4f, 0.5f, 0.6f));
+  EXPECT_EQ(2u, snapshot.getVersion());
+  EXPECT_EQ(2u, snapshot.read(pose));
+  EXPECT_TRUE(pose.isNear(AL::Math::Pose2D(0.4f, 0.5f, 0.6f), 0.0f));
+
+  AL::Math::Snapshot<AL::Math::Velocity6D> velocity(
+        AL::Math::Velocity6D(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f));
+  AL::Math::Velocity6D value;
+  EXPECT_TRUE(velocity.tryRead(value));
+  EXPECT_TRUE(value.isNear(
+                AL::Math::Velocity6D(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f), 0.0f));
+}
+
+
+TEST(SnapshotTest, array)
+{
+  EXPECT_THROW(AL::Math::SnapshotArray<AL::Math::Transform> empty(0),
+               std::invalid_argument);
+
+  AL::Math::SnapshotArray<AL::Math::Transform> frames(3);
+  EXPECT_EQ(3u, frames.size());
+  EXPECT_EQ(0u, frames.getVersion());
+
+  std::vector<AL::Math::Transform> values;
+  EXPECT_EQ(0u, frames.read(values));
+  ASSERT_EQ(3u, values.size());
+  EXPECT_TRUE(values[2].isNear(AL::Math::Transform(), 0.0f));
+
+  for (unsigned int v=1; v<=3; v++)
+  {
+    for (unsigned int i=0; i<3; i++)
+    {
+      values[i] = makeTransform(10.0f*v + i);
+    }
+    frames.publish(values);
+    EXPECT_EQ(v, frames.getVersion());
+  }
+
+  AL::Math::Transform frame;
+  EXPECT_EQ(3u, frames.read(1, frame));
+  EXPECT_TRUE(makeTransform(31.0f).isNear(frame, 0.0f));
+  EXPECT_THROW(frames.read(3, frame), std::out_of_range);
+  EXPECT_THROW(frames.publish(std::vector<AL::Math::Transform>(2)),
+               std::invalid_argument);
+
+  AL::Math::Transform read[3];
+  EXPECT_EQ(3u, frames.read(read));
+  EXPECT_TRUE(makeTransform(30.0f).isNear(read[0], 0.0f));
+  EXPECT_TRUE(makeTransform(32.0f).isNear(read[2], 0.0f));
+}
+
+
+TEST(SnapshotTest, concurrentReaders)
+{
+  const unsigned int nbPublications = 100000;
+  AL::Math::Snapshot<AL::Math::Transform> snapshot(makeTransform(0.0f));
+  AL::Math::SnapshotArray<AL::Math::Transform> frames(8);
+  std::vector<AL::Math::Transform> values(8);
+  for (unsigned int i=0; i<values.size(); i++)
+  {
+    values[i] = makeTransform(static_cast<float>(1 + i));
+  }
+  frames.publish(values);
+  std::atomic<bool> done(false);
+  std::atomic<unsigned int> nbErrors(0);
+
+  std::vector<std::thread> readers;
+  for (unsigned int r=0; r<4; r++)
+  {
+    readers.push_back(std::thread([&snapshot, &frames, &done, &nbErrors]()
+    {
+      AL::Math::Transform value;
+      std::vector<AL::Math::Transform> values;
+      uint64_t lastVersion = 0;
+      while (!done.load())
+      {
+        // a value is never torn, and the versions never go back
+        const uint64_t version = snapshot.read(value);
+        if (!isConsistent(value) || (value.r1_c1 != version) ||
+            (version < lastVersion))
+        {
+          ++nbErrors;
+        }
+        lastVersion = version;
+
+        // all the frames are of the same publication
+        const uint64_t framesVersion = frames.read(values);
+        for (unsigned int i=0; i<values.size(); i++)
+        {
+          if (!isConsistent(values[i]) ||
+              (values[i].r1_c1 != framesVersion + i))
+          {
+            ++nbErrors;
+          }
+        }
+      }
+    }));
+  }
+
+  for (unsigned int v=1; v<=nbPublications; v++)
+  {
+    snapshot.publish(makeTransform(static_cast<float>(v)));
+    for (unsigned int i=0; i<values.size(); i++)
+    {
+      values[i] = makeTransform(static_cast<float>(v + 1 + i));
+    }
+    frames.publish(values);
+  }
+  done.store(true);
+  for (unsigned int r=0; r<readers.size(); r++)
+  {
+    readers[r].join();
+  }
+  EXPECT_EQ(0u, nbErrors.load());
+}
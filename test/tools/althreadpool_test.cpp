@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/althreadpool.h>
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(ThreadPoolTest, parallelFor)
+{
+  AL::Math::ThreadPool pool(3);
+  EXPECT_EQ(4u, pool.getNbThreads());
+
+  const unsigned int grainSizes[] = {0, 1, 7, 1000, 20000};
+  for (unsigned int g=0; g<5; g++)
+  {
+    // each index is run once
+    std::vector<unsigned int> counts(10000, 0);
+    pool.parallelFor(10, 10000, grainSizes[g],
+                     [&counts](const unsigned int& pBegin, const unsigned int& pEnd)
+    {
+      for (unsigned int i=pBegin; i<pEnd; i++)
+      {
+        ++counts[i];
+      }
+    });
+    for (unsigned int i=0; i<counts.size(); i++)
+    {
+      ASSERT_EQ((i < 10) ? 0u : 1u, counts[i]) << i;
+    }
+  }
+
+  // an empty range does not call the body
+  bool called = false;
+  pool.parallelFor(5, 5, 0,
+                   [&called](const unsigned int&, const unsigned int&)
+  {
+    called = true;
+  });
+  EXPECT_FALSE(called);
+}
+
+
+TEST(ThreadPoolTest, unbalanced)
+{
+  // the chunks of the slow thread are stolen
+  AL::Math::ThreadPool pool(3, true);
+  std::atomic<unsigned long> sum(0);
+  for (unsigned int loop=0; loop<50; loop++)
+  {
+    pool.parallelFor(0, 1000, 1,
+                     [&sum](const unsigned int& pBegin, const unsigned int& pEnd)
+    {
+      for (unsigned int i=pBegin; i<pEnd; i++)
+      {
+        volatile unsigned long work = 0;
+        for (unsigned int j=0; j<((i < 250) ? 2000u : 10u); j++)
+        {
+          work = work + j;
+        }
+        sum += i;
+      }
+    });
+  }
+  EXPECT_EQ(50ul*999*1000/2, sum.load());
+}
+
+
+TEST(ThreadPoolTest, nestedAndExceptions)
+{
+  AL::Math::ThreadPool pool(2);
+  std::atomic<unsigned int> count(0);
+  pool.parallelFor(0, 8, 1,
+                   [&pool, &count](const unsigned int& pBegin, const unsigned int& pEnd)
+  {
+    for (unsigned int i=pBegin; i<pEnd; i++)
+    {
+      // runs on the calling thread
+      pool.parallelFor(0, 10, 1,
+                       [&count](const unsigned int& pBegin2, const unsigned int& pEnd2)
+      {
+        count += pEnd2 - pBegin2;
+      });
+    }
+  });
+  EXPECT_EQ(80u, count.load());
+
+  EXPECT_THROW(pool.parallelFor(0, 100, 1,
+                                [](const unsigned int& pBegin, const unsigned int&)
+  {
+    if (pBegin == 42)
+    {
+      throw std::runtime_error("42");
+    }
+  }), std::runtime_error);
+
+  // the pool is still usable
+  count.store(0);
+  pool.parallelFor(0, 100, 3,
+                   [&count](const unsigned int& pBegin, const unsigned int& pEnd)
+  {
+    count += pEnd - pBegin;
+  });
+  EXPECT_EQ(100u, count.load());
+}
+
+
+TEST(ThreadPoolTest, executionPolicy)
+{
+  // the calling thread only: one call for the whole range
+  unsigned int nbCalls = 0;
+  AL::Math::parallelFor(AL::Math::ExecutionPolicy(), 0, 1000,
+                        [&nbCalls](const unsigned int& pBegin, const unsigned int& pEnd)
+  {
+    EXPECT_EQ(0u, pBegin);
+    EXPECT_EQ(1000u, pEnd);
+    ++nbCalls;
+  });
+  EXPECT_EQ(1u, nbCalls);
+
+  AL::Math::ThreadPool callerOnly(0);
+  EXPECT_EQ(1u, callerOnly.getNbThreads());
+  nbCalls = 0;
+  AL::Math::parallelFor(AL::Math::ExecutionPolicy(callerOnly, 10), 0, 1000,
+                        [&nbCalls](const unsigned int&, const unsigned int&)
+  {
+    ++nbCalls;
+  });
+  EXPECT_EQ(1u, nbCalls);
+}
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/altrajectorycodec.h>
+#include <almath/tools/altransformhelpers.h>
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+  // the error is the bound plus the float rounding of the values
+  const float kRounding = 1e-6f;
+
+  AL::Math::Transform makeTransform(const unsigned int& pIndex)
+  {
+    const float t = 0.01f*pIndex;
+    AL::Math::Transform transform = AL::Math::Transform::from3DRotation(
+          0.3f*std::sin(t), 0.2f*std::cos(0.5f*t), 1.5f*t);
+    transform.r1_c4 = 0.5f*std::cos(t);
+    transform.r2_c4 = 0.5f*std::sin(t);
+    transform.r3_c4 = 0.3f + 0.01f*t;
+    return transform;
+  }
+
+  float rotationError(
+    const AL::Math::Transform& pT1,
+    const AL::Math::Transform& pT2)
+  {
+    const AL::Math::Transform diff = AL::Math::transformInverse(pT1)*pT2;
+    const float cosAngle = 0.5f*(diff.r1_c1 + diff.r2_c2 + diff.r3_c3 - 1.0f);
+    return std::acos(std::min(1.0f, std::max(-1.0f, cosAngle)));
+  }
+}
+
+
+TEST(TrajectoryCodecTest, pose2D)
+{
+  const float positionBound = 0.001f;
+  const float angleBound    = 0.001f;
+  const unsigned int nbValues = 2000;
+
+  std::stringstream stream;
+  {
+    AL::Math::TrajectoryEncoder<AL::Math::Pose2D> encoder(
+          stream, positionBound, angleBound);
+    for (unsigned int i=0; i<nbValues; i++)
+    {
+      // a circle, then a stop
+      const float t = 0.01f*std::min(i, 1500u);
+      encoder.encode(AL::Math::Pose2D(std::cos(t), std::sin(t), t + 1.57f));
+    }
+    EXPECT_EQ(nbValues, encoder.size());
+    encoder.finish();
+    EXPECT_THROW(encoder.encode(AL::Math::Pose2D()), std::runtime_error);
+
+    // 12 bytes per raw value
+    EXPECT_EQ(stream.str().size(), encoder.getNbBytes());
+    EXPECT_LT(10*encoder.getNbBytes(), 12*nbValues);
+  }
+
+  AL::Math::TrajectoryDecoder<AL::Math::Pose2D> decoder(stream);
+  EXPECT_FLOAT_EQ(positionBound, decoder.getPositionBound());
+  EXPECT_FLOAT_EQ(angleBound, decoder.getAngleBound());
+  EXPECT_EQ(AL::Math::TRAJECTORY_PREDICTION_LINEAR, decoder.getPrediction());
+
+  AL::Math::Pose2D pose;
+  for (unsigned int i=0; i<nbValues; i++)
+  {
+    ASSERT_TRUE(decoder.decode(pose));
+    const float t = 0.01f*std::min(i, 1500u);
+    EXPECT_NEAR(std::cos(t), pose.x, positionBound + kRounding);
+    EXPECT_NEAR(std::sin(t), pose.y, positionBound + kRounding);
+    EXPECT_NEAR(t + 1.57f, pose.theta, angleBound + kRounding);
+  }
+  EXPECT_FALSE(decoder.decode(pose));
+  EXPECT_FALSE(decoder.decode(pose));
+  EXPECT_EQ(nbValues, decoder.size());
+}
+
+
+TEST(TrajectoryCodecTest, transform)
+{
+  const float positionBound = 0.001f;
+  const float angleBound    = 0.002f;
+  const unsigned int nbValues = 1000;
+
+  std::stringstream stream;
+  AL::Math::TrajectoryEncoder<AL::Math::Transform> encoder(
+        stream, positionBound, angleBound);
+  for (unsigned int i=0; i<nbValues; i++)
+  {
+    encoder.encode(makeTransform(i));
+  }
+  encoder.finish();
+  // 48 bytes per raw value
+  EXPECT_LT(10*encoder.getNbBytes(), 48*nbValues);
+
+  AL::Math::TrajectoryDecoder<AL::Math::Transform> decoder(stream);
+  AL::Math::Transform transform;
+  for (unsigned int i=0; i<nbValues; i++)
+  {
+    ASSERT_TRUE(decoder.decode(transform));
+    const AL::Math::Transform expected = makeTransform(i);
+    EXPECT_NEAR(expected.r1_c4, transform.r1_c4, positionBound + kRounding);
+    EXPECT_NEAR(expected.r2_c4, transform.r2_c4, positionBound + kRounding);
+    EXPECT_NEAR(expected.r3_c4, transform.r3_c4, positionBound + kRounding);
+    EXPECT_LT(rotationError(expected, transform), angleBound);
+    EXPECT_TRUE(transform.isTransform(1e-5f));
+  }
+  EXPECT_FALSE(decoder.decode(transform));
+}
+
+
+TEST(TrajectoryCodecTest, jumps)
+{
+  // large jumps are escaped, the values read are the ones returned by
+  // the encoder
+  const AL::Math::Quaternion quaternions[] = {
+    AL::Math::Quaternion(1.0f, 0.0f, 0.0f, 0.0f),
+    AL::Math::Quaternion(-1.0f, 0.0f, 0.0f, 0.0f),
+    AL::Math::Quaternion(0.5f, 0.5f, -0.5f, 0.5f),
+    AL::Math::Quaternion(0.5f, 0.5f, -0.5f, 0.5f),
+    AL::Math::Quaternion(0.0f, 0.0f, 1.0f, 0.0f)};
+  const unsigned int nbValues = sizeof(quaternions)/sizeof(quaternions[0]);
+
+  std::stringstream stream;
+  AL::Math::Quaternion decoded[nbValues];
+  {
+    AL::Math::TrajectoryEncoder<AL::Math::Quaternion> encoder(
+          stream, 1.0f, 1e-4f, AL::Math::TRAJECTORY_PREDICTION_DELTA);
+    for (unsigned int i=0; i<nbValues; i++)
+    {
+      encoder.encode(quaternions[i], decoded[i]);
+      EXPECT_TRUE(quaternions[i].isNear(decoded[i], 2.5e-5f + kRounding));
+    }
+  }
+
+  AL::Math::TrajectoryDecoder<AL::Math::Quaternion> decoder(stream);
+  EXPECT_EQ(AL::Math::TRAJECTORY_PREDICTION_DELTA, decoder.getPrediction());
+  AL::Math::Quaternion quaternion;
+  for (unsigned int i=0; i<nbValues; i++)
+  {
+    ASSERT_TRUE(decoder.decode(quaternion));
+    EXPECT_EQ(0, std::memcmp(&decoded[i], &quaternion, sizeof(quaternion)));
+  }
+  EXPECT_FALSE(decoder.decode(quaternion));
+
+  std::stringstream positions;
+  {
+    AL::Math::TrajectoryEncoder<AL::Math::Position3D> encoder(
+          positions, 1e-4f, 1.0f);
+    encoder.encode(AL::Math::Position3D(1e4f, -1e4f, 0.0f));
+    encoder.encode(AL::Math::Position3D(-1e4f, 1e4f, 1e-3f));
+    encoder.encode(AL::Math::Position3D(0.0f, 0.0f, 0.0f));
+  }
+  AL::Math::TrajectoryDecoder<AL::Math::Position3D> positionDecoder(positions);
+  AL::Math::Position3D position;
+  ASSERT_TRUE(positionDecoder.decode(position));
+  EXPECT_TRUE(position.isNear(AL::Math::Position3D(1e4f, -1e4f, 0.0f), 1e-3f));
+  ASSERT_TRUE(positionDecoder.decode(position));
+  EXPECT_TRUE(position.isNear(AL::Math::Position3D(-1e4f, 1e4f, 1e-3f), 1e-3f));
+  ASSERT_TRUE(positionDecoder.decode(position));
+  EXPECT_TRUE(position.isNear(AL::Math::Position3D(), 1e-4f));
+  EXPECT_FALSE(positionDecoder.decode(position));
+}
+
+
+TEST(TrajectoryCodecTest, concatenated)
+{
+  // the decoder stops at the end of its trajectory
+  std::stringstream stream;
+  for (unsigned int j=0; j<2; j++)
+  {
+    AL::Math::TrajectoryEncoder<AL::Math::Pose2D> encoder(stream, 0.01f, 0.01f);
+    for (unsigned int i=0; i<10; i++)
+    {
+      encoder.encode(AL::Math::Pose2D(0.1f*i, 0.1f*j, 0.0f));
+    }
+  }
+
+  AL::Math::Pose2D pose;
+  for (unsigned int j=0; j<2; j++)
+  {
+    AL::Math::TrajectoryDecoder<AL::Math::Pose2D> decoder(stream);
+    while (decoder.decode(pose))
+    {
+      EXPECT_NEAR(0.1f*j, pose.y, 0.01f + kRounding);
+    }
+    EXPECT_EQ(10u, decoder.size());
+  }
+}
+
+
+TEST(TrajectoryCodecTest, errors)
+{
+  std::stringstream stream;
+  EXPECT_THROW(AL::Math::TrajectoryEncoder<AL::Math::Pose2D> encoder(
+                 stream, 0.0f, 0.01f), std::invalid_argument);
+  EXPECT_THROW(AL::Math::TrajectoryEncoder<AL::Math::Pose2D> encoder(
+                 stream, 0.01f, std::numeric_limits<float>::quiet_NaN()),
+               std::invalid_argument);
+
+  std::stringstream truncated;
+  {
+    AL::Math::TrajectoryEncoder<AL::Math::Pose2D> encoder(truncated, 1e-3f, 1e-3f);
+    EXPECT_THROW(encoder.encode(AL::Math::Pose2D(
+                   std::numeric_limits<float>::quiet_NaN(), 0.0f, 0.0f)),
+                 std::invalid_argument);
+    EXPECT_THROW(encoder.encode(AL::Math::Pose2D(1e30f, 0.0f, 0.0f)),
+                 std::invalid_argument);
+    EXPECT_EQ(0u, encoder.size());
+    for (unsigned int i=0; i<10; i++)
+    {
+      encoder.encode(AL::Math::Pose2D(0.1f*i, 0.0f, 0.0f));
+    }
+  }
+  {
+    std::stringstream wrongType(truncated.str());
+    EXPECT_THROW(AL::Math::TrajectoryDecoder<AL::Math::Position3D> decoder(
+                   wrongType), std::runtime_error);
+  }
+  {
+    const std::string data = truncated.str();
+    std::stringstream cut(data.substr(0, data.size() - 3));
+    AL::Math::TrajectoryDecoder<AL::Math::Pose2D> decoder(cut);
+    AL::Math::Pose2D pose;
+    EXPECT_THROW(while (decoder.decode(pose)) {}, std::runtime_error);
+  }
+
+  std::stringstream notCompressed("not a compressed trajectory");
+  EXPECT_THROW(AL::Math::TrajectoryDecoder<AL::Math::Pose2D> decoder(
+                 notCompressed), std::runtime_error);
+  std::stringstream tooShort("ALMC");
+  EXPECT_THROW(AL::Math::TrajectoryDecoder<AL::Math::Pose2D> decoder(
+                 tooShort), std::runtime_error);
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/altrajectoryfile.h>
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+  const std::string kFileName = "altrajectoryfile_test.bin";
+
+  AL::Math::Transform makeTransform(const unsigned int& pIndex)
+  {
+    AL::Math::Transform transform =
+        AL::Math::Transform::from3DRotation(0.01f*pIndex, 0.2f, -0.01f*pIndex);
+    transform.r1_c4 = 0.001f*pIndex;
+    return transform;
+  }
+}
+
+
+TEST(TrajectoryFileTest, writeRead)
+{
+  {
+    AL::Math::TrajectoryWriter<AL::Math::Transform> writer(kFileName, false, 16);
+    for (unsigned int i=0; i<1000; i++)
+    {
+      writer.append(0.01*i, makeTransform(i));
+    }
+    EXPECT_EQ(1000u, writer.size());
+    EXPECT_THROW(writer.append(1.0, makeTransform(0)), std::invalid_argument);
+    writer.close();
+    EXPECT_THROW(writer.append(20.0, makeTransform(0)), std::runtime_error);
+  }
+
+  AL::Math::TrajectoryReader<AL::Math::Transform> reader(kFileName);
+  ASSERT_EQ(1000u, reader.size());
+  EXPECT_TRUE(reader.hasIndex());
+
+  AL::Math::Transform transform;
+  for (unsigned int i=0; i<reader.size(); i+=7)
+  {
+    EXPECT_DOUBLE_EQ(0.01*i, reader.getTime(i));
+    reader.get(i, transform);
+    EXPECT_TRUE(makeTransform(i).isNear(transform, 0.0f));
+  }
+
+  // random access by time
+  EXPECT_EQ(0u, reader.findRecord(-1.0));
+  EXPECT_EQ(0u, reader.findRecord(0.0));
+  EXPECT_EQ(123u, reader.findRecord(1.235));
+  EXPECT_EQ(999u, reader.findRecord(100.0));
+  EXPECT_DOUBLE_EQ(5.0, reader.getAtTime(5.005, transform));
+  EXPECT_TRUE(makeTransform(500).isNear(transform, 0.0f));
+
+  AL::Math::fromBinary(reader.getPayload(42), transform);
+  EXPECT_TRUE(makeTransform(42).isNear(transform, 0.0f));
+
+  EXPECT_THROW(AL::Math::TrajectoryReader<AL::Math::Pose2D> wrongType(kFileName),
+               std::runtime_error);
+  std::remove(kFileName.c_str());
+}
+
+
+TEST(TrajectoryFileTest, append)
+{
+  {
+    AL::Math::TrajectoryWriter<AL::Math::Pose2D> writer(kFileName);
+    for (unsigned int i=0; i<100; i++)
+    {
+      writer.append(0.1*i, AL::Math::Pose2D(0.1f*i, 0.0f, 0.0f));
+    }
+  }
+  {
+    AL::Math::TrajectoryWriter<AL::Math::Pose2D> writer(kFileName, true);
+    EXPECT_EQ(100u, writer.size());
+    EXPECT_THROW(writer.append(5.0, AL::Math::Pose2D()), std::invalid_argument);
+    for (unsigned int i=100; i<250; i++)
+    {
+      writer.append(0.1*i, AL::Math::Pose2D(0.1f*i, 0.0f, 0.0f));
+    }
+
+    // a reader sees the records flushed while recording
+    writer.flush();
+    AL::Math::TrajectoryReader<AL::Math::Pose2D> reader(kFileName);
+    EXPECT_FALSE(reader.hasIndex());
+    EXPECT_EQ(250u, reader.size());
+    EXPECT_EQ(180u, reader.findRecord(18.05));
+  }
+
+  AL::Math::TrajectoryReader<AL::Math::Pose2D> reader(kFileName);
+  EXPECT_TRUE(reader.hasIndex());
+  ASSERT_EQ(250u, reader.size());
+  AL::Math::Pose2D pose;
+  for (unsigned int i=0; i<reader.size(); i++)
+  {
+    reader.get(i, pose);
+    EXPECT_FLOAT_EQ(0.1f*i, pose.x);
+    EXPECT_EQ(i, reader.findRecord(0.1*i + 0.01));
+  }
+
+  // append to a file which was not closed, with a partial record at the end
+  {
+    std::ofstream file(kFileName.c_str(), std::ios::binary | std::ios::app);
+    file.write("xyz", 3);
+  }
+  {
+    AL::Math::TrajectoryWriter<AL::Math::Pose2D> writer(kFileName, true);
+    EXPECT_EQ(250u, writer.size());
+    writer.append(25.0, AL::Math::Pose2D(25.0f, 0.0f, 0.0f));
+  }
+  AL::Math::TrajectoryReader<AL::Math::Pose2D> appended(kFileName);
+  EXPECT_EQ(251u, appended.size());
+  EXPECT_DOUBLE_EQ(25.0, appended.getTime(250));
+  std::remove(kFileName.c_str());
+}
+
+
+TEST(TrajectoryFileTest, appendClosed)
+{
+  const std::string crashName = "altrajectoryfile_test_crash.bin";
+  {
+    // an index longer than a record
+    AL::Math::TrajectoryWriter<AL::Math::Pose2D> writer(kFileName, false, 1);
+    for (unsigned int i=0; i<100; i++)
+    {
+      writer.append(0.01*i, AL::Math::Pose2D(0.01f*i, 0.0f, 0.0f));
+    }
+  }
+  {
+    AL::Math::TrajectoryWriter<AL::Math::Pose2D> writer(kFileName, true);
+    writer.append(1.0, AL::Math::Pose2D(1.0f, 0.0f, 0.0f));
+    writer.flush();
+
+    // the old index is not read as records
+    AL::Math::TrajectoryReader<AL::Math::Pose2D> reader(kFileName);
+    EXPECT_FALSE(reader.hasIndex());
+    ASSERT_EQ(101u, reader.size());
+    EXPECT_DOUBLE_EQ(1.0, reader.getTime(100));
+
+    // the file as it is after a crash of the writer
+    std::ifstream source(kFileName.c_str(), std::ios::binary);
+    std::ofstream copy(crashName.c_str(), std::ios::binary);
+    copy << source.rdbuf();
+  }
+  {
+    AL::Math::TrajectoryWriter<AL::Math::Pose2D> writer(crashName, true);
+    EXPECT_EQ(101u, writer.size());
+    writer.append(1.01, AL::Math::Pose2D(1.01f, 0.0f, 0.0f));
+  }
+  AL::Math::TrajectoryReader<AL::Math::Pose2D> reader(crashName);
+  EXPECT_TRUE(reader.hasIndex());
+  ASSERT_EQ(102u, reader.size());
+  AL::Math::Pose2D pose;
+  for (unsigned int i=0; i<reader.size(); i++)
+  {
+    reader.get(i, pose);
+    EXPECT_FLOAT_EQ(0.01f*i, pose.x);
+  }
+  std::remove(kFileName.c_str());
+  std::remove(crashName.c_str());
+}
+
+
+TEST(TrajectoryFileTest, badFile)
+{
+  EXPECT_THROW(AL::Math::TrajectoryReader<AL::Math::Pose2D> reader(
+                 "altrajectoryfile_test_missing.bin"), std::runtime_error);
+
+  {
+    std::ofstream file(kFileName.c_str(), std::ios::binary);
+    file << "not a trajectory file, not a trajectory file, not a trajectory file";
+  }
+  EXPECT_THROW(AL::Math::TrajectoryReader<AL::Math::Pose2D> reader(kFileName),
+               std::runtime_error);
+  EXPECT_THROW(AL::Math::TrajectoryWriter<AL::Math::Pose2D> writer(kFileName, true),
+               std::runtime_error);
+
+  {
+    AL::Math::TrajectoryWriter<AL::Math::Pose2D> writer(kFileName);
+  }
+  AL::Math::TrajectoryReader<AL::Math::Pose2D> reader(kFileName);
+  EXPECT_EQ(0u, reader.size());
+  AL::Math::Pose2D pose;
+  EXPECT_THROW(reader.getAtTime(0.0, pose), std::runtime_error);
+  std::remove(kFileName.c_str());
+}
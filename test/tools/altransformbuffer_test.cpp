@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/altransformbuffer.h>
+#include <almath/tools/altransformhelpers.h>
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  // a screw motion along x: its SE(3) interpolation is exact
+  AL::Math::Transform makeScrew(const double& pTime)
+  {
+    AL::Math::Transform transform =
+        AL::Math::Transform::fromRotX(0.1f*static_cast<float>(pTime));
+    transform.r1_c4 = static_cast<float>(pTime);
+    return transform;
+  }
+
+  const bool isScrew(
+    const double&              pTime,
+    const AL::Math::Transform& pTransform)
+  {
+    const float angle = 0.1f*static_cast<float>(pTime);
+    return (std::fabs(pTransform.r1_c4 - static_cast<float>(pTime)) < 1e-3f) &&
+        (std::fabs(pTransform.r2_c2 - std::cos(angle)) < 1e-3f) &&
+        (std::fabs(pTransform.r3_c2 - std::sin(angle)) < 1e-3f);
+  }
+}
+
+
+TEST(TransformBufferTest, interpolation)
+{
+  EXPECT_THROW(AL::Math::TransformBuffer buffer(1), std::invalid_argument);
+
+  AL::Math::TransformBuffer buffer(16);
+  EXPECT_EQ(16u, buffer.capacity());
+  EXPECT_EQ(0u, buffer.size());
+
+  AL::Math::Transform transform;
+  double time = 0.0;
+  EXPECT_FALSE(buffer.getAtTime(0.0, transform));
+  EXPECT_FALSE(buffer.getLatest(time, transform));
+
+  const AL::Math::Transform t1 = AL::Math::Transform::from3DRotation(0.1f, 0.2f, 0.3f);
+  AL::Math::Transform t2 = AL::Math::Transform::from3DRotation(0.3f, -0.1f, 0.5f);
+  t2.r1_c4 = 0.2f;
+  t2.r3_c4 = -0.1f;
+  EXPECT_TRUE(buffer.push(1.0, t1));
+  EXPECT_TRUE(buffer.getAtTime(1.0, transform));
+  EXPECT_TRUE(t1.isNear(transform, 0.0f));
+  EXPECT_FALSE(buffer.getAtTime(1.5, transform));
+
+  EXPECT_TRUE(buffer.push(2.0, t2));
+  EXPECT_FALSE(buffer.push(2.0, t1));
+  EXPECT_FALSE(buffer.push(1.5, t1));
+  EXPECT_EQ(2u, buffer.size());
+
+  // same as the logarithmic mean
+  EXPECT_TRUE(buffer.getAtTime(1.25, transform));
+  EXPECT_TRUE(AL::Math::transformMean(t1, t2, 0.25f).isNear(transform, 1e-5f));
+  EXPECT_TRUE(buffer.getAtTime(2.0, transform));
+  EXPECT_TRUE(t2.isNear(transform, 0.0f));
+  EXPECT_FALSE(buffer.getAtTime(0.5, transform));
+  EXPECT_FALSE(buffer.getAtTime(2.5, transform));
+
+  EXPECT_TRUE(buffer.getLatest(time, transform));
+  EXPECT_DOUBLE_EQ(2.0, time);
+  EXPECT_TRUE(t2.isNear(transform, 0.0f));
+}
+
+
+TEST(TransformBufferTest, wrapAround)
+{
+  AL::Math::TransformBuffer buffer(10);
+  for (unsigned int i=0; i<25; i++)
+  {
+    EXPECT_TRUE(buffer.push(0.1*i, makeScrew(0.1*i)));
+  }
+  EXPECT_EQ(10u, buffer.size());
+
+  AL::Math::Transform transform;
+  // samples 15 to 24 are left
+  EXPECT_FALSE(buffer.getAtTime(1.45, transform));
+  for (unsigned int i=150; i<=240; i+=3)
+  {
+    const double time = 0.01*i;
+    ASSERT_TRUE(buffer.getAtTime(time, transform)) << time;
+    EXPECT_TRUE(isScrew(time, transform)) << time;
+  }
+}
+
+
+TEST(TransformBufferTest, concurrentReaders)
+{
+  const unsigned int nbSamples = 50000;
+  AL::Math::TransformBuffer buffer(64);
+  std::atomic<bool> done(false);
+  std::atomic<unsigned int> nbErrors(0);
+  std::atomic<unsigned int> nbFound(0);
+
+  std::vector<std::thread> readers;
+  for (unsigned int r=0; r<3; r++)
+  {
+    readers.push_back(std::thread([&buffer, &done, &nbErrors, &nbFound]()
+    {
+      AL::Math::Transform transform;
+      double latest = 0.0;
+      while (!done.load())
+      {
+        if (!buffer.getLatest(latest, transform))
+        {
+          continue;
+        }
+        if (!isScrew(latest, transform))
+        {
+          ++nbErrors;
+        }
+        // a time in the middle of the buffer, which may be replaced
+        // while it is read
+        const double time = latest - 0.0005*(nbFound.load() % 64);
+        if (buffer.getAtTime(time, transform))
+        {
+          ++nbFound;
+          if (!isScrew(time, transform))
+          {
+            ++nbErrors;
+          }
+        }
+      }
+    }));
+  }
+
+  for (unsigned int i=0; i<nbSamples; i++)
+  {
+    buffer.push(0.001*i, makeScrew(0.001*i));
+  }
+  done.store(true);
+  for (unsigned int r=0; r<readers.size(); r++)
+  {
+    readers[r].join();
+  }
+  EXPECT_EQ(0u, nbErrors.load());
+  EXPECT_LT(0u, nbFound.load());
+}
@@ -1419,3 +1419,62 @@ TEST(ALTransformHelpersTest, quaternionVsTransform)
 //  std::cout << "Result  : " << pQua << std::endl;
 //  std::cout << "Expected: " << AL::Math::Quaternion() << std::endl;
 }
+
+
+TEST(ALTransformHelpersTest, axisMask)
+{
+  const AL::Math::Transform current =
+      AL::Math::Transform::fromPosition(0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f);
+  const AL::Math::Transform target =
+      AL::Math::Transform::fromPosition(0.3f, -0.2f, 0.1f, -0.4f, 0.2f, 0.1f);
+
+  // all the axes: same as the unmasked functions
+  const AL::Math::Velocity6D log = AL::Math::transformLogarithm(target);
+  const AL::Math::Position6D diff = AL::Math::position6DFromTransformDiff(current, target);
+  EXPECT_TRUE(AL::Math::maskedTransformLogarithm<AL::Math::AXIS_MASK_ALL>(target).isNear(log, 0.0f));
+  EXPECT_TRUE(AL::Math::maskedPosition6DFromTransformDiff<AL::Math::AXIS_MASK_ALL>(
+                current, target).isNear(diff, 0.0f));
+
+  // some axes: the others are zero
+  const AL::Math::Velocity6D logRot =
+      AL::Math::maskedTransformLogarithm<AL::Math::AXIS_MASK_ROT>(target);
+  EXPECT_TRUE(logRot.isNear(AL::Math::Velocity6D(0.0f, 0.0f, 0.0f,
+                                                 log.wxd, log.wyd, log.wzd), 0.0f));
+  const AL::Math::Velocity6D logXWz =
+      AL::Math::maskedTransformLogarithm<AL::Math::AXIS_MASK_X + AL::Math::AXIS_MASK_WZ>(target);
+  EXPECT_TRUE(logXWz.isNear(AL::Math::Velocity6D(log.xd, 0.0f, 0.0f,
+                                                 0.0f, 0.0f, log.wzd), 0.0f));
+
+  // the special cases of the logarithm, at an angle of pi
+  const AL::Math::Transform halfTurn =
+      AL::Math::Transform::fromRotY(AL::Math::PI)*AL::Math::Transform(0.1f, 0.2f, 0.3f);
+  const AL::Math::Velocity6D logHalfTurn = AL::Math::transformLogarithm(halfTurn);
+  EXPECT_TRUE(AL::Math::maskedTransformLogarithm<AL::Math::AXIS_MASK_VEL>(halfTurn).isNear(
+                AL::Math::Velocity6D(logHalfTurn.xd, logHalfTurn.yd, logHalfTurn.zd,
+                                     0.0f, 0.0f, 0.0f), 0.0f));
+
+  AL::Math::Position6D diffXY(1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+  AL::Math::maskedPosition6DFromTransformDiffInPlace<AL::Math::AXIS_MASK_XY>(
+        current, target, diffXY);
+  EXPECT_TRUE(diffXY.isNear(AL::Math::Position6D(diff.x, diff.y, 0.0f,
+                                                 0.0f, 0.0f, 0.0f), 0.0f));
+  const AL::Math::Position6D diffWyWz =
+      AL::Math::maskedPosition6DFromTransformDiff<AL::Math::AXIS_MASK_WYWZ>(current, target);
+  EXPECT_TRUE(diffWyWz.isNear(AL::Math::Position6D(0.0f, 0.0f, 0.0f,
+                                                   0.0f, diff.wy, diff.wz), 0.0f));
+
+  const AL::Math::Velocity6D vel(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f);
+  EXPECT_TRUE(AL::Math::maskedVelocity6DProjection<AL::Math::AXIS_MASK_Z + AL::Math::AXIS_MASK_WX>(
+                vel).isNear(AL::Math::Velocity6D(0.0f, 0.0f, 3.0f, 4.0f, 0.0f, 0.0f), 0.0f));
+  AL::Math::Velocity6D none = vel;
+  AL::Math::maskedVelocity6DProjectionInPlace<AL::Math::AXIS_MASK_NONE>(none);
+  EXPECT_TRUE(none.isNear(AL::Math::Velocity6D(), 0.0f));
+
+  const AL::Math::Position6D pos1(1.0f, 2.0f, 3.0f, 0.1f, 0.2f, 0.3f);
+  const AL::Math::Position6D pos2(0.0f, 0.0f, 1.0f, 0.1f, 0.5f, 0.7f);
+  EXPECT_NEAR(AL::Math::distance(pos1, pos2),
+              AL::Math::maskedDistance<AL::Math::AXIS_MASK_VEL>(pos1, pos2), 0.00001f);
+  EXPECT_NEAR(0.25f, AL::Math::maskedDistanceSquared<AL::Math::AXIS_MASK_ROT>(pos1, pos2), 0.00001f);
+  EXPECT_NEAR(1.0f, AL::Math::maskedDistance<AL::Math::AXIS_MASK_X>(pos1, pos2), 0.00001f);
+  EXPECT_EQ(0.0f, AL::Math::maskedDistance<AL::Math::AXIS_MASK_NONE>(pos1, pos2));
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+#include <almath/types/alfootpolygon.h>
+#include <almath/tools/altrigonometry.h>
+
+#include <gtest/gtest.h>
+
+TEST(ALFootPolygonTest, update)
+{
+  // clockwise box
+  std::vector<AL::Math::Pose2D> pBox;
+  pBox.push_back(AL::Math::Pose2D( 0.080f,  0.050f, 0.0f));
+  pBox.push_back(AL::Math::Pose2D( 0.080f, -0.038f, 0.0f));
+  pBox.push_back(AL::Math::Pose2D(-0.047f, -0.038f, 0.0f));
+  pBox.push_back(AL::Math::Pose2D(-0.047f,  0.050f, 0.0f));
+
+  AL::Math::FootBox pFoot = AL::Math::FootBox(pBox);
+  EXPECT_EQ(4u, pFoot.size());
+  EXPECT_TRUE(pFoot.vertices[1].isNear(AL::Math::Position2D(0.080f, -0.038f)));
+
+  // outward unit normals
+  EXPECT_TRUE(pFoot.normals[0].isNear(AL::Math::Position2D( 1.0f,  0.0f)));
+  EXPECT_TRUE(pFoot.normals[1].isNear(AL::Math::Position2D( 0.0f, -1.0f)));
+  EXPECT_TRUE(pFoot.normals[2].isNear(AL::Math::Position2D(-1.0f,  0.0f)));
+  EXPECT_TRUE(pFoot.normals[3].isNear(AL::Math::Position2D( 0.0f,  1.0f)));
+
+  EXPECT_TRUE(pFoot.boxMin.isNear(AL::Math::Position2D(-0.047f, -0.038f)));
+  EXPECT_TRUE(pFoot.boxMax.isNear(AL::Math::Position2D( 0.080f,  0.050f)));
+
+  // counterclockwise triangle
+  AL::Math::Position2D pTriangle[3];
+  pTriangle[0] = AL::Math::Position2D(0.0f, 0.0f);
+  pTriangle[1] = AL::Math::Position2D(1.0f, 0.0f);
+  pTriangle[2] = AL::Math::Position2D(0.0f, 1.0f);
+
+  AL::Math::FootPolygon<3> pPolygon = AL::Math::FootPolygon<3>(pTriangle);
+  EXPECT_TRUE(pPolygon.normals[0].isNear(AL::Math::Position2D(0.0f, -1.0f)));
+  EXPECT_TRUE(pPolygon.normals[1].isNear(AL::Math::Position2D(0.70711f, 0.70711f)));
+  EXPECT_TRUE(pPolygon.normals[2].isNear(AL::Math::Position2D(-1.0f, 0.0f)));
+}
+
+
+TEST(ALFootPolygonTest, transform)
+{
+  AL::Math::Position2D pVertices[4];
+  pVertices[0] = AL::Math::Position2D( 0.1f,  0.05f);
+  pVertices[1] = AL::Math::Position2D( 0.1f, -0.05f);
+  pVertices[2] = AL::Math::Position2D(-0.1f, -0.05f);
+  pVertices[3] = AL::Math::Position2D(-0.1f,  0.05f);
+
+  AL::Math::FootBox pFoot = AL::Math::FootBox(pVertices);
+  AL::Math::FootBox pMoved;
+  pFoot.transform(AL::Math::Pose2D(1.0f, 2.0f, AL::Math::PI_2), pMoved);
+
+  EXPECT_TRUE(pMoved.vertices[0].isNear(AL::Math::Position2D(0.95f, 2.1f)));
+  EXPECT_TRUE(pMoved.vertices[2].isNear(AL::Math::Position2D(1.05f, 1.9f)));
+  EXPECT_TRUE(pMoved.normals[0].isNear(AL::Math::Position2D(0.0f, 1.0f)));
+  EXPECT_TRUE(pMoved.boxMin.isNear(AL::Math::Position2D(0.95f, 1.9f)));
+  EXPECT_TRUE(pMoved.boxMax.isNear(AL::Math::Position2D(1.05f, 2.1f)));
+
+  // the transformed polygon is the same as the one built from scratch
+  AL::Math::FootBox pRebuilt = AL::Math::FootBox(pMoved.vertices);
+  for (unsigned int i=0; i<4; i++)
+  {
+    EXPECT_TRUE(pRebuilt.normals[i].isNear(pMoved.normals[i]));
+  }
+
+  EXPECT_TRUE(pFoot.isBoundingBoxOverlapping(pFoot));
+  EXPECT_FALSE(pFoot.isBoundingBoxOverlapping(pMoved));
+}
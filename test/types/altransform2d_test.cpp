@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+#include <almath/types/altransform2d.h>
+#include <almath/tools/altrigonometry.h>
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+TEST(ALTransform2DTest, sameAsPose2D)
+{
+  const AL::Math::Pose2D pose1(0.5f, -0.3f, 0.1f);
+  const AL::Math::Pose2D pose2(-0.2f, 0.4f, 1.2f);
+  const AL::Math::Transform2D t1(pose1);
+  const AL::Math::Transform2D t2 = AL::Math::transform2DFromPose2D(pose2);
+
+  EXPECT_TRUE(AL::Math::Transform2D().toPose2D().isNear(AL::Math::Pose2D(), 0.0f));
+  EXPECT_TRUE(t1.toPose2D().isNear(pose1));
+  EXPECT_TRUE(AL::Math::Transform2D(0.5f, -0.3f, 0.1f) == t1);
+  EXPECT_TRUE(t1 != t2);
+
+  // compose, inverse and apply
+  EXPECT_TRUE((t1*t2).toPose2D().isNear(pose1*pose2));
+  EXPECT_TRUE(t1.inverse().toPose2D().isNear(AL::Math::pose2DInverse(pose1)));
+  EXPECT_TRUE((t1*t1.inverse()).isNear(AL::Math::Transform2D()));
+  AL::Math::Transform2D t3 = t1;
+  t3 *= t2;
+  EXPECT_TRUE(t3.isNear(t1*t2, 0.0f));
+  AL::Math::transform2DInverse(t3, t3);
+  EXPECT_TRUE(t3.isNear(AL::Math::transform2DInverse(t1*t2), 0.0f));
+
+  const AL::Math::Position2D position = t1*AL::Math::Position2D(0.2f, 0.1f);
+  const AL::Math::Pose2D expected = pose1*AL::Math::Pose2D(0.2f, 0.1f, 0.0f);
+  EXPECT_NEAR(expected.x, position.x, 0.0001f);
+  EXPECT_NEAR(expected.y, position.y, 0.0001f);
+
+  // theta is wrapped in [-pi, pi]
+  const AL::Math::Pose2D turn(0.0f, 0.0f, 3.0f);
+  EXPECT_NEAR(6.0f - 2.0f*AL::Math::PI,
+              AL::Math::pose2DFromTransform2D(AL::Math::Transform2D(turn*turn)).theta,
+              0.0001f);
+}
+
+
+TEST(ALTransform2DTest, batchAndNormalize)
+{
+  AL::Math::Transform2D left[3];
+  AL::Math::Transform2D right[3];
+  AL::Math::Transform2D results[3];
+  AL::Math::Position2D positions[3];
+  for (unsigned int i=0; i<3; i++)
+  {
+    left[i] = AL::Math::Transform2D(0.1f*i, -0.2f, 0.3f*i);
+    right[i] = AL::Math::Transform2D(0.4f, 0.1f*i, -0.5f);
+    positions[i] = AL::Math::Position2D(0.1f*i, 1.0f);
+  }
+
+  AL::Math::transform2DCompose(left, right, 3, results);
+  for (unsigned int i=0; i<3; i++)
+  {
+    EXPECT_TRUE(results[i].isNear(left[i]*right[i], 0.0f));
+  }
+
+  // results may be the operands
+  AL::Math::transform2DCompose(left[1], right, 3, right);
+  for (unsigned int i=0; i<3; i++)
+  {
+    EXPECT_TRUE(right[i].isNear(left[1]*AL::Math::Transform2D(0.4f, 0.1f*i, -0.5f), 0.0f));
+  }
+
+  AL::Math::transform2DApply(left[2], positions, 3, positions);
+  for (unsigned int i=0; i<3; i++)
+  {
+    const AL::Math::Position2D expected = left[2]*AL::Math::Position2D(0.1f*i, 1.0f);
+    EXPECT_TRUE(positions[i].isNear(expected, 0.0f));
+  }
+
+  // many compositions, then normalize
+  const AL::Math::Transform2D step(0.01f, 0.0f, 0.001f);
+  AL::Math::Transform2D chain;
+  for (unsigned int i=0; i<10000; i++)
+  {
+    chain *= step;
+  }
+  AL::Math::transform2DNormalizeInPlace(chain);
+  EXPECT_NEAR(1.0f, chain.cosTheta*chain.cosTheta + chain.sinTheta*chain.sinTheta, 0.000001f);
+  EXPECT_NEAR(10.0f - 4.0f*AL::Math::PI, chain.toPose2D().theta, 0.01f);
+
+  AL::Math::Transform2D zero;
+  zero.cosTheta = 0.0f;
+  EXPECT_THROW(AL::Math::transform2DNormalizeInPlace(zero), std::runtime_error);
+}